@@ -0,0 +1,442 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "BatchRunner.cpp"
+//! \brief Implementation file for BatchRunner class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "BatchRunner.h"
+#include "SceneModel.h"
+#include "NodeModel.h"
+#include "NodeFactory.h"
+#include "Node.h"
+#include "Parameter.h"
+#include "OgreManager.h"
+#include "Profiler.h"
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTextStream>
+#include <QtCore/QElapsedTimer>
+#include <iostream>
+
+// COLLADA
+#define NO_BOOST
+#include <dae.h>
+
+
+///
+/// Public Static Functions
+///
+
+
+//!
+//! Returns the command line usage of the batch runner.
+//!
+//! \return The usage text.
+//!
+QString BatchRunner::getUsage ()
+{
+    return QString(
+        "Usage: frapperbatch <scene.dae> [options]\n"
+        "\n"
+        "Options:\n"
+        "  --frames <first>:<last>[:<step>]  Frames to evaluate (default: in and out frame of the scene)\n"
+        "  --output <node>:<parameter>       Output parameter to evaluate, may be given several times\n"
+        "                                    (default: all outputs of nodes with the eval flag set)\n"
+        "  --csv <file>                      Write the evaluated values to the given file instead of stdout\n"
+        "  --quiet                           Evaluate without writing values to stdout\n"
+        "  --profile <file>                  Record the evaluation and write a Chrome trace JSON file\n"
+    );
+}
+
+
+//!
+//! Prints the given message to stderr. stdout only carries the CSV
+//! values, and the console output of the log is not available in all
+//! builds.
+//!
+//! \param message The message to print.
+//! \param prefix The prefix of the message, e.g. "Error".
+//!
+void BatchRunner::printMessage ( const QString &message, const QString &prefix /* = QString() */ )
+{
+    if (prefix.isEmpty())
+        std::cerr << message.toLocal8Bit().constData() << std::endl;
+    else
+        std::cerr << prefix.toLocal8Bit().constData() << ": " << message.toLocal8Bit().constData() << std::endl;
+}
+
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the BatchRunner class.
+//!
+BatchRunner::BatchRunner () :
+    m_sceneModel(0),
+    m_frameRangeGiven(false),
+    m_firstFrame(0),
+    m_lastFrame(0),
+    m_frameStep(1),
+    m_quiet(false)
+{
+}
+
+
+//!
+//! Destructor of the BatchRunner class.
+//!
+BatchRunner::~BatchRunner ()
+{
+    delete m_sceneModel;
+
+    NodeFactory::freeResources();
+    OgreManager::finalize();
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Parses the given command line arguments.
+//!
+//! \param arguments The command line arguments without the program name.
+//! \return True if the arguments are valid, otherwise False.
+//!
+bool BatchRunner::parseArguments ( const QStringList &arguments )
+{
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QString &argument = arguments.at(i);
+        const bool hasValue = i + 1 < arguments.size();
+
+        if (argument == "--frames" && hasValue) {
+            const QStringList range = arguments.at(++i).split(':');
+            bool firstOk = false;
+            bool lastOk = false;
+            bool stepOk = true;
+            if (range.size() >= 2) {
+                m_firstFrame = range.at(0).toInt(&firstOk);
+                m_lastFrame = range.at(1).toInt(&lastOk);
+                if (range.size() > 2)
+                    m_frameStep = range.at(2).toInt(&stepOk);
+            }
+            if (!firstOk || !lastOk || !stepOk || m_frameStep < 1 || range.size() > 3) {
+                printMessage(QString("Invalid frame range \"%1\".").arg(arguments.at(i)), "Error");
+                return false;
+            }
+            m_frameRangeGiven = true;
+        } else if (argument == "--output" && hasValue) {
+            const QString outputName = arguments.at(++i);
+            if (!outputName.contains(':')) {
+                printMessage(QString("Invalid output \"%1\", expected <node>:<parameter>.").arg(outputName), "Error");
+                return false;
+            }
+            m_outputNames << outputName;
+        } else if (argument == "--csv" && hasValue) {
+            m_outputFilename = arguments.at(++i);
+        } else if (argument == "--profile" && hasValue) {
+            m_profileFilename = arguments.at(++i);
+        } else if (argument == "--quiet") {
+            m_quiet = true;
+        } else if (!argument.startsWith("--") && m_sceneFilename.isEmpty()) {
+            m_sceneFilename = argument;
+        } else {
+            printMessage(QString("Invalid argument \"%1\".").arg(argument), "Error");
+            return false;
+        }
+    }
+
+    if (m_sceneFilename.isEmpty()) {
+        printMessage("No scene file given.", "Error");
+        return false;
+    }
+
+    return true;
+}
+
+
+//!
+//! Loads the scene, evaluates all frames and writes the results.
+//!
+//! \return The exit code for the application.
+//!
+int BatchRunner::run ()
+{
+    initialize();
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    if (!loadScene())
+        return EC_SceneNotLoaded;
+    const qint64 loadTime = loadTimer.elapsed();
+
+    if (!collectOutputs())
+        return EC_OutputNotFound;
+
+    // open the destination of the evaluated values
+    QFile outputFile;
+    if (!m_outputFilename.isEmpty()) {
+        outputFile.setFileName(m_outputFilename);
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+            printMessage(QString("The file \"%1\" could not be opened for writing.").arg(m_outputFilename), "Error");
+            return EC_OutputNotWritten;
+        }
+    } else if (!m_quiet)
+        outputFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+
+    QTextStream stream (&outputFile);
+    const bool writeValues = outputFile.isOpen();
+    if (writeValues) {
+        QStringList header;
+        header << "frame";
+        foreach (const QString &columnName, m_columnNames)
+            header << toField(columnName);
+        stream << header.join(",") << "\n";
+    }
+
+    if (!m_frameRangeGiven) {
+        m_firstFrame = m_sceneModel->getInFrame();
+        m_lastFrame = m_sceneModel->getOutFrame();
+    }
+
+    if (!m_profileFilename.isEmpty())
+        Profiler::setEnabled(true);
+
+    // step through the frames without any playback pacing
+    QElapsedTimer evaluationTimer;
+    evaluationTimer.start();
+    int frameCount = 0;
+    for (int frame = m_firstFrame; frame <= m_lastFrame; frame += m_frameStep) {
+        m_sceneModel->stepFrame(frame);
+
+        QStringList fields;
+        fields << QString::number(frame);
+        for (int i = 0; i < m_outputParameters.size(); ++i) {
+            const QVariant value = m_outputParameters.at(i)->getValue(true);
+            if (writeValues)
+                fields << toField(value);
+        }
+        if (writeValues)
+            stream << fields.join(",") << "\n";
+
+        ++frameCount;
+    }
+    const qint64 evaluationTime = evaluationTimer.elapsed();
+
+    if (!m_profileFilename.isEmpty()) {
+        Profiler::setEnabled(false);
+        writeProfile();
+    }
+
+    stream.flush();
+    if (outputFile.isOpen())
+        outputFile.close();
+
+    const double framesPerSecond = evaluationTime > 0 ? 1000.0 * frameCount / evaluationTime : 0.0;
+    printMessage(QString("Loaded scene in %1 ms, evaluated %2 frames with %3 outputs in %4 ms (%5 frames per second).")
+        .arg(loadTime).arg(frameCount).arg(m_outputParameters.size()).arg(evaluationTime).arg(framesPerSecond, 0, 'f', 1));
+
+    return EC_Success;
+}
+
+
+///
+/// Private Functions
+///
+
+
+//!
+//! Initializes OGRE without a render window and registers the node types.
+//!
+void BatchRunner::initialize ()
+{
+    // using absolute paths here is more robust against changes of current directory during runtime
+    const Ogre::String applicationPath = QDir::currentPath().toStdString();
+    const Ogre::String pluginFileName   = applicationPath + "/config/plugins.cfg";
+    const Ogre::String configFileName   = applicationPath + "/config/ogre.cfg";
+    const Ogre::String resourceFileName = applicationPath + "/config/resources.cfg";
+    const Ogre::String logFileName      = applicationPath + "/logs/ogre.log";
+    OgreManager::initialize(pluginFileName, configFileName, resourceFileName, logFileName, false);
+
+    m_sceneModel = new SceneModel();
+    m_sceneModel->createSceneRoot();
+
+    // parse the XML directory and look for node type description files
+    NodeFactory::initialize();
+    QDir nodeDir ("plugins/nodes");
+    const QFileInfoList fileInfoList = nodeDir.entryInfoList(QStringList() << "*.xml", QDir::Files);
+    if (fileInfoList.size() > 0)
+        for (int i = 0; i < fileInfoList.size(); ++i)
+            NodeFactory::registerType(fileInfoList.at(i).absoluteFilePath());
+    else
+        printMessage(QString("No XML description files for node types found in \"%1\".").arg(nodeDir.path()), "Warning");
+}
+
+
+//!
+//! Loads the scene file given on the command line.
+//!
+//! \return True if the scene was loaded, otherwise False.
+//!
+bool BatchRunner::loadScene ()
+{
+    const QString filename = QFileInfo(m_sceneFilename).absoluteFilePath();
+    if (!QFile::exists(filename)) {
+        printMessage(QString("The file \"%1\" could not be found.").arg(filename), "Error");
+        return false;
+    }
+
+    DAE dae;
+    daeElement *rootElement = dae.open(filename.toStdString());
+    if (!rootElement) {
+        printMessage(QString("The file \"%1\" could not be loaded.").arg(filename), "Error");
+        return false;
+    }
+
+    m_sceneModel->setSceneFileName(filename);
+    m_sceneModel->createScene(rootElement);
+    dae.close(filename.toStdString());
+    return true;
+}
+
+
+//!
+//! Resolves the requested output parameters. Without explicit outputs the
+//! output parameters of all nodes with the eval flag set are evaluated.
+//!
+//! \return True if all requested outputs were found, otherwise False.
+//!
+bool BatchRunner::collectOutputs ()
+{
+    NodeModel *nodeModel = m_sceneModel->getNodeModel();
+
+    if (m_outputNames.isEmpty()) {
+        const QStringList nodeNames = nodeModel->getNodeNames();
+        foreach (const QString &nodeName, nodeNames) {
+            Node *node = nodeModel->getNode(nodeName);
+            if (node && node->isEvaluated())
+                addOutputParameters(node);
+        }
+        return true;
+    }
+
+    foreach (const QString &outputName, m_outputNames) {
+        const int separatorIndex = outputName.indexOf(':');
+        const QString nodeName = outputName.left(separatorIndex);
+        const QString parameterName = outputName.mid(separatorIndex + 1);
+
+        Node *node = nodeModel->getNode(nodeName);
+        if (!node) {
+            printMessage(QString("The scene does not contain a node named \"%1\".").arg(nodeName), "Error");
+            return false;
+        }
+
+        Parameter *parameter = node->getParameter(parameterName);
+        if (!parameter) {
+            printMessage(QString("The node \"%1\" does not contain a parameter named \"%2\".").arg(nodeName, parameterName), "Error");
+            return false;
+        }
+
+        m_outputParameters << parameter;
+        m_columnNames << outputName;
+    }
+    return true;
+}
+
+
+//!
+//! Adds the output parameters of the given node to the evaluated outputs.
+//!
+//! \param node The node to add the output parameters of.
+//!
+void BatchRunner::addOutputParameters ( Node *node )
+{
+    const AbstractParameter::List parameters = node->getParameters(Parameter::PT_Output, true) + node->getParameters(Parameter::PT_Output, false);
+    foreach (AbstractParameter *abstractParameter, parameters) {
+        if (abstractParameter->isGroup())
+            continue;
+        Parameter *parameter = static_cast<Parameter *>(abstractParameter);
+        m_outputParameters << parameter;
+        m_columnNames << QString("%1:%2").arg(node->getName(), parameter->getName());
+    }
+}
+
+
+//!
+//! Writes the recorded profile and logs the hottest nodes.
+//!
+void BatchRunner::writeProfile ()
+{
+    if (Profiler::writeChromeTrace(m_profileFilename))
+        printMessage(QString("Wrote %1 profile events to \"%2\".").arg(Profiler::getEventCount()).arg(m_profileFilename));
+
+    const int droppedEventCount = Profiler::getDroppedEventCount();
+    if (droppedEventCount > 0)
+        printMessage(QString("%1 profile events were dropped.").arg(droppedEventCount), "Warning");
+
+    const QList<Profiler::NodeStatistics> statistics = Profiler::getNodeStatistics();
+    for (int i = 0; i < statistics.size() && i < 10; ++i) {
+        const Profiler::NodeStatistics &nodeStatistics = statistics.at(i);
+        printMessage(QString("%1: %2 ms in %3 calls (max %4 ms)")
+            .arg(nodeStatistics.nodeName)
+            .arg(nodeStatistics.selfTime / 1000.0, 0, 'f', 2)
+            .arg(nodeStatistics.calls)
+            .arg(nodeStatistics.maxTime / 1000.0, 0, 'f', 2));
+    }
+}
+
+
+//!
+//! Converts the given parameter value to a single CSV field.
+//!
+//! \param value The value to convert.
+//! \return The CSV field for the value.
+//!
+QString BatchRunner::toField ( const QVariant &value ) const
+{
+    QString field;
+    if (value.type() == QVariant::List) {
+        QStringList items;
+        foreach (const QVariant &item, value.toList())
+            items << item.toString();
+        field = items.join(" ");
+    } else if (value.canConvert(QVariant::String))
+        field = value.toString();
+    else
+        field = QString("<%1>").arg(value.typeName());
+
+    if (field.contains(',') || field.contains('"') || field.contains('\n'))
+        field = QString("\"%1\"").arg(field.replace("\"", "\"\""));
+    return field;
+}
@@ -0,0 +1,217 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "BatchRunner.h"
+//! \brief Header file for BatchRunner class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QList>
+#include <QtCore/QVariant>
+
+// forward declarations
+namespace Frapper {
+    class SceneModel;
+    class Node;
+    class Parameter;
+}
+
+using namespace Frapper;
+
+
+//!
+//! Class that loads a scene without a user interface, steps through its
+//! frames as fast as possible and writes the values of the requested output
+//! parameters for every frame.
+//!
+//! Only node plugins are registered; widget and panel plugins as well as
+//! OGRE render windows are never created.
+//!
+class BatchRunner
+{
+
+public: // nested type definitions
+
+    //!
+    //! Exit codes returned by run().
+    //!
+    enum ExitCode {
+        EC_Success = 0,
+        EC_InvalidArguments,
+        EC_SceneNotLoaded,
+        EC_OutputNotFound,
+        EC_OutputNotWritten
+    };
+
+public: // static functions
+
+    //!
+    //! Returns the command line usage of the batch runner.
+    //!
+    //! \return The usage text.
+    //!
+    static QString getUsage ();
+
+    //!
+    //! Prints the given message to stderr. stdout only carries the CSV
+    //! values, and the console output of the log is not available in all
+    //! builds.
+    //!
+    //! \param message The message to print.
+    //! \param prefix The prefix of the message, e.g. "Error".
+    //!
+    static void printMessage ( const QString &message, const QString &prefix = QString() );
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the BatchRunner class.
+    //!
+    BatchRunner ();
+
+    //!
+    //! Destructor of the BatchRunner class.
+    //!
+    ~BatchRunner ();
+
+public: // functions
+
+    //!
+    //! Parses the given command line arguments.
+    //!
+    //! \param arguments The command line arguments without the program name.
+    //! \return True if the arguments are valid, otherwise False.
+    //!
+    bool parseArguments ( const QStringList &arguments );
+
+    //!
+    //! Loads the scene, evaluates all frames and writes the results.
+    //!
+    //! \return The exit code for the application.
+    //!
+    int run ();
+
+private: // functions
+
+    //!
+    //! Initializes OGRE without a render window and registers the node types.
+    //!
+    void initialize ();
+
+    //!
+    //! Loads the scene file given on the command line.
+    //!
+    //! \return True if the scene was loaded, otherwise False.
+    //!
+    bool loadScene ();
+
+    //!
+    //! Resolves the requested output parameters. Without explicit outputs the
+    //! output parameters of all nodes with the eval flag set are evaluated.
+    //!
+    //! \return True if all requested outputs were found, otherwise False.
+    //!
+    bool collectOutputs ();
+
+    //!
+    //! Adds the output parameters of the given node to the evaluated outputs.
+    //!
+    //! \param node The node to add the output parameters of.
+    //!
+    void addOutputParameters ( Node *node );
+
+    //!
+    //! Writes the recorded profile and logs the hottest nodes.
+    //!
+    void writeProfile ();
+
+    //!
+    //! Converts the given parameter value to a single CSV field.
+    //!
+    //! \param value The value to convert.
+    //! \return The CSV field for the value.
+    //!
+    QString toField ( const QVariant &value ) const;
+
+private: // data
+
+    //!
+    //! The scene model the scene is loaded into.
+    //!
+    SceneModel *m_sceneModel;
+
+    //!
+    //! The name of the scene file to evaluate.
+    //!
+    QString m_sceneFilename;
+
+    //!
+    //! The name of the CSV file to write, or an empty string for stdout.
+    //!
+    QString m_outputFilename;
+
+    //!
+    //! The name of the Chrome trace file to write, or an empty string to
+    //! evaluate without profiling.
+    //!
+    QString m_profileFilename;
+
+    //!
+    //! The requested outputs in the form "node:parameter".
+    //!
+    QStringList m_outputNames;
+
+    //!
+    //! Flag that states whether a frame range was given on the command line.
+    //!
+    bool m_frameRangeGiven;
+
+    //!
+    //! The first, last and step frame to evaluate.
+    //!
+    int m_firstFrame;
+    int m_lastFrame;
+    int m_frameStep;
+
+    //!
+    //! Flag that states whether only the timing summary should be printed.
+    //!
+    bool m_quiet;
+
+    //!
+    //! The resolved output parameters and their column names.
+    //!
+    QList<Parameter *> m_outputParameters;
+    QStringList m_columnNames;
+};
+
+
+#endif
@@ -0,0 +1,82 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "main.cpp"
+//! \brief Main implementation file for the frapperbatch application.
+//!
+//! Evaluates a scene without user interface, e.g. on a build server without
+//! a display. With Qt 5 the offscreen platform plugin is used unless another
+//! platform is requested through QT_QPA_PLATFORM.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "BatchRunner.h"
+#include "Log.h"
+#include <QApplication>
+#include <iostream>
+
+
+//!
+//! The application's entry point.
+//!
+//! \param argc     the number of parameters passed to the program
+//! \param argv     the list of parameters passed to the program
+//!
+int main ( int argc, char **argv )
+{
+#if QT_VERSION >= 0x050000
+    // the scene model creates graphics items, so a GUI application is required, but nothing is shown
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+#endif
+
+    // initialize the log message handler
+    Log::initialize(true);
+
+    int result = BatchRunner::EC_Success;
+    try {
+        QApplication application (argc, argv);
+        application.setOrganizationName("Filmakademie Baden-Wuerttemberg");
+        application.setApplicationName("Frapper Batch");
+
+        BatchRunner batchRunner;
+        if (batchRunner.parseArguments(application.arguments().mid(1)))
+            result = batchRunner.run();
+        else {
+            std::cerr << BatchRunner::getUsage().toStdString();
+            result = BatchRunner::EC_InvalidArguments;
+        }
+    } catch ( std::exception& e) {
+        std::cerr << "An unhandled exception was thrown:" << std::endl;
+        std::cerr << e.what() << std::endl;
+        result = -1;
+    }
+
+    // free all resources from the log message handler
+    Log::finalize();
+
+    return result;
+}
@@ -0,0 +1,108 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AllocationCounter.cpp"
+//! \brief Implementation file for the allocation counting functions of frapperbench.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+
+///
+/// Global Variables with File Scope
+///
+
+//!
+//! The allocation count and byte count. The benchmark evaluates on a single
+//! thread, plain counters are sufficient.
+//!
+static quint64 s_allocationCount = 0;
+static quint64 s_allocationBytes = 0;
+
+
+///
+/// Global Allocation Operators
+///
+
+void * operator new ( size_t size )
+{
+    ++s_allocationCount;
+    s_allocationBytes += size;
+
+    void *memory = std::malloc(size ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void * operator new[] ( size_t size )
+{
+    return operator new(size);
+}
+
+void operator delete ( void *memory ) throw()
+{
+    std::free(memory);
+}
+
+void operator delete[] ( void *memory ) throw()
+{
+    std::free(memory);
+}
+
+
+namespace AllocationCounter {
+
+///
+/// Functions
+///
+
+
+//!
+//! Returns the number of allocations since the program started.
+//!
+//! \return The number of calls to the global operator new.
+//!
+quint64 getCount ()
+{
+    return s_allocationCount;
+}
+
+
+//!
+//! Returns the number of allocated bytes since the program started.
+//!
+//! \return The sum of the sizes passed to the global operator new.
+//!
+quint64 getBytes ()
+{
+    return s_allocationBytes;
+}
+
+} // end namespace AllocationCounter
@@ -0,0 +1,60 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AllocationCounter.h"
+//! \brief Header file for the allocation counting functions of frapperbench.
+//!
+//! The global operator new and delete are replaced to count the heap
+//! allocations made through them. Memory that Qt containers and strings
+//! allocate directly with malloc is not included, and on Windows only the
+//! allocations of the benchmark executable itself are counted.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtCore/QtGlobal>
+
+namespace AllocationCounter {
+
+    //!
+    //! Returns the number of allocations since the program started.
+    //!
+    //! \return The number of calls to the global operator new.
+    //!
+    quint64 getCount ();
+
+    //!
+    //! Returns the number of allocated bytes since the program started.
+    //!
+    //! \return The sum of the sizes passed to the global operator new.
+    //!
+    quint64 getBytes ();
+
+} // end namespace AllocationCounter
+
+#endif
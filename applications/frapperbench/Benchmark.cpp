@@ -0,0 +1,1414 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "Benchmark.cpp"
+//! \brief Implementation file for Benchmark class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "Log.h"
+#include "NodeModel.h"
+#include "SkeletonPose.h"
+#include "S3DGameClock.h"
+#include "S3DGameEngine.h"
+#include "ToFLibFusion.h"
+#include "AnimationClipTracks.h"
+#include "PoemLexicon.h"
+#include "CurveGraphicsItem.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#ifdef FRAPPERBENCH_OPENCV
+#include "Face.h"
+#endif
+#ifdef FRAPPERBENCH_PYTHON
+#include "PythonRuntime.h"
+#endif
+
+
+///
+/// Functions with File Scope
+///
+
+
+//!
+//! Selects the keys with a negative value.
+//!
+//! \param key The key to test.
+//! \param data Unused.
+//! \return True if the key's value is negative, otherwise False.
+//!
+static bool isNegativeKey ( const Key &key, void * /* data */ )
+{
+    return key.keyValue.toFloat() < 0.0f;
+}
+
+
+//!
+//! Replays the given number of frames of the fixed step game logic of the
+//! S3DGame node on the given paths. The frame times come from a fixed
+//! pseudo random sequence, so every replay is the same.
+//!
+//! \param paths The paths the character moves along, one after another.
+//! \param frames The number of frames to replay.
+//! \param steps Returns the number of simulated steps.
+//! \return A checksum of the events the character triggered.
+//!
+static quint64 replayGame ( const QList<S3DGameNode::Path *> &paths, int frames, int *steps )
+{
+    using namespace S3DGameNode;
+
+    // the default simulation rate of 25 steps per second
+    const int stepLength = 40;
+    const float stepAlpha = 0.01f;
+
+    FixedStepClock clock;
+    quint32 random = 12345;
+    int time = 0;
+    int pathIndex = 0;
+    float alpha = 0.0f;
+    quint64 checksum = 0;
+    *steps = 0;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        // frame times between 5 and 60 ms
+        random = random * 1664525u + 1013904223u;
+        time += 5 + (random >> 16) % 56;
+
+        const int frameSteps = clock.Advance(time, stepLength);
+        for (int step = 0; step < frameSteps; ++step) {
+            ++*steps;
+            alpha += stepAlpha;
+            if (alpha >= 1.0f) {
+                alpha = 0.0f;
+                pathIndex = (pathIndex + 1) % paths.size();
+            }
+
+            Path *path = paths.at(pathIndex);
+            const Vec3 position = path->GetPosition(alpha);
+            if (!path->EventBounds().contains(position))
+                continue;
+
+            foreach (GameEvent *event, path->Events())
+                if (event->isActive(position))
+                    checksum = checksum * 31 + *steps + event->GetPlatformType() + (event->IsFinish() ? 8 : 0);
+        }
+    }
+    return checksum;
+}
+
+
+///
+/// Macro Definitions
+///
+
+//!
+//! The number of frames between two keys of animated parameters.
+//!
+#define KEY_SPACING 4
+
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the Benchmark class.
+//!
+//! \param frames The number of frames to time for each graph.
+//! \param keys The number of keys of each animated parameter.
+//!
+Benchmark::Benchmark ( int frames, int keys ) :
+    m_frames(frames),
+    m_keys(keys),
+    m_nodeType(0),
+    m_heavyNodeType(0),
+    m_frameParameter(new NumberParameter("Frame", Parameter::T_Int, 0)),
+    m_rangeParameter(new NumberParameter("FrameRange", Parameter::T_Int, 0)),
+    m_animatedParameters(0)
+{
+    m_frameParameter->setMinValue(0);
+    m_frameParameter->setMaxValue(frames + 1);
+    m_rangeParameter->setMinValue(0);
+    m_rangeParameter->setMaxValue(frames + 1);
+
+    m_nodeType = new NodeType(":/benchmarknode.xml", &m_nodeFactory);
+    m_heavyNodeType = new NodeType(":/benchmarkheavynode.xml", &m_nodeFactory);
+}
+
+
+//!
+//! Destructor of the Benchmark class.
+//!
+Benchmark::~Benchmark ()
+{
+    reset();
+
+    delete m_nodeType;
+    delete m_heavyNodeType;
+    delete m_frameParameter;
+    delete m_rangeParameter;
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Returns whether the benchmark node type could be created.
+//!
+//! \return True if the benchmarks can be run, otherwise False.
+//!
+bool Benchmark::isValid () const
+{
+    return m_nodeType && m_nodeType->isAvailable() && m_heavyNodeType && m_heavyNodeType->isAvailable();
+}
+
+
+//!
+//! Times a chain of nodes, each connected to its predecessor.
+//!
+//! \param length The number of nodes in the chain.
+//! \return The measurements.
+//!
+Benchmark::Result Benchmark::runChain ( int length )
+{
+    const double createNodeMicroseconds = createNodes(length);
+    animate(m_nodes.first(), 0);
+    for (int i = 1; i < m_nodes.size(); ++i)
+        connect(m_nodes.at(i - 1), m_nodes.at(i), BenchmarkNode::InputAName);
+
+    const Result result = evaluate(QString("chain%1").arg(length), QList<Node *>() << m_nodes.last(), createNodeMicroseconds);
+    reset();
+    return result;
+}
+
+
+//!
+//! Times one animated node feeding the given number of nodes.
+//!
+//! \param width The number of nodes connected to the source node.
+//! \return The measurements.
+//!
+Benchmark::Result Benchmark::runFan ( int width )
+{
+    const double createNodeMicroseconds = createNodes(width + 1);
+    animate(m_nodes.first(), 0);
+    for (int i = 1; i < m_nodes.size(); ++i)
+        connect(m_nodes.first(), m_nodes.at(i), BenchmarkNode::InputAName);
+
+    const Result result = evaluate(QString("fan%1").arg(width), m_nodes.mid(1), createNodeMicroseconds);
+    reset();
+    return result;
+}
+
+
+//!
+//! Times a lattice of diamonds: every node of a layer is connected to two
+//! nodes of the previous layer.
+//!
+//! \param width The number of nodes per layer.
+//! \param depth The number of layers.
+//! \return The measurements.
+//!
+Benchmark::Result Benchmark::runDiamond ( int width, int depth )
+{
+    const double createNodeMicroseconds = createNodes(width * depth);
+    for (int column = 0; column < width; ++column)
+        animate(m_nodes.at(column), 0);
+    for (int layer = 1; layer < depth; ++layer)
+        for (int column = 0; column < width; ++column) {
+            Node *node = m_nodes.at(layer * width + column);
+            connect(m_nodes.at((layer - 1) * width + column), node, BenchmarkNode::InputAName);
+            connect(m_nodes.at((layer - 1) * width + (column + 1) % width), node, BenchmarkNode::InputBName);
+        }
+
+    const Result result = evaluate(QString("diamond%1x%2").arg(width).arg(depth), m_nodes.mid((depth - 1) * width), createNodeMicroseconds);
+    reset();
+    return result;
+}
+
+
+//!
+//! Times unconnected nodes whose values are all animated.
+//!
+//! \param nodes The number of nodes.
+//! \return The measurements.
+//!
+Benchmark::Result Benchmark::runAnimated ( int nodes )
+{
+    const double createNodeMicroseconds = createNodes(nodes);
+    foreach (Node *node, m_nodes)
+        for (int i = 0; i < 4; ++i)
+            animate(node, i);
+
+    const Result result = evaluate(QString("animated%1").arg(nodes), m_nodes, createNodeMicroseconds);
+    reset();
+    return result;
+}
+
+
+//!
+//! Times looking up parameters by name.
+//!
+//! \param iterations The number of lookups.
+//! \return The measurements.
+//!
+Benchmark::Result Benchmark::runParameterLookup ( int iterations )
+{
+    const double createNodeMicroseconds = createNodes(1);
+    Node *node = m_nodes.first();
+
+    const QString names[] = { BenchmarkNode::InputAName, BenchmarkNode::OutputName, BenchmarkNode::ValueNames[3] };
+
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    int found = 0;
+    for (int i = 0; i < iterations; ++i)
+        if (node->getParameter(names[i % 3]))
+            ++found;
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    if (found != iterations)
+        Log::warning("Not all parameters were found.", "Benchmark::runParameterLookup");
+
+    Result result;
+    result.scenario = "parameterLookup";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = iterations;
+    result.createNodeMicroseconds = createNodeMicroseconds;
+    result.microsecondsPerIteration = elapsed / 1000.0 / iterations;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / iterations;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / iterations;
+
+    reset();
+    return result;
+}
+
+
+//!
+//! Times the key interpolation of an animated parameter.
+//!
+//! \param iterations The number of interpolations.
+//! \return The measurements.
+//!
+Benchmark::Result Benchmark::runKeyInterpolation ( int iterations )
+{
+    const double createNodeMicroseconds = createNodes(1);
+    animate(m_nodes.first(), 0);
+    NumberParameter *parameter = m_nodes.first()->getNumberParameter(BenchmarkNode::ValueNames[0]);
+
+    const float lastTime = float(m_keys * KEY_SPACING);
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i)
+        sum += parameter->getKeyValueTime(lastTime * (i % 1000) / 1000.0f).toDouble();
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    Result result;
+    result.scenario = "keyInterpolation";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = m_animatedParameters;
+    result.iterations = iterations;
+    result.createNodeMicroseconds = createNodeMicroseconds;
+    result.microsecondsPerIteration = elapsed / 1000.0 / iterations;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / iterations;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / iterations;
+
+    // keep the interpolated values alive so the loop cannot be optimized away
+    if (sum == -1.0)
+        Log::debug("Unexpected sum of interpolated values.", "Benchmark::runKeyInterpolation");
+
+    reset();
+    return result;
+}
+
+
+//!
+//! Times the bulk key functions of a baked parameter with one key per
+//! frame: every other key is selected, transformed, normalized and set,
+//! the middle half of the keys is selected by time and retimed, and the
+//! set keys are selected by a predicate and removed, in one call each.
+//!
+//! \param keys The number of keys of the baked parameter.
+//! \param rounds The number of times the channel is baked and edited.
+//! \return The measurements per round.
+//!
+Benchmark::Result Benchmark::runBulkKeys ( int keys, int rounds )
+{
+    const double createNodeMicroseconds = createNodes(1);
+    NumberParameter *parameter = m_nodes.first()->getNumberParameter(BenchmarkNode::ValueNames[0]);
+    ++m_animatedParameters;
+
+    quint64 allocationCount = 0;
+    quint64 allocationBytes = 0;
+    qint64 elapsed = 0;
+    bool removed = true;
+    QElapsedTimer timer;
+    for (int round = 0; round < rounds; ++round) {
+        // baking the channel and selecting the keys is not timed
+        parameter->clearKeys();
+        for (int i = 0; i < keys; ++i)
+            parameter->addKey(float((i * 7) % 13));
+
+        const QList<Key> &parameterKeys = parameter->getKeys();
+        const float keySpacing = keys > 1 ? parameterKeys.at(1).index - parameterKeys.at(0).index : 1.0f;
+        const float firstTime = parameterKeys.at(keys / 4).index;
+        const float lastTime = parameterKeys.at(keys * 3 / 4).index;
+        const float timeOffset = keySpacing * 0.25f;
+        QList<Key *> selectedKeys;
+        selectedKeys.reserve(keys / 2 + 1);
+        for (int i = 0; i < keys; i += 2)
+            selectedKeys.append(const_cast<Key *>(&parameterKeys.at(i)));
+
+        const quint64 roundCount = AllocationCounter::getCount();
+        const quint64 roundBytes = AllocationCounter::getBytes();
+        timer.start();
+        const QList<int> indices = parameter->getKeyIndices(selectedKeys);
+        parameter->transformKeyValues(indices, 0.5f, 1.0f);
+        parameter->normalizeKeyValues(indices, 2.0f);
+        parameter->setKeyValues(indices, -1.0f);
+        const QList<int> rangeIndices = parameter->getKeyIndices(firstTime, lastTime);
+        parameter->retimeKeys(rangeIndices, 1.0f, timeOffset);
+        parameter->removeKeys(parameter->getKeyIndices(isNegativeKey));
+        elapsed += timer.nsecsElapsed();
+        allocationCount += AllocationCounter::getCount() - roundCount;
+        allocationBytes += AllocationCounter::getBytes() - roundBytes;
+
+        removed = removed && parameter->numKeys() == keys / 2;
+    }
+
+    if (!removed)
+        Log::warning("The bulk key functions did not remove the selected keys.", "Benchmark::runBulkKeys");
+
+    Result result;
+    result.scenario = "bulkKeys";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = m_animatedParameters;
+    result.iterations = rounds;
+    result.createNodeMicroseconds = createNodeMicroseconds;
+    result.microsecondsPerIteration = elapsed / 1000.0 / rounds;
+    result.allocationsPerIteration = double(allocationCount) / rounds;
+    result.bytesPerIteration = double(allocationBytes) / rounds;
+
+    reset();
+    return result;
+}
+
+
+//!
+//! Times creating and deleting nodes of a type with many parameters.
+//!
+//! \param count The number of nodes to create.
+//! \return The measurements per node.
+//!
+Benchmark::Result Benchmark::runCreateNodes ( int count )
+{
+    QList<Node *> nodes;
+    nodes.reserve(count);
+
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i)
+        nodes.append(m_heavyNodeType->createNode(QString("heavy%1").arg(i)));
+    const qint64 createElapsed = timer.nsecsElapsed();
+    const quint64 createCount = AllocationCounter::getCount() - allocationCount;
+    const quint64 createBytes = AllocationCounter::getBytes() - allocationBytes;
+
+    timer.restart();
+    qDeleteAll(nodes);
+    const qint64 deleteElapsed = timer.nsecsElapsed();
+
+    Result result;
+    result.scenario = "createHeavyNodes";
+    result.nodes = count;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = count;
+    result.createNodeMicroseconds = createElapsed / 1000.0 / count;
+    result.microsecondsPerIteration = (createElapsed + deleteElapsed) / 1000.0 / count;
+    result.allocationsPerIteration = double(createCount) / count;
+    result.bytesPerIteration = double(createBytes) / count;
+    return result;
+}
+
+
+//!
+//! Times deleting connections and nodes of a node model: every other
+//! connection of a chain is deleted in a nested update, as the scene model
+//! does, then the nodes are deleted with their remaining connections.
+//! The model indices are checked before and after.
+//!
+//! \param count The number of nodes in the chain.
+//! \return The measurements per deleted node.
+//!
+Benchmark::Result Benchmark::runNodeModel ( int count )
+{
+    NodeModel nodeModel;
+    QList<Node *> nodes;
+    nodes.reserve(count);
+
+    // build a chain of nodes of an unknown type with dummy parameters, as
+    // loading a scene whose plugins are missing does
+    QElapsedTimer timer;
+    timer.start();
+    nodeModel.beginUpdate();
+    for (int i = 0; i < count; ++i) {
+        Node *node = nodeModel.createNode("BenchmarkModelNode", QString("model%1").arg(i));
+        if (!node)
+            break;
+        Parameter *inputParameter = Parameter::create(BenchmarkNode::InputAName, Parameter::T_Float);
+        inputParameter->setPinType(Parameter::PT_Input);
+        node->getParameterRoot()->addParameter(inputParameter);
+        Parameter *outputParameter = Parameter::create(BenchmarkNode::OutputName, Parameter::T_Float);
+        outputParameter->setPinType(Parameter::PT_Output);
+        node->getParameterRoot()->addParameter(outputParameter);
+
+        if (!nodes.isEmpty()) {
+            Parameter *sourceParameter = nodes.last()->getParameter(BenchmarkNode::OutputName);
+            Connection *connection = nodeModel.createConnection(sourceParameter, inputParameter);
+            if (connection) {
+                sourceParameter->addConnection(connection);
+                inputParameter->addConnection(connection);
+            }
+        }
+        nodes.append(node);
+    }
+    nodeModel.endUpdate();
+    const qint64 createElapsed = timer.nsecsElapsed();
+
+    bool consistent = nodeModel.checkIndices();
+    const QList<Connection *> connections = nodeModel.getConnections();
+
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    timer.restart();
+    nodeModel.beginUpdate();
+    for (int i = 0; i < connections.size(); i += 2) {
+        nodeModel.beginUpdate();
+        nodeModel.deleteConnection(QString::number(connections.at(i)->getId()));
+        nodeModel.endUpdate();
+    }
+    foreach (Node *node, nodes)
+        nodeModel.deleteNode(node->getName());
+    nodeModel.endUpdate();
+    const qint64 deleteElapsed = timer.nsecsElapsed();
+    const quint64 deleteCount = AllocationCounter::getCount() - allocationCount;
+    const quint64 deleteBytes = AllocationCounter::getBytes() - allocationBytes;
+
+    consistent = consistent && nodeModel.checkIndices()
+        && nodeModel.getNodes().isEmpty() && nodeModel.getConnections().isEmpty();
+    if (!consistent)
+        Log::warning("The node model indices did not match its nodes and connections.", "Benchmark::runNodeModel");
+
+    Result result;
+    result.scenario = "nodeModel";
+    result.nodes = nodes.size();
+    result.connections = connections.size();
+    result.animatedParameters = 0;
+    result.iterations = nodes.size();
+    result.createNodeMicroseconds = createElapsed / 1000.0 / count;
+    result.microsecondsPerIteration = deleteElapsed / 1000.0 / count;
+    result.allocationsPerIteration = double(deleteCount) / count;
+    result.bytesPerIteration = double(deleteBytes) / count;
+    return result;
+}
+
+
+//!
+//! Times blending skeleton poses: every frame, the pose of each
+//! character is blended with a second pose in one pass.
+//!
+//! \param bones The number of bones per character.
+//! \param characters The number of characters.
+//! \return The measurements per frame.
+//!
+Benchmark::Result Benchmark::runSkeletonPose ( int bones, int characters )
+{
+    std::vector<unsigned short> handles (bones);
+    for (int i = 0; i < bones; ++i)
+        handles[i] = (unsigned short) i;
+
+    QVector<SkeletonPose> fadePoses (characters);
+    QVector<SkeletonPose> animationPoses (characters);
+    for (int c = 0; c < characters; ++c) {
+        fadePoses[c].setHandles(handles);
+        animationPoses[c].setHandles(handles);
+        for (int i = 0; i < bones; ++i) {
+            const Ogre::Real angle = 0.01f * (c + i);
+            fadePoses[c].setTransform(i, Ogre::Vector3(i, c, 1.0f), Ogre::Quaternion(Ogre::Radian(angle), Ogre::Vector3::UNIT_Y));
+            animationPoses[c].setTransform(i, Ogre::Vector3(c, i, 2.0f), Ogre::Quaternion(Ogre::Radian(-angle), Ogre::Vector3::UNIT_X));
+        }
+    }
+    SkeletonPose blendPose;
+    blendPose.setHandles(handles);
+
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    double sum = 0.0;
+    for (int frame = 0; frame < m_frames; ++frame) {
+        const float alpha = float(frame) / m_frames;
+        for (int c = 0; c < characters; ++c) {
+            SkeletonPose::blend(fadePoses[c], animationPoses[c], alpha, blendPose);
+            sum += blendPose.getOrientation(c % bones).w;
+        }
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    Result result;
+    result.scenario = "skeletonPose";
+    result.nodes = characters;
+    result.connections = 0;
+    result.animatedParameters = bones * characters;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = elapsed / 1000.0 / m_frames;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / m_frames;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / m_frames;
+
+    // keep the blended poses alive so the loop cannot be optimized away
+    if (sum == -1.0)
+        Log::debug("Unexpected sum of blended orientations.", "Benchmark::runSkeletonPose");
+
+    return result;
+}
+
+
+//!
+//! Replays the fixed step game logic of the S3DGame node with recorded
+//! frame times: the steps of each frame move a character along line
+//! paths and test it against the event bounds of the paths. The replay
+//! is run twice and must give the same result both times.
+//!
+//! \param frames The number of replayed frames.
+//! \return The measurements per simulated step.
+//!
+Benchmark::Result Benchmark::runGameReplay ( int frames )
+{
+    using namespace S3DGameNode;
+
+    // events only cover the second half of each path, so the path bounds
+    // skip the event tests on the first half
+    const int pathCount = 64;
+    const int eventsPerPath = 16;
+    const char *platforms[] = { "", "Door", "Platform1", "Platform2", "Platform3" };
+    QList<Path *> paths;
+    QList<GameEvent *> events;
+    for (int p = 0; p < pathCount; ++p) {
+        Path *path = new LinePath(Vec3(p * 100.0f, 10.0f, 0.0f), Vec3((p + 1) * 100.0f, 10.0f, 0.0f));
+        for (int e = 0; e < eventsPerPath; ++e) {
+            const float x = p * 100.0f + 50.0f + (e + 0.5f) * 50.0f / eventsPerPath;
+            GameEvent *event = new GameEvent(Ogre::AxisAlignedBox(x - 1.0f, 9.0f, -1.0f, x + 1.0f, 11.0f, 1.0f));
+            event->Platform(platforms[e % 5]);
+            if (e == eventsPerPath - 1)
+                event->Checkpoint(p == pathCount - 1 ? "finish" : "checkpoint");
+            path->AddEvent(event, event->Bounds());
+            events.append(event);
+        }
+        paths.append(path);
+    }
+
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    int steps = 0;
+    const quint64 checksum = replayGame(paths, frames, &steps);
+    const qint64 elapsed = timer.nsecsElapsed();
+    const quint64 replayCount = AllocationCounter::getCount() - allocationCount;
+    const quint64 replayBytes = AllocationCounter::getBytes() - allocationBytes;
+
+    int replaySteps = 0;
+    if (replayGame(paths, frames, &replaySteps) != checksum || replaySteps != steps || steps == 0)
+        Log::warning("The replays of the game logic differ.", "Benchmark::runGameReplay");
+
+    qDeleteAll(events);
+    qDeleteAll(paths);
+
+    Result result;
+    result.scenario = "gameReplay";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = steps;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = steps > 0 ? elapsed / 1000.0 / steps : 0.0;
+    result.allocationsPerIteration = steps > 0 ? double(replayCount) / steps : 0.0;
+    result.bytesPerIteration = steps > 0 ? double(replayBytes) / steps : 0.0;
+    return result;
+}
+
+
+//!
+//! Times the per frame host side work of the fusion context of the
+//! ToFLib node: comparing the fusion settings to decide whether the
+//! algorithm is reused, and copying the depth result into the reused,
+//! pitched output buffer. The settings change every 25 frames.
+//!
+//! \param width The width of the fusion result.
+//! \param height The height of the fusion result.
+//! \return The measurements per frame.
+//!
+Benchmark::Result Benchmark::runFusionContext ( int width, int height )
+{
+    using namespace ToFLibNode;
+
+    // the option values of the block matching algorithm
+    QVariantList optionValues;
+    optionValues << 64 << 9 << 0.5 << true << 2.0;
+
+    FusionSettings algorithmSettings;
+    FusionSettings settings;
+    settings.algorithmIndex = 1;
+    for (int i = 0; i < 6; i += 2) {
+        settings.shape[i] = width;
+        settings.shape[i + 1] = height;
+    }
+    settings.baselineLeftToF = 0.05f;
+    settings.baselineLeftRight = 0.1f;
+
+    // the result of the algorithm and the locked output texture, whose rows
+    // are padded
+    std::vector<float> depth;
+    const int rowPitch = width + 16;
+    std::vector<float> output (size_t(rowPitch) * height);
+    Ogre::PixelBox pixelBox (Ogre::Box(0, 0, width, height), Ogre::PF_FLOAT32_R, &output[0]);
+    pixelBox.rowPitch = rowPitch;
+
+    int rebuilds = 0;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < m_frames; ++frame) {
+        settings.fov = 60.0f + frame / 25;
+        settings.optionValues = optionValues;
+
+        // the algorithm and its result buffer are only re-created when the
+        // settings change
+        if (!(algorithmSettings == settings)) {
+            algorithmSettings = settings;
+            depth.assign(size_t(width) * height, 7.0f * (rebuilds + 1));
+            ++rebuilds;
+        }
+
+        copyDepthToPixelBox(&depth[0], width, height, pixelBox);
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    if (rebuilds != (m_frames + 24) / 25 || output[size_t(rowPitch) * (height - 1) + width - 1] != float(rebuilds))
+        Log::warning("The fusion context was not reused as expected.", "Benchmark::runFusionContext");
+
+    Result result;
+    result.scenario = "fusionContext";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = elapsed / 1000.0 / m_frames;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / m_frames;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / m_frames;
+    return result;
+}
+
+
+//!
+//! Times sampling the animation tracks of the AnimationClip node: every
+//! frame, all tracks are sampled at the frame time, then sampled again at
+//! the same time, as the further parameters bound to the clip do.
+//!
+//! \param tracks The number of animation curves.
+//! \param keys The number of keys per curve.
+//! \param spline Use spline instead of linear interpolation.
+//! \return The measurements per frame.
+//!
+Benchmark::Result Benchmark::runAnimationClip ( int tracks, int keys, bool spline )
+{
+    using namespace AnimationClipNode;
+
+    // the value of each curve rises by one per key, at 25 keys per second
+    const float keyStep = 1.0f / 25.0f;
+    const float clipLength = (keys - 1) * keyStep;
+    QHash<QString, AnimCurve> curves;
+    curves.reserve(tracks);
+    for (int i = 0; i < tracks; ++i) {
+        AnimCurve curve;
+        curve.length = clipLength;
+        curve.name = QString("joint%1_translateX").arg(i);
+        curve.keys.reserve(keys);
+        for (int k = 0; k < keys; ++k)
+            curve.keys.append(QPair<float, float>(k * keyStep, float(i + k)));
+        curves.insert(curve.name, curve);
+    }
+
+    QHash<QString, unsigned short> forwCurveMap;
+    QHash<unsigned short, QString> backwCurveMap;
+    AnimationTracks animationTracks;
+    animationTracks.create("frapperbench", clipLength, curves, spline, forwCurveMap, backwCurveMap);
+
+    // the frames walk through the clip in steps between the keys
+    const float frameStep = clipLength / m_frames;
+    float checksum = 0.0f;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < m_frames; ++frame) {
+        const float time = frame * frameStep;
+        animationTracks.sample(time);
+        animationTracks.sample(time);
+        checksum += animationTracks.getValue(frame % tracks);
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    // both interpolation modes pass through the keys
+    const int firstTrack = forwCurveMap.value("joint0_translateX");
+    animationTracks.sample((keys / 2) * keyStep);
+    if (animationTracks.getNumTracks() != tracks || qAbs(animationTracks.getValue(firstTrack) - keys / 2) > 0.01f
+        || animationTracks.getOffset(firstTrack) != 0.0f || checksum < 0.0f)
+        Log::warning("The animation tracks were not sampled as expected.", "Benchmark::runAnimationClip");
+
+    Result result;
+    result.scenario = spline ? "animationClipSpline" : "animationClipLinear";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = tracks;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = elapsed / 1000.0 / m_frames;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / m_frames;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / m_frames;
+    return result;
+}
+
+
+//!
+//! Times loading the animation curves of the AnimationClip node from their
+//! cache file, which is written once for a file in the temp directory.
+//!
+//! \param tracks The number of animation curves.
+//! \param keys The number of keys per curve.
+//! \param loads The number of times the cache is loaded.
+//! \return The measurements per load.
+//!
+Benchmark::Result Benchmark::runAnimationCache ( int tracks, int keys, int loads )
+{
+    using namespace AnimationClipNode;
+
+    Result result;
+    result.scenario = "animationCacheLoad";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = tracks;
+    result.iterations = 0;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = 0.0;
+    result.allocationsPerIteration = 0.0;
+    result.bytesPerIteration = 0.0;
+
+    // the cache is only valid for an existing animation file
+    const QString filename = QString("%1/frapperbench_%2.anim").arg(QDir::tempPath()).arg(QCoreApplication::applicationPid());
+    QFile file (filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        Log::warning(QString("The animation file %1 could not be written.").arg(filename), "Benchmark::runAnimationCache");
+        return result;
+    }
+    file.write("frapperbench\n");
+    file.close();
+
+    QHash<QString, AnimCurve> curves;
+    curves.reserve(tracks);
+    for (int i = 0; i < tracks; ++i) {
+        AnimCurve curve;
+        curve.length = 0.0f;
+        curve.name = QString("joint%1_translateX").arg(i);
+        curve.keys.reserve(keys);
+        for (int k = 0; k < keys; ++k)
+            curve.keys.append(QPair<float, float>(k / 25.0f, float(i + k)));
+        curves.insert(curve.name, curve);
+    }
+
+    const QString parseOptions = "frapperbench";
+    const QString cacheFilename = AnimationCurveCache::getCacheFilename(filename);
+    const QString tempFilename = QString("%1.%2.tmp").arg(cacheFilename).arg(QCoreApplication::applicationPid());
+    if (!AnimationCurveCache::write(filename, parseOptions, curves) || QFile::exists(tempFilename)) {
+        Log::warning(QString("The animation cache %1 could not be written.").arg(cacheFilename), "Benchmark::runAnimationCache");
+        QFile::remove(filename);
+        QFile::remove(cacheFilename);
+        return result;
+    }
+
+    bool loaded = true;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < loads; ++i) {
+        QHash<QString, AnimCurve> loadedCurves;
+        loaded = AnimationCurveCache::read(filename, parseOptions, loadedCurves) && loadedCurves.size() == tracks && loaded;
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    // a cache parsed with other options must not be used
+    QHash<QString, AnimCurve> staleCurves;
+    if (!loaded || AnimationCurveCache::read(filename, "other options", staleCurves))
+        Log::warning("The animation cache was not loaded as expected.", "Benchmark::runAnimationCache");
+
+    QFile::remove(filename);
+    QFile::remove(cacheFilename);
+
+    result.iterations = loads;
+    result.microsecondsPerIteration = elapsed / 1000.0 / loads;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / loads;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / loads;
+    return result;
+}
+
+
+//!
+//! Times loading the word lexicon of the PoemAnalyser node, either by
+//! parsing the text of a DAT file or from the cache file of a DAT file in
+//! the temp directory.
+//!
+//! \param words The number of words of the lexicon.
+//! \param loads The number of times the lexicon is loaded.
+//! \param cached Load the lexicon from its cache file.
+//! \return The measurements per load.
+//!
+Benchmark::Result Benchmark::runLexicon ( int words, int loads, bool cached )
+{
+    using namespace PoemAnalyserNode;
+
+    Result result;
+    result.scenario = cached ? "lexiconCacheLoad" : "lexiconParse";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = 0;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = 0.0;
+    result.allocationsPerIteration = 0.0;
+    result.bytesPerIteration = 0.0;
+
+    // a DAT file in the WDAL layout, each word has one of the ten states set
+    QString text = "sample,word,emotion,activation,kpleasant,kactive,imagery,frequency,"
+        "pleasant,nice,passive,sad,unpleasant,nasty,active,fun,himagery,loimagery\n";
+    text.reserve(words * 64);
+    for (int i = 0; i < words; ++i) {
+        text += QString("%1,Word%1,1.8750,1.6667,0,0,1.4,%2").arg(i).arg(i % 1000);
+        for (int s = 0; s < PoemLexicon::NumStates; ++s)
+            text += s == i % PoemLexicon::NumStates ? ",1" : ",";
+        text += '\n';
+    }
+
+    const QString filename = QString("%1/frapperbench_%2.dat").arg(QDir::tempPath()).arg(QCoreApplication::applicationPid());
+    const QString cacheFilename = PoemLexicon::getCacheFilename(filename);
+    if (cached) {
+        QFile file (filename);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            Log::warning(QString("The DAT file %1 could not be written.").arg(filename), "Benchmark::runLexicon");
+            return result;
+        }
+        file.write(text.toLatin1());
+        file.close();
+
+        PoemLexicon lexicon;
+        QTextStream stream (&text, QIODevice::ReadOnly);
+        lexicon.parse(stream);
+        if (!lexicon.writeCache(filename)) {
+            Log::warning(QString("The lexicon cache %1 could not be written.").arg(cacheFilename), "Benchmark::runLexicon");
+            QFile::remove(filename);
+            return result;
+        }
+    }
+
+    bool loaded = true;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < loads; ++i) {
+        PoemLexicon lexicon;
+        if (cached)
+            loaded = lexicon.readCache(filename) && loaded;
+        else {
+            QTextStream stream (&text, QIODevice::ReadOnly);
+            lexicon.parse(stream);
+        }
+
+        // the words are looked up in lower case, the state of the last word is set
+        const int last = words - 1;
+        const PoemLexicon::WordStates *states = lexicon.find(QString("word%1").arg(last));
+        loaded = loaded && lexicon.size() == words && states && states->values[last % PoemLexicon::NumStates] == 1;
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    if (!loaded)
+        Log::warning("The lexicon was not loaded as expected.", "Benchmark::runLexicon");
+
+    if (cached) {
+        QFile::remove(filename);
+        QFile::remove(cacheFilename);
+    }
+
+    result.iterations = loads;
+    result.microsecondsPerIteration = elapsed / 1000.0 / loads;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / loads;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / loads;
+    return result;
+}
+
+
+//!
+//! Times building the curve item of the Curve Editor panel for an animated
+//! parameter with many keys.
+//!
+//! \param keys The number of keys of the parameter.
+//! \return The measurements per built item.
+//!
+Benchmark::Result Benchmark::runCurveItemBuild ( int keys )
+{
+    NumberParameter parameter ("curve", Parameter::T_Float, 0.0f);
+    for (int i = 0; i < keys; ++i) {
+        Key key (float(i), QVariant(float((i * 7) % 13)), Key::KT_Linear, &parameter);
+        parameter.addKeyPresorted(key);
+    }
+
+    const QSizeF scale (1.0, 10.0);
+    QRectF bounds;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < m_frames; ++frame) {
+        CurveGraphicsItem curveItem (&parameter, scale, 0.0f, Qt::red);
+        bounds = static_cast<QGraphicsItem &>(curveItem).boundingRect();
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    if (bounds.width() < (keys - 1) * scale.width() || bounds.height() < 12.0 * scale.height())
+        Log::warning("The curve item does not contain all keys.", "Benchmark::runCurveItemBuild");
+
+    Result result;
+    result.scenario = "curveItemBuild";
+    result.nodes = 0;
+    result.connections = 0;
+    result.animatedParameters = 1;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = elapsed / 1000.0 / m_frames;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / m_frames;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / m_frames;
+    return result;
+}
+
+
+//!
+//! Times painting the curve item of the Curve Editor panel into an image of
+//! the size of a curve editor view, either showing all keys or zoomed in to
+//! 200 keys, which are drawn as segments.
+//!
+//! \param keys The number of keys of the parameter.
+//! \param zoomed Paint only 200 keys in the middle of the curve.
+//! \return The measurements per frame.
+//!
+Benchmark::Result Benchmark::runCurveItemPaint ( int keys, bool zoomed )
+{
+    NumberParameter parameter ("curve", Parameter::T_Float, 0.0f);
+    for (int i = 0; i < keys; ++i) {
+        Key key (float(i), QVariant(float((i * 7) % 13)), Key::KT_Linear, &parameter);
+        parameter.addKeyPresorted(key);
+    }
+
+    CurveGraphicsItem curveItem (&parameter, QSizeF(1.0, 10.0), 0.0f, Qt::red);
+    QGraphicsItem &item = curveItem;
+    const QRectF bounds = item.boundingRect();
+
+    // the exposed part of the scene, mapped to the whole image as a view does
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = bounds;
+    if (zoomed) {
+        const qreal visibleKeys = qMin(200, keys);
+        option.exposedRect.setLeft(bounds.center().x() - visibleKeys / 2);
+        option.exposedRect.setWidth(visibleKeys);
+    }
+    QImage image (1280, 400, QImage::Format_ARGB32_Premultiplied);
+    const QTransform transform = QTransform::fromTranslate(-option.exposedRect.left(), -option.exposedRect.top())
+        * QTransform::fromScale(image.width() / option.exposedRect.width(), image.height() / qMax(option.exposedRect.height(), 1.0));
+
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+    for (int frame = 0; frame < m_frames; ++frame) {
+        // clearing the image is not timed
+        image.fill(Qt::transparent);
+        QPainter painter (&image);
+        painter.setWorldTransform(transform);
+        timer.start();
+        item.paint(&painter, &option, 0);
+        elapsed += timer.nsecsElapsed();
+    }
+
+    // the curve has to reach the middle column of the image
+    bool painted = false;
+    for (int y = 0; y < image.height() && !painted; ++y)
+        painted = qAlpha(image.pixel(image.width() / 2, y)) != 0;
+    if (!painted)
+        Log::warning("The curve item was not painted.", "Benchmark::runCurveItemPaint");
+
+    Result result;
+    result.scenario = zoomed ? "curveItemPaintZoomed" : "curveItemPaint";
+    result.nodes = 0;
+    result.connections = 0;
+    result.animatedParameters = 1;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = elapsed / 1000.0 / m_frames;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / m_frames;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / m_frames;
+    return result;
+}
+
+
+#ifdef FRAPPERBENCH_OPENCV
+//!
+//! Returns the position of a face bouncing between 0 and the given range.
+//!
+static int bounce ( int frame, int range )
+{
+    if (range <= 0)
+        return 0;
+    const int position = frame % (2 * range);
+    return position < range ? position : 2 * range - position;
+}
+
+
+//!
+//! Times following a face of the FaceTracker node by template matching: a
+//! textured face moves over a noise background by one pixel per frame.
+//! Every 15 frames, a detection of the face from 5 frames before is merged
+//! as the node merges asynchronous detections.
+//!
+//! \param width The width of the grayscale image.
+//! \param height The height of the grayscale image.
+//! \return The measurements per frame.
+//!
+Benchmark::Result Benchmark::runFaceTracking ( int width, int height )
+{
+    using namespace FaceTrackerNode;
+
+    const int faceSize = qMax(qMin(width, height) / 5, 8);
+    cv::RNG rng (12345);
+    cv::Mat background (height, width, CV_8UC1);
+    rng.fill(background, cv::RNG::UNIFORM, 0, 256);
+    cv::Mat faceImage (faceSize, faceSize, CV_8UC1);
+    rng.fill(faceImage, cv::RNG::UNIFORM, 0, 256);
+
+    RectNDC rect;
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = (float) faceSize / width;
+    rect.h = (float) faceSize / height;
+    Face face (rect);
+    cv::Mat image = background.clone();
+    faceImage.copyTo(image(cv::Rect(0, 0, faceSize, faceSize)));
+    face.updateTemplate(image);
+
+    int tracked = 0;
+    int staleUpdates = 0;
+    cv::Point position;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+    for (int frame = 1; frame <= m_frames; ++frame) {
+        // drawing the frame is not timed
+        position = cv::Point(bounce(frame, width - faceSize), bounce(frame, height - faceSize));
+        background.copyTo(image);
+        faceImage.copyTo(image(cv::Rect(position.x, position.y, faceSize, faceSize)));
+
+        timer.start();
+        if (frame % 15 == 0) {
+            RectNDC detectionRect = rect;
+            detectionRect.x = (float) bounce(frame - 5, width - faceSize) / width;
+            detectionRect.y = (float) bounce(frame - 5, height - faceSize) / height;
+            const bool update = !face.isTracked();
+            if (face.checkDetectionRect(detectionRect, update) && update) {
+                face.updateTemplate(image);
+                ++staleUpdates;
+            }
+        }
+        if (face.track(image, 0.5f, 0.7f))
+            ++tracked;
+        elapsed += timer.nsecsElapsed();
+    }
+
+    // the stale detections must not move the tracked face back
+    const RectNDC faceRect = face.getRect();
+    if (tracked != m_frames || staleUpdates != 0 || cvRound(faceRect.x * width) != position.x || cvRound(faceRect.y * height) != position.y)
+        Log::warning("The face was not tracked as expected.", "Benchmark::runFaceTracking");
+
+    Result result;
+    result.scenario = "faceTracking";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = elapsed / 1000.0 / m_frames;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / m_frames;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / m_frames;
+    return result;
+}
+#endif
+
+
+#ifdef FRAPPERBENCH_PYTHON
+//!
+//! Times running a trivial script through the embedded Python runtime of
+//! the Python node. After every run, one of the given number of distinct
+//! scripts is run as well, as editing a script in a node does.
+//!
+//! \param runs The number of runs of the script.
+//! \param edits The number of distinct scripts run in between, or 0.
+//! \return The measurements per run.
+//!
+Benchmark::Result Benchmark::runPythonScript ( int runs, int edits )
+{
+    Result result;
+    result.scenario = edits > 0 ? "pythonScriptEdits" : "pythonScript";
+    result.nodes = 1;
+    result.connections = 0;
+    result.animatedParameters = 0;
+    result.iterations = 0;
+    result.createNodeMicroseconds = 0.0;
+    result.microsecondsPerIteration = 0.0;
+    result.allocationsPerIteration = 0.0;
+    result.bytesPerIteration = 0.0;
+
+    PythonNode::PythonRuntime &runtime = PythonNode::PythonRuntime::instance();
+    PyObject *ns = runtime.createNamespace("frapperbench");
+    if (!ns) {
+        Log::warning("The Python runtime could not be initialized.", "Benchmark::runPythonScript");
+        return result;
+    }
+
+    const QString source = "counter = globals().get('counter', 0) + 1\n";
+    QStringList editedSources;
+    for (int i = 0; i < edits; ++i)
+        editedSources << QString("edited = %1\n").arg(i);
+
+    bool executed = true;
+    const quint64 allocationCount = AllocationCounter::getCount();
+    const quint64 allocationBytes = AllocationCounter::getBytes();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < runs; ++i) {
+        executed = runtime.execute(source, "frapperbench.py", ns) && executed;
+        if (edits > 0)
+            executed = runtime.execute(editedSources.at(i % edits), "edited.py", ns) && executed;
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    PyObject *counter = PyDict_GetItemString(ns, "counter");
+    if (!executed || !counter || PyInt_AsLong(counter) != runs)
+        Log::warning("The Python script did not run the expected number of times.", "Benchmark::runPythonScript");
+    runtime.releaseNamespace(ns);
+
+    result.iterations = runs;
+    result.microsecondsPerIteration = elapsed / 1000.0 / runs;
+    result.allocationsPerIteration = double(AllocationCounter::getCount() - allocationCount) / runs;
+    result.bytesPerIteration = double(AllocationCounter::getBytes() - allocationBytes) / runs;
+    return result;
+}
+#endif
+
+
+//!
+//! Converts the given results to a JSON document.
+//!
+//! \param results The results to convert.
+//! \return The JSON text.
+//!
+QString Benchmark::toJson ( const QList<Result> &results )
+{
+    QStringList entries;
+    foreach (const Result &result, results)
+        entries << QString("    {\"scenario\": \"%1\", \"nodes\": %2, \"connections\": %3, \"animatedParameters\": %4, "
+                           "\"iterations\": %5, \"createNodeUs\": %6, \"usPerIteration\": %7, "
+                           "\"allocationsPerIteration\": %8, \"bytesPerIteration\": %9}")
+            .arg(result.scenario)
+            .arg(result.nodes)
+            .arg(result.connections)
+            .arg(result.animatedParameters)
+            .arg(result.iterations)
+            .arg(result.createNodeMicroseconds, 0, 'f', 3)
+            .arg(result.microsecondsPerIteration, 0, 'f', 3)
+            .arg(result.allocationsPerIteration, 0, 'f', 2)
+            .arg(result.bytesPerIteration, 0, 'f', 1);
+
+    return QString("{\n  \"results\": [\n%1\n  ]\n}\n").arg(entries.join(",\n"));
+}
+
+
+///
+/// Private Functions
+///
+
+
+//!
+//! Creates the given number of benchmark nodes and returns the average
+//! creation time in microseconds.
+//!
+double Benchmark::createNodes ( int count )
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i) {
+        Node *node = m_nodeType->createNode(QString("node%1").arg(i));
+        node->setUpTimeDependencies(m_frameParameter, m_rangeParameter);
+        m_nodes.append(node);
+    }
+    return count > 0 ? timer.nsecsElapsed() / 1000.0 / count : 0.0;
+}
+
+
+//!
+//! Adds keys to the value parameter with the given index of the given node.
+//!
+void Benchmark::animate ( Node *node, int valueIndex )
+{
+    NumberParameter *parameter = node->getNumberParameter(BenchmarkNode::ValueNames[valueIndex]);
+    if (!parameter)
+        return;
+
+    for (int i = 0; i < m_keys; ++i) {
+        Key key (float(i * KEY_SPACING), QVariant(float((i * 7 + valueIndex) % 13)), Key::KT_Linear, parameter);
+        parameter->addKey(key);
+    }
+    ++m_animatedParameters;
+}
+
+
+//!
+//! Connects the output of the source node to the given input of the target node.
+//!
+void Benchmark::connect ( Node *sourceNode, Node *targetNode, const QString &inputName )
+{
+    Parameter *sourceParameter = sourceNode->getParameter(BenchmarkNode::OutputName);
+    Parameter *targetParameter = targetNode->getParameter(inputName);
+    if (!sourceParameter || !targetParameter)
+        return;
+
+    Connection *connection = new Connection(sourceParameter, targetParameter);
+    sourceParameter->addConnection(connection);
+    targetParameter->addConnection(connection);
+    targetParameter->propagateDirty();
+    m_connections.append(connection);
+}
+
+
+//!
+//! Steps through the frames and evaluates the outputs of the given nodes.
+//!
+Benchmark::Result Benchmark::evaluate ( const QString &scenario, const QList<Node *> &sinkNodes, double createNodeMicroseconds )
+{
+    QList<Parameter *> outputParameters;
+    foreach (Node *node, sinkNodes)
+        outputParameters << node->getParameter(BenchmarkNode::OutputName);
+
+    quint64 allocationCount = 0;
+    quint64 allocationBytes = 0;
+    QElapsedTimer timer;
+
+    // the first frame warms up caches and is not timed
+    for (int frame = 0; frame <= m_frames; ++frame) {
+        if (frame == 1) {
+            allocationCount = AllocationCounter::getCount();
+            allocationBytes = AllocationCounter::getBytes();
+            timer.start();
+        }
+
+        m_frameParameter->setValue(frame);
+        m_frameParameter->propagateDirty();
+        m_frameParameter->setDirty(false);
+
+        foreach (Parameter *outputParameter, outputParameters)
+            outputParameter->getValue(true);
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    Result result;
+    result.scenario = scenario;
+    result.nodes = m_nodes.size();
+    result.connections = m_connections.size();
+    result.animatedParameters = m_animatedParameters;
+    result.iterations = m_frames;
+    result.createNodeMicroseconds = createNodeMicroseconds;
+    result.microsecondsPerIteration = m_frames > 0 ? elapsed / 1000.0 / m_frames : 0.0;
+    result.allocationsPerIteration = m_frames > 0 ? double(AllocationCounter::getCount() - allocationCount) / m_frames : 0.0;
+    result.bytesPerIteration = m_frames > 0 ? double(AllocationCounter::getBytes() - allocationBytes) / m_frames : 0.0;
+    return result;
+}
+
+
+//!
+//! Deletes all nodes and connections.
+//!
+void Benchmark::reset ()
+{
+    qDeleteAll(m_connections);
+    m_connections.clear();
+    qDeleteAll(m_nodes);
+    m_nodes.clear();
+    m_animatedParameters = 0;
+}
@@ -0,0 +1,364 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "Benchmark.h"
+//! \brief Header file for Benchmark class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "BenchmarkNode.h"
+#include "NodeType.h"
+#include "NumberParameter.h"
+#include "Connection.h"
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+using namespace Frapper;
+
+
+//!
+//! Class building synthetic node graphs from core classes only and timing
+//! their evaluation over a number of frames.
+//!
+class Benchmark
+{
+
+public: // nested type definitions
+
+    //!
+    //! The measurements of a single scenario.
+    //!
+    struct Result
+    {
+        QString scenario;               //!< name of the scenario
+        int nodes;                      //!< number of nodes in the graph
+        int connections;                //!< number of connections in the graph
+        int animatedParameters;         //!< number of parameters with keys
+        int iterations;                 //!< number of timed frames or calls
+        double createNodeMicroseconds;  //!< average duration of NodeType::createNode
+        double microsecondsPerIteration;//!< average duration of a frame or call
+        double allocationsPerIteration; //!< average number of allocations of a frame or call
+        double bytesPerIteration;       //!< average number of allocated bytes of a frame or call
+    };
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the Benchmark class.
+    //!
+    //! \param frames The number of frames to time for each graph.
+    //! \param keys The number of keys of each animated parameter.
+    //!
+    Benchmark ( int frames, int keys );
+
+    //!
+    //! Destructor of the Benchmark class.
+    //!
+    ~Benchmark ();
+
+public: // functions
+
+    //!
+    //! Returns whether the benchmark node type could be created.
+    //!
+    //! \return True if the benchmarks can be run, otherwise False.
+    //!
+    bool isValid () const;
+
+    //!
+    //! Times a chain of nodes, each connected to its predecessor.
+    //!
+    //! \param length The number of nodes in the chain.
+    //! \return The measurements.
+    //!
+    Result runChain ( int length );
+
+    //!
+    //! Times one animated node feeding the given number of nodes.
+    //!
+    //! \param width The number of nodes connected to the source node.
+    //! \return The measurements.
+    //!
+    Result runFan ( int width );
+
+    //!
+    //! Times a lattice of diamonds: every node of a layer is connected to two
+    //! nodes of the previous layer.
+    //!
+    //! \param width The number of nodes per layer.
+    //! \param depth The number of layers.
+    //! \return The measurements.
+    //!
+    Result runDiamond ( int width, int depth );
+
+    //!
+    //! Times unconnected nodes whose values are all animated.
+    //!
+    //! \param nodes The number of nodes.
+    //! \return The measurements.
+    //!
+    Result runAnimated ( int nodes );
+
+    //!
+    //! Times looking up parameters by name.
+    //!
+    //! \param iterations The number of lookups.
+    //! \return The measurements.
+    //!
+    Result runParameterLookup ( int iterations );
+
+    //!
+    //! Times the key interpolation of an animated parameter.
+    //!
+    //! \param iterations The number of interpolations.
+    //! \return The measurements.
+    //!
+    Result runKeyInterpolation ( int iterations );
+
+    //!
+    //! Times the bulk key functions of a baked parameter with one key per
+    //! frame: every other key is selected, transformed, normalized and set,
+    //! the middle half of the keys is selected by time and retimed, and the
+    //! set keys are selected by a predicate and removed, in one call each.
+    //!
+    //! \param keys The number of keys of the baked parameter.
+    //! \param rounds The number of times the channel is baked and edited.
+    //! \return The measurements per round.
+    //!
+    Result runBulkKeys ( int keys, int rounds );
+
+    //!
+    //! Times creating and deleting nodes of a type with many parameters.
+    //!
+    //! \param count The number of nodes to create.
+    //! \return The measurements per node.
+    //!
+    Result runCreateNodes ( int count );
+
+    //!
+    //! Times deleting connections and nodes of a node model: every other
+    //! connection of a chain is deleted in a nested update, as the scene model
+    //! does, then the nodes are deleted with their remaining connections.
+    //! The model indices are checked before and after.
+    //!
+    //! \param count The number of nodes in the chain.
+    //! \return The measurements per deleted node.
+    //!
+    Result runNodeModel ( int count );
+
+    //!
+    //! Times blending skeleton poses: every frame, the pose of each
+    //! character is blended with a second pose in one pass.
+    //!
+    //! \param bones The number of bones per character.
+    //! \param characters The number of characters.
+    //! \return The measurements per frame.
+    //!
+    Result runSkeletonPose ( int bones, int characters );
+
+    //!
+    //! Replays the fixed step game logic of the S3DGame node with recorded
+    //! frame times: the steps of each frame move a character along line
+    //! paths and test it against the event bounds of the paths. The replay
+    //! is run twice and must give the same result both times.
+    //!
+    //! \param frames The number of replayed frames.
+    //! \return The measurements per simulated step.
+    //!
+    Result runGameReplay ( int frames );
+
+    //!
+    //! Times the per frame host side work of the fusion context of the
+    //! ToFLib node: comparing the fusion settings to decide whether the
+    //! algorithm is reused, and copying the depth result into the reused,
+    //! pitched output buffer. The settings change every 25 frames.
+    //!
+    //! \param width The width of the fusion result.
+    //! \param height The height of the fusion result.
+    //! \return The measurements per frame.
+    //!
+    Result runFusionContext ( int width, int height );
+
+    //!
+    //! Times sampling the animation tracks of the AnimationClip node: every
+    //! frame, all tracks are sampled at the frame time, then sampled again at
+    //! the same time, as the further parameters bound to the clip do.
+    //!
+    //! \param tracks The number of animation curves.
+    //! \param keys The number of keys per curve.
+    //! \param spline Use spline instead of linear interpolation.
+    //! \return The measurements per frame.
+    //!
+    Result runAnimationClip ( int tracks, int keys, bool spline );
+
+    //!
+    //! Times loading the animation curves of the AnimationClip node from
+    //! their cache file, which is written once for a file in the temp
+    //! directory.
+    //!
+    //! \param tracks The number of animation curves.
+    //! \param keys The number of keys per curve.
+    //! \param loads The number of times the cache is loaded.
+    //! \return The measurements per load.
+    //!
+    Result runAnimationCache ( int tracks, int keys, int loads );
+
+    //!
+    //! Times loading the word lexicon of the PoemAnalyser node, either by
+    //! parsing the text of a DAT file or from the cache file of a DAT file
+    //! in the temp directory.
+    //!
+    //! \param words The number of words of the lexicon.
+    //! \param loads The number of times the lexicon is loaded.
+    //! \param cached Load the lexicon from its cache file.
+    //! \return The measurements per load.
+    //!
+    Result runLexicon ( int words, int loads, bool cached );
+
+    //!
+    //! Times building the curve item of the Curve Editor panel for an
+    //! animated parameter with many keys.
+    //!
+    //! \param keys The number of keys of the parameter.
+    //! \return The measurements per built item.
+    //!
+    Result runCurveItemBuild ( int keys );
+
+    //!
+    //! Times painting the curve item of the Curve Editor panel into an image
+    //! of the size of a curve editor view, either showing all keys or
+    //! zoomed in to 200 keys, which are drawn as segments.
+    //!
+    //! \param keys The number of keys of the parameter.
+    //! \param zoomed Paint only 200 keys in the middle of the curve.
+    //! \return The measurements per frame.
+    //!
+    Result runCurveItemPaint ( int keys, bool zoomed );
+
+#ifdef FRAPPERBENCH_OPENCV
+    //!
+    //! Times following a face of the FaceTracker node by template matching:
+    //! a textured face moves over a noise background by one pixel per frame.
+    //! Every 15 frames, a detection of the face from 5 frames before is
+    //! merged as the node merges asynchronous detections.
+    //!
+    //! \param width The width of the grayscale image.
+    //! \param height The height of the grayscale image.
+    //! \return The measurements per frame.
+    //!
+    Result runFaceTracking ( int width, int height );
+#endif
+
+#ifdef FRAPPERBENCH_PYTHON
+    //!
+    //! Times running a trivial script through the embedded Python runtime of
+    //! the Python node. After every run, one of the given number of distinct
+    //! scripts is run as well, as editing a script in a node does.
+    //!
+    //! \param runs The number of runs of the script.
+    //! \param edits The number of distinct scripts run in between, or 0.
+    //! \return The measurements per run.
+    //!
+    Result runPythonScript ( int runs, int edits );
+#endif
+
+    //!
+    //! Converts the given results to a JSON document.
+    //!
+    //! \param results The results to convert.
+    //! \return The JSON text.
+    //!
+    static QString toJson ( const QList<Result> &results );
+
+private: // functions
+
+    //!
+    //! Creates the given number of benchmark nodes and returns the average
+    //! creation time in microseconds.
+    //!
+    double createNodes ( int count );
+
+    //!
+    //! Adds keys to the value parameter with the given index of the given node.
+    //!
+    void animate ( Node *node, int valueIndex );
+
+    //!
+    //! Connects the output of the source node to the given input of the target node.
+    //!
+    void connect ( Node *sourceNode, Node *targetNode, const QString &inputName );
+
+    //!
+    //! Steps through the frames and evaluates the outputs of the given nodes.
+    //!
+    Result evaluate ( const QString &scenario, const QList<Node *> &sinkNodes, double createNodeMicroseconds );
+
+    //!
+    //! Deletes all nodes and connections.
+    //!
+    void reset ();
+
+private: // data
+
+    //!
+    //! The number of frames to time for each graph.
+    //!
+    int m_frames;
+
+    //!
+    //! The number of keys of each animated parameter.
+    //!
+    int m_keys;
+
+    //!
+    //! The node type interface and the node types of the benchmark nodes.
+    //!
+    BenchmarkNodeFactory m_nodeFactory;
+    NodeType *m_nodeType;
+    NodeType *m_heavyNodeType;
+
+    //!
+    //! The scene time parameters the nodes depend on.
+    //!
+    NumberParameter *m_frameParameter;
+    NumberParameter *m_rangeParameter;
+
+    //!
+    //! The nodes and connections of the current graph.
+    //!
+    QList<Node *> m_nodes;
+    QList<Connection *> m_connections;
+
+    //!
+    //! The number of animated parameters of the current graph.
+    //!
+    int m_animatedParameters;
+};
+
+#endif
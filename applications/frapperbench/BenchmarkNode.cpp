@@ -0,0 +1,104 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "BenchmarkNode.cpp"
+//! \brief Implementation file for BenchmarkNode class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "BenchmarkNode.h"
+
+
+///
+/// Static Data
+///
+
+const QString BenchmarkNode::InputAName = "Input A";
+const QString BenchmarkNode::InputBName = "Input B";
+const QString BenchmarkNode::OutputName = "Output";
+const QString BenchmarkNode::ValueNames[4] = { "Value 1", "Value 2", "Value 3", "Value 4" };
+
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the BenchmarkNode class.
+//!
+//! \param name The name for the new node.
+//! \param parameterRoot A copy of the parameter tree specific for the type of the node.
+//!
+BenchmarkNode::BenchmarkNode ( const QString &name, ParameterGroup *parameterRoot ) :
+    Node(name, parameterRoot)
+{
+    setProcessingFunction(OutputName, SLOT(processOutput()));
+}
+
+
+//!
+//! Destructor of the BenchmarkNode class.
+//!
+BenchmarkNode::~BenchmarkNode ()
+{
+}
+
+
+///
+/// Private Slots
+///
+
+
+//!
+//! Computes the output value from the inputs and values.
+//!
+void BenchmarkNode::processOutput ()
+{
+    double result = getDoubleValue(InputAName) + getDoubleValue(InputBName);
+    for (int i = 0; i < 4; ++i)
+        result += getDoubleValue(ValueNames[i]);
+
+    setValue(OutputName, 0.5 * result);
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Creates a benchmark node.
+//!
+//! \param name The name for the new node.
+//! \param parameterRoot A copy of the parameter tree specific for the type of the node.
+//! \return A pointer to the new node.
+//!
+Node * BenchmarkNodeFactory::createNode ( const QString &name, ParameterGroup *parameterRoot )
+{
+    return new BenchmarkNode(name, parameterRoot);
+}
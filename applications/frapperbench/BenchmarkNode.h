@@ -0,0 +1,105 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "BenchmarkNode.h"
+//! \brief Header file for BenchmarkNode class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef BENCHMARKNODE_H
+#define BENCHMARKNODE_H
+
+#include "Node.h"
+#include "NodeTypeInterface.h"
+
+using namespace Frapper;
+
+
+//!
+//! Synthetic node used by the benchmark. Its output is a cheap function of
+//! its two inputs and four (possibly animated) values, so the measured time
+//! is dominated by the evaluation machinery of the core.
+//!
+class BenchmarkNode : public Node
+{
+
+    Q_OBJECT
+
+public: // static data
+
+    //!
+    //! The names of the parameters of benchmark nodes.
+    //!
+    static const QString InputAName;
+    static const QString InputBName;
+    static const QString OutputName;
+    static const QString ValueNames[4];
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the BenchmarkNode class.
+    //!
+    //! \param name The name for the new node.
+    //! \param parameterRoot A copy of the parameter tree specific for the type of the node.
+    //!
+    BenchmarkNode ( const QString &name, ParameterGroup *parameterRoot );
+
+    //!
+    //! Destructor of the BenchmarkNode class.
+    //!
+    virtual ~BenchmarkNode ();
+
+private slots: //
+
+    //!
+    //! Computes the output value from the inputs and values.
+    //!
+    void processOutput ();
+
+};
+
+
+//!
+//! Node type interface creating benchmark nodes without a plugin library.
+//!
+class BenchmarkNodeFactory : public NodeTypeInterface
+{
+
+public: // functions
+
+    //!
+    //! Creates a benchmark node.
+    //!
+    //! \param name The name for the new node.
+    //! \param parameterRoot A copy of the parameter tree specific for the type of the node.
+    //! \return A pointer to the new node.
+    //!
+    virtual Node * createNode ( const QString &name, ParameterGroup *parameterRoot );
+
+};
+
+#endif
@@ -0,0 +1,282 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "main.cpp"
+//! \brief Main implementation file for the frapperbench application.
+//!
+//! Builds synthetic node graphs from an in-process node type, steps them
+//! through a number of frames and prints the timings and the allocations
+//! per frame as JSON, so that changes to the evaluation core can be
+//! compared without loading scenes or plugins.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "Benchmark.h"
+#include "Log.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <iostream>
+
+
+//!
+//! Returns the usage text of the application.
+//!
+static QString getUsage ()
+{
+    return QString(
+        "Usage: frapperbench [options]\n"
+        "  --frames <n>          frames to evaluate per graph (default 100)\n"
+        "  --keys <n>            keys per animated parameter (default 16)\n"
+        "  --chain <n>           length of the chain graph (default 100)\n"
+        "  --fan <n>             number of consumers of the fan graph (default 100)\n"
+        "  --diamond <w>x<d>     width and depth of the diamond graph (default 10x10)\n"
+        "  --animated <n>        number of nodes with animated values (default 100)\n"
+        "  --lookups <n>         number of parameter lookups (default 1000000)\n"
+        "  --interpolations <n>  number of key interpolations (default 1000000)\n"
+        "  --bulkkeys <k>x<r>    keys of the baked channel and rounds of the bulk key benchmark (default 100000x10)\n"
+        "  --create <n>          number of heavy nodes to create (default 10000)\n"
+        "  --nodemodel <n>       number of nodes of the node model benchmark (default 10000)\n"
+        "  --skeleton <b>x<c>    bones per character and characters of the skeleton pose benchmark (default 64x100)\n"
+        "  --fusion <w>x<h>      size of the result of the ToFLib fusion context benchmark (default 640x480)\n"
+        "  --animclip <t>x<k>    curves and keys per curve of the AnimationClip sampling benchmarks (default 500x1000)\n"
+        "  --cacheloads <n>      loads of the AnimationClip cache benchmark, with the --animclip size (default 20)\n"
+        "  --lexicon <w>x<l>     words and loads of the PoemAnalyser lexicon benchmarks (default 100000x5)\n"
+        "  --curvekeys <n>       keys of the curve editor item benchmarks (default 100000)\n"
+        "  --replay <n>          frames of the S3DGame logic replay (default 100000)\n"
+        "  --face <w>x<h>        size of the grayscale image of the face tracking benchmark, if built with OpenCV (default 320x240)\n"
+        "  --python <n>          runs of the Python script benchmarks, if built with Python (default 10000)\n"
+        "  --output <file>       write the JSON results to a file instead of stdout\n"
+    );
+}
+
+
+//!
+//! The application's entry point.
+//!
+//! \param argc     the number of parameters passed to the program
+//! \param argv     the list of parameters passed to the program
+//!
+int main ( int argc, char **argv )
+{
+    QCoreApplication application (argc, argv);
+
+    // initialize the log message handler
+    Log::initialize(true);
+
+    int frames = 100;
+    int keys = 16;
+    int chainLength = 100;
+    int fanWidth = 100;
+    int diamondWidth = 10;
+    int diamondDepth = 10;
+    int animatedNodes = 100;
+    int lookups = 1000000;
+    int interpolations = 1000000;
+    int bulkKeys = 100000;
+    int bulkRounds = 10;
+    int createdNodes = 10000;
+    int modelNodes = 10000;
+    int skeletonBones = 64;
+    int skeletonCharacters = 100;
+    int replayFrames = 100000;
+    int fusionWidth = 640;
+    int fusionHeight = 480;
+    int clipTracks = 500;
+    int clipKeys = 1000;
+    int cacheLoads = 20;
+    int lexiconWords = 100000;
+    int lexiconLoads = 5;
+    int curveKeys = 100000;
+    int faceWidth = 320;
+    int faceHeight = 240;
+    int pythonRuns = 10000;
+    QString outputFilename;
+
+    // parse the command line arguments
+    const QStringList arguments = application.arguments().mid(1);
+    bool valid = true;
+    for (int i = 0; i < arguments.size() && valid; ++i) {
+        const QString &argument = arguments.at(i);
+        if (i + 1 >= arguments.size()) {
+            valid = false;
+            break;
+        }
+        const QString value = arguments.at(++i);
+        bool ok = true;
+        if (argument == "--frames")
+            frames = value.toInt(&ok);
+        else if (argument == "--keys")
+            keys = value.toInt(&ok);
+        else if (argument == "--chain")
+            chainLength = value.toInt(&ok);
+        else if (argument == "--fan")
+            fanWidth = value.toInt(&ok);
+        else if (argument == "--diamond") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                diamondWidth = size.at(0).toInt(&ok);
+            if (ok)
+                diamondDepth = size.at(1).toInt(&ok);
+        } else if (argument == "--animated")
+            animatedNodes = value.toInt(&ok);
+        else if (argument == "--lookups")
+            lookups = value.toInt(&ok);
+        else if (argument == "--interpolations")
+            interpolations = value.toInt(&ok);
+        else if (argument == "--bulkkeys") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                bulkKeys = size.at(0).toInt(&ok);
+            if (ok)
+                bulkRounds = size.at(1).toInt(&ok);
+        } else if (argument == "--create")
+            createdNodes = value.toInt(&ok);
+        else if (argument == "--nodemodel")
+            modelNodes = value.toInt(&ok);
+        else if (argument == "--skeleton") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                skeletonBones = size.at(0).toInt(&ok);
+            if (ok)
+                skeletonCharacters = size.at(1).toInt(&ok);
+        } else if (argument == "--replay")
+            replayFrames = value.toInt(&ok);
+        else if (argument == "--fusion") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                fusionWidth = size.at(0).toInt(&ok);
+            if (ok)
+                fusionHeight = size.at(1).toInt(&ok);
+        } else if (argument == "--animclip") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                clipTracks = size.at(0).toInt(&ok);
+            if (ok)
+                clipKeys = size.at(1).toInt(&ok);
+        } else if (argument == "--cacheloads")
+            cacheLoads = value.toInt(&ok);
+        else if (argument == "--lexicon") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                lexiconWords = size.at(0).toInt(&ok);
+            if (ok)
+                lexiconLoads = size.at(1).toInt(&ok);
+        } else if (argument == "--curvekeys")
+            curveKeys = value.toInt(&ok);
+        else if (argument == "--face") {
+            const QStringList size = value.split('x');
+            ok = size.size() == 2;
+            if (ok)
+                faceWidth = size.at(0).toInt(&ok);
+            if (ok)
+                faceHeight = size.at(1).toInt(&ok);
+        } else if (argument == "--python")
+            pythonRuns = value.toInt(&ok);
+        else if (argument == "--output")
+            outputFilename = value;
+        else
+            ok = false;
+        valid = ok;
+    }
+    valid = valid && frames > 0 && keys > 1 && chainLength > 0 && fanWidth > 0 && diamondWidth > 0
+        && diamondDepth > 0 && animatedNodes > 0 && lookups > 0 && interpolations > 0
+        && bulkKeys > 0 && bulkRounds > 0
+        && createdNodes > 0 && modelNodes > 0 && skeletonBones > 0 && skeletonBones <= 65535 && skeletonCharacters > 0
+        && replayFrames > 0 && fusionWidth > 0 && fusionHeight > 0
+        && clipTracks > 0 && clipTracks <= 65535 && clipKeys > 1 && cacheLoads > 0
+        && lexiconWords > 0 && lexiconLoads > 0 && curveKeys > 1
+        && faceWidth >= 16 && faceHeight >= 16 && pythonRuns > 0;
+
+    if (!valid) {
+        std::cerr << getUsage().toStdString();
+        Log::finalize();
+        return 1;
+    }
+
+    int result = 0;
+    {
+        Benchmark benchmark (frames, keys);
+        if (benchmark.isValid()) {
+            QList<Benchmark::Result> results;
+            results << benchmark.runChain(chainLength);
+            results << benchmark.runFan(fanWidth);
+            results << benchmark.runDiamond(diamondWidth, diamondDepth);
+            results << benchmark.runAnimated(animatedNodes);
+            results << benchmark.runParameterLookup(lookups);
+            results << benchmark.runKeyInterpolation(interpolations);
+            results << benchmark.runBulkKeys(bulkKeys, bulkRounds);
+            results << benchmark.runCreateNodes(createdNodes);
+            results << benchmark.runNodeModel(modelNodes);
+            results << benchmark.runSkeletonPose(skeletonBones, skeletonCharacters);
+            results << benchmark.runGameReplay(replayFrames);
+            results << benchmark.runFusionContext(fusionWidth, fusionHeight);
+            results << benchmark.runAnimationClip(clipTracks, clipKeys, false);
+            results << benchmark.runAnimationClip(clipTracks, clipKeys, true);
+            results << benchmark.runAnimationCache(clipTracks, clipKeys, cacheLoads);
+            results << benchmark.runLexicon(lexiconWords, lexiconLoads, false);
+            results << benchmark.runLexicon(lexiconWords, lexiconLoads, true);
+            results << benchmark.runCurveItemBuild(curveKeys);
+            results << benchmark.runCurveItemPaint(curveKeys, false);
+            results << benchmark.runCurveItemPaint(curveKeys, true);
+#ifdef FRAPPERBENCH_OPENCV
+            results << benchmark.runFaceTracking(faceWidth, faceHeight);
+#endif
+#ifdef FRAPPERBENCH_PYTHON
+            // more edited scripts than the runtime caches
+            results << benchmark.runPythonScript(pythonRuns, 0);
+            results << benchmark.runPythonScript(pythonRuns, 100);
+#endif
+
+            const QByteArray json = Benchmark::toJson(results).toUtf8();
+            if (outputFilename.isEmpty())
+                std::cout << json.constData();
+            else {
+                QFile file (outputFilename);
+                if (file.open(QIODevice::WriteOnly | QIODevice::Text))
+                    file.write(json);
+                else {
+                    Log::error(QString("Could not write results to \"%1\".").arg(outputFilename), "main");
+                    result = 3;
+                }
+            }
+        } else {
+            Log::error("The benchmark node type could not be created.", "main");
+            result = 2;
+        }
+    }
+
+    // free all resources from the log message handler
+    Log::finalize();
+
+    return result;
+}
@@ -467,26 +467,20 @@ void GeometryAnimationNode::progressAnimation ( const QString &animationName, fl
 //!
 void GeometryAnimationNode::transformBone( const QString &name, const Ogre::Vector3 &position, const Ogre::Vector3 &orientation )
 {
-	if (m_entity->hasSkeleton()) 
-	{
-		const std::string &stdName = name.toStdString();
-		Ogre::SkeletonInstance *skeletonInstance = m_entity->getSkeleton();
-		if (skeletonInstance->hasBone(stdName)) 
-		{
-			Ogre::Bone *bone = skeletonInstance->getBone(stdName);
+	Ogre::Bone *bone = getBone(name);
+	if (!bone)
+		return;
 
-			bone->setManuallyControlled(true);
-			bone->reset();
-			bone->translate(position);
+	bone->setManuallyControlled(true);
+	bone->reset();
+	bone->translate(position);
 
-			bone->rotate(Ogre::Vector3::UNIT_X, Ogre::Radian( orientation.x ));
-			bone->rotate(Ogre::Vector3::UNIT_Y, Ogre::Radian( orientation.y));
-			bone->rotate(Ogre::Vector3::UNIT_Z, Ogre::Radian( orientation.z ));
+	bone->rotate(Ogre::Vector3::UNIT_X, Ogre::Radian( orientation.x ));
+	bone->rotate(Ogre::Vector3::UNIT_Y, Ogre::Radian( orientation.y));
+	bone->rotate(Ogre::Vector3::UNIT_Z, Ogre::Radian( orientation.z ));
 
-			m_entityContainer->updateCopies(name, position.x, position.y, position.z, 
-				orientation.x, orientation.y, orientation.z);
-		}
-	}
+	m_entityContainer->updateCopies(name, position.x, position.y, position.z, 
+		orientation.x, orientation.y, orientation.z);
 }
 
 //!
@@ -498,36 +492,49 @@ void GeometryAnimationNode::transformBone( const QString &name, const Ogre::Vect
 //!
 void GeometryAnimationNode::transformBone( const QString &name, const Ogre::Vector3& position, const Ogre::Quaternion &orientation )
 {
-	if (m_entity->hasSkeleton()) 
-	{
-		const std::string &stdName = name.toStdString();
-		Ogre::SkeletonInstance *skeletonInstance = m_entity->getSkeleton();
-		if (skeletonInstance->hasBone(stdName)) 
-		{
-			Ogre::Bone *bone = skeletonInstance->getBone(stdName);
+	Ogre::Bone *bone = getBone(name);
+	if (!bone)
+		return;
 
-			bone->setManuallyControlled(true);
-			bone->reset();
-			bone->translate( position);
+	bone->setManuallyControlled(true);
+	bone->reset();
+	bone->translate( position);
 
-			bone->rotate( orientation);
+	bone->rotate( orientation);
 
-			Ogre::Matrix3 rot;
-			orientation.ToRotationMatrix(rot);
+	Ogre::Matrix3 rot;
+	orientation.ToRotationMatrix(rot);
 
-			Ogre::Radian rx, ry, rz;
-			rot.ToEulerAnglesXYZ(rx, ry, rz);
+	Ogre::Radian rx, ry, rz;
+	rot.ToEulerAnglesXYZ(rx, ry, rz);
 
-			float yaw = orientation.getYaw().valueDegrees();
-			float pitch = orientation.getPitch().valueDegrees();
-			float roll = orientation.getRoll().valueDegrees();
+	// @TODO: update copies with quaternions!!!
+	m_entityContainer->updateCopies(name, position.x, position.y, position.z, 
+		rx.valueRadians(), ry.valueRadians(), rz.valueRadians());
+}
 
-			// @TODO: update copies with quaternions!!!
-			m_entityContainer->updateCopies(name, position.x, position.y, position.z, 
-				rx.valueRadians(), ry.valueRadians(), rz.valueRadians());
 
-		}
-	}
+//!
+//! Returns the bone of the given name of the entity's skeleton using the
+//! bone handles resolved when the geometry was loaded.
+//!
+//! \param name The name of the bone.
+//! \return The bone, or 0 if the skeleton has no bone of the given name.
+//!
+Ogre::Bone * GeometryAnimationNode::getBone ( const QString &name ) const
+{
+	if (!m_entity || !m_entity->hasSkeleton())
+		return 0;
+
+	QHash<QString, unsigned short>::const_iterator handleIter = m_boneHandles.constFind(name);
+	if (handleIter == m_boneHandles.constEnd())
+		return 0;
+
+	Ogre::SkeletonInstance *skeletonInstance = m_entity->getSkeleton();
+	if (handleIter.value() >= skeletonInstance->getNumBones())
+		return 0;
+
+	return skeletonInstance->getBone(handleIter.value());
 }
 
 
@@ -607,6 +614,7 @@ void GeometryAnimationNode::geometryFileChanged ()
 {
 	// call change method of parent
 	GeometryNode::geometryFileChanged();
+	m_boneHandles.clear();
 
 	// check if geometry file was loaded successfully
 	if (!m_entity)
@@ -645,6 +653,12 @@ void GeometryAnimationNode::geometryFileChanged ()
 		Ogre::Skeleton *skeleton = m_entity->getSkeleton();
 		skeleton->setBlendMode(Ogre::ANIMBLEND_CUMULATIVE);
 
+		// resolve the bone handles once, bone handles are the bone indices
+		const unsigned short numBones = skeleton->getNumBones();
+		m_boneHandles.reserve(numBones);
+		for (unsigned short i = 0; i < numBones; ++i)
+			m_boneHandles.insert(QString::fromStdString(skeleton->getBone(i)->getName()), i);
+
 		// clean empty animation tracks
 		if( getBoolValue("Clean empty Skeleton Animation tracks on load"))
 		{
@@ -41,6 +41,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "OgreManager.h" 
 #include "OgreTools.h"
 #include <QtCore/QFile>
+#include <QtCore/QHash>
 #include <qvector3d.h>
 #endif
 using namespace Frapper;
@@ -269,6 +270,15 @@ protected:	// functions
 	//!
 	virtual void transformBone( const QString &name, const Ogre::Vector3& position, const Ogre::Quaternion &orientation );
 
+	//!
+	//! Returns the bone of the given name of the entity's skeleton using the
+	//! bone handles resolved when the geometry was loaded.
+	//!
+	//! \param name The name of the bone.
+	//! \return The bone, or 0 if the skeleton has no bone of the given name.
+	//!
+	Ogre::Bone * getBone ( const QString &name ) const;
+
 	//!
     //! Checks the Ogre entity if it is animatable.
 	//! \return True if the entity is animated
@@ -400,6 +410,11 @@ protected:	//data
 	//!
 	QMap<QString, BoneAttachment *> m_boneAttachmentMap;
 
+	//!
+	//! Bone handles by bone name, resolved once per skeleton.
+	//!
+	QHash<QString, unsigned short> m_boneHandles;
+
 };
 
 #endif
@@ -33,6 +33,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "ImageNode.h"
 #include "OgreTools.h"
+#include "Profiler.h"
 
 namespace Frapper {
 
@@ -250,6 +251,7 @@ void ImageNode::createImageFromTexture( const Ogre::TexturePtr texturePointer, O
     outputImage.loadDynamicImage(imageData, width, height, 1, outputPixelFormat, true);
 
     // copy the render texture's image data to the image
+    FRAPPER_PROFILE_SCOPE("download", m_name, m_outputImageName)
     texturePointer->getBuffer()->blitToMemory(outputImage.getPixelBox());
 }
 
@@ -280,6 +282,7 @@ Ogre::TexturePtr ImageNode::createTextureFromImage( const Ogre::Image& image )
 	outputTexture = Ogre::TextureManager::getSingletonPtr()->createManual(textureName, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D, width, height, 1, pixelFormat, Ogre::TU_DYNAMIC_WRITE_ONLY);
 
 	// load the image data into the output texture
+	FRAPPER_PROFILE_SCOPE("upload", m_name, m_outputImageName)
 	Ogre::TextureManager::getSingletonPtr()->setVerbose(false);
 	outputTexture->loadImage(image);
 	Ogre::TextureManager::getSingletonPtr()->setVerbose(true);
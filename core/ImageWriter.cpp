@@ -0,0 +1,359 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ImageWriter.cpp"
+//! \brief Implementation file for ImageWriter class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "ImageWriter.h"
+#include "Log.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMutexLocker>
+
+namespace Frapper {
+
+
+///
+/// Constructors and Destructors of ImageWriteJob
+///
+
+
+//!
+//! Constructor of the ImageWriteJob class.
+//!
+//! \param filename The name of the file to write.
+//!
+ImageWriteJob::ImageWriteJob ( const QString &filename ) :
+    m_filename(filename)
+{
+}
+
+
+//!
+//! Destructor of the ImageWriteJob class.
+//!
+ImageWriteJob::~ImageWriteJob ()
+{
+}
+
+
+///
+/// Public Functions of ImageWriteJob
+///
+
+
+//!
+//! Returns the name of the file to write.
+//!
+//! \return The name of the file to write.
+//!
+const QString & ImageWriteJob::getFilename () const
+{
+    return m_filename;
+}
+
+
+///
+/// Constructors of OgreImageWriteJob
+///
+
+
+//!
+//! Constructor of the OgreImageWriteJob class, copying the given pixels.
+//!
+//! \param filename The name of the file to write.
+//! \param pixelBox The pixels to write, e.g. of a locked hardware buffer.
+//!
+OgreImageWriteJob::OgreImageWriteJob ( const QString &filename, const Ogre::PixelBox &pixelBox ) :
+    ImageWriteJob(filename)
+{
+    const size_t width = pixelBox.getWidth();
+    const size_t height = pixelBox.getHeight();
+    const size_t depth = pixelBox.getDepth();
+    const size_t dataSize = Ogre::PixelUtil::getMemorySize(width, height, depth, pixelBox.format);
+
+    // copy row by row, the source may have a row pitch larger than its width
+    void *data = OGRE_MALLOC(dataSize, Ogre::MEMCATEGORY_GENERAL);
+    Ogre::PixelBox copyBox (width, height, depth, pixelBox.format, data);
+    Ogre::PixelUtil::bulkPixelConversion(pixelBox, copyBox);
+
+    // let the image delete the memory when it's done
+    m_image.loadDynamicImage(static_cast<Ogre::uchar *>(data), width, height, depth, pixelBox.format, true);
+}
+
+
+//!
+//! Constructor of the OgreImageWriteJob class, downloading the given texture.
+//! Must be called from the thread owning the render system.
+//!
+//! \param filename The name of the file to write.
+//! \param texture The texture to write.
+//!
+OgreImageWriteJob::OgreImageWriteJob ( const QString &filename, Ogre::TexturePtr texture ) :
+    ImageWriteJob(filename)
+{
+    const size_t numMips = 1;
+    const size_t dataSize = Ogre::Image::calculateSize(numMips, texture->getNumFaces(),
+        texture->getWidth(), texture->getHeight(), texture->getDepth(), texture->getFormat());
+
+    // if there are multiple faces, pack them into the data one after another
+    void *data = OGRE_MALLOC(dataSize, Ogre::MEMCATEGORY_GENERAL);
+    Ogre::uchar *faceData = static_cast<Ogre::uchar *>(data);
+    const size_t faceDataSize = Ogre::PixelUtil::getMemorySize(texture->getWidth(),
+        texture->getHeight(), texture->getDepth(), texture->getFormat());
+    for (size_t face = 0; face < texture->getNumFaces(); ++face) {
+        Ogre::PixelBox pixelBox (texture->getWidth(), texture->getHeight(), texture->getDepth(), texture->getFormat(), faceData);
+        texture->getBuffer(face, 0)->blitToMemory(pixelBox);
+        faceData += faceDataSize;
+    }
+
+    // let the image delete the memory when it's done
+    m_image.loadDynamicImage(static_cast<Ogre::uchar *>(data), texture->getWidth(), texture->getHeight(),
+        texture->getDepth(), texture->getFormat(), true, texture->getNumFaces(), numMips - 1);
+}
+
+
+///
+/// Public Functions of OgreImageWriteJob
+///
+
+
+//!
+//! Encodes and writes the image.
+//!
+//! \param errorMessage The message to set if writing fails.
+//! \return True if the image was written, otherwise False.
+//!
+bool OgreImageWriteJob::write ( QString &errorMessage )
+{
+    try {
+        m_image.save(getFilename().toStdString());
+    } catch (Ogre::Exception &e) {
+        errorMessage = QString::fromStdString(e.getDescription());
+        return false;
+    }
+    return true;
+}
+
+
+///
+/// Private Static Data of ImageWriter
+///
+
+
+//!
+//! The shared image writer.
+//!
+ImageWriter *ImageWriter::s_instance = 0;
+
+
+///
+/// Public Static Functions of ImageWriter
+///
+
+
+//!
+//! Returns the image writer shared by all nodes. The writer is created on
+//! first use and waits for all pending jobs when the application quits.
+//!
+//! \return The shared image writer.
+//!
+ImageWriter * ImageWriter::getInstance ()
+{
+    if (!s_instance) {
+        // one thread is left to the evaluation, two slots per thread keep the encoders busy
+        const int threadCount = qMax(1, QThread::idealThreadCount() - 1);
+        s_instance = new ImageWriter(threadCount, 2 * threadCount);
+        qAddPostRoutine(destroyInstance);
+    }
+    return s_instance;
+}
+
+
+///
+/// Constructors and Destructors of ImageWriter
+///
+
+
+//!
+//! Constructor of the ImageWriter class.
+//!
+//! \param threadCount The number of worker threads.
+//! \param queueSize The maximum number of queued jobs.
+//!
+ImageWriter::ImageWriter ( int threadCount, int queueSize ) :
+    QObject(),
+    m_queueSize(queueSize),
+    m_activeCount(0),
+    m_stopRequested(false)
+{
+    // failures are reported in the thread the writer was created in
+    connect(this, SIGNAL(imageWriteFailed(const QString &, const QString &)),
+        SLOT(reportFailure(const QString &, const QString &)), Qt::QueuedConnection);
+
+    for (int i = 0; i < threadCount; ++i) {
+        Worker *worker = new Worker(this);
+        m_workers.append(worker);
+        worker->start(QThread::LowPriority);
+    }
+}
+
+
+//!
+//! Destructor of the ImageWriter class. Writes all pending jobs and
+//! stops the worker threads.
+//!
+ImageWriter::~ImageWriter ()
+{
+    waitForDone();
+
+    m_mutex.lock();
+    m_stopRequested = true;
+    m_jobQueued.wakeAll();
+    m_mutex.unlock();
+
+    foreach (Worker *worker, m_workers) {
+        worker->wait();
+        delete worker;
+    }
+}
+
+
+///
+/// Public Functions of ImageWriter
+///
+
+
+//!
+//! Queues the given job, blocking while the queue is full. The writer
+//! takes ownership of the job.
+//!
+//! \param job The job to queue.
+//!
+void ImageWriter::submit ( ImageWriteJob *job )
+{
+    if (!job)
+        return;
+
+    QMutexLocker locker (&m_mutex);
+    while (m_queue.size() >= m_queueSize)
+        m_slotFreed.wait(&m_mutex);
+
+    m_queue.enqueue(job);
+    m_jobQueued.wakeOne();
+}
+
+
+//!
+//! Blocks until all queued jobs have been written.
+//!
+void ImageWriter::waitForDone ()
+{
+    QMutexLocker locker (&m_mutex);
+    while (!m_queue.isEmpty() || m_activeCount > 0)
+        m_allDone.wait(&m_mutex);
+}
+
+
+//!
+//! Returns the number of jobs that are queued or being written.
+//!
+//! \return The number of pending jobs.
+//!
+int ImageWriter::getPendingCount () const
+{
+    QMutexLocker locker (&m_mutex);
+    return m_queue.size() + m_activeCount;
+}
+
+
+///
+/// Private Slots of ImageWriter
+///
+
+
+//!
+//! Reports a failed job in the log.
+//!
+//! \param filename The name of the file that could not be written.
+//! \param message The error message.
+//!
+void ImageWriter::reportFailure ( const QString &filename, const QString &message )
+{
+    Log::error(QString("Could not write image \"%1\": %2").arg(filename).arg(message), "ImageWriter::reportFailure");
+}
+
+
+///
+/// Private Functions of ImageWriter
+///
+
+
+//!
+//! Takes jobs from the queue and writes them until the writer is stopped.
+//!
+void ImageWriter::processJobs ()
+{
+    forever {
+        m_mutex.lock();
+        while (m_queue.isEmpty() && !m_stopRequested)
+            m_jobQueued.wait(&m_mutex);
+        if (m_queue.isEmpty()) {
+            m_mutex.unlock();
+            return;
+        }
+        ImageWriteJob *job = m_queue.dequeue();
+        ++m_activeCount;
+        m_slotFreed.wakeOne();
+        m_mutex.unlock();
+
+        QString errorMessage;
+        if (job->write(errorMessage))
+            emit imageWritten(job->getFilename());
+        else
+            emit imageWriteFailed(job->getFilename(), errorMessage);
+        delete job;
+
+        m_mutex.lock();
+        --m_activeCount;
+        if (m_queue.isEmpty() && m_activeCount == 0)
+            m_allDone.wakeAll();
+        m_mutex.unlock();
+    }
+}
+
+
+//!
+//! Deletes the shared image writer.
+//!
+void ImageWriter::destroyInstance ()
+{
+    delete s_instance;
+    s_instance = 0;
+}
+
+} // end namespace Frapper
@@ -0,0 +1,304 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ImageWriter.h"
+//! \brief Header file for ImageWriter class.
+//!
+//! The image writer encodes and writes images on a pool of worker threads,
+//! so that nodes saving image sequences do not stall the evaluation on
+//! compression and disk I/O. Jobs own a copy of the pixel data. The queue is
+//! bounded: submitting blocks while the pool is busy with as many jobs as
+//! there are queue slots, which limits the memory held by pending frames.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef IMAGEWRITER_H
+#define IMAGEWRITER_H
+
+#include "FrapperPrerequisites.h"
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+#include <QtCore/QThread>
+#include <Ogre.h>
+
+
+namespace Frapper {
+
+//!
+//! Abstract base class for jobs executed by the image writer.
+//!
+class FRAPPER_CORE_EXPORT ImageWriteJob
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the ImageWriteJob class.
+    //!
+    //! \param filename The name of the file to write.
+    //!
+    ImageWriteJob ( const QString &filename );
+
+    //!
+    //! Destructor of the ImageWriteJob class.
+    //!
+    virtual ~ImageWriteJob ();
+
+public: // functions
+
+    //!
+    //! Returns the name of the file to write.
+    //!
+    //! \return The name of the file to write.
+    //!
+    const QString & getFilename () const;
+
+    //!
+    //! Encodes and writes the image. Called from a worker thread of the
+    //! image writer, so the job must not access nodes or parameters.
+    //!
+    //! \param errorMessage The message to set if writing fails.
+    //! \return True if the image was written, otherwise False.
+    //!
+    virtual bool write ( QString &errorMessage ) = 0;
+
+private: // data
+
+    //!
+    //! The name of the file to write.
+    //!
+    QString m_filename;
+
+};
+
+
+//!
+//! Job writing an OGRE image to a file, using the OGRE image codecs.
+//!
+class FRAPPER_CORE_EXPORT OgreImageWriteJob : public ImageWriteJob
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the OgreImageWriteJob class, copying the given pixels.
+    //!
+    //! \param filename The name of the file to write.
+    //! \param pixelBox The pixels to write, e.g. of a locked hardware buffer.
+    //!
+    OgreImageWriteJob ( const QString &filename, const Ogre::PixelBox &pixelBox );
+
+    //!
+    //! Constructor of the OgreImageWriteJob class, downloading the given texture.
+    //! Must be called from the thread owning the render system.
+    //!
+    //! \param filename The name of the file to write.
+    //! \param texture The texture to write.
+    //!
+    OgreImageWriteJob ( const QString &filename, Ogre::TexturePtr texture );
+
+public: // functions
+
+    //!
+    //! Encodes and writes the image.
+    //!
+    //! \param errorMessage The message to set if writing fails.
+    //! \return True if the image was written, otherwise False.
+    //!
+    virtual bool write ( QString &errorMessage );
+
+private: // data
+
+    //!
+    //! The image owning a copy of the pixel data.
+    //!
+    Ogre::Image m_image;
+
+};
+
+
+//!
+//! Class running image write jobs on a bounded pool of worker threads.
+//!
+class FRAPPER_CORE_EXPORT ImageWriter : public QObject
+{
+
+    Q_OBJECT
+
+public: // static functions
+
+    //!
+    //! Returns the image writer shared by all nodes. The writer is created on
+    //! first use and waits for all pending jobs when the application quits.
+    //!
+    //! \return The shared image writer.
+    //!
+    static ImageWriter * getInstance ();
+
+public: // functions
+
+    //!
+    //! Queues the given job, blocking while the queue is full. The writer
+    //! takes ownership of the job.
+    //!
+    //! \param job The job to queue.
+    //!
+    void submit ( ImageWriteJob *job );
+
+    //!
+    //! Blocks until all queued jobs have been written.
+    //!
+    void waitForDone ();
+
+    //!
+    //! Returns the number of jobs that are queued or being written.
+    //!
+    //! \return The number of pending jobs.
+    //!
+    int getPendingCount () const;
+
+signals: //
+
+    //!
+    //! Signal that is emitted from a worker thread when an image was written.
+    //!
+    //! \param filename The name of the written file.
+    //!
+    void imageWritten ( const QString &filename );
+
+    //!
+    //! Signal that is emitted from a worker thread when writing an image failed.
+    //!
+    //! \param filename The name of the file that could not be written.
+    //! \param message The error message.
+    //!
+    void imageWriteFailed ( const QString &filename, const QString &message );
+
+private slots: //
+
+    //!
+    //! Reports a failed job in the log.
+    //!
+    //! \param filename The name of the file that could not be written.
+    //! \param message The error message.
+    //!
+    void reportFailure ( const QString &filename, const QString &message );
+
+private: // nested classes
+
+    //!
+    //! Worker thread taking jobs from the queue.
+    //!
+    class Worker : public QThread
+    {
+    public:
+        Worker ( ImageWriter *imageWriter ) : m_imageWriter(imageWriter) {}
+    protected:
+        virtual void run () { m_imageWriter->processJobs(); }
+    private:
+        ImageWriter *m_imageWriter;
+    };
+
+private: // constructors and destructors
+
+    //!
+    //! Constructor of the ImageWriter class.
+    //!
+    //! \param threadCount The number of worker threads.
+    //! \param queueSize The maximum number of queued jobs.
+    //!
+    ImageWriter ( int threadCount, int queueSize );
+
+    //!
+    //! Destructor of the ImageWriter class. Writes all pending jobs and
+    //! stops the worker threads.
+    //!
+    virtual ~ImageWriter ();
+
+private: // functions
+
+    //!
+    //! Takes jobs from the queue and writes them until the writer is stopped.
+    //!
+    void processJobs ();
+
+    //!
+    //! Deletes the shared image writer.
+    //!
+    static void destroyInstance ();
+
+private: // data
+
+    //!
+    //! The shared image writer.
+    //!
+    static ImageWriter *s_instance;
+
+    //!
+    //! The worker threads.
+    //!
+    QList<Worker *> m_workers;
+
+    //!
+    //! The queued jobs.
+    //!
+    QQueue<ImageWriteJob *> m_queue;
+
+    //!
+    //! The maximum number of queued jobs.
+    //!
+    int m_queueSize;
+
+    //!
+    //! The number of jobs being written.
+    //!
+    int m_activeCount;
+
+    //!
+    //! Flag that is set when the worker threads should stop.
+    //!
+    bool m_stopRequested;
+
+    //!
+    //! Mutex guarding the queue and the counters.
+    //!
+    mutable QMutex m_mutex;
+
+    //!
+    //! Conditions for jobs being queued, slots being freed and all jobs being done.
+    //!
+    QWaitCondition m_jobQueued;
+    QWaitCondition m_slotFreed;
+    QWaitCondition m_allDone;
+
+};
+
+} // end namespace Frapper
+
+#endif
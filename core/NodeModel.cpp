@@ -34,8 +34,10 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "NodeModel.h"
 #include "NodeFactory.h"
+#include <QApplication>
 #include <QGraphicsScene>
 #include <QProgressDialog>
+#include <QtCore/QSet>
 #include "Log.h"
 #include "BackDropNode.h"
 
@@ -62,7 +64,7 @@ namespace Frapper {
 //! Constructor of the NodeModel class.
 //!
 NodeModel::NodeModel () :
-m_updating(false),
+m_updateDepth(0),
 m_selectingAll(false)
 {
     // set the horizontal labels for the standard item model
@@ -75,10 +77,14 @@ m_selectingAll(false)
 //!
 NodeModel::~NodeModel ()
 {
-    QProgressDialog progressDialog (tr("Freeing resources of node model..."), QString(), 0, m_standardItemNodeMap.size());
-    progressDialog.setWindowTitle(tr("Closing"));
-    progressDialog.setWindowModality(Qt::ApplicationModal);
-    progressDialog.setMaximum(m_standardItemNodeMap.size());
+    // only show the progress in applications with a GUI
+    QProgressDialog *progressDialog = 0;
+    if (qobject_cast<QApplication *>(QCoreApplication::instance())) {
+        progressDialog = new QProgressDialog(tr("Freeing resources of node model..."), QString(), 0, m_standardItemNodeMap.size());
+        progressDialog->setWindowTitle(tr("Closing"));
+        progressDialog->setWindowModality(Qt::ApplicationModal);
+        progressDialog->setMaximum(m_standardItemNodeMap.size());
+    }
     int progress = 0;
 
     beginUpdate();
@@ -92,9 +98,12 @@ NodeModel::~NodeModel ()
         deleteNode(item->text());
 
         ++progress;
-        progressDialog.setValue(progress);
+        if (progressDialog)
+            progressDialog->setValue(progress);
     }
     endUpdate();
+
+    delete progressDialog;
 }
 
 
@@ -103,22 +112,23 @@ NodeModel::~NodeModel ()
 ///
 
 //!
-//! Sets an updating flag for the node model to prevent emitting redundant
-//! updated() signals.
+//! Increases the update depth of the node model to prevent emitting
+//! redundant updated() signals.
 //!
-//! Should be called to initiate a substantial update of the model.
+//! Should be called to initiate a substantial update of the model. Updates
+//! can be nested, each call has to be matched by a call to endUpdate().
 //!
 //! \see endUpdate()
 //!
 void NodeModel::beginUpdate ()
 {
-    m_updating = true;
+    ++m_updateDepth;
 }
 
 
 //!
-//! Resets the updating flag for the node model and emits the updated()
-//! signal.
+//! Decreases the update depth of the node model and emits the updated()
+//! signal when the outermost update has finished.
 //!
 //! Should be called when a substantial update of the model that was initiated
 //! by calling beginUpdate() has finished.
@@ -127,7 +137,19 @@ void NodeModel::beginUpdate ()
 //!
 void NodeModel::endUpdate ()
 {
-    m_updating = false;
+    if (m_updateDepth == 0) {
+        Log::error("endUpdate() was called without a matching beginUpdate().", "NodeModel::endUpdate");
+        return;
+    }
+
+    // nested updates are part of the outermost one
+    if (--m_updateDepth > 0)
+        return;
+
+#ifdef _DEBUG
+    // substantial updates create and delete many nodes and connections
+    checkIndices();
+#endif
 
     // notify connected objects that the node model has been modified
     emit modified();
@@ -216,6 +238,7 @@ Node * NodeModel::createBackDrop (const QString name /* = "" */, const QPointF p
 	}
 
 	m_nodeMap.insert(nodeName, node);
+	m_nodeTypeMap.insert(node->getTypeName(), node);
 
 	// create a new standard item in the node's category
 	QStandardItem *categoryItem = getCategoryItem(nodeCategoryName);
@@ -277,6 +300,7 @@ Node * NodeModel::createNode ( const QString &typeName, const QString &name /* =
     }
 
     m_nodeMap.insert(nodeName, node);
+    m_nodeTypeMap.insert(node->getTypeName(), node);
 
     // create a new standard item in the node's category
     QStandardItem *categoryItem = getCategoryItem(nodeCategoryName);
@@ -341,6 +365,9 @@ Connection * NodeModel::createConnection ( Parameter *sourceParameter, Parameter
     }
 
     m_connectionMap.insert(connectionId, connection);
+    m_incomingConnectionMap.insert(targetParameter, connection);
+    m_outgoingConnectionMap.insert(sourceParameter, connection);
+    m_connectionParameterMap.insert(connection, qMakePair(targetParameter, sourceParameter));
 
     // create a new standard item in the category
     QStandardItem *categoryItem = getCategoryItem(categoryName);
@@ -432,16 +459,10 @@ Node * NodeModel::getNode ( const QString &name ) const
 //!
 QList<Node *> NodeModel::getNodes ( const QString &typeName /* = "" */ ) const
 {
-    QList<Node *> result;
-
-    QHashIterator<QString, Node *> it (m_nodeMap);
-    while (it.hasNext()) {
-        it.next();
-        Node *node = it.value();
-        if ((typeName == "") || (node && node->getTypeName() == typeName))
-            result << node;
-    }
-    return result;
+    if (typeName.isEmpty())
+        return m_nodeMap.values();
+    else
+        return m_nodeTypeMap.values(typeName);
 }
 
 
@@ -468,7 +489,7 @@ QList<Node *> NodeModel::getGroupedNodes ( const QString &groupName/* = ""*/ ) c
 QList<Node *> NodeModel::getUngroupedNodes ( ) const
 {
 	QList<Node *> ungroupedNodes;
-	const QList<Node *> &groupedNodes = getGroupedNodes();
+	const QSet<Node *> groupedNodes = getGroupedNodes().toSet();
 
 	foreach (Node* node, m_nodeMap)
 		if (!groupedNodes.contains(node))
@@ -503,6 +524,74 @@ Connection * NodeModel::getConnection (const QString &name) const
 }
 
 
+//!
+//! Returns the connections that have the given parameter as target.
+//!
+//! \param parameter The target parameter of the connections to return.
+//! \return A list of connections.
+//!
+QList<Connection *> NodeModel::getIncomingConnections ( Parameter *parameter ) const
+{
+    return m_incomingConnectionMap.values(parameter);
+}
+
+
+//!
+//! Returns the connections that have the given parameter as source.
+//!
+//! \param parameter The source parameter of the connections to return.
+//! \return A list of connections.
+//!
+QList<Connection *> NodeModel::getOutgoingConnections ( Parameter *parameter ) const
+{
+    return m_outgoingConnectionMap.values(parameter);
+}
+
+
+//!
+//! Checks that the type and connection indices match the nodes and
+//! connections of the model and logs an error if they do not.
+//!
+//! \return True if the indices are consistent, otherwise False.
+//!
+bool NodeModel::checkIndices () const
+{
+    int errors = 0;
+
+    if (m_nodeTypeMap.size() != m_nodeMap.size())
+        ++errors;
+    foreach (Node *node, m_nodeMap)
+        if (!m_nodeTypeMap.contains(node->getTypeName(), node))
+            ++errors;
+
+    if (m_incomingConnectionMap.size() != m_connectionMap.size() ||
+        m_outgoingConnectionMap.size() != m_connectionMap.size() ||
+        m_connectionParameterMap.size() != m_connectionMap.size())
+        ++errors;
+    foreach (Connection *connection, m_connectionMap) {
+        QHash<Connection *, QPair<Parameter *, Parameter *> >::const_iterator iter = m_connectionParameterMap.constFind(connection);
+        if (iter == m_connectionParameterMap.constEnd()) {
+            ++errors;
+            continue;
+        }
+        Parameter *targetParameter = iter.value().first;
+        Parameter *sourceParameter = iter.value().second;
+        if (!m_incomingConnectionMap.contains(targetParameter, connection) ||
+            !m_outgoingConnectionMap.contains(sourceParameter, connection))
+            ++errors;
+
+        // deleted parameters reset the endpoints, all others must be the recorded ones
+        if ((connection->getTargetParameter() && connection->getTargetParameter() != targetParameter) ||
+            (connection->getSourceParameter() && connection->getSourceParameter() != sourceParameter))
+            ++errors;
+    }
+
+    if (errors > 0)
+        Log::error(QString("The node and connection indices are inconsistent (%1 errors).").arg(errors), "NodeModel::checkIndices");
+    return errors == 0;
+}
+
+
 //!
 //! Returns the list of names of nodes of the given type name contained in
 //! the node model.
@@ -654,21 +743,37 @@ void NodeModel::deleteNode ( const QString &name )
         // remove the corresponding item from the model
         standardItem->parent()->removeRow(standardItem->row());
 
-    // delete the node
+    // find the connections of the node's parameters through the indices
+    QList<Connection *> nodeConnections;
+    const AbstractParameter::List &parameters = node->getParameterRoot()->getAllParameters();
+    foreach (AbstractParameter *abstractParameter, parameters) {
+        Parameter *parameter = dynamic_cast<Parameter *>(abstractParameter);
+        if (parameter)
+            nodeConnections << m_incomingConnectionMap.values(parameter) << m_outgoingConnectionMap.values(parameter);
+    }
+
+    // delete the node, the pointer is only used as key of the type index afterwards
+    const QString typeName = node->getTypeName();
     delete node;
-    node = 0;
 
     // remove the object from the maps
     m_nodeMap.remove(name);
+    m_nodeTypeMap.remove(typeName, node);
     m_standardItemNodeMap.remove(name);
 
     mutexLocker.unlock();
     DEBUG_LOG_UNLOCK("NodeModel::deleteNode");
 
+    // the deleted parameters ask the scene model to delete their connections,
+    // delete the ones left over so the indices do not keep deleted parameters
+    foreach (Connection *connection, nodeConnections)
+        if (m_connectionParameterMap.contains(connection))
+            deleteConnection(QString::number(connection->getId()));
+
     // notify connected objects that the node has been deleted
     emit nodeDeleted(name);
 
-    if (!m_updating)
+    if (m_updateDepth == 0)
         // notify connected objects that the node model has been modified
         emit modified();
 }
@@ -702,6 +807,11 @@ void NodeModel::deleteConnection ( const QString &name )
         // remove the corresponding item from the model
         standardItem->parent()->removeRow(standardItem->row());
 
+    // remove the connection from the parameter indices
+    const QPair<Parameter *, Parameter *> connectionParameters = m_connectionParameterMap.take(connection);
+    m_incomingConnectionMap.remove(connectionParameters.first, connection);
+    m_outgoingConnectionMap.remove(connectionParameters.second, connection);
+
     // reset the target parameter
     Parameter *targetParameter = connection->getTargetParameter();
     // delete the connection
@@ -721,7 +831,7 @@ void NodeModel::deleteConnection ( const QString &name )
     // notify connected objects that the node has been deleted
     //emit nodeDeleted(name);
 
-    if (!m_updating)
+    if (m_updateDepth == 0)
         // notify connected objects that the node model has been modified
         emit modified();
 }
@@ -879,8 +989,8 @@ void NodeModel::changeParameterPinType ( const QString &name, const QString &par
 		Parameter *parameter = node->getParameter(parameterName);
 		if (parameter)
 			if (pinType != parameter->getPinType()) {
-				Connection::Map connectionMap = parameter->getConnectionMap();
-				foreach (Connection *connection, connectionMap)
+				const QList<Connection *> connections = getIncomingConnections(parameter) + getOutgoingConnections(parameter);
+				foreach (Connection *connection, connections)
 					node->deleteConnection(connection);
 				parameter->setPinType(pinType);
 				node->notifyChange();
@@ -85,18 +85,19 @@ namespace Frapper {
     public: // functions
 
         //!
-        //! Sets an updating flag for the node model to prevent emitting redundant
-        //! updated() signals.
+        //! Increases the update depth of the node model to prevent emitting
+        //! redundant updated() signals.
         //!
-        //! Should be called to initiate a substantial update of the model.
+        //! Should be called to initiate a substantial update of the model. Updates
+        //! can be nested, each call has to be matched by a call to endUpdate().
         //!
         //! \see endUpdate()
         //!
         void beginUpdate ();
 
         //!
-        //! Resets the updating flag for the node model and emits the updated()
-        //! signal.
+        //! Decreases the update depth of the node model and emits the updated()
+        //! signal when the outermost update has finished.
         //!
         //! Should be called when a substantial update of the model that was initiated
         //! by calling beginUpdate() has finished.
@@ -233,6 +234,30 @@ namespace Frapper {
 		//!
 		Connection * getConnection (const QString &name) const;
 
+        //!
+        //! Returns the connections that have the given parameter as target.
+        //!
+        //! \param parameter The target parameter of the connections to return.
+        //! \return A list of connections.
+        //!
+        QList<Connection *> getIncomingConnections ( Parameter *parameter ) const;
+
+        //!
+        //! Returns the connections that have the given parameter as source.
+        //!
+        //! \param parameter The source parameter of the connections to return.
+        //! \return A list of connections.
+        //!
+        QList<Connection *> getOutgoingConnections ( Parameter *parameter ) const;
+
+        //!
+        //! Checks that the type and connection indices match the nodes and
+        //! connections of the model and logs an error if they do not.
+        //!
+        //! \return True if the indices are consistent, otherwise False.
+        //!
+        bool checkIndices () const;
+
         //!
         //! Returns the list of names of nodes of the given type name contained in
         //! the node model.
@@ -404,12 +429,12 @@ signals: //
     private: // data
 
         //!
-        //! Flag that states whether a bigger update of the node model is taking
-        //! place.
+        //! The number of nested bigger updates of the node model that are
+        //! taking place.
         //!
         //! \see beginUpdate(), endUpdate()
         //!
-        bool m_updating;
+        int m_updateDepth;
 
         //!
         //! Flag that states whether all nodes are currently being selected.
@@ -438,11 +463,29 @@ signals: //
         //!
         QMultiHash<QString, Node *> m_nodeGroupMap;
 
+        //!
+        //! A hash for referencing nodes by type name.
+        //!
+        QMultiHash<QString, Node *> m_nodeTypeMap;
+
         //!
         //! A map for referencing connections by name.
         //!
         QHash<QString, Connection *> m_connectionMap;
 
+        //!
+        //! Hashes for referencing connections by target and source parameter.
+        //!
+        QMultiHash<Parameter *, Connection *> m_incomingConnectionMap;
+        QMultiHash<Parameter *, Connection *> m_outgoingConnectionMap;
+
+        //!
+        //! The target and source parameters the connections were created with.
+        //! Parameters reset the connections' parameters when they are deleted,
+        //! so the indices are updated from these.
+        //!
+        QHash<Connection *, QPair<Parameter *, Parameter *> > m_connectionParameterMap;
+
         //!
         //! A map for referencing standard items by name.
         //!
@@ -91,6 +91,26 @@ m_erroneous(false)
 }
 
 
+//!
+//! Constructor of the NodeType class for node types that are compiled
+//! into the application instead of being loaded from a plugin library.
+//!
+//! \param filename The name of an XML file describing the node type.
+//! \param nodeTypeInterface The interface creating the nodes of this type.
+//!
+NodeType::NodeType ( const QString &filename, NodeTypeInterface *nodeTypeInterface ) :
+m_nodeTypeInterface(nodeTypeInterface),
+m_parameterRoot(0),
+m_available(false),
+m_internal(false),
+m_erroneous(false)
+{
+    m_available = parseDescriptionFile(filename);
+
+    INC_INSTANCE_COUNTER
+}
+
+
 //!
 //! Destructor of the NodeType class.
 //!
@@ -258,7 +278,7 @@ bool NodeType::parseDescriptionFile ( const QString &filename )
     m_categoryName = rootElement.attribute("category");
     QString colorString = rootElement.attribute("color");
     QString pluginFilename = rootElement.attribute("plugin");
-    if (m_name.isEmpty() || m_categoryName.isEmpty() || colorString.isEmpty() || pluginFilename.isEmpty()) {
+    if (m_name.isEmpty() || m_categoryName.isEmpty() || colorString.isEmpty() || (pluginFilename.isEmpty() && !m_nodeTypeInterface)) {
         Log::error(QString("\"%1\": A required attribute in the root node is missing.").arg(filename), "NodeType::parseDescriptionFile");
         return false;
     }
@@ -298,8 +318,8 @@ bool NodeType::parseDescriptionFile ( const QString &filename )
 
     Log::debug(QString("\"%1\" parsed.").arg(baseFilename), "NodeType::parseDescriptionFile");
 
-    // load plugin if a plugin filename is given
-    if (pluginFilename != "") {
+    // load plugin if a plugin filename is given and no node type interface was passed in
+    if (pluginFilename != "" && !m_nodeTypeInterface) {
 #ifdef __MINGW32__
         pluginFilename = "lib" + pluginFilename;
 #endif
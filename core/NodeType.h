@@ -97,6 +97,16 @@ namespace Frapper {
         //!
         NodeType ( const QString &filename );
 
+        //!
+        //! Constructor of the NodeType class for node types that are compiled
+        //! into the application instead of being loaded from a plugin library.
+        //! The plugin attribute of the description file is not required.
+        //!
+        //! \param filename The name of an XML file describing the node type.
+        //! \param nodeTypeInterface The interface creating the nodes of this type.
+        //!
+        NodeType ( const QString &filename, NodeTypeInterface *nodeTypeInterface );
+
         //!
         //! Destructor of the NodeType class.
         //!
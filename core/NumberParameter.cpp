@@ -34,6 +34,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "NumberParameter.h"
 #include "Node.h"
+#include <QtCore/QSet>
 
 namespace Frapper {
 
@@ -814,6 +815,228 @@ float NumberParameter::getLastKeyPos () const
 }
 
 
+///
+/// Public Bulk Key Functions
+///
+
+
+//!
+//! Returns the sorted indices of the keys in the time range [minTime, maxTime].
+//!
+//! \param minTime The start time of the range.
+//! \param maxTime The end time of the range.
+//! \return The indices of the keys in the range.
+//!
+QList<int> NumberParameter::getKeyIndices ( const float minTime, const float maxTime ) const
+{
+    QList<int> result;
+
+    // the keys are sorted by time, so the range is contiguous
+    QList<Key>::const_iterator iter = qLowerBound(m_keys.constBegin(), m_keys.constEnd(), Key(minTime, 0.0f), lessThan);
+    for (int index = iter - m_keys.constBegin(); iter != m_keys.constEnd() && iter->index <= maxTime; ++iter, ++index)
+        result.append(index);
+
+    return result;
+}
+
+
+//!
+//! Returns the sorted indices of the keys the given predicate selects.
+//!
+//! \param predicate The function that selects keys.
+//! \param data The user data to pass to the predicate.
+//! \return The indices of the selected keys.
+//!
+QList<int> NumberParameter::getKeyIndices ( KeyPredicate predicate, void *data /* = 0 */ ) const
+{
+    QList<int> result;
+    if (!predicate)
+        return result;
+
+    for (int i = 0; i < m_keys.size(); ++i)
+        if (predicate(m_keys.at(i), data))
+            result.append(i);
+
+    return result;
+}
+
+
+//!
+//! Returns the sorted indices of the given keys, which must point into
+//! the list of keys of this parameter. Keys of other parameters are
+//! ignored.
+//!
+//! \param keys Pointers to keys of the list of keys.
+//! \return The indices of the given keys.
+//!
+QList<int> NumberParameter::getKeyIndices ( const QList<Key *> &keys ) const
+{
+    QList<int> result;
+    if (keys.isEmpty())
+        return result;
+
+    QSet<const Key *> keySet;
+    foreach (const Key *key, keys)
+        keySet.insert(key);
+
+    for (int i = 0; i < m_keys.size(); ++i)
+        if (keySet.contains(&m_keys.at(i)))
+            result.append(i);
+
+    return result;
+}
+
+
+//!
+//! Sets the value of the keys at the given indices. Bezier tangents are
+//! moved along with the values.
+//!
+//! \param indices The sorted indices of the keys to edit.
+//! \param value The new value of the keys.
+//!
+void NumberParameter::setKeyValues ( const QList<int> &indices, const float value )
+{
+    if (indices.isEmpty())
+        return;
+
+    const int numKeys = m_keys.size();
+    foreach (int index, indices) {
+        if (index < 0 || index >= numKeys)
+            continue;
+        Key &key = m_keys[index];
+        key.tangentValue += value - key.keyValue.toFloat();
+        key.keyValue.setValue<float>(value);
+    }
+
+    setBounds(value);
+    emit keysChanged();
+}
+
+
+//!
+//! Transforms the values of the keys at the given indices to
+//! value * scale + offset, including their bezier tangents.
+//!
+//! \param indices The sorted indices of the keys to edit.
+//! \param scale The factor to scale the values with.
+//! \param offset The offset to add to the scaled values.
+//!
+void NumberParameter::transformKeyValues ( const QList<int> &indices, const float scale, const float offset /* = 0.0f */ )
+{
+    if (indices.isEmpty())
+        return;
+
+    const int numKeys = m_keys.size();
+    foreach (int index, indices) {
+        if (index < 0 || index >= numKeys)
+            continue;
+        Key &key = m_keys[index];
+        const float value = key.keyValue.toFloat() * scale + offset;
+        key.tangentValue = key.tangentValue * scale + offset;
+        key.keyValue.setValue<float>(value);
+        setBounds(value);
+    }
+
+    emit keysChanged();
+}
+
+
+//!
+//! Returns the largest absolute value of the keys at the given indices.
+//!
+//! \param indices The indices of the keys.
+//! \return The largest absolute key value, or 0 if no key was given.
+//!
+float NumberParameter::getMaxAbsKeyValue ( const QList<int> &indices ) const
+{
+    float largest = 0.0f;
+    const int numKeys = m_keys.size();
+    foreach (int index, indices)
+        if (index >= 0 && index < numKeys)
+            largest = qMax(largest, qAbs(m_keys.at(index).keyValue.toFloat()));
+
+    return largest;
+}
+
+
+//!
+//! Scales the values of the keys at the given indices so that their
+//! largest absolute value equals the given maximum.
+//!
+//! \param indices The sorted indices of the keys to edit.
+//! \param maximum The largest absolute value after normalization.
+//!
+void NumberParameter::normalizeKeyValues ( const QList<int> &indices, const float maximum /* = 1.0f */ )
+{
+    const float largest = getMaxAbsKeyValue(indices);
+    if (largest == 0.0f)
+        return;
+
+    transformKeyValues(indices, maximum / largest);
+}
+
+
+//!
+//! Moves the keys at the given indices to time * scale + offset and
+//! keeps the list of keys sorted by time.
+//!
+//! \param indices The sorted indices of the keys to edit.
+//! \param scale The factor to scale the key times with.
+//! \param offset The offset to add to the scaled key times.
+//!
+void NumberParameter::retimeKeys ( const QList<int> &indices, const float scale, const float offset /* = 0.0f */ )
+{
+    if (indices.isEmpty())
+        return;
+
+    const int numKeys = m_keys.size();
+    foreach (int index, indices) {
+        if (index < 0 || index >= numKeys)
+            continue;
+        Key &key = m_keys[index];
+        key.index = key.index * scale + offset;
+        key.tangentIndex = key.tangentIndex * scale + offset;
+    }
+
+    // restore the order only if the moved keys passed other keys
+    bool sorted = true;
+    for (int i = 1; i < numKeys && sorted; ++i)
+        sorted = !lessThan(m_keys.at(i), m_keys.at(i - 1));
+    if (!sorted)
+        qStableSort(m_keys.begin(), m_keys.end(), lessThan);
+
+    emit keysChanged();
+}
+
+
+//!
+//! Removes the keys at the given indices.
+//!
+//! \param indices The sorted indices of the keys to remove.
+//!
+void NumberParameter::removeKeys ( const QList<int> &indices )
+{
+    if (indices.isEmpty())
+        return;
+
+    // compact the remaining keys in one pass
+    const int numKeys = m_keys.size();
+    QList<Key> keys;
+    keys.reserve(numKeys);
+    QList<int>::const_iterator removeIter = indices.constBegin();
+    for (int i = 0; i < numKeys; ++i) {
+        while (removeIter != indices.constEnd() && *removeIter < i)
+            ++removeIter;
+        if (removeIter != indices.constEnd() && *removeIter == i)
+            continue;
+        keys.append(m_keys.at(i));
+    }
+    m_keys.swap(keys);
+
+    emit keysChanged();
+}
+
+
 //!
 //! Returns the parameter's value while optionally triggering the
 //! evaluation chain.
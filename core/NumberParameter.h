@@ -419,6 +419,98 @@ public: // animation functions
     //!
 	float getLastKeyPos () const;
 
+public: // bulk key functions
+
+    //!
+    //! Function type for selecting keys with getKeyIndices().
+    //!
+    //! \param key The key to test.
+    //! \param data The user data passed to getKeyIndices().
+    //! \return True if the key is selected, otherwise False.
+    //!
+    typedef bool (*KeyPredicate) ( const Key &key, void *data );
+
+    //!
+    //! Returns the sorted indices of the keys in the time range [minTime, maxTime].
+    //!
+    //! \param minTime The start time of the range.
+    //! \param maxTime The end time of the range.
+    //! \return The indices of the keys in the range.
+    //!
+    QList<int> getKeyIndices ( const float minTime, const float maxTime ) const;
+
+    //!
+    //! Returns the sorted indices of the keys the given predicate selects.
+    //!
+    //! \param predicate The function that selects keys.
+    //! \param data The user data to pass to the predicate.
+    //! \return The indices of the selected keys.
+    //!
+    QList<int> getKeyIndices ( KeyPredicate predicate, void *data = 0 ) const;
+
+    //!
+    //! Returns the sorted indices of the given keys, which must point into
+    //! the list of keys of this parameter. Keys of other parameters are
+    //! ignored.
+    //!
+    //! \param keys Pointers to keys of the list of keys.
+    //! \return The indices of the given keys.
+    //!
+    QList<int> getKeyIndices ( const QList<Key *> &keys ) const;
+
+    //!
+    //! Sets the value of the keys at the given indices. Bezier tangents are
+    //! moved along with the values.
+    //!
+    //! \param indices The sorted indices of the keys to edit.
+    //! \param value The new value of the keys.
+    //!
+    void setKeyValues ( const QList<int> &indices, const float value );
+
+    //!
+    //! Transforms the values of the keys at the given indices to
+    //! value * scale + offset, including their bezier tangents.
+    //!
+    //! \param indices The sorted indices of the keys to edit.
+    //! \param scale The factor to scale the values with.
+    //! \param offset The offset to add to the scaled values.
+    //!
+    void transformKeyValues ( const QList<int> &indices, const float scale, const float offset = 0.0f );
+
+    //!
+    //! Returns the largest absolute value of the keys at the given indices.
+    //!
+    //! \param indices The indices of the keys.
+    //! \return The largest absolute key value, or 0 if no key was given.
+    //!
+    float getMaxAbsKeyValue ( const QList<int> &indices ) const;
+
+    //!
+    //! Scales the values of the keys at the given indices so that their
+    //! largest absolute value equals the given maximum.
+    //!
+    //! \param indices The sorted indices of the keys to edit.
+    //! \param maximum The largest absolute value after normalization.
+    //!
+    void normalizeKeyValues ( const QList<int> &indices, const float maximum = 1.0f );
+
+    //!
+    //! Moves the keys at the given indices to time * scale + offset and
+    //! keeps the list of keys sorted by time.
+    //!
+    //! \param indices The sorted indices of the keys to edit.
+    //! \param scale The factor to scale the key times with.
+    //! \param offset The offset to add to the scaled key times.
+    //!
+    void retimeKeys ( const QList<int> &indices, const float scale, const float offset = 0.0f );
+
+    //!
+    //! Removes the keys at the given indices.
+    //!
+    //! \param indices The sorted indices of the keys to remove.
+    //!
+    void removeKeys ( const QList<int> &indices );
+
     //!
     //! Returns the parameter's value while optionally triggering the
     //! evaluation chain.
@@ -435,6 +527,12 @@ signals: // signals
 	//!
 	void rangeChanged();
 
+	//!
+	//! Signal that is emitted once after keys were edited by one of the bulk
+	//! key functions.
+	//!
+	void keysChanged();
+
 protected: // functions
 
 	//!
@@ -189,6 +189,7 @@ Ogre::Entity * OgreContainer::getEntity ()
 void OgreContainer::setEntity ( Ogre::Entity *entity )
 {
     m_entity = entity;
+    m_boneHandles.clear();
 }
 
 
@@ -375,6 +376,84 @@ void OgreContainer::updateCopies ( const QString &name,
     emit boneTransformUpdated(name, position, orientation);
 }
 
+
+//!
+//! Lets the manual object contained in this container render the vertex
+//! and index buffers of the given manual object instead of holding
+//! buffers of its own. Only the section layout is kept per copy.
+//!
+//! \param manualObject The manual object whose buffers to share.
+//!
+void OgreContainer::shareVertexData ( Ogre::ManualObject *manualObject )
+{
+	if (!m_manualObject || !manualObject || manualObject == m_manualObject)
+		return;
+
+	const unsigned int numSections = manualObject->getNumSections();
+
+	// recreate the sections if the layout changed, the placeholder vertex
+	// buffers are released as soon as the shared buffers are bound
+	if (m_manualObject->getNumSections() != numSections) {
+		m_manualObject->clear();
+		for (unsigned int i = 0; i < numSections; ++i) {
+			Ogre::ManualObject::ManualObjectSection *section = manualObject->getSection(i);
+			m_manualObject->begin(section->getMaterialName(), section->getRenderOperation()->operationType, section->getMaterialGroup());
+			m_manualObject->position(Ogre::Vector3::ZERO);
+			m_manualObject->end();
+		}
+	}
+
+	for (unsigned int i = 0; i < numSections; ++i) {
+		Ogre::ManualObject::ManualObjectSection *section = manualObject->getSection(i);
+		Ogre::ManualObject::ManualObjectSection *sectionCopy = m_manualObject->getSection(i);
+		Ogre::RenderOperation *renderOperation = section->getRenderOperation();
+		Ogre::RenderOperation *renderOperationCopy = sectionCopy->getRenderOperation();
+
+		if (sectionCopy->getMaterialName() != section->getMaterialName() || sectionCopy->getMaterialGroup() != section->getMaterialGroup())
+			sectionCopy->setMaterialName(section->getMaterialName(), section->getMaterialGroup());
+		renderOperationCopy->operationType = renderOperation->operationType;
+
+		// vertex layout, only rebuilt if it differs
+		const Ogre::VertexData *vertexData = renderOperation->vertexData;
+		Ogre::VertexData *vertexDataCopy = renderOperationCopy->vertexData;
+		const Ogre::VertexDeclaration::VertexElementList &elements = vertexData->vertexDeclaration->getElements();
+		if (vertexDataCopy->vertexDeclaration->getElements() != elements) {
+			vertexDataCopy->vertexDeclaration->removeAllElements();
+			Ogre::VertexDeclaration::VertexElementList::const_iterator elementIter;
+			for (elementIter = elements.begin(); elementIter != elements.end(); ++elementIter)
+				vertexDataCopy->vertexDeclaration->addElement(elementIter->getSource(), elementIter->getOffset(), elementIter->getType(), elementIter->getSemantic(), elementIter->getIndex());
+		}
+
+		// shared hardware vertex buffers
+		const Ogre::VertexBufferBinding::VertexBufferBindingMap &bindings = vertexData->vertexBufferBinding->getBindings();
+		vertexDataCopy->vertexBufferBinding->unsetAllBindings();
+		Ogre::VertexBufferBinding::VertexBufferBindingMap::const_iterator bindingIter;
+		for (bindingIter = bindings.begin(); bindingIter != bindings.end(); ++bindingIter)
+			vertexDataCopy->vertexBufferBinding->setBinding(bindingIter->first, bindingIter->second);
+		vertexDataCopy->vertexStart = vertexData->vertexStart;
+		vertexDataCopy->vertexCount = vertexData->vertexCount;
+
+		// shared hardware index buffer, the placeholder sections are built
+		// without indices, so the copy gets index data of its own that is
+		// released with the section
+		const bool useIndexes = renderOperation->useIndexes && renderOperation->indexData;
+		if (useIndexes) {
+			if (!renderOperationCopy->indexData)
+				renderOperationCopy->indexData = OGRE_NEW Ogre::IndexData();
+			renderOperationCopy->indexData->indexBuffer = renderOperation->indexData->indexBuffer;
+			renderOperationCopy->indexData->indexStart = renderOperation->indexData->indexStart;
+			renderOperationCopy->indexData->indexCount = renderOperation->indexData->indexCount;
+		}
+		else if (renderOperationCopy->indexData) {
+			renderOperationCopy->indexData->indexBuffer.setNull();
+			renderOperationCopy->indexData->indexCount = 0;
+		}
+		renderOperationCopy->useIndexes = useIndexes;
+	}
+
+	m_manualObject->setBoundingBox(manualObject->getBoundingBox());
+}
+
 ///
 /// Public Slots
 ///
@@ -592,19 +671,19 @@ void OgreContainer::updateBoneTransform ( const QString &name,
 	const float &tx, const float &ty, const float &tz, 
 	const float &rx, const float &ry, const float &rz )
 {
-    if (m_entity->hasSkeleton()) {
-        Ogre::SkeletonInstance *skeletonInstance = m_entity->getSkeleton();
-        if (skeletonInstance->hasBone(name.toStdString())) {
-            Ogre::Bone *bone = skeletonInstance->getBone(name.toStdString());
-            bone->setManuallyControlled(true);
-            bone->reset();
-            bone->translate(tx, ty, tz);
-            bone->rotate(Ogre::Vector3::UNIT_X, Ogre::Radian(rx));
-            bone->rotate(Ogre::Vector3::UNIT_Y, Ogre::Radian(ry));
-            bone->rotate(Ogre::Vector3::UNIT_Z, Ogre::Radian(rz));
-            emit boneTransformUpdated(name, tx, ty, tz, rx, ry, rz);
-        }
+    if (!sharesSkeletonWithSender()) {
+        Ogre::Bone *bone = getBone(name);
+        if (!bone)
+            return;
+
+        bone->setManuallyControlled(true);
+        bone->reset();
+        bone->translate(tx, ty, tz);
+        bone->rotate(Ogre::Vector3::UNIT_X, Ogre::Radian(rx));
+        bone->rotate(Ogre::Vector3::UNIT_Y, Ogre::Radian(ry));
+        bone->rotate(Ogre::Vector3::UNIT_Z, Ogre::Radian(rz));
     }
+    emit boneTransformUpdated(name, tx, ty, tz, rx, ry, rz);
 }
 
 //!
@@ -619,18 +698,17 @@ void OgreContainer::updateBoneTransform ( const QString &name,
     const Ogre::Vector3 position,
     const Ogre::Quaternion orientation )
 {
-    if (m_entity->hasSkeleton()) {
-        Ogre::SkeletonInstance *skeletonInstance = m_entity->getSkeleton();
-        if (skeletonInstance->hasBone(name.toStdString())) {
-            Ogre::Bone *bone = skeletonInstance->getBone(name.toStdString());
-            bone->setManuallyControlled(true);
-            bone->reset();
-            bone->setPosition(position);
-            bone->setOrientation(orientation);
+    if (!sharesSkeletonWithSender()) {
+        Ogre::Bone *bone = getBone(name);
+        if (!bone)
+            return;
 
-            emit boneTransformUpdated(name, position, orientation);
-        }
+        bone->setManuallyControlled(true);
+        bone->reset();
+        bone->setPosition(position);
+        bone->setOrientation(orientation);
     }
+    emit boneTransformUpdated(name, position, orientation);
 }
 
 //!
@@ -654,8 +732,17 @@ void OgreContainer::updateCustomParameter ( const QString &name,
 //!
 void OgreContainer::updateVertexBuffer ( ParameterGroup* vertexBufferGroup )
 {
-	if (!vertexBufferGroup)
+	if (!vertexBufferGroup || !m_manualObject)
+		return;
+
+	// copies render the buffers that have just been built by the container
+	// sending the update instead of building buffers of their own
+	OgreContainer *ogreContainer = dynamic_cast<OgreContainer *>(sender());
+	if (ogreContainer && ogreContainer->getManualObject()) {
+		shareVertexData(ogreContainer->getManualObject());
+		emit vertexBufferUpdated(vertexBufferGroup);
 		return;
+	}
 
 	m_manualObject->clear();
 	
@@ -684,90 +771,102 @@ void OgreContainer::updateVertexBuffer ( ParameterGroup* vertexBufferGroup )
 		materialGroupName = matGroupParameter->getValue().value<QString>();
 	}
 
-	m_manualObject->begin(materialName.toStdString(), renderOperation, materialGroupName.toStdString());
 	const int code = (bool) posParameter * 1 + 
 					 (bool) colParameter * 2 +
 					 (bool) normParameter * 4 + 
 					 (bool) uvParameter * 8;
 
-	switch (code){
-		case 1: {
-			const QVector<float> &posList = posParameter->getValue().value<QVector<float>>();
-			for(int i=0; i<posList.size(); i+=3) {
-				m_manualObject->position(
-					posList.at(i),
-					posList.at(i+1),
-					posList.at(i+2) );
-			}
-			break;
-		}
-		case 3: {
-			const QVector<float> &posList = posParameter->getValue().value<QVector<float>>();
-			const QVector<float> &colList = colParameter->getValue().value<QVector<float>>();
-			for(int i=0; i<posList.size(); i+=3) {
-				m_manualObject->position(
-					posList.at(i),
-					posList.at(i+1),
-					posList.at(i+2) );
-				m_manualObject->colour(
-					colList.at(i),
-					colList.at(i+1),
-					colList.at(i+2) );
-			}
-			break;
-		}
-		case 7: {
-			const QVector<float> &posList = posParameter->getValue().value<QVector<float>>();
-			const QVector<float> &colList = colParameter->getValue().value<QVector<float>>();
-			const QVector<float> &normList = normParameter->getValue().value<QVector<float>>();
-			for(int i=0; i<posList.size(); i+=3) {
-				m_manualObject->position(
-					posList.at(i),
-					posList.at(i+1),
-					posList.at(i+2) );
-				m_manualObject->colour(
-					colList.at(i),
-					colList.at(i+1),
-					colList.at(i+2) );
-				m_manualObject->normal(
-					normList.at(i),
-					normList.at(i+1),
-					normList.at(i+2));
-			}
-			break;
-		}
-		case 15: {
-			const QVector<float> &posList = posParameter->getValue().value<QVector<float>>();
-			const QVector<float> &colList = colParameter->getValue().value<QVector<float>>();
-			const QVector<float> &normList = normParameter->getValue().value<QVector<float>>();
-			const QVector<float> &uvList = uvParameter->getValue().value<QVector<float>>();
-			for(int i=0; i<posList.size(); i+=3) {
-				m_manualObject->position(
-					posList.at(i),
-					posList.at(i+1),
-					posList.at(i+2) );
-				m_manualObject->colour(
-					colList.at(i),
-					colList.at(i+1),
-					colList.at(i+2) );
-				m_manualObject->normal(
-					normList.at(i),
-					normList.at(i+1),
-					normList.at(i+2) );
-				m_manualObject->textureCoord(
-					uvList.at(i),
-					uvList.at(i+1),
-					uvList.at(i+2));
-			}
-			break;
-		}
-		default: {
-			Log::error(QString("Max supported attributes size is 4"), "OgreContainer::updateVertexBuffer");
-			break;
-		}
+	if (code != 1 && code != 3 && code != 7 && code != 15) {
+		Log::error(QString("Max supported attributes size is 4"), "OgreContainer::updateVertexBuffer");
+		return;
 	}
+
+	const QVector<float> posList = posParameter->getValue().value<QVector<float> >();
+	const QVector<float> colList = colParameter ? colParameter->getValue().value<QVector<float> >() : QVector<float>();
+	const QVector<float> normList = normParameter ? normParameter->getValue().value<QVector<float> >() : QVector<float>();
+	const QVector<float> uvList = uvParameter ? uvParameter->getValue().value<QVector<float> >() : QVector<float>();
+	if (((code & 2) && colList.size() < posList.size()) ||
+		((code & 4) && normList.size() < posList.size()) ||
+		((code & 8) && uvList.size() < posList.size())) {
+		Log::error(QString("The vertex attribute lists are shorter than the position list."), "OgreContainer::updateVertexBuffer");
+		return;
+	}
+
+	const float *pos = posList.constData();
+	const float *col = colList.constData();
+	const float *norm = normList.constData();
+	const float *uv = uvList.constData();
+
+	// allocate the vertex buffer once instead of growing it while adding vertices
+	m_manualObject->estimateVertexCount(posList.size() / 3);
+	m_manualObject->begin(materialName.toStdString(), renderOperation, materialGroupName.toStdString());
+
+	for (int i=0; i+2<posList.size(); i+=3) {
+		m_manualObject->position(pos[i], pos[i+1], pos[i+2]);
+		if (code & 2)
+			m_manualObject->colour(col[i], col[i+1], col[i+2]);
+		if (code & 4)
+			m_manualObject->normal(norm[i], norm[i+1], norm[i+2]);
+		if (code & 8)
+			m_manualObject->textureCoord(uv[i], uv[i+1], uv[i+2]);
+	}
+
 	m_manualObject->end();
 	emit vertexBufferUpdated(vertexBufferGroup);
 }
 
+///
+/// Private Functions
+///
+
+
+//!
+//! Returns the bone of the given name of the entity's skeleton. The bone
+//! handles are cached by name, so the name is only converted once.
+//!
+//! \param name The name of the bone.
+//! \return The bone, or 0 if the skeleton has no bone of the given name.
+//!
+Ogre::Bone * OgreContainer::getBone ( const QString &name )
+{
+    if (!m_entity || !m_entity->hasSkeleton())
+        return 0;
+
+    Ogre::SkeletonInstance *skeletonInstance = m_entity->getSkeleton();
+
+    // handles stay valid when the entity switches to a shared skeleton
+    // instance, all instances of a skeleton use the same bone handles
+    QHash<QString, unsigned short>::const_iterator handleIter = m_boneHandles.constFind(name);
+    if (handleIter != m_boneHandles.constEnd() && handleIter.value() < skeletonInstance->getNumBones())
+        return skeletonInstance->getBone(handleIter.value());
+
+    const Ogre::String boneName = name.toStdString();
+    if (!skeletonInstance->hasBone(boneName))
+        return 0;
+
+    Ogre::Bone *bone = skeletonInstance->getBone(boneName);
+    m_boneHandles.insert(name, bone->getHandle());
+    return bone;
+}
+
+
+//!
+//! Returns whether the object that sent the current signal is a container
+//! whose entity shares the skeleton instance of this container's entity.
+//! The pose has then already been applied to the shared bones.
+//!
+//! \return True if the sender shares the skeleton instance, otherwise false.
+//!
+bool OgreContainer::sharesSkeletonWithSender () const
+{
+    if (!m_entity || !m_entity->hasSkeleton())
+        return false;
+
+    const OgreContainer *ogreContainer = dynamic_cast<const OgreContainer *>(sender());
+    if (!ogreContainer || !ogreContainer->m_entity || !ogreContainer->m_entity->hasSkeleton())
+        return false;
+
+    return ogreContainer->m_entity->getSkeleton() == m_entity->getSkeleton();
+}
+
 } // end namespace Frapper
\ No newline at end of file
@@ -38,6 +38,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "ParameterGroup.h"
 #include "NumberParameter.h"
 #include <QtCore/QObject>
+#include <QtCore/QHash>
 #include "InstanceCounterMacros.h"
 #include <Ogre.h>
 #if (OGRE_PLATFORM  == OGRE_PLATFORM_WIN32)
@@ -258,6 +259,15 @@ public: // functions
     //!
     void updateCopies ( const QString &name, float &tx );
 
+    //!
+    //! Lets the manual object contained in this container render the vertex
+    //! and index buffers of the given manual object instead of holding
+    //! buffers of its own. Only the section layout is kept per copy.
+    //!
+    //! \param manualObject The manual object whose buffers to share.
+    //!
+    void shareVertexData ( Ogre::ManualObject *manualObject );
+
 
 signals: //
 
@@ -391,9 +401,30 @@ signals: //
 		//!
 		//! Updates the vertex buffers used by a manual object
 		//! Necessary to update all existing copys!
+		//! Copies connected to a container share its buffers instead of
+		//! rebuilding them from the parameter group.
 		//!
 		void updateVertexBuffer ( ParameterGroup* vertexBufferGroup );
 
+private: // functions
+
+    //!
+    //! Returns the bone of the given name of the entity's skeleton. The bone
+    //! handles are cached by name, so the name is only converted once.
+    //!
+    //! \param name The name of the bone.
+    //! \return The bone, or 0 if the skeleton has no bone of the given name.
+    //!
+    Ogre::Bone * getBone ( const QString &name );
+
+    //!
+    //! Returns whether the object that sent the current signal is a container
+    //! whose entity shares the skeleton instance of this container's entity.
+    //!
+    //! \return True if the sender shares the skeleton instance, otherwise false.
+    //!
+    bool sharesSkeletonWithSender () const;
+
 private: // data
 
     //!
@@ -431,6 +462,11 @@ private: // data
     //!
     unsigned int m_cameraHeight;
 
+    //!
+    //! Handles of the skeleton's bones by name.
+    //!
+    QHash<QString, unsigned short> m_boneHandles;
+
 };
 
 } // end namespace Frapper
@@ -109,7 +109,7 @@ void OgreManager::execConfigDialog ()
 //!
 //! Initializes private static data of the OgreManager
 //!
-void OgreManager::initialize ( const Ogre::String &pluginFileName /* = "config/plugins.cfg" */, const Ogre::String &configFileName /* = "config/ogre.cfg" */, const Ogre::String &resourceFileName /* = "config/resources.cfg" */, const Ogre::String &logFileName /* = "logs/ogre.log" */ )
+void OgreManager::initialize ( const Ogre::String &pluginFileName /* = "config/plugins.cfg" */, const Ogre::String &configFileName /* = "config/ogre.cfg" */, const Ogre::String &resourceFileName /* = "config/resources.cfg" */, const Ogre::String &logFileName /* = "logs/ogre.log" */, bool showConfigDialog /* = true */ )
 {
     QString adjustedPluginFileName (pluginFileName.c_str());
 #ifdef _DEBUG
@@ -138,7 +138,20 @@ void OgreManager::initialize ( const Ogre::String &pluginFileName /* = "config/p
     }
 
     // set up the OGRE render system
-    if (s_root && (s_root->restoreConfig() || s_root->showConfigDialog())) {
+    bool configured = s_root && s_root->restoreConfig();
+    if (s_root && !configured) {
+        if (showConfigDialog)
+            configured = s_root->showConfigDialog();
+        else {
+            // without a dialog use the first available render system with its default options
+            const Ogre::RenderSystemList &renderSystems = s_root->getAvailableRenderers();
+            if (!renderSystems.empty()) {
+                s_root->setRenderSystem(*renderSystems.begin());
+                configured = true;
+            }
+        }
+    }
+    if (configured) {
         // initialize the renderer, but don't create a render window yet (will be created later in ViewportWidget::createRenderWindow)
         //s_root->initialise(false);
         // create the main OGRE scene manager
@@ -146,14 +159,17 @@ void OgreManager::initialize ( const Ogre::String &pluginFileName /* = "config/p
     } else
         Log::error("The OGRE render system could not be set up.", "OgreManager::initialize");
 	
-	s_rendersystemName = s_root->getRenderSystem()->getName();
+	if (s_root && s_root->getRenderSystem())
+		s_rendersystemName = s_root->getRenderSystem()->getName();
 
     s_initialized = s_root && s_sceneManager;
 
 #if (OGRE_VERSION >= 0x010900)
 	// check for Ogre versions >= 1.9.0 to initialize overlay component
-	s_overlaySystem = OGRE_NEW Ogre::OverlaySystem();
-	s_sceneManager->addRenderQueueListener(s_overlaySystem);
+	if (s_initialized) {
+		s_overlaySystem = OGRE_NEW Ogre::OverlaySystem();
+		s_sceneManager->addRenderQueueListener(s_overlaySystem);
+	}
 #endif
 }
 
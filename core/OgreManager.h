@@ -83,7 +83,9 @@ public: // static functions
     //!
     //! Initializes private static data of the OgreManager.
     //!
-    static void initialize ( const Ogre::String &pluginFileName = "config/plugins.cfg", const Ogre::String &configFileName = "config/ogre.cfg", const Ogre::String &resourceFileName = "config/resources.cfg", const Ogre::String &logFileName = "logs/ogre.log" );
+    //! \param showConfigDialog Flag that controls whether the OGRE configuration dialog may be shown when no stored configuration is found. Headless applications pass false to fall back to the first available render system instead.
+    //!
+    static void initialize ( const Ogre::String &pluginFileName = "config/plugins.cfg", const Ogre::String &configFileName = "config/ogre.cfg", const Ogre::String &resourceFileName = "config/resources.cfg", const Ogre::String &logFileName = "logs/ogre.log", bool showConfigDialog = true );
 
     //!
     //! Frees all resources that were used by the OgreManager.
@@ -162,101 +162,11 @@ Ogre::MovableObject * OgreTools::cloneMovableObject ( Ogre::MovableObject *movab
 			// in case visibility has been changed in the original entity
 			manualObjCopy->setVisibilityFlags(manualObj->getVisibilityFlags());
 			
-			for (unsigned int i=0; i<manualObj->getNumSections(); ++i) {
-				Ogre::ManualObject::ManualObjectSection *section = manualObj->getSection(i);
-
-				Ogre::VertexData *vertexData = section->getRenderOperation()->vertexData;
-				
-				const size_t vertexElementCount = vertexData->vertexDeclaration->getElementCount();
-				const Ogre::String &materialName = section->getMaterialName();
-				const Ogre::RenderOperation::OperationType operationType = section->getRenderOperation()->operationType;
-				const Ogre::HardwareVertexBufferSharedPtr bufferPtr = vertexData->vertexBufferBinding->getBuffer(0);
-				
-				void* vertexBuffer0Data = bufferPtr->lock(Ogre::HardwareBuffer::HBL_READ_ONLY);
-				float* vertexBuffer0PosFloat = static_cast<float*>(vertexBuffer0Data);
-				Ogre::uchar* vertexBuffer0PosChar = static_cast<Ogre::uchar*>(vertexBuffer0Data);
-
-				manualObjCopy->begin(materialName, operationType);
-				switch (vertexElementCount) {
-					case 1: {
-						// getVertexSize is the size in bytes of the vertex. Vertex = 3 values * 4 bytes, but we need is just the number of values
-						for(int jf=0; jf<vertexData->vertexCount*(bufferPtr->getVertexSize()/4); jf+=3) {
-							float f1 = vertexBuffer0PosFloat[jf];
-							float f2 = vertexBuffer0PosFloat[jf+1];
-							float f3 = vertexBuffer0PosFloat[jf+2];
-							manualObjCopy->position(
-								vertexBuffer0PosFloat[jf],
-								vertexBuffer0PosFloat[jf+1],
-								vertexBuffer0PosFloat[jf+2] );
-						}
-						break;
-					}
-					case 2: {
-						for(int j=0, jf=0; j<vertexData->vertexCount*bufferPtr->getVertexSize()-16; j+=16, jf+=4) {
-							manualObjCopy->position(
-								vertexBuffer0PosFloat[jf],
-								vertexBuffer0PosFloat[jf+1],
-								vertexBuffer0PosFloat[jf+2] );
-							manualObjCopy->colour(
-								static_cast<float>(vertexBuffer0PosChar[j+12]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+13]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+14]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+15]/255.f) );
-						}
-						break;
-					}
-					case 3: {
-						for(int j=0, jf=0; j<vertexData->vertexCount*bufferPtr->getVertexSize()-28; j+=28, jf+=7) {
-							manualObjCopy->position(
-								vertexBuffer0PosFloat[jf],
-								vertexBuffer0PosFloat[jf+1],
-								vertexBuffer0PosFloat[jf+2] );
-							manualObjCopy->colour(
-								static_cast<float>(vertexBuffer0PosChar[j+12]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+13]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+14]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+15]/255.f) );
-							manualObjCopy->normal(
-								vertexBuffer0PosFloat[jf+4],
-								vertexBuffer0PosFloat[jf+5],
-								vertexBuffer0PosFloat[jf+6]);
-						}
-						break;
-					}
-					case 4: {
-						for(int j=0, jf=0; j<vertexData->vertexCount*bufferPtr->getVertexSize()-40; j+=40, jf+=10) {
-							manualObjCopy->position(
-								vertexBuffer0PosFloat[jf],
-								vertexBuffer0PosFloat[jf+1],
-								vertexBuffer0PosFloat[jf+2] );
-							manualObjCopy->normal(
-								vertexBuffer0PosFloat[jf+3],
-								vertexBuffer0PosFloat[jf+4],
-								vertexBuffer0PosFloat[jf+5]);
-							manualObjCopy->colour(
-								static_cast<float>(vertexBuffer0PosChar[j+12]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+13]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+14]/255.f),
-								static_cast<float>(vertexBuffer0PosChar[j+15]/255.f) );
-							manualObjCopy->textureCoord(
-								vertexBuffer0PosFloat[jf+7],
-								vertexBuffer0PosFloat[jf+8],
-								vertexBuffer0PosFloat[jf+9]);
-						}
-						break;
-					}
-					default: {
-						Log::error(QString("Max supported attributes size is 4"), "OgreTools::cloneMovableObject");
-						break;
-					}
-				}  // end switch block
-				manualObjCopy->end();
-				bufferPtr->unlock();
-			}
-
-			// create a new container for the cloned manual object
+			// create a new container for the cloned manual object, the copy
+			// renders the hardware buffers of the original object
 			OgreContainer *manualObjCopyContainer = new OgreContainer(manualObjCopy);
 			manualObjCopy->setUserAny(Ogre::Any(manualObjCopyContainer));
+			manualObjCopyContainer->shareVertexData(manualObj);
 
 			if (!manualObj->getUserAny().isEmpty()) 
             {
@@ -1033,36 +943,66 @@ void OgreTools::QImageToOgreTexture( const QImage &src, Ogre::TexturePtr& dst, c
 	}
 
 	HardwareBufferLocker hbl( dst->getBuffer(),  Ogre::HardwareBuffer::HBL_DISCARD);
+	copyQImageToPixelBox( src, src.rect(), hbl.getCurrentLock() );
+}
 
-	// buffer data
-	const Ogre::PixelBox &pixBox = hbl.getCurrentLock();
+void OgreTools::QImageToOgreTexture( const QImage &src, Ogre::TexturePtr& dst, const QRect &region )
+{
+	if (src.isNull() || dst.isNull())
+		return;
 
-	uchar* pixelData = static_cast<uchar*>(pixBox.data);
-	ulong pxDataIndex = 0;
-	ulong pxDataIndexStep = Ogre::PixelUtil::getNumElemBytes( format ); 
+	if( src.width() != dst->getWidth() || src.height() != dst->getHeight() ) {
+		QImageToOgreTexture( src, dst, dst->getFormat() );
+		return;
+	}
 
-	const uchar* qImageData = src.constBits();
-	ulong qxDataIndex = 0;
-	ulong qxDataIndexStep = 4;  // at least for QImage::Format_ARGB32..
+	if( ! (src.format() == QImage::Format_ARGB32 || src.format() == QImage::Format_ARGB32_Premultiplied )){
+		Frapper::Log::error(QString("Function currently only supports QImages of format QImage::Format_ARGB32!"), "OgreTools::QImageToOgreTexture");
+		return;
+	}
+
+	const QRect box = region.intersected( src.rect() );
+	if( box.isEmpty() )
+		return;
 
+	// lock only the region, so only the region is uploaded on unlock
+	Ogre::HardwarePixelBufferSharedPtr buffer = dst->getBuffer();
+	const Ogre::PixelBox &pixBox = buffer->lock( Ogre::Image::Box( box.left(), box.top(), box.right()+1, box.bottom()+1 ), Ogre::HardwareBuffer::HBL_NORMAL );
+	copyQImageToPixelBox( src, box, pixBox );
+	buffer->unlock();
+}
+
+void OgreTools::copyQImageToPixelBox( const QImage &src, const QRect &region, const Ogre::PixelBox &pixBox )
+{
+	const Ogre::PixelFormat format = pixBox.format;
+	const size_t pxDataIndexStep = Ogre::PixelUtil::getNumElemBytes( format );
+	const size_t rowPitch = pixBox.rowPitch * pxDataIndexStep;
+	uchar* pixelData = static_cast<uchar*>(pixBox.data);
 
 	// copy loops
-	for(uint y = 0; y < height; ++y) 
+	for( int y = 0; y < region.height(); ++y ) 
 	{
-		const QRgb* col = ( const QRgb*) src.scanLine(y);
+		const QRgb* col = ( const QRgb*) src.scanLine( region.top() + y ) + region.left();
+		uchar* row = pixelData + y * rowPitch;
 
-		for(uint x = 0; x < width; ++x) 
+		if( format == Ogre::PF_L8 ) // treat as mask
 		{
-			if( format == Ogre::PF_L8 ) // treat as mask
-			{
-				*(static_cast<Ogre::uint8*>(pixelData + pxDataIndex)) = static_cast<Ogre::uint8>( qGray(col[x]));
-			}
-			else // copy all available channels
+			for( int x = 0; x < region.width(); ++x )
+				row[x] = static_cast<Ogre::uint8>( qGray(col[x]) );
+		}
+		else if( format == Ogre::PF_A8R8G8B8 || format == Ogre::PF_X8R8G8B8 ) // same layout, opaque
+		{
+			Ogre::uint32* dstRow = reinterpret_cast<Ogre::uint32*>(row);
+			for( int x = 0; x < region.width(); ++x )
+				dstRow[x] = 0xFF000000 | (col[x] & 0x00FFFFFF);
+		}
+		else // copy all available channels
+		{
+			for( int x = 0; x < region.width(); ++x ) 
 			{
 				QColor qcolor = QColor::fromRgba(col[x]);
-				Ogre::PixelUtil::packColour( qcolor.redF(), qcolor.greenF(), qcolor.blueF(), 1.0f, format, static_cast<void*> (pixelData + pxDataIndex));
+				Ogre::PixelUtil::packColour( qcolor.redF(), qcolor.greenF(), qcolor.blueF(), 1.0f, format, static_cast<void*> (row + x * pxDataIndexStep));
 			}
-			pxDataIndex += pxDataIndexStep;
 		}
 	}
 }
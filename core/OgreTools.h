@@ -207,6 +207,13 @@ public: // static functions
     //!
     static void QImageToOgreTexture( const QImage &src, Ogre::TexturePtr& dst, const Ogre::PixelFormat& format = Ogre::PF_A8R8G8B8 );
 
+    //!
+    //! Copy a region of a QImage to the same region of an Ogre Texture. Only
+    //! the region is locked and uploaded. The texture is recreated by a full
+    //! copy if its size differs from the size of the image.
+    //!
+    static void QImageToOgreTexture( const QImage &src, Ogre::TexturePtr& dst, const QRect &region );
+
 public:
 	//! 
 	//! This class implements a locker for OgreHardwareBuffer
@@ -242,6 +249,12 @@ public:
 
 private: // static functions
 
+    //!
+    //! Converts a region of a QImage of format QImage::Format_ARGB32 into the
+    //! given locked pixel box, whose origin is the top left of the region.
+    //!
+    static void copyQImageToPixelBox( const QImage &src, const QRect &region, const Ogre::PixelBox &pixelBox );
+
     //!
     //! Returns the first movable object of the given type name contained in
     //! the given scene node.
@@ -40,6 +40,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "ParameterPlugin.h"
 #include "Node.h"
 #include "Log.h"
+#include "Profiler.h"
 #include <QColor>
 #include "MotionDataNode.h"
 #include <QFile>
@@ -73,6 +74,11 @@ INIT_INSTANCE_COUNTER(Parameter)
 /// Global Variables with File Scope
 ///
 
+//!
+//! Node name used when profiling parameters that do not belong to a node.
+//!
+static const QString NoNodeName;
+
 //!
 //! List of strings of names of parameter types.
 //!
@@ -839,6 +845,28 @@ Parameter * Parameter::createGroupParameter ( const QString &name, ParameterGrou
 }
 
 
+//!
+//! Sets the dirty flag for all parameters that are connected with and
+//! affected by the given parameters. Self-evaluating input parameters
+//! reached from several of them are evaluated once after all parameters
+//! have been dirtied.
+//!
+//! \param parameters The parameters whose dirty flag to propagate.
+//!
+void Parameter::propagateDirty ( const QList<Parameter *> &parameters )
+{
+    DeferredEvaluations deferredEvaluations;
+    foreach (Parameter *parameter, parameters)
+        parameter->propagateDirty(true, &deferredEvaluations);
+
+    foreach (Parameter *parameter, deferredEvaluations.parameters) {
+        parameter->propagateEvaluation();
+        if (parameter->isDirty())
+            emit parameter->dirtied();
+    }
+}
+
+
 ///
 /// Public Static Constants
 ///
@@ -869,7 +897,7 @@ const QString Parameter::PathSeparator = " > ";
 //!
 Parameter::Parameter ( const QString &name, Parameter::Type type, const QVariant &value ) :
 AbstractParameter(name),
-m_mutex(QMutex::Recursive),
+m_mutex(0),
 m_type(type),
 m_size((value.type() == QVariant::List) ? value.toList().size() : value.canConvert<Ogre::Vector3>() ? 3 : 1),
 m_multiplicity(1),
@@ -897,7 +925,7 @@ m_auxProcessingFunction("")
 //!
 Parameter::Parameter ( const Parameter &parameter, Node* node /*=0*/ ) :
 AbstractParameter(parameter, node),
-    m_mutex(QMutex::Recursive),
+    m_mutex(0),
     m_type(parameter.m_type),
     m_size(parameter.m_size),
     m_multiplicity(parameter.m_multiplicity),
@@ -947,6 +975,12 @@ Parameter::~Parameter ()
 		}
 	}
 
+#if QT_VERSION >= 0x050000
+    delete m_mutex.load();
+#else
+    delete (QMutex *) m_mutex;
+#endif
+
     DEC_INSTANCE_COUNTER
 }
 
@@ -1074,14 +1108,15 @@ int Parameter::getNumberOfConnections () const
 //!
 QVariant Parameter::getValue ( const bool triggerEvaluation /* = false */ ) 
 {
-	m_mutex.lock();
+	getMutex()->lock();
 
 	// optionally trigger the evaluation chain
 	if (triggerEvaluation && ( m_pinType == Parameter::PT_Output || m_pinType == Parameter::PT_Input) ) {
+		FRAPPER_PROFILE_SCOPE("evaluate", m_node ? m_node->getName() : NoNodeName, m_name)
 		propagateEvaluation();
 	}
 
-	m_mutex.unlock();
+	getMutex()->unlock();
 	return m_value;
 }
 
@@ -1097,12 +1132,13 @@ const QVariantList Parameter::getValues ( const bool triggerEvaluation /* = fals
 {
 	if (m_size > 1)
 	{
-		m_mutex.lock();
+		getMutex()->lock();
 		// optionally trigger the evaluation chain
 		if (triggerEvaluation && ( m_pinType == Parameter::PT_Output || m_pinType == Parameter::PT_Input) ) {
+			FRAPPER_PROFILE_SCOPE("evaluate", m_node ? m_node->getName() : NoNodeName, m_name)
 			propagateEvaluation();
 		}
-		m_mutex.unlock();
+		getMutex()->unlock();
 		if (m_value.canConvert<QVariantList>())
 			return m_value.toList();
 		else
@@ -1120,14 +1156,15 @@ const QVariantList Parameter::getValues ( const bool triggerEvaluation /* = fals
 //!
 const QVariantList &Parameter::getValueList (const bool triggerEvaluation /* = false */)
 {
-	m_mutex.lock();
+	getMutex()->lock();
 
 	// optionally trigger the evaluation chain
 	if (triggerEvaluation && ( m_pinType == Parameter::PT_Output || m_pinType == Parameter::PT_Input) ) {
+		FRAPPER_PROFILE_SCOPE("evaluate", m_node ? m_node->getName() : NoNodeName, m_name)
 		propagateEvaluation();
 	}
 
-	m_mutex.unlock();
+	getMutex()->unlock();
 
 	return m_valueList;
 }
@@ -1139,7 +1176,7 @@ const QVariantList &Parameter::getValueList (const bool triggerEvaluation /* = f
 //!
 void Parameter::setValue ( const QVariant &value, bool triggerDirtying /*= false*/ )
 {
-	m_mutex.lock();
+	getMutex()->lock();
 
     // check if the value has actually changed
     if (m_value != value) {
@@ -1151,7 +1188,7 @@ void Parameter::setValue ( const QVariant &value, bool triggerDirtying /*= false
 		if (triggerDirtying)
 			propagateDirty();
     }
-    m_mutex.unlock();
+    getMutex()->unlock();
 }
 
 
@@ -1163,7 +1200,7 @@ void Parameter::setValue ( const QVariant &value, bool triggerDirtying /*= false
 void Parameter::setValues ( const QVariantList &valueList, bool triggerDirtying /*= false*/ )
 {
 	if (valueList.size() > 1) {
-		m_mutex.lock();
+		getMutex()->lock();
 		QVariant value = QVariant(valueList);
 		// check if the value has actually changed
 		if (m_value != value) {
@@ -1176,7 +1213,7 @@ void Parameter::setValues ( const QVariantList &valueList, bool triggerDirtying
 			if (triggerDirtying)
 				propagateDirty();
 		}
-		m_mutex.unlock();
+		getMutex()->unlock();
 	}
 	else if (valueList.size() == 1)
 		setValue(valueList[0], triggerDirtying);
@@ -1193,7 +1230,7 @@ void Parameter::setValues ( const QVariantList &valueList, bool triggerDirtying
 //!
 void Parameter::setValue ( int index, const QVariant &value, bool triggerDirtying /*= false*/ )
 {
-    m_mutex.lock();
+    getMutex()->lock();
     if (m_value.type() != QVariant::List && !m_value.canConvert<Ogre::Vector3>()) {
         Log::error(QString("Parameter \"%1\" does not contain a list of values.").arg(m_name), "Parameter::setValue");
         return;
@@ -1240,7 +1277,7 @@ void Parameter::setValue ( int index, const QVariant &value, bool triggerDirtyin
 				propagateDirty();
         }
     }
-    m_mutex.unlock();
+    getMutex()->unlock();
 }
 
 
@@ -1534,7 +1571,7 @@ Parameter * Parameter::getConnectedParameter (const unsigned int position /*= 0*
 //!
 bool Parameter::isDirty ()
 {
-    QMutexLocker locker(&m_mutex);
+    QMutexLocker locker(getMutex());
     return m_dirty;
 }
 
@@ -1546,7 +1583,7 @@ bool Parameter::isDirty ()
 //!
 void Parameter::setDirty ( bool dirty )
 {
-    QMutexLocker locker(&m_mutex);
+    QMutexLocker locker(getMutex());
     m_dirty = dirty;
 }
 
@@ -1556,7 +1593,7 @@ void Parameter::setDirty ( bool dirty )
 //! \return The auxiliary dirty flag.
 //!
 bool Parameter::isAuxDirty () {
-    QMutexLocker locker(&m_mutex);
+    QMutexLocker locker(getMutex());
     return m_auxDirty;
 }
 
@@ -1566,7 +1603,7 @@ bool Parameter::isAuxDirty () {
 //! \param dirty The new value for the parameter auxiliary dirty flag.
 //!
 void Parameter::setAuxDirty ( bool dirty ) {
-    QMutexLocker locker(&m_mutex);
+    QMutexLocker locker(getMutex());
     m_auxDirty = dirty;
 }
 
@@ -1645,8 +1682,25 @@ bool Parameter::isSelfEvaluating () const
 //! \param callingNode The node calling this function.
 //!
 void Parameter::propagateDirty (bool setFirstTrue /* = true */)
+{
+    propagateDirty(setFirstTrue, 0);
+}
+
+//!
+//! Sets the dirty flag for all parameters that are connected with and
+//! affected by this parameter. Self-evaluating input parameters are added
+//! to the given deferred evaluations instead of being evaluated if that is
+//! not 0.
+//!
+//! \param setFirstTrue The dirty flag to set for this parameter.
+//! \param deferredEvaluations The inputs to evaluate later, or 0.
+//!
+void Parameter::propagateDirty ( bool setFirstTrue, DeferredEvaluations *deferredEvaluations )
 {
 	CREATE_EVAL_LOG("logs/eval_log.txt");
+	FRAPPER_PROFILE_SCOPE("dirty", m_node ? m_node->getName() : NoNodeName, m_name)
+
+    bool deferred = false;
 
     // Input parameter, that are self-evaluating, automatically trigger an evaluation of the whole chain at this point (HACK?)
     if (isSelfEvaluating() && getPinType() == PT_Input)
@@ -1654,10 +1708,18 @@ void Parameter::propagateDirty (bool setFirstTrue /* = true */)
 		// mark this parameter as dirty
 		setDirty(true);
 		WRITE_EVAL_LOG( this->toString() + ": Dirty = True\n" )
-		WRITE_EVAL_LOG( "Propagate Dirty -> Propagate Evaluation: " + this->toString() + "\n" )
-        propagateEvaluation();
 
-        // check if the parameter is still dirty and if so notify connected objects that it has been dirtied
+		// propagateDirty() for a list of parameters evaluates the parameter once at its end
+		if (deferredEvaluations) {
+			deferred = true;
+			if (!deferredEvaluations->contained.contains(this)) {
+				deferredEvaluations->contained.insert(this);
+				deferredEvaluations->parameters.append(this);
+			}
+		} else {
+			WRITE_EVAL_LOG( "Propagate Dirty -> Propagate Evaluation: " + this->toString() + "\n" )
+			propagateEvaluation();
+		}
     }
 	else {
 		WRITE_EVAL_LOG( this->toString() + ": Dirty = " + QString(setFirstTrue?"True":"False") + "\n" )
@@ -1665,7 +1727,7 @@ void Parameter::propagateDirty (bool setFirstTrue /* = true */)
 	}
 
     // check if the parameter is still dirty and if so notify connected objects that it has been dirtied
-    if (isDirty())
+    if (!deferred && isDirty())
         emit dirtied();
 
     if (m_pinType == PT_Output) 
@@ -1679,7 +1741,7 @@ void Parameter::propagateDirty (bool setFirstTrue /* = true */)
 				if( targetParameter)
 				{
 					WRITE_EVAL_LOG( "Propagate Dirty: " + this->toString() + " -> " + targetParameter->toString() + "\n")
-					targetParameter->propagateDirty();
+					targetParameter->propagateDirty(true, deferredEvaluations);
 				}
 			}
         }
@@ -1693,7 +1755,7 @@ void Parameter::propagateDirty (bool setFirstTrue /* = true */)
             if (parameter)
 			{
 				WRITE_EVAL_LOG( "Propagate Dirty: " + this->toString() + " -> " + parameter->toString() + "\n")
-				parameter->propagateDirty();
+				parameter->propagateDirty(true, deferredEvaluations);
 			}
         }
     }
@@ -1799,12 +1861,14 @@ void Parameter::propagateEvaluation ()
     //if (getPinType() == Parameter::PT_Output)
     if (isDirty()) {
 		WRITE_EVAL_LOG( "Processing Requested: " + this->toString() + "\n")
+		FRAPPER_PROFILE_SCOPE("process", m_node ? m_node->getName() : NoNodeName, m_name)
         emit processingRequested();
 	}
 		
 
     if (isAuxDirty()) {
 		WRITE_EVAL_LOG( "Aux Processing Requested: " + this->toString() + "\n")
+		FRAPPER_PROFILE_SCOPE("auxProcess", m_node ? m_node->getName() : NoNodeName, m_name)
 		emit auxProcessingRequested();
     }
     if (m_node)
@@ -2068,4 +2132,40 @@ const QString Parameter::toString() const
 		return m_name;
 }
 
+
+///
+/// Protected Functions
+///
+
+
+//!
+//! Returns the mutex of the parameter, creating it on first use, so
+//! that parameters whose values are never accessed do not allocate one.
+//!
+//! \return The recursive mutex of the parameter.
+//!
+QMutex * Parameter::getMutex ()
+{
+#if QT_VERSION >= 0x050000
+    QMutex *mutex = m_mutex.loadAcquire();
+#else
+    QMutex *mutex = m_mutex;
+#endif
+    if (!mutex) {
+        // another thread may create the mutex at the same time, the first one wins
+        QMutex *newMutex = new QMutex(QMutex::Recursive);
+        if (m_mutex.testAndSetOrdered(0, newMutex))
+            mutex = newMutex;
+        else {
+            delete newMutex;
+#if QT_VERSION >= 0x050000
+            mutex = m_mutex.loadAcquire();
+#else
+            mutex = m_mutex;
+#endif
+        }
+    }
+    return mutex;
+}
+
 } // end namespace Frapper
\ No newline at end of file
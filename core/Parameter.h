@@ -44,6 +44,8 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <QtXml/QDomElement>
 #include <QtCore/QStringList>
 #include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QAtomicPointer>
 #include "InstanceCounterMacros.h"
 
 // OGRE
@@ -270,6 +272,21 @@ namespace Frapper {
         //!
         static Parameter * createGroupParameter ( const QString &name, ParameterGroup *parameterGroup = 0 );
 
+        //!
+        //! Sets the dirty flag for all parameters that are connected with and
+        //! affected by the given parameters. Self-evaluating input parameters
+        //! reached from several of them are evaluated once after all
+        //! parameters have been dirtied.
+        //!
+        //! Unlike propagateDirty() for a single parameter, which evaluates a
+        //! self-evaluating input as soon as the dirty flag reaches it, the
+        //! inputs are evaluated in the order they were reached after the
+        //! whole dirty pass, and dirtied() is emitted for them afterwards.
+        //!
+        //! \param parameters The parameters whose dirty flag to propagate.
+        //!
+        static void propagateDirty ( const QList<Parameter *> &parameters );
+
     public: // static data
 
         //!
@@ -819,6 +836,42 @@ signals: // signals
 		void connectionDestroyed(int id = -1);
 
 
+    protected: // functions
+
+        //!
+        //! Returns the mutex of the parameter, creating it on first use, so
+        //! that parameters whose values are never accessed do not allocate one.
+        //!
+        //! \return The recursive mutex of the parameter.
+        //!
+        QMutex * getMutex ();
+
+    private: // type definitions
+
+        //!
+        //! The self-evaluating input parameters whose evaluation is deferred
+        //! by propagateDirty() for a list of parameters, in the order they
+        //! were reached.
+        //!
+        struct DeferredEvaluations
+        {
+            QList<Parameter *> parameters;
+            QSet<Parameter *> contained;
+        };
+
+    private: // functions
+
+        //!
+        //! Sets the dirty flag for all parameters that are connected with and
+        //! affected by this parameter. Self-evaluating input parameters are
+        //! added to the given deferred evaluations instead of being evaluated
+        //! if that is not 0.
+        //!
+        //! \param setFirstTrue The dirty flag to set for this parameter.
+        //! \param deferredEvaluations The inputs to evaluate later, or 0.
+        //!
+        void propagateDirty ( bool setFirstTrue, DeferredEvaluations *deferredEvaluations );
+
     protected: // data
 
 		//!
@@ -849,9 +902,9 @@ signals: // signals
         bool m_selfEvaluating;
 
         //!
-        //! Mutex for threaded programming.
+        //! Mutex for threaded programming, created on first use.
         //!
-        QMutex m_mutex;
+        QAtomicPointer<QMutex> m_mutex;
 
         //!
         //! The type of the parameter's value.
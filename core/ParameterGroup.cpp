@@ -65,10 +65,22 @@ ParameterGroup::ParameterGroup ( const ParameterGroup &parameterGroup, Node* nod
 {
 	INC_INSTANCE_COUNTER
 
-	QList<AbstractParameter*> list = parameterGroup.m_parameterList;
+	// the prototype list already has its final order and unique names, so
+	// the clones are appended directly instead of searching for an insert
+	// position per parameter in addParameter()
+	const AbstractParameter::List &list = parameterGroup.m_parameterList;
+	Q_ASSERT(list.size() == parameterGroup.m_parameterMap.size());
+	m_parameterList.reserve(list.size());
+	m_parameterMap.reserve(list.size());
 	foreach(AbstractParameter* param, list) {
-		this->setNode(node);
-		this->addParameter(param->clone());
+		AbstractParameter *clonedParameter = param->clone();
+		Q_ASSERT(!m_parameterMap.contains(clonedParameter->getName()));
+		m_parameterList.append(clonedParameter);
+		m_parameterMap.insert(clonedParameter->getName(), clonedParameter);
+		if (m_node)
+			clonedParameter->setNode(m_node);
+		if (!m_enabled)
+			clonedParameter->setEnabled(false);
 	}
 }
 
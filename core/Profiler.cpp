@@ -0,0 +1,395 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "Profiler.cpp"
+//! \brief Implementation file for Profiler class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "Profiler.h"
+#include "Log.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtCore/QThreadStorage>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVector>
+#include <QtCore/QHash>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+#include <algorithm>
+
+namespace Frapper {
+
+///
+/// Macro Definitions
+///
+
+//!
+//! The maximum number of events kept per thread, further events are dropped.
+//!
+#define MAX_EVENTS_PER_THREAD (1 << 20)
+
+
+///
+/// Local Type Definitions
+///
+
+//!
+//! The events recorded by a single thread. Buffers are never deleted while
+//! the application runs, so the events of finished threads can still be
+//! exported.
+//!
+struct ThreadBuffer
+{
+    QMutex mutex;
+    QVector<Profiler::Event> events;
+    int dropped;
+    int index;
+    QString threadName;
+};
+
+//!
+//! Per-thread handle to the buffer of the thread. The handle is deleted
+//! when the thread finishes, the buffer itself is kept.
+//!
+struct ThreadBufferHandle
+{
+    ThreadBuffer *buffer;
+};
+
+
+///
+/// Global Variables with File Scope
+///
+
+static QMutex s_buffersMutex;
+static QList<ThreadBuffer *> s_buffers;
+static QThreadStorage<ThreadBufferHandle *> s_threadBuffer;
+static QElapsedTimer s_timer;
+
+
+///
+/// Local Functions
+///
+
+//!
+//! Returns the event buffer of the calling thread, creating it on first use.
+//!
+static ThreadBuffer * getThreadBuffer ()
+{
+    if (!s_threadBuffer.hasLocalData()) {
+        ThreadBufferHandle *handle = new ThreadBufferHandle();
+        handle->buffer = new ThreadBuffer();
+        handle->buffer->dropped = 0;
+
+        QThread *thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+            handle->buffer->threadName = "Main Thread";
+        else
+            handle->buffer->threadName = thread->objectName();
+
+        QMutexLocker locker (&s_buffersMutex);
+        handle->buffer->index = s_buffers.size() + 1;
+        if (handle->buffer->threadName.isEmpty())
+            handle->buffer->threadName = QString("Thread %1").arg(handle->buffer->index);
+        s_buffers.append(handle->buffer);
+        s_threadBuffer.setLocalData(handle);
+    }
+    return s_threadBuffer.localData()->buffer;
+}
+
+
+//!
+//! Returns the given string escaped for use in a JSON string literal.
+//!
+static QString escapeJson ( const QString &text )
+{
+    QString result;
+    result.reserve(text.size());
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (c == '"' || c == '\\')
+            result += QString("\\") + c;
+        else if (c.unicode() < 0x20)
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        else
+            result += c;
+    }
+    return result;
+}
+
+
+//!
+//! Orders events by start time with enclosing events first.
+//!
+static bool eventLessThan ( const Profiler::Event &first, const Profiler::Event &second )
+{
+    if (first.start != second.start)
+        return first.start < second.start;
+    return first.duration > second.duration;
+}
+
+
+//!
+//! Orders node statistics by descending self time.
+//!
+static bool statisticsGreaterThan ( const Profiler::NodeStatistics &first, const Profiler::NodeStatistics &second )
+{
+    return first.selfTime > second.selfTime;
+}
+
+
+///
+/// Static Data
+///
+
+volatile bool Profiler::s_enabled = false;
+
+volatile int Profiler::s_frame = 0;
+
+
+///
+/// Public Static Functions
+///
+
+
+//!
+//! Starts or stops recording events.
+//!
+//! \param enabled The new recording state.
+//!
+void Profiler::setEnabled ( bool enabled )
+{
+    if (enabled && !s_timer.isValid())
+        s_timer.start();
+
+    s_enabled = enabled;
+}
+
+
+//!
+//! Returns the time since the profiler was started.
+//!
+//! \return The time in microseconds.
+//!
+qint64 Profiler::getTime ()
+{
+    return s_timer.isValid() ? s_timer.nsecsElapsed() / 1000 : 0;
+}
+
+
+//!
+//! Adds an event to the buffer of the calling thread.
+//!
+//! \param category The static category name of the event.
+//! \param nodeName The name of the node the event belongs to.
+//! \param name The name of the event.
+//! \param start The start time in microseconds.
+//! \param duration The duration in microseconds.
+//!
+void Profiler::addEvent ( const char *category, const QString &nodeName, const QString &name, qint64 start, qint64 duration )
+{
+    ThreadBuffer *buffer = getThreadBuffer();
+
+    // the lock is only contended while the events are collected for export
+    QMutexLocker locker (&buffer->mutex);
+    if (buffer->events.size() >= MAX_EVENTS_PER_THREAD) {
+        ++buffer->dropped;
+        return;
+    }
+
+    Event event;
+    event.category = category;
+    event.nodeName = nodeName;
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    event.frame = s_frame;
+    buffer->events.append(event);
+}
+
+
+//!
+//! Drops all recorded events.
+//!
+void Profiler::clear ()
+{
+    QMutexLocker locker (&s_buffersMutex);
+    foreach (ThreadBuffer *buffer, s_buffers) {
+        QMutexLocker bufferLocker (&buffer->mutex);
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+}
+
+
+//!
+//! Returns the number of recorded events.
+//!
+//! \return The number of events in all thread buffers.
+//!
+int Profiler::getEventCount ()
+{
+    int result = 0;
+    QMutexLocker locker (&s_buffersMutex);
+    foreach (ThreadBuffer *buffer, s_buffers) {
+        QMutexLocker bufferLocker (&buffer->mutex);
+        result += buffer->events.size();
+    }
+    return result;
+}
+
+
+//!
+//! Returns the number of events that were dropped because a thread
+//! buffer was full.
+//!
+//! \return The number of dropped events.
+//!
+int Profiler::getDroppedEventCount ()
+{
+    int result = 0;
+    QMutexLocker locker (&s_buffersMutex);
+    foreach (ThreadBuffer *buffer, s_buffers) {
+        QMutexLocker bufferLocker (&buffer->mutex);
+        result += buffer->dropped;
+    }
+    return result;
+}
+
+
+//!
+//! Returns the accumulated timing of all nodes, hottest nodes first.
+//!
+//! The self time of an event is its duration minus the durations of the
+//! events nested in it on the same thread, so upstream nodes evaluated from
+//! within a processing function are not counted twice.
+//!
+//! \return The statistics sorted by descending self time.
+//!
+QList<Profiler::NodeStatistics> Profiler::getNodeStatistics ()
+{
+    QHash<QString, NodeStatistics> statisticsMap;
+
+    QMutexLocker locker (&s_buffersMutex);
+    foreach (ThreadBuffer *buffer, s_buffers) {
+        buffer->mutex.lock();
+        QVector<Event> events = buffer->events;
+        buffer->mutex.unlock();
+
+        std::sort(events.begin(), events.end(), eventLessThan);
+
+        // stack of indices of the enclosing events and their accumulated child time
+        QVector<int> stack;
+        QVector<qint64> childTime (events.size(), 0);
+        for (int i = 0; i <= events.size(); ++i) {
+            // close all events that end before the current one starts
+            while (!stack.isEmpty()) {
+                const Event &enclosing = events.at(stack.last());
+                if (i < events.size() && events.at(i).start < enclosing.start + enclosing.duration)
+                    break;
+
+                const int index = stack.last();
+                stack.pop_back();
+                if (!stack.isEmpty())
+                    childTime[stack.last()] += enclosing.duration;
+
+                if (enclosing.nodeName.isEmpty())
+                    continue;
+
+                NodeStatistics &statistics = statisticsMap[enclosing.nodeName];
+                if (statistics.nodeName.isEmpty()) {
+                    statistics.nodeName = enclosing.nodeName;
+                    statistics.calls = 0;
+                    statistics.selfTime = 0;
+                    statistics.maxTime = 0;
+                }
+                if (qstrcmp(enclosing.category, "process") == 0)
+                    ++statistics.calls;
+                statistics.selfTime += qMax(qint64(0), enclosing.duration - childTime.at(index));
+                statistics.maxTime = qMax(statistics.maxTime, enclosing.duration);
+            }
+            if (i < events.size())
+                stack.append(i);
+        }
+    }
+
+    QList<NodeStatistics> result = statisticsMap.values();
+    std::sort(result.begin(), result.end(), statisticsGreaterThan);
+    return result;
+}
+
+
+//!
+//! Writes all recorded events to the given file in Chrome trace format.
+//!
+//! \param filename The name of the JSON file to write.
+//! \return True if the file was written, otherwise False.
+//!
+bool Profiler::writeChromeTrace ( const QString &filename )
+{
+    QFile file (filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        Log::error(QString("The file \"%1\" could not be opened for writing.").arg(filename), "Profiler::writeChromeTrace");
+        return false;
+    }
+
+    QTextStream stream (&file);
+    stream.setCodec("UTF-8");
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    QMutexLocker locker (&s_buffersMutex);
+    foreach (ThreadBuffer *buffer, s_buffers) {
+        buffer->mutex.lock();
+        const QVector<Event> events = buffer->events;
+        buffer->mutex.unlock();
+
+        if (!first)
+            stream << ",\n";
+        first = false;
+        stream << QString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%1,\"args\":{\"name\":\"%2\"}}")
+            .arg(buffer->index).arg(escapeJson(buffer->threadName));
+
+        for (int i = 0; i < events.size(); ++i) {
+            const Event &event = events.at(i);
+            const QString name = event.nodeName.isEmpty() ? event.name : event.nodeName + "." + event.name;
+            stream << ",\n" << QString("{\"name\":\"%1\",\"cat\":\"%2\",\"ph\":\"X\",\"ts\":%3,\"dur\":%4,\"pid\":1,\"tid\":%5,\"args\":{\"node\":\"%6\",\"frame\":%7}}")
+                .arg(escapeJson(name)).arg(event.category).arg(event.start).arg(event.duration)
+                .arg(buffer->index).arg(escapeJson(event.nodeName)).arg(event.frame);
+        }
+    }
+
+    stream << "\n]}\n";
+    stream.flush();
+    file.close();
+
+    return file.error() == QFile::NoError;
+}
+
+} // end namespace Frapper
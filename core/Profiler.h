@@ -0,0 +1,248 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "Profiler.h"
+//! \brief Header file for Profiler class.
+//!
+//! The profiler times processing function calls, dirty propagation and
+//! texture uploads per node and per frame. Events are recorded into one
+//! buffer per thread and can be exported as Chrome trace JSON (load the file
+//! in chrome://tracing or ui.perfetto.dev). While recording is disabled an
+//! instrumented scope only costs a single flag test.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "FrapperPrerequisites.h"
+#include <QtCore/QString>
+#include <QtCore/QList>
+
+
+//!
+//! Records the enclosing scope as an event of the given category if the
+//! profiler is enabled. The node and event names are only evaluated while
+//! recording and must stay valid until the end of the scope.
+//!
+#define FRAPPER_PROFILE_SCOPE(category, nodeName, name) \
+    Frapper::ProfileScope profileScope (category); \
+    if (profileScope.isActive()) \
+        profileScope.describe(nodeName, name);
+
+
+namespace Frapper {
+
+//!
+//! Static class collecting timed evaluation events.
+//!
+class FRAPPER_CORE_EXPORT Profiler
+{
+
+public: // nested type definitions
+
+    //!
+    //! A single timed event.
+    //!
+    struct Event
+    {
+        const char *category;   //!< static category name, e.g. "process"
+        QString nodeName;       //!< name of the node the event belongs to
+        QString name;           //!< name of the event, e.g. the parameter name
+        qint64 start;           //!< start time in microseconds since the profiler was started
+        qint64 duration;        //!< duration in microseconds
+        int frame;              //!< scene frame the event was recorded in
+    };
+
+    //!
+    //! Accumulated timing of a single node.
+    //!
+    struct NodeStatistics
+    {
+        QString nodeName;       //!< name of the node
+        int calls;              //!< number of processing calls
+        qint64 selfTime;        //!< time spent in the node without nested events, in microseconds
+        qint64 maxTime;         //!< duration of the longest single event, in microseconds
+    };
+
+public: // static functions
+
+    //!
+    //! Returns whether events are recorded.
+    //!
+    //! \return True if the profiler is recording, otherwise False.
+    //!
+    static inline bool isEnabled () { return s_enabled; }
+
+    //!
+    //! Starts or stops recording events.
+    //!
+    //! \param enabled The new recording state.
+    //!
+    static void setEnabled ( bool enabled );
+
+    //!
+    //! Sets the scene frame subsequent events are recorded for.
+    //!
+    //! \param index The index of the current frame.
+    //!
+    static inline void setFrame ( int index ) { s_frame = index; }
+
+    //!
+    //! Returns the time since the profiler was started.
+    //!
+    //! \return The time in microseconds.
+    //!
+    static qint64 getTime ();
+
+    //!
+    //! Adds an event to the buffer of the calling thread.
+    //!
+    //! \param category The static category name of the event.
+    //! \param nodeName The name of the node the event belongs to.
+    //! \param name The name of the event.
+    //! \param start The start time in microseconds.
+    //! \param duration The duration in microseconds.
+    //!
+    static void addEvent ( const char *category, const QString &nodeName, const QString &name, qint64 start, qint64 duration );
+
+    //!
+    //! Drops all recorded events.
+    //!
+    static void clear ();
+
+    //!
+    //! Returns the number of recorded events.
+    //!
+    //! \return The number of events in all thread buffers.
+    //!
+    static int getEventCount ();
+
+    //!
+    //! Returns the number of events that were dropped because a thread
+    //! buffer was full.
+    //!
+    //! \return The number of dropped events.
+    //!
+    static int getDroppedEventCount ();
+
+    //!
+    //! Returns the accumulated timing of all nodes, hottest nodes first.
+    //!
+    //! \return The statistics sorted by descending self time.
+    //!
+    static QList<NodeStatistics> getNodeStatistics ();
+
+    //!
+    //! Writes all recorded events to the given file in Chrome trace format.
+    //!
+    //! \param filename The name of the JSON file to write.
+    //! \return True if the file was written, otherwise False.
+    //!
+    static bool writeChromeTrace ( const QString &filename );
+
+private: // static data
+
+    //!
+    //! Flag that states whether events are recorded.
+    //!
+    static volatile bool s_enabled;
+
+    //!
+    //! The scene frame events are currently recorded for.
+    //!
+    static volatile int s_frame;
+};
+
+
+//!
+//! Helper class timing the scope it lives in. Use the FRAPPER_PROFILE_SCOPE
+//! macro instead of creating instances directly.
+//!
+class FRAPPER_CORE_EXPORT ProfileScope
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the ProfileScope class.
+    //!
+    //! \param category The static category name of the event.
+    //!
+    inline ProfileScope ( const char *category ) :
+        m_category(0),
+        m_start(0),
+        m_nodeName(0),
+        m_name(0)
+    {
+        if (Profiler::isEnabled()) {
+            m_category = category;
+            m_start = Profiler::getTime();
+        }
+    }
+
+    //!
+    //! Destructor of the ProfileScope class.
+    //!
+    inline ~ProfileScope ()
+    {
+        if (m_name)
+            Profiler::addEvent(m_category, *m_nodeName, *m_name, m_start, Profiler::getTime() - m_start);
+    }
+
+public: // functions
+
+    //!
+    //! Returns whether the scope is being recorded.
+    //!
+    //! \return True if the scope is recorded, otherwise False.
+    //!
+    inline bool isActive () const { return m_category != 0; }
+
+    //!
+    //! Sets the node and event names of the recorded scope. The names are
+    //! referenced, not copied, so no string is touched while not recording.
+    //!
+    //! \param nodeName The name of the node the event belongs to.
+    //! \param name The name of the event.
+    //!
+    inline void describe ( const QString &nodeName, const QString &name )
+    {
+        m_nodeName = &nodeName;
+        m_name = &name;
+    }
+
+private: // data
+
+    const char *m_category;
+    qint64 m_start;
+    const QString *m_nodeName;
+    const QString *m_name;
+};
+
+} // end namespace Frapper
+
+#endif
@@ -38,6 +38,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "RenderNode.h"
 #include "OgreManager.h"
 #include "Log.h"
+#include "Profiler.h"
 #include <QItemSelection>
 #include <QProgressDialog>
 #include <QFileDialog>
@@ -976,18 +977,16 @@ QString SceneModel::createObject ( const QString &typeName, const QString &name
     QString nodeName (name);
     if (nodeName == "") {
         // find a name for the node
-        QStringList nodeNames = m_nodeModel->getNodeNames();
         nodeName = QString("%1%2").arg(typeName[0].toLower()).arg(typeName.mid(1));
         int index = 2;
-        while (nodeNames.contains(nodeName))
+        while (m_nodeModel->getNode(nodeName))
             nodeName = QString("%1%2%3").arg(typeName[0].toLower()).arg(typeName.mid(1)).arg(index++);
     } 
 	else {
-		QStringList nodeNames = m_nodeModel->getNodeNames();
 		//nodeName = QString("%1%2").arg(nodeName[0].toLower()).arg(nodeName.mid(1));
 		nodeName = QString("%1%2").arg(nodeName[0]).arg(nodeName.mid(1));
 		int index = 2;
-		while (nodeNames.contains(nodeName))
+		while (m_nodeModel->getNode(nodeName))
 			nodeName = QString("%1%2").arg(nodeName.left(nodeName.indexOf(QRegExp("[0-9]")))).arg(index++);
 	}
 
@@ -1123,10 +1122,9 @@ void  SceneModel::backDrop (const QString name /* = "" */, const QPointF positio
 
 	if (nodeName == "") {
 		// find a name for the node
-		QStringList nodeNames = m_nodeModel->getNodeNames();
 		nodeName = QString("%1%2").arg(typeName[0].toLower()).arg(typeName.mid(1));
 		int index = 2;
-		while (nodeNames.contains(nodeName))
+		while (m_nodeModel->getNode(nodeName))
 			nodeName = QString("%1%2%3").arg(typeName[0].toLower()).arg(typeName.mid(1)).arg(index++);
 	} else {
 		// check if a node of the given name already exists
@@ -2217,6 +2215,7 @@ inline void SceneModel::setCurrentFrame ( int index, bool realtime /* = false */
     if (!realtime && index == m_frameParameter->getValue().toInt())
         return;
 
+    Profiler::setFrame(index);
     m_frameParameter->setValue(index);
     m_frameParameter->propagateDirty();
 
@@ -2237,6 +2236,18 @@ void SceneModel::updateFrame ()
 }
 
 
+//!
+//! Sets the current frame and propagates the frame change through the
+//! network right away, without any playback pacing.
+//!
+//! \param index The index of the frame to step to.
+//!
+void SceneModel::stepFrame ( int index )
+{
+    setCurrentFrame(index, true);
+}
+
+
 //!
 //! Sets the index of the start frame in the scene's time.
 //!
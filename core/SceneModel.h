@@ -266,6 +266,15 @@ public: // functions
     //!
     int getOutFrame () const;
 
+    //!
+    //! Sets the current frame and propagates the frame change through the
+    //! network right away, without any playback pacing. Used by applications
+    //! that step through the scene's frames in batch mode.
+    //!
+    //! \param index The index of the frame to step to.
+    //!
+    void stepFrame ( int index );
+
     //!
     //! Creates the OGRE scene root scene node.
     //!
@@ -0,0 +1,300 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "SkeletonPose.cpp"
+//! \brief Implementation file for SkeletonPose class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "SkeletonPose.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Frapper {
+
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the SkeletonPose class.
+//!
+SkeletonPose::SkeletonPose ()
+{
+}
+
+
+//!
+//! Destructor of the SkeletonPose class.
+//!
+SkeletonPose::~SkeletonPose ()
+{
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Sets the handles of the bones held by the pose. The transforms are
+//! reset to the identity. The memory of the pose is kept when the
+//! number of bones shrinks.
+//!
+//! \param handles The bone handles.
+//!
+void SkeletonPose::setHandles ( const std::vector<unsigned short> &handles )
+{
+    m_handles.assign(handles.begin(), handles.end());
+    resize(m_handles.size());
+
+    std::fill(m_positionX.begin(), m_positionX.end(), 0.0f);
+    std::fill(m_positionY.begin(), m_positionY.end(), 0.0f);
+    std::fill(m_positionZ.begin(), m_positionZ.end(), 0.0f);
+    std::fill(m_orientationW.begin(), m_orientationW.end(), 1.0f);
+    std::fill(m_orientationX.begin(), m_orientationX.end(), 0.0f);
+    std::fill(m_orientationY.begin(), m_orientationY.end(), 0.0f);
+    std::fill(m_orientationZ.begin(), m_orientationZ.end(), 0.0f);
+}
+
+
+//!
+//! Returns the handles of the bones held by the pose.
+//!
+//! \return The bone handles.
+//!
+const std::vector<unsigned short> & SkeletonPose::getHandles () const
+{
+    return m_handles;
+}
+
+
+//!
+//! Returns the number of bones held by the pose.
+//!
+//! \return The number of bones.
+//!
+size_t SkeletonPose::getSize () const
+{
+    return m_handles.size();
+}
+
+
+//!
+//! Returns whether the pose holds no bones.
+//!
+//! \return True if the pose is empty, otherwise False.
+//!
+bool SkeletonPose::isEmpty () const
+{
+    return m_handles.empty();
+}
+
+
+//!
+//! Removes all bones from the pose.
+//!
+void SkeletonPose::clear ()
+{
+    m_handles.clear();
+    resize(0);
+}
+
+
+//!
+//! Sets the transform of the bone with the given index.
+//!
+//! \param index The index of the bone in the pose.
+//! \param position The position of the bone.
+//! \param orientation The orientation of the bone.
+//!
+void SkeletonPose::setTransform ( size_t index, const Ogre::Vector3 &position, const Ogre::Quaternion &orientation )
+{
+    m_positionX[index] = position.x;
+    m_positionY[index] = position.y;
+    m_positionZ[index] = position.z;
+    m_orientationW[index] = orientation.w;
+    m_orientationX[index] = orientation.x;
+    m_orientationY[index] = orientation.y;
+    m_orientationZ[index] = orientation.z;
+}
+
+
+//!
+//! Returns the position of the bone with the given index.
+//!
+//! \param index The index of the bone in the pose.
+//! \return The position of the bone.
+//!
+Ogre::Vector3 SkeletonPose::getPosition ( size_t index ) const
+{
+    return Ogre::Vector3(m_positionX[index], m_positionY[index], m_positionZ[index]);
+}
+
+
+//!
+//! Returns the orientation of the bone with the given index.
+//!
+//! \param index The index of the bone in the pose.
+//! \return The orientation of the bone.
+//!
+Ogre::Quaternion SkeletonPose::getOrientation ( size_t index ) const
+{
+    return Ogre::Quaternion(m_orientationW[index], m_orientationX[index], m_orientationY[index], m_orientationZ[index]);
+}
+
+
+//!
+//! Reads the current transforms of the pose's bones from the given
+//! skeleton instance.
+//!
+//! \param skeletonInstance The skeleton instance to read from.
+//!
+void SkeletonPose::capture ( const Ogre::SkeletonInstance *skeletonInstance )
+{
+    if (!skeletonInstance)
+        return;
+
+    const unsigned short numBones = skeletonInstance->getNumBones();
+    const size_t size = m_handles.size();
+    for (size_t i = 0; i < size; ++i) {
+        if (m_handles[i] >= numBones)
+            continue;
+        const Ogre::Bone *bone = skeletonInstance->getBone(m_handles[i]);
+        setTransform(i, bone->getPosition(), bone->getOrientation());
+    }
+}
+
+
+//!
+//! Sets the transforms of the pose's bones of the given skeleton instance.
+//!
+//! \param skeletonInstance The skeleton instance to modify.
+//!
+void SkeletonPose::apply ( Ogre::SkeletonInstance *skeletonInstance ) const
+{
+    if (!skeletonInstance)
+        return;
+
+    const unsigned short numBones = skeletonInstance->getNumBones();
+    const size_t size = m_handles.size();
+    for (size_t i = 0; i < size; ++i) {
+        if (m_handles[i] >= numBones)
+            continue;
+        Ogre::Bone *bone = skeletonInstance->getBone(m_handles[i]);
+        bone->setPosition(m_positionX[i], m_positionY[i], m_positionZ[i]);
+        bone->setOrientation(m_orientationW[i], m_orientationX[i], m_orientationY[i], m_orientationZ[i]);
+    }
+}
+
+
+//!
+//! Blends two poses of the same bones: positions are interpolated
+//! linearly, orientations are normalized-lerped along the shortest path
+//! (like Ogre::Quaternion::nlerp). The result may be one of the inputs.
+//!
+//! \param from The pose at alpha 0.
+//! \param to The pose at alpha 1.
+//! \param alpha The blend factor.
+//! \param result The pose receiving the blended transforms.
+//!
+void SkeletonPose::blend ( const SkeletonPose &from, const SkeletonPose &to, float alpha, SkeletonPose &result )
+{
+    const size_t size = std::min(from.getSize(), to.getSize());
+    if (&result != &from) {
+        result.m_handles.assign(from.m_handles.begin(), from.m_handles.begin() + size);
+        result.resize(size);
+    }
+    if (size == 0)
+        return;
+
+    const Ogre::Real *fpx = &from.m_positionX[0];
+    const Ogre::Real *fpy = &from.m_positionY[0];
+    const Ogre::Real *fpz = &from.m_positionZ[0];
+    const Ogre::Real *fqw = &from.m_orientationW[0];
+    const Ogre::Real *fqx = &from.m_orientationX[0];
+    const Ogre::Real *fqy = &from.m_orientationY[0];
+    const Ogre::Real *fqz = &from.m_orientationZ[0];
+    const Ogre::Real *tpx = &to.m_positionX[0];
+    const Ogre::Real *tpy = &to.m_positionY[0];
+    const Ogre::Real *tpz = &to.m_positionZ[0];
+    const Ogre::Real *tqw = &to.m_orientationW[0];
+    const Ogre::Real *tqx = &to.m_orientationX[0];
+    const Ogre::Real *tqy = &to.m_orientationY[0];
+    const Ogre::Real *tqz = &to.m_orientationZ[0];
+    Ogre::Real *rpx = &result.m_positionX[0];
+    Ogre::Real *rpy = &result.m_positionY[0];
+    Ogre::Real *rpz = &result.m_positionZ[0];
+    Ogre::Real *rqw = &result.m_orientationW[0];
+    Ogre::Real *rqx = &result.m_orientationX[0];
+    Ogre::Real *rqy = &result.m_orientationY[0];
+    Ogre::Real *rqz = &result.m_orientationZ[0];
+
+    for (size_t i = 0; i < size; ++i) {
+        rpx[i] = fpx[i] + alpha * (tpx[i] - fpx[i]);
+        rpy[i] = fpy[i] + alpha * (tpy[i] - fpy[i]);
+        rpz[i] = fpz[i] + alpha * (tpz[i] - fpz[i]);
+
+        // take the shortest path by flipping the target orientation
+        const Ogre::Real dot = fqw[i] * tqw[i] + fqx[i] * tqx[i] + fqy[i] * tqy[i] + fqz[i] * tqz[i];
+        const Ogre::Real sign = dot < 0.0f ? -1.0f : 1.0f;
+        const Ogre::Real w = fqw[i] + alpha * (sign * tqw[i] - fqw[i]);
+        const Ogre::Real x = fqx[i] + alpha * (sign * tqx[i] - fqx[i]);
+        const Ogre::Real y = fqy[i] + alpha * (sign * tqy[i] - fqy[i]);
+        const Ogre::Real z = fqz[i] + alpha * (sign * tqz[i] - fqz[i]);
+        const Ogre::Real length = std::sqrt(w * w + x * x + y * y + z * z);
+        const Ogre::Real scale = length > 0.0f ? 1.0f / length : 0.0f;
+        rqw[i] = w * scale;
+        rqx[i] = x * scale;
+        rqy[i] = y * scale;
+        rqz[i] = z * scale;
+    }
+}
+
+
+///
+/// Private Functions
+///
+
+
+//!
+//! Resizes the component arrays to the given number of bones.
+//!
+void SkeletonPose::resize ( size_t size )
+{
+    m_positionX.resize(size);
+    m_positionY.resize(size);
+    m_positionZ.resize(size);
+    m_orientationW.resize(size);
+    m_orientationX.resize(size);
+    m_orientationY.resize(size);
+    m_orientationZ.resize(size);
+}
+
+} // end namespace Frapper
@@ -0,0 +1,187 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "SkeletonPose.h"
+//! \brief Header file for SkeletonPose class.
+//!
+//! A skeleton pose holds the positions and orientations of a set of bones,
+//! addressed by bone handles that are resolved once per skeleton. The
+//! components are stored as packed arrays, so poses can be blended in a
+//! single pass and read from or applied to a skeleton in bulk.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef SKELETONPOSE_H
+#define SKELETONPOSE_H
+
+#include "FrapperPrerequisites.h"
+#include <Ogre.h>
+#include <vector>
+
+
+namespace Frapper {
+
+//!
+//! Class representing the local transforms of a set of bones.
+//!
+class FRAPPER_CORE_EXPORT SkeletonPose
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the SkeletonPose class.
+    //!
+    SkeletonPose ();
+
+    //!
+    //! Destructor of the SkeletonPose class.
+    //!
+    ~SkeletonPose ();
+
+public: // functions
+
+    //!
+    //! Sets the handles of the bones held by the pose. The transforms are
+    //! reset to the identity. The memory of the pose is kept when the
+    //! number of bones shrinks.
+    //!
+    //! \param handles The bone handles.
+    //!
+    void setHandles ( const std::vector<unsigned short> &handles );
+
+    //!
+    //! Returns the handles of the bones held by the pose.
+    //!
+    //! \return The bone handles.
+    //!
+    const std::vector<unsigned short> & getHandles () const;
+
+    //!
+    //! Returns the number of bones held by the pose.
+    //!
+    //! \return The number of bones.
+    //!
+    size_t getSize () const;
+
+    //!
+    //! Returns whether the pose holds no bones.
+    //!
+    //! \return True if the pose is empty, otherwise False.
+    //!
+    bool isEmpty () const;
+
+    //!
+    //! Removes all bones from the pose.
+    //!
+    void clear ();
+
+    //!
+    //! Sets the transform of the bone with the given index.
+    //!
+    //! \param index The index of the bone in the pose.
+    //! \param position The position of the bone.
+    //! \param orientation The orientation of the bone.
+    //!
+    void setTransform ( size_t index, const Ogre::Vector3 &position, const Ogre::Quaternion &orientation );
+
+    //!
+    //! Returns the position of the bone with the given index.
+    //!
+    //! \param index The index of the bone in the pose.
+    //! \return The position of the bone.
+    //!
+    Ogre::Vector3 getPosition ( size_t index ) const;
+
+    //!
+    //! Returns the orientation of the bone with the given index.
+    //!
+    //! \param index The index of the bone in the pose.
+    //! \return The orientation of the bone.
+    //!
+    Ogre::Quaternion getOrientation ( size_t index ) const;
+
+    //!
+    //! Reads the current transforms of the pose's bones from the given
+    //! skeleton instance.
+    //!
+    //! \param skeletonInstance The skeleton instance to read from.
+    //!
+    void capture ( const Ogre::SkeletonInstance *skeletonInstance );
+
+    //!
+    //! Sets the transforms of the pose's bones of the given skeleton instance.
+    //!
+    //! \param skeletonInstance The skeleton instance to modify.
+    //!
+    void apply ( Ogre::SkeletonInstance *skeletonInstance ) const;
+
+    //!
+    //! Blends two poses of the same bones: positions are interpolated
+    //! linearly, orientations are normalized-lerped along the shortest path
+    //! (like Ogre::Quaternion::nlerp). The result may be one of the inputs.
+    //!
+    //! \param from The pose at alpha 0.
+    //! \param to The pose at alpha 1.
+    //! \param alpha The blend factor.
+    //! \param result The pose receiving the blended transforms.
+    //!
+    static void blend ( const SkeletonPose &from, const SkeletonPose &to, float alpha, SkeletonPose &result );
+
+private: // functions
+
+    //!
+    //! Resizes the component arrays to the given number of bones.
+    //!
+    void resize ( size_t size );
+
+private: // data
+
+    //!
+    //! The handles of the bones.
+    //!
+    std::vector<unsigned short> m_handles;
+
+    //!
+    //! The bone positions, one array per component.
+    //!
+    std::vector<Ogre::Real> m_positionX;
+    std::vector<Ogre::Real> m_positionY;
+    std::vector<Ogre::Real> m_positionZ;
+
+    //!
+    //! The bone orientations, one array per component.
+    //!
+    std::vector<Ogre::Real> m_orientationW;
+    std::vector<Ogre::Real> m_orientationX;
+    std::vector<Ogre::Real> m_orientationY;
+    std::vector<Ogre::Real> m_orientationZ;
+
+};
+
+} // end namespace Frapper
+
+#endif
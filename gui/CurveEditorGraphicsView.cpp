@@ -33,6 +33,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //!
 
 #include "CurveEditorGraphicsView.h"
+#include "CurveGraphicsItem.h"
 #include "SegmentGraphicsItem.h"
 #include "KeyGraphicsItem.h"
 #include "NumberParameter.h"
@@ -45,6 +46,12 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #define scenescale 5
 #define collumns 10 
 
+//!
+//! The min distance of key items in pixels, keys are not editable if they
+//! are denser at the current zoom level.
+//!
+#define minKeyItemDistance 5
+
 
 namespace Frapper {
 
@@ -183,6 +190,7 @@ void CurveEditorGraphicsView::mouseMoveEvent ( QMouseEvent * event )
 				else
 					(dy < 0) ? scale(1.0, 1.01) : scale(1.0, 0.99);
 				m_lastPosition = event->pos();
+				updateHandles();
 			}
 		}
 	}
@@ -221,6 +229,18 @@ void CurveEditorGraphicsView::mousePressEvent ( QMouseEvent *event )
 }
 
 
+//!
+//! Event handler for mouse release events.
+//!
+//! \param event The description of the mouse event.
+//!
+void CurveEditorGraphicsView::mouseReleaseEvent ( QMouseEvent *event )
+{
+	BaseGraphicsView::mouseReleaseEvent(event);
+	updateHandles();
+}
+
+
 //!
 //! The overwritten the event handler for resize events.
 //! Adds scene resizing and redrawing.
@@ -286,6 +306,21 @@ void CurveEditorGraphicsView::drawBackground (QPainter *painter, const QRectF &r
 }
 
 
+//!
+//! The overwritten handler for scrolling the view.
+//! Creates the key items of keys scrolled into the view.
+//!
+//! \param dx The horizontal scroll distance.
+//! \param dy The vertical scroll distance.
+//!
+void CurveEditorGraphicsView::scrollContentsBy ( int dx, int dy )
+{
+	BaseGraphicsView::scrollContentsBy(dx, dy);
+	if (dx != 0)
+		updateHandles();
+}
+
+
 ///
 /// Public Slots
 ///
@@ -353,27 +388,20 @@ void CurveEditorGraphicsView::toggleShowEnabledOnly( bool enabled )
 //!
 void CurveEditorGraphicsView::buildScene ()
 {
-    // local variable definitions
-    float keyPosX, keyPosY;
-	QVariant data;
 	QColor curveColor;
-	Key::KeyType preKeyType = Key::KT_Linear;
     unsigned int index = 0;
-    KeyGraphicsItem *keyItem = 0;
-    KeyGraphicsItem *preKey = 0;
-	TangentGraphicsItem *tangentItem = 0;
-	TangentGraphicsItem *preTan = 0;
-	SegmentGraphicsItem *segmentItem = 0;
-	//const QList<Key> *keys;
 
     // offset and scale for curve drawing
     const float yOffset = scene()->height() / 2.0f;
 	const float rescale = 1.0f / matrix().m11();
-    
+
 	// remove all items from scene	
 	scene()->clear();
+	m_curveItems.clear();
+
+	m_scaleFactor.setWidth((float) width() / (float) (m_outFrame-m_inFrame));
 
-    // iterate over axes
+    // one curve item per parameter, key items are created for the visible keys only
     foreach (NumberParameter *numberParameter, m_numberParametersToDraw) {
         switch (index) {
             case 0:
@@ -389,66 +417,68 @@ void CurveEditorGraphicsView::buildScene ()
                 curveColor = QColor(Qt::darkGray);
         }
 
-        const QList<Key> &keys = numberParameter->getKeys();
-        preKey = preTan = 0;
-
-        // iterate through keys
-        foreach (const Key &key, keys) {
-			// get data and calulate positions in scene
-			data = QVariant::fromValue<Key*>(const_cast<Key *>(&key));
-			keyPosX = key.index * m_scaleFactor.width();
-			keyPosY = yOffset - key.keyValue.toFloat() * m_scaleFactor.height();
-
-			// add key item
-			keyItem  = new KeyGraphicsItem(m_scaleFactor, keyPosX);
-			scene()->addItem(keyItem);
-			keyItem->setPos(keyPosX, keyPosY);
-			keyItem->setScale(rescale);
-			keyItem->setData(0, data);
-						
-			// add segment items
-			segmentItem = new SegmentGraphicsItem(preKey, keyItem, preKeyType, curveColor);
-			segmentItem->setWidth(rescale);
-			scene()->addItem(segmentItem);
-
-			if (preTan && (preTan->getMaxX() > keyPosX)) {
-				preTan->setMaxX(keyPosX);
-				preTan = 0;
-			}
-
-			// add tangent items with handles
-			if (key.type == Key::KT_Bezier)
-			{
-				tangentItem = new TangentGraphicsItem(keyItem, m_scaleFactor, keyPosX);
-				scene()->addItem(tangentItem);
-				tangentItem->setPos(
-					key.tangentIndex * m_scaleFactor.width(), 
-					yOffset - key.tangentValue * m_scaleFactor.height());
-				tangentItem->setScale(rescale);
-				tangentItem->setData(0, data);
-				
-				if (preKey)
-					tangentItem->setMaxX((2.0f*keyPosX - preKey->pos().x()));
-			
-				segmentItem = new SegmentGraphicsItem(keyItem, tangentItem);
-				segmentItem->setWidth(rescale);
-				scene()->addItem(segmentItem);
-				preTan = tangentItem;
-			}
-            
-			// store previous items
-			preKeyType = key.type;
-			preKey = keyItem;
-		}
+        CurveGraphicsItem *curveItem = new CurveGraphicsItem(numberParameter, m_scaleFactor, yOffset, curveColor);
+        scene()->addItem(curveItem);
+        m_curveItems.append(curveItem);
+        connect(numberParameter, SIGNAL(keysChanged()), SLOT(updateParameterKeys()), Qt::UniqueConnection);
         ++index;
 	}
 
     // adding the timeline widget
-	m_scaleFactor.setWidth((float) width() / (float) (m_outFrame-m_inFrame));
     m_timeline = new TimelineGraphicsItem(height()*scenescale);
 	m_timeline->setPos(m_timelinePos, 0);
 	m_timeline->setWidth(rescale);
     scene()->addItem(m_timeline);
+
+	updateHandles();
+}
+
+
+//!
+//! Returns the keys of the selected key items or all keys of the shown
+//! curves if no key item is selected.
+//!
+//! \return The keys to edit.
+//!
+QHash<NumberParameter *, QList<int> > CurveEditorGraphicsView::getSelectedKeyIndices () const
+{
+	QHash<NumberParameter *, QList<int> > keyIndices;
+
+	const QList<QGraphicsItem *> &selectedItems = scene()->selectedItems();
+	foreach (QGraphicsItem *item, selectedItems) {
+		KeyGraphicsItem *keyItem = dynamic_cast<KeyGraphicsItem *>(item);
+		if (keyItem && !dynamic_cast<TangentGraphicsItem *>(item) && keyItem->getCurveItem())
+			keyIndices[keyItem->getCurveItem()->getNumberParameter()].append(keyItem->getKeyIndex());
+	}
+
+	if (keyIndices.isEmpty()) {
+		foreach (CurveGraphicsItem *curveItem, m_curveItems) {
+			NumberParameter *numberParameter = curveItem->getNumberParameter();
+			QList<int> &indices = keyIndices[numberParameter];
+			for (int i = 0; i < numberParameter->numKeys(); ++i)
+				indices.append(i);
+		}
+	}
+	else {
+		// the bulk key functions expect sorted indices
+		for (QHash<NumberParameter *, QList<int> >::iterator iter = keyIndices.begin(); iter != keyIndices.end(); ++iter)
+			qSort(iter.value());
+	}
+	return keyIndices;
+}
+
+
+//!
+//! Updates the curve and key items of the number parameter whose keys
+//! were edited by one of its bulk key functions.
+//!
+void CurveEditorGraphicsView::updateParameterKeys ()
+{
+	// parameters stay connected after their curves were hidden
+	const NumberParameter *numberParameter = static_cast<NumberParameter *>(sender());
+	foreach (CurveGraphicsItem *curveItem, m_curveItems)
+		if (curveItem->getNumberParameter() == numberParameter)
+			curveItem->updateKeys();
 }
 
 //!
@@ -495,6 +525,9 @@ void CurveEditorGraphicsView::scaleSceneItems ( const float value )
 {
 	SegmentGraphicsItem *segmentItem;
 	const float scale = 1.0f/value;
+
+	updateHandles();
+
 	const QList<QGraphicsItem *> &itemList = scene()->items();
 	foreach(QGraphicsItem *item, itemList) {
 		if (item->isVisible())
@@ -524,4 +557,21 @@ void CurveEditorGraphicsView::emitSelectedKeyTypeChanged ( )
 	}
 }
 
-} // end namespace Frapper
\ No newline at end of file
+//!
+//! Creates the key items for the keys visible at the current zoom level.
+//!
+void CurveEditorGraphicsView::updateHandles ()
+{
+	// don't delete key items while they are dragged
+	if (QApplication::mouseButtons() & Qt::LeftButton)
+		return;
+
+	const QRectF visibleRect = mapToScene(viewport()->rect()).boundingRect();
+	const int maxHandles = viewport()->width() / minKeyItemDistance;
+	const float rescale = 1.0f / matrix().m11();
+
+	foreach (CurveGraphicsItem *curveItem, m_curveItems)
+		curveItem->updateHandles(visibleRect, maxHandles, rescale);
+}
+
+} // end namespace Frapper
@@ -45,6 +45,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <QPainter>
 #include <QpainterPath>
 #include <QtCore/QPointF>
+#include <QtCore/QHash>
 #include <QTreeWidget>
 
 
@@ -70,6 +71,7 @@ namespace Frapper {
 //!
 
 class KeyGraphicsItem;
+class CurveGraphicsItem;
 
 class FRAPPER_GUI_EXPORT CurveEditorGraphicsView : public BaseGraphicsView
 {
@@ -131,6 +133,14 @@ public: // functions
 	//!
 	void setOutFrame ( const int index );
 
+	//!
+	//! Returns the sorted key indices of the selected key items per number
+	//! parameter or all keys of the shown curves if no key item is selected.
+	//!
+	//! \return The indices of the keys to edit per number parameter.
+	//!
+	QHash<NumberParameter *, QList<int> > getSelectedKeyIndices () const;
+
 
 public slots: //
 
@@ -158,6 +168,14 @@ public slots: //
     //!
 	void toggleShowEnabledOnly( bool enabled );
 
+private slots: //
+
+	//!
+	//! Updates the curve and key items of the number parameter whose keys
+	//! were edited by one of its bulk key functions.
+	//!
+	void updateParameterKeys ();
+
 signals:
 	//!
 	//! Signal that is emitted when a drag event is emited
@@ -198,6 +216,13 @@ protected: // event handlers
 	//!
 	virtual void mousePressEvent ( QMouseEvent *event );
 
+	//!
+	//! Event handler for mouse release events.
+	//!
+	//! \param event The description of the mouse event.
+	//!
+	virtual void mouseReleaseEvent ( QMouseEvent *event );
+
 
     //!
     //! The overwritten the event handler for resize events.
@@ -216,6 +241,15 @@ protected: // event handlers
     //!
     virtual void drawBackground (QPainter *painter, const QRectF &rect);
 
+    //!
+    //! The overwritten handler for scrolling the view.
+    //! Creates the key items of keys scrolled into the view.
+    //!
+    //! \param dx The horizontal scroll distance.
+    //! \param dy The vertical scroll distance.
+    //!
+    virtual void scrollContentsBy ( int dx, int dy );
+
 protected: // functions
 	//!
 	//! Event handler for mouse wheel events.
@@ -238,6 +272,11 @@ private: // functions
 	//!
 	void emitSelectedKeyTypeChanged ( );
 
+	//!
+	//! Creates the key items for the keys visible at the current zoom level.
+	//!
+	void updateHandles ();
+
 public: // data
 	//!
     //! The current scene scale.
@@ -280,6 +319,11 @@ private: // data
     //!
     QList<NumberParameter *> m_numberParametersToDraw;
 
+    //!
+    //! The curve items of the drawn number parameters.
+    //!
+    QList<CurveGraphicsItem *> m_curveItems;
+
     //!
     //! The timeleine widget.
     //!
@@ -288,23 +288,12 @@ void CurveEditorPanel::setOutFrame ( const int index )
 //!
 void CurveEditorPanel::changeKeyValues ()
 {
-	QList<QGraphicsItem *> &selectedItems = m_curveEditorGraphicsView->scene()->selectedItems();
-	const double value = m_valueSpinBox->value();
-	
-	if (selectedItems.empty())
-		selectedItems = m_curveEditorGraphicsView->scene()->items();
-	
-	const float sceneScale = m_curveEditorGraphicsView->m_scaleFactor.height();
-
-	foreach (QGraphicsItem *item, selectedItems) {
-		KeyGraphicsItem *keyItem = dynamic_cast<KeyGraphicsItem *>(item);
-		if (keyItem) {
-			Key *key = item->data(0).value<Key *>();
-			key->keyValue.setValue(static_cast<float>(value));
-			const float newPosY = m_curveEditorGraphicsView->scene()->height() / 2.0f - value * sceneScale;
-			keyItem->setPos(keyItem->x(),newPosY);
-		}
-	}
+	const QHash<NumberParameter *, QList<int> > keyIndices = m_curveEditorGraphicsView->getSelectedKeyIndices();
+	const float value = static_cast<float>(m_valueSpinBox->value());
+
+	for (QHash<NumberParameter *, QList<int> >::const_iterator iter = keyIndices.constBegin(); iter != keyIndices.constEnd(); ++iter)
+		iter.key()->setKeyValues(iter.value(), value);
+
 	emit drag();
 }
 
@@ -314,24 +303,12 @@ void CurveEditorPanel::changeKeyValues ()
 //!
 void CurveEditorPanel::scaleKeyValues ()
 {
-	QList<QGraphicsItem *> &selectedItems = m_curveEditorGraphicsView->scene()->selectedItems();
-	const double scale = m_scaleSpinBox->value();
-	
-	if (selectedItems.empty())
-		selectedItems = m_curveEditorGraphicsView->scene()->items();
-	
-	const float sceneScale = m_curveEditorGraphicsView->m_scaleFactor.height();
-
-	foreach (QGraphicsItem *item, selectedItems) {
-		KeyGraphicsItem *keyItem = dynamic_cast<KeyGraphicsItem *>(item);
-		if (keyItem) {
-			Key *key = item->data(0).value<Key *>();
-			const float keyValue = key->keyValue.toFloat();
-			key->keyValue.setValue<float>(keyValue * scale);
-			const float newPosY = m_curveEditorGraphicsView->scene()->height() / 2.0f - (keyValue * scale) * sceneScale;
-			keyItem->setPos(keyItem->x(),newPosY);
-		}
-	}
+	const QHash<NumberParameter *, QList<int> > keyIndices = m_curveEditorGraphicsView->getSelectedKeyIndices();
+	const float scale = static_cast<float>(m_scaleSpinBox->value());
+
+	for (QHash<NumberParameter *, QList<int> >::const_iterator iter = keyIndices.constBegin(); iter != keyIndices.constEnd(); ++iter)
+		iter.key()->transformKeyValues(iter.value(), scale);
+
 	emit drag();
 }
 
@@ -341,42 +318,21 @@ void CurveEditorPanel::scaleKeyValues ()
 //!
 void CurveEditorPanel::normalizeKeyValues ()
 {
-#ifdef __GNUC__
-float max = -HUGE_VAL;
-#else
-float max = -HUGE;
-#endif
-	
-	const double scale = m_normalizeSpinBox->value();
-	const float sceneScale = m_curveEditorGraphicsView->m_scaleFactor.height();
-	QList<QGraphicsItem *> &items = m_curveEditorGraphicsView->scene()->selectedItems();
-
-	if (items.empty())
-		items = m_curveEditorGraphicsView->scene()->items();
-
-	// find max value
-	foreach (QGraphicsItem *item, items) {
-		const KeyGraphicsItem *keyItem = dynamic_cast<KeyGraphicsItem *>(item);
-		if (keyItem) {
-			const Key *key = item->data(0).value<Key *>();
-			const float keyValue = abs(key->keyValue.toFloat());
-			if (keyValue > max)
-				max = keyValue;
-		}
-	}
+	const QHash<NumberParameter *, QList<int> > keyIndices = m_curveEditorGraphicsView->getSelectedKeyIndices();
+	const float scale = static_cast<float>(m_normalizeSpinBox->value());
+
+	// find the max absolute value over all edited keys
+	float max = 0.0f;
+	for (QHash<NumberParameter *, QList<int> >::const_iterator iter = keyIndices.constBegin(); iter != keyIndices.constEnd(); ++iter)
+		max = qMax(max, iter.key()->getMaxAbsKeyValue(iter.value()));
+
+	if (max == 0.0f)
+		return;
+
+	// scale values
+	for (QHash<NumberParameter *, QList<int> >::const_iterator iter = keyIndices.constBegin(); iter != keyIndices.constEnd(); ++iter)
+		iter.key()->transformKeyValues(iter.value(), scale / max);
 
-	// scale values and move objects to new position
-	foreach (QGraphicsItem *item, items) {
-		KeyGraphicsItem *keyItem = dynamic_cast<KeyGraphicsItem *>(item);
-		if (keyItem) {
-			Key *key = item->data(0).value<Key *>();
-			const float keyValue = key->keyValue.toFloat();
-			key->keyValue = static_cast<float>(keyValue / max * scale);
-			keyItem = static_cast<KeyGraphicsItem *>(item);
-			const float newPosY = m_curveEditorGraphicsView->scene()->height() / 2.0f - (keyValue / max*scale) * sceneScale;
-			keyItem->setPos(keyItem->x(),newPosY);
-		}
-	}
 	emit drag();
 }
 
@@ -536,16 +492,19 @@ void CurveEditorPanel::deleteSelectedKeys()
 	QList<QGraphicsItem *> &selectedItems = m_curveEditorGraphicsView->scene()->selectedItems();
 	
 	if (!selectedItems.empty()) {
+		// collect the keys per parameter to remove them in one pass each
+		QHash<NumberParameter *, QList<Key *> > keys;
 		foreach (QGraphicsItem *item, selectedItems) {
 			if (dynamic_cast<TangentGraphicsItem *>(item))
 				continue;
 			KeyGraphicsItem *keyItem = dynamic_cast<KeyGraphicsItem *>(item);
 			if (keyItem) {
 				Key *key = item->data(0).value<Key *>();
-				NumberParameter *numberParameter = static_cast<NumberParameter *>(key->parent);
-				numberParameter->removeKey(*key);
+				keys[static_cast<NumberParameter *>(key->parent)].append(key);
 			}
 		}
+		for (QHash<NumberParameter *, QList<Key *> >::const_iterator iter = keys.constBegin(); iter != keys.constEnd(); ++iter)
+			iter.key()->removeKeys(iter.key()->getKeyIndices(iter.value()));
 		showCurves();
 	}
 }
@@ -0,0 +1,435 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "CurveGraphicsItem.cpp"
+//! \brief Implementation file for CurveGraphicsItem class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "CurveGraphicsItem.h"
+#include "KeyGraphicsItem.h"
+#include "SegmentGraphicsItem.h"
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QPainterPath>
+#include <QStyleOptionGraphicsItem>
+#include <QtCore/QSet>
+#include <cmath>
+
+
+namespace Frapper {
+
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the CurveGraphicsItem class.
+//!
+//! \param numberParameter The animated number parameter to display.
+//! \param scale The scene scale of frames and values.
+//! \param yOffset The scene y coordinate of the value 0.
+//! \param color The color to use for the curve.
+//!
+CurveGraphicsItem::CurveGraphicsItem ( NumberParameter *numberParameter, const QSizeF &scale, const float yOffset, const QColor &color ) :
+    m_numberParameter(numberParameter),
+    m_scale(scale),
+    m_yOffset(yOffset),
+    m_color(color),
+    m_firstHandle(0),
+    m_lastHandle(0)
+{
+    setAcceptedMouseButtons(0);
+    setFlag(ItemIsMovable, false);
+    setFlag(ItemIsSelectable, false);
+    setFlag(ItemUsesExtendedStyleOption);
+    setZValue(0);
+
+    updateKeys();
+}
+
+
+//!
+//! Destructor of the CurveGraphicsItem class.
+//!
+//! The handles are scene items and are deleted with the scene.
+//!
+CurveGraphicsItem::~CurveGraphicsItem ()
+{
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Returns the number parameter displayed by the curve item.
+//!
+//! \return The number parameter displayed by the curve item.
+//!
+NumberParameter * CurveGraphicsItem::getNumberParameter () const
+{
+    return m_numberParameter;
+}
+
+
+//!
+//! Recalculates the scene positions of all keys and moves the existing
+//! handles to them. Must be called after key values were changed
+//! directly.
+//!
+void CurveGraphicsItem::updateKeys ()
+{
+    const QList<Key> &keys = m_numberParameter->getKeys();
+    const int numKeys = keys.size();
+
+    // handles refer to key indices, drop them if keys were added or removed
+    if (numKeys != m_points.size())
+        clearHandles();
+
+    m_points.resize(numKeys);
+    m_tangents.resize(numKeys);
+    m_types.resize(numKeys);
+
+    prepareGeometryChange();
+    m_bounds = numKeys > 0 ? QRectF(keyPosition(keys.first()), QSizeF(0.0, 0.0)) : QRectF();
+    for (int i = 0; i < numKeys; ++i) {
+        const Key &key = keys.at(i);
+        m_points[i] = keyPosition(key);
+        m_tangents[i] = tangentPosition(key);
+        m_types[i] = key.type;
+        extendBounds(m_points[i]);
+        if (key.type == Key::KT_Bezier) {
+            extendBounds(m_tangents[i]);
+            extendBounds(m_points[i]*2.0f - m_tangents[i]);
+        }
+    }
+
+    // move the existing handles, tangents follow their keys
+    foreach (KeyGraphicsItem *keyItem, m_keyItems)
+        keyItem->setPos(m_points[keyItem->getKeyIndex()]);
+
+    update();
+}
+
+
+//!
+//! Updates the cached position of a single key after its handle moved.
+//!
+//! \param index The index of the key in the parameter's key list.
+//! \param pos The new scene position of the key.
+//!
+void CurveGraphicsItem::moveKey ( const int index, const QPointF &pos )
+{
+    if (index < 0 || index >= m_points.size())
+        return;
+
+    m_points[index] = pos;
+    if (!m_bounds.contains(pos)) {
+        prepareGeometryChange();
+        extendBounds(pos);
+    }
+    update();
+}
+
+
+//!
+//! Updates the cached position of a single tangent after its handle moved.
+//!
+//! \param index The index of the key in the parameter's key list.
+//! \param pos The new scene position of the tangent.
+//!
+void CurveGraphicsItem::moveTangent ( const int index, const QPointF &pos )
+{
+    if (index < 0 || index >= m_tangents.size())
+        return;
+
+    m_tangents[index] = pos;
+    const QPointF mirrored = m_points[index]*2.0f - pos;
+    if (!m_bounds.contains(pos) || !m_bounds.contains(mirrored)) {
+        prepareGeometryChange();
+        extendBounds(pos);
+        extendBounds(mirrored);
+    }
+    update();
+}
+
+
+//!
+//! Creates the key and tangent handles for the keys inside the given
+//! scene rect. No handles are created if more than the given number of
+//! keys are visible. Handles are only rebuilt if the visible key range
+//! changed.
+//!
+//! \param visibleRect The visible part of the scene.
+//! \param maxHandles The max number of key handles to create.
+//! \param rescale The inverse horizontal view scale for handle sizes.
+//!
+void CurveGraphicsItem::updateHandles ( const QRectF &visibleRect, const int maxHandles, const float rescale )
+{
+    if (!scene())
+        return;
+
+    int first = lowerBound(visibleRect.left());
+    int last = lowerBound(visibleRect.right());
+    if (last - first > maxHandles)
+        first = last = 0;
+
+    if (first == m_firstHandle && last == m_lastHandle && (m_keyItems.size() == last - first))
+        return;
+
+    // keep the selection of keys that stay visible
+    QSet<int> selectedKeys;
+    foreach (KeyGraphicsItem *keyItem, m_keyItems)
+        if (keyItem->isSelected())
+            selectedKeys.insert(keyItem->getKeyIndex());
+
+    clearHandles();
+    m_firstHandle = first;
+    m_lastHandle = last;
+
+    const QList<Key> &keys = m_numberParameter->getKeys();
+    for (int i = first; i < last; ++i) {
+        const Key &key = keys.at(i);
+        const QVariant data = QVariant::fromValue<Key *>(const_cast<Key *>(&key));
+        const QPointF &keyPos = m_points[i];
+
+        // add key item
+        KeyGraphicsItem *keyItem = new KeyGraphicsItem(m_scale, keyPos.x());
+        scene()->addItem(keyItem);
+        keyItem->setPos(keyPos);
+        keyItem->setScale(rescale);
+        keyItem->setData(0, data);
+        keyItem->setCurveItem(this, i);
+        m_keyItems.append(keyItem);
+
+        // add tangent items with handles
+        if (key.type == Key::KT_Bezier) {
+            TangentGraphicsItem *tangentItem = new TangentGraphicsItem(keyItem, m_scale, keyPos.x());
+            scene()->addItem(tangentItem);
+            tangentItem->setPos(m_tangents[i]);
+            tangentItem->setScale(rescale);
+            tangentItem->setData(0, data);
+            tangentItem->setCurveItem(this, i);
+
+            if (i > 0)
+                tangentItem->setMaxX(2.0f*keyPos.x() - m_points[i-1].x());
+            if (i+1 < m_points.size() && m_points[i+1].x() < tangentItem->getMaxX())
+                tangentItem->setMaxX(m_points[i+1].x());
+
+            SegmentGraphicsItem *segmentItem = new SegmentGraphicsItem(keyItem, tangentItem);
+            segmentItem->setWidth(rescale);
+            scene()->addItem(segmentItem);
+
+            m_tangentItems << tangentItem << segmentItem;
+        }
+
+        if (selectedKeys.contains(i))
+            keyItem->setSelected(true);
+    }
+}
+
+
+//!
+//! Deletes all key and tangent handles of the curve.
+//!
+void CurveGraphicsItem::clearHandles ()
+{
+    qDeleteAll(m_tangentItems);
+    m_tangentItems.clear();
+    qDeleteAll(m_keyItems);
+    m_keyItems.clear();
+    m_firstHandle = m_lastHandle = 0;
+}
+
+
+//!
+//! Returns the key handles of the curve.
+//!
+//! \return The key handles of the curve.
+//!
+const QList<KeyGraphicsItem *> & CurveGraphicsItem::getKeyItems () const
+{
+    return m_keyItems;
+}
+
+
+///
+/// Protected Functions
+///
+
+
+//!
+//! Returns the bounding rectangle of the graphics item.
+//!
+//! \return The bounding rectangle of the graphics item.
+//!
+QRectF CurveGraphicsItem::boundingRect () const
+{
+    return m_bounds.adjusted(-1.0, -1.0, 1.0, 1.0);
+}
+
+
+//!
+//! Paints the visible part of the curve into a graphics view.
+//!
+//! \param painter The object to use for painting.
+//! \param option Style options for painting the graphics item.
+//! \param widget The widget into which to paint the graphics item.
+//!
+void CurveGraphicsItem::paint ( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget )
+{
+    const int numKeys = m_points.size();
+    if (numKeys < 2)
+        return;
+
+    // keys of the exposed range plus the segments entering and leaving it
+    const QRectF &exposedRect = option->exposedRect;
+    const int first = qMax(lowerBound(exposedRect.left()) - 1, 0);
+    const int last = qMin(lowerBound(exposedRect.right()), numKeys - 1);
+    if (last <= first)
+        return;
+
+    QPen pen(m_color, 1.0, Qt::SolidLine);
+    pen.setCosmetic(true);
+    painter->setPen(pen);
+
+    const qreal pixelsPerUnit = qAbs(painter->worldTransform().m11());
+    const qreal columns = (m_points[last].x() - m_points[first].x()) * pixelsPerUnit;
+
+    if (last - first > 2.0 * columns) {
+        // more keys than pixels: draw the min/max envelope of each pixel column
+        QPolygonF polyline;
+        polyline.reserve(4 * (int(columns) + 2));
+
+        qreal column = std::floor(m_points[first].x() * pixelsPerUnit);
+        qreal firstY = m_points[first].y(), minY = firstY, maxY = firstY, lastY = firstY;
+
+        for (int i = first + 1; i <= last + 1; ++i) {
+            const bool done = i > last;
+            const qreal keyColumn = done ? column + 1.0 : std::floor(m_points[i].x() * pixelsPerUnit);
+            if (keyColumn != column) {
+                const qreal x = (column + 0.5) / pixelsPerUnit;
+                polyline << QPointF(x, firstY) << QPointF(x, minY) << QPointF(x, maxY) << QPointF(x, lastY);
+                if (done)
+                    break;
+                column = keyColumn;
+                firstY = minY = maxY = lastY = m_points[i].y();
+            }
+            else {
+                lastY = m_points[i].y();
+                minY = qMin(minY, lastY);
+                maxY = qMax(maxY, lastY);
+            }
+        }
+        painter->drawPolyline(polyline);
+    }
+    else {
+        // draw the segments using the type of their start key
+        QPainterPath path;
+        path.moveTo(m_points[first]);
+        for (int i = first; i < last; ++i) {
+            const QPointF &startPoint = m_points[i];
+            const QPointF &endPoint = m_points[i+1];
+            switch (m_types[i]) {
+            case Key::KT_Bezier:
+                if (m_types[i+1] == Key::KT_Bezier)
+                    path.cubicTo(m_tangents[i], endPoint*2.0f - m_tangents[i+1], endPoint);
+                else
+                    path.cubicTo(m_tangents[i], endPoint, endPoint);
+                break;
+            case Key::KT_Step:
+                path.lineTo(endPoint.x(), startPoint.y());
+                path.moveTo(endPoint);
+                break;
+            default:
+                path.lineTo(endPoint);
+            }
+        }
+        painter->drawPath(path);
+    }
+}
+
+
+///
+/// Private Functions
+///
+
+
+//!
+//! Returns the index of the first key at or after the given scene x.
+//!
+int CurveGraphicsItem::lowerBound ( const qreal x ) const
+{
+    int first = 0;
+    int count = m_points.size();
+    while (count > 0) {
+        const int step = count / 2;
+        if (m_points[first + step].x() < x) {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+    return first;
+}
+
+
+//!
+//! Returns the scene position of the given key.
+//!
+QPointF CurveGraphicsItem::keyPosition ( const Key &key ) const
+{
+    return QPointF(key.index * m_scale.width(), m_yOffset - key.keyValue.toFloat() * m_scale.height());
+}
+
+
+//!
+//! Returns the scene position of the given key's tangent.
+//!
+QPointF CurveGraphicsItem::tangentPosition ( const Key &key ) const
+{
+    return QPointF(key.tangentIndex * m_scale.width(), m_yOffset - key.tangentValue * m_scale.height());
+}
+
+
+//!
+//! Extends the bounding rect to contain the given point.
+//!
+void CurveGraphicsItem::extendBounds ( const QPointF &point )
+{
+    if (point.x() < m_bounds.left())   m_bounds.setLeft(point.x());
+    if (point.x() > m_bounds.right())  m_bounds.setRight(point.x());
+    if (point.y() < m_bounds.top())    m_bounds.setTop(point.y());
+    if (point.y() > m_bounds.bottom()) m_bounds.setBottom(point.y());
+}
+
+} // end namespace Frapper
@@ -0,0 +1,229 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "CurveGraphicsItem.h"
+//! \brief Header file for CurveGraphicsItem class.
+//!
+//! A curve item paints the complete curve of one animated number parameter.
+//! Where several keys fall into one device pixel the curve is reduced to the
+//! min/max envelope of each pixel column, so painting cost depends on the
+//! view size instead of the number of keys. Key and tangent handles are only
+//! created for the keys in the visible part of the scene.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef CURVEGRAPHICSITEM_H
+#define CURVEGRAPHICSITEM_H
+
+#include "FrapperPrerequisites.h"
+#include "NumberParameter.h"
+#include <QGraphicsItem>
+#include <QtCore/QVector>
+#include <QtCore/QList>
+#include <QColor>
+
+
+namespace Frapper {
+
+//!
+//! Forward declaration for the key item class.
+//!
+class KeyGraphicsItem;
+
+
+//!
+//! Class for graphics items representing the curve of an animated number
+//! parameter in the Curve Editor panel.
+//!
+class FRAPPER_GUI_EXPORT CurveGraphicsItem : public QGraphicsItem
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the CurveGraphicsItem class.
+    //!
+    //! \param numberParameter The animated number parameter to display.
+    //! \param scale The scene scale of frames and values.
+    //! \param yOffset The scene y coordinate of the value 0.
+    //! \param color The color to use for the curve.
+    //!
+    CurveGraphicsItem ( NumberParameter *numberParameter, const QSizeF &scale, const float yOffset, const QColor &color );
+
+    //!
+    //! Destructor of the CurveGraphicsItem class.
+    //!
+    //! The handles are scene items and are deleted with the scene.
+    //!
+    virtual ~CurveGraphicsItem ();
+
+public: // functions
+
+    //!
+    //! Returns the number parameter displayed by the curve item.
+    //!
+    //! \return The number parameter displayed by the curve item.
+    //!
+    NumberParameter * getNumberParameter () const;
+
+    //!
+    //! Recalculates the scene positions of all keys and moves the existing
+    //! handles to them. Must be called after key values were changed
+    //! directly.
+    //!
+    void updateKeys ();
+
+    //!
+    //! Updates the cached position of a single key after its handle moved.
+    //!
+    //! \param index The index of the key in the parameter's key list.
+    //! \param pos The new scene position of the key.
+    //!
+    void moveKey ( const int index, const QPointF &pos );
+
+    //!
+    //! Updates the cached position of a single tangent after its handle moved.
+    //!
+    //! \param index The index of the key in the parameter's key list.
+    //! \param pos The new scene position of the tangent.
+    //!
+    void moveTangent ( const int index, const QPointF &pos );
+
+    //!
+    //! Creates the key and tangent handles for the keys inside the given
+    //! scene rect. No handles are created if more than the given number of
+    //! keys are visible. Handles are only rebuilt if the visible key range
+    //! changed.
+    //!
+    //! \param visibleRect The visible part of the scene.
+    //! \param maxHandles The max number of key handles to create.
+    //! \param rescale The inverse horizontal view scale for handle sizes.
+    //!
+    void updateHandles ( const QRectF &visibleRect, const int maxHandles, const float rescale );
+
+    //!
+    //! Deletes all key and tangent handles of the curve.
+    //!
+    void clearHandles ();
+
+    //!
+    //! Returns the key handles of the curve.
+    //!
+    //! \return The key handles of the curve.
+    //!
+    const QList<KeyGraphicsItem *> & getKeyItems () const;
+
+protected: // functions
+
+    //!
+    //! Returns the bounding rectangle of the graphics item.
+    //!
+    //! \return The bounding rectangle of the graphics item.
+    //!
+    virtual QRectF boundingRect () const;
+
+    //!
+    //! Paints the visible part of the curve into a graphics view.
+    //!
+    //! \param painter The object to use for painting.
+    //! \param option Style options for painting the graphics item.
+    //! \param widget The widget into which to paint the graphics item.
+    //!
+    virtual void paint ( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget );
+
+private: // functions
+
+    //!
+    //! Returns the index of the first key at or after the given scene x.
+    //!
+    int lowerBound ( const qreal x ) const;
+
+    //!
+    //! Returns the scene position of the given key.
+    //!
+    QPointF keyPosition ( const Key &key ) const;
+
+    //!
+    //! Returns the scene position of the given key's tangent.
+    //!
+    QPointF tangentPosition ( const Key &key ) const;
+
+    //!
+    //! Extends the bounding rect to contain the given point.
+    //!
+    void extendBounds ( const QPointF &point );
+
+private: // data
+
+    //!
+    //! The number parameter displayed by the curve item.
+    //!
+    NumberParameter *m_numberParameter;
+
+    //!
+    //! The scene scale of frames and values.
+    //!
+    QSizeF m_scale;
+
+    //!
+    //! The scene y coordinate of the value 0.
+    //!
+    float m_yOffset;
+
+    //!
+    //! The color to use for the curve.
+    //!
+    QColor m_color;
+
+    //!
+    //! Cached scene positions, tangent positions and types of the keys.
+    //!
+    QVector<QPointF> m_points;
+    QVector<QPointF> m_tangents;
+    QVector<int> m_types;
+
+    //!
+    //! The bounding rect of the curve.
+    //!
+    QRectF m_bounds;
+
+    //!
+    //! The key handles and the tangent handles and segments of the visible
+    //! key range.
+    //!
+    QList<KeyGraphicsItem *> m_keyItems;
+    QList<QGraphicsItem *> m_tangentItems;
+
+    //!
+    //! The key range the handles were created for.
+    //!
+    int m_firstHandle;
+    int m_lastHandle;
+};
+
+} // end namespace Frapper
+
+#endif
@@ -32,6 +32,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "KeyGraphicsItem.h"
 #include "SegmentGraphicsItem.h"
+#include "CurveGraphicsItem.h"
 
 
 namespace Frapper {
@@ -83,6 +84,8 @@ QVariant KeyGraphicsItem::itemChange ( GraphicsItemChange change, const QVariant
 	case ItemPositionHasChanged :
 		foreach (SegmentGraphicsItem *segmentItem, m_segmentItems)
 			segmentItem->adjust();
+		if (m_curveItem)
+			m_curveItem->moveKey(m_keyIndex, pos());
 		if (m_tangentItem)
 			m_tangentItem->adjust();
 		break;
@@ -103,6 +106,8 @@ QVariant TangentGraphicsItem::itemChange ( GraphicsItemChange change, const QVar
 	case ItemPositionHasChanged :
 		foreach (SegmentGraphicsItem *segmentItem, m_segmentItems)
 			segmentItem->adjust();
+		if (m_curveItem)
+			m_curveItem->moveTangent(m_keyIndex, pos());
 		break;
 	case ItemSelectedHasChanged :
 		setVisibility(isSelected());
@@ -65,6 +65,11 @@ class SegmentGraphicsItem;
 //!
 class TangentGraphicsItem;
 
+//!
+//! Forward declaration for the curve class.
+//!
+class CurveGraphicsItem;
+
 //!
 //! Class for graphics items representing keys in the Curve Editor panel.
 //!
@@ -81,6 +86,8 @@ public: // constructors and destructors
     inline KeyGraphicsItem ( const QSizeF &scale = QSizeF(1.0f, 1.0f), const float minX = 0.0f ) :
 	m_minX(minX),
 	m_sceneScale(scale),
+	m_curveItem(0),
+	m_keyIndex(-1),
 	m_tangentItem(0)
 	{
 		setFlag(ItemIsMovable);
@@ -133,6 +140,39 @@ public: // functions
 		return m_minX;
 	}
 
+	//!
+	//! Sets the curve item that displays the key and the index of the key
+	//! in the parameter's key list.
+	//!
+	//! \param curveItem The curve item to notify when the item moves.
+	//! \param keyIndex The index of the key in the parameter's key list.
+	//!
+	inline void setCurveItem( CurveGraphicsItem *curveItem, const int keyIndex )
+	{
+		m_curveItem = curveItem;
+		m_keyIndex = keyIndex;
+	}
+
+	//!
+	//! Returns the index of the key in the parameter's key list.
+	//!
+	//! \return The index of the key in the parameter's key list.
+	//!
+	inline int getKeyIndex( ) const
+	{
+		return m_keyIndex;
+	}
+
+	//!
+	//! Returns the curve item that displays the key.
+	//!
+	//! \return The curve item that displays the key.
+	//!
+	inline CurveGraphicsItem * getCurveItem( ) const
+	{
+		return m_curveItem;
+	}
+
 protected: // functions
 
     //!
@@ -173,6 +213,9 @@ protected: // functions
 
 		event->setScenePos(QPointF(m_minX, event->scenePos().y()));
 
+		// move the items first so the keys get the new positions
+		QGraphicsItem::mouseMoveEvent(event);
+
 		const QList<QGraphicsItem *> &selectedItems = scene()->selectedItems();
 		foreach (QGraphicsItem *item, selectedItems) {
 			key = item->data(0).value<Key *>();
@@ -183,8 +226,6 @@ protected: // functions
 			else
 				continue;
 		}
-
-		QGraphicsItem::mouseMoveEvent(event);
 	}
 	
 protected: // data
@@ -202,6 +243,12 @@ protected: // data
     //!
 	QSizeF m_sceneScale;
 
+	//!
+    //! The curve item displaying the key and the index of the key
+    //!
+	CurveGraphicsItem *m_curveItem;
+	int m_keyIndex;
+
 	//!
     //! The list containing all curve segment items connected to the key item.
     //!
@@ -315,6 +362,9 @@ protected: // functions
 		else if (event->scenePos().x() > m_maxX)
 			event->setScenePos(QPointF(m_maxX, event->scenePos().y()));
 
+		// move the items first so the keys get the new positions
+		QGraphicsItem::mouseMoveEvent(event);
+
 		const QList<QGraphicsItem *> &selectedItems = scene()->selectedItems();
 		foreach (QGraphicsItem *item, selectedItems) {
 			key = item->data(0).value<Key *>();
@@ -322,8 +372,6 @@ protected: // functions
 			key->tangentIndex = tangentItem->pos().x() / m_sceneScale.width();
 			key->tangentValue = (scene()->height() / 2.0f - tangentItem->pos().y()) / m_sceneScale.height();
 		}
-
-		QGraphicsItem::mouseMoveEvent(event);
 	}
 
 private:
@@ -72,6 +72,7 @@ TimelineWidget::TimelineWidget ( QWidget *parent /* = 0 */, Qt::WindowFlags flag
     m_movedGrabber(0),
     m_currentFrameEdit(new QLineEdit(this)),
     m_currentFrameValidator(new QIntValidator(this)),
+    m_imageValid(false),
     m_autoScroll(true),
     m_frameWidth(DefaultFrameSize.width()),
     m_frameHeight(DefaultFrameSize.height()),
@@ -159,6 +160,7 @@ void TimelineWidget::setStartFrame ( int index )
     m_currentGrabber->setStartFrameIndex(index);
 
     updateWidth();
+    invalidateImage();
     update();
 }
 
@@ -173,6 +175,7 @@ void TimelineWidget::setEndFrame ( int index )
     m_endGrabber->setFrameIndex(index);
 
     updateWidth();
+    invalidateImage();
     update();
 }
 
@@ -185,6 +188,7 @@ void TimelineWidget::setEndFrame ( int index )
 void TimelineWidget::setInFrame ( int index )
 {
     m_inGrabber->setFrameIndex(index);
+    invalidateImage();
     update();
 }
 
@@ -197,6 +201,7 @@ void TimelineWidget::setInFrame ( int index )
 void TimelineWidget::setOutFrame ( int index )
 {
     m_outGrabber->setFrameIndex(index);
+    invalidateImage();
     update();
 }
 
@@ -272,6 +277,7 @@ void TimelineWidget::setFrameWidth ( int frameWidth )
     m_currentGrabber->setFrameWidth(frameWidth);
 
     updateWidth();
+    invalidateImage();
 
     if (m_parentScrollArea && m_autoScroll)
         m_parentScrollArea->ensureVisible((m_currentGrabber->getFrameIndex() - m_startGrabber->getFrameIndex()) * (m_frameWidth - 1) + GrabberWidget::Width - 1, 0);
@@ -294,10 +300,43 @@ void TimelineWidget::paintEvent ( QPaintEvent *event )
 {
     //Log::debug(QString("paintEvent handler has been called. Rect: (%1, %2, %3, %4)").arg(event->rect().left()).arg(event->rect().top()).arg(event->rect().width()).arg(event->rect().height()), "TimelineWidget::paintEvent");
 
-    paintImage(event->rect());
+    const QRect &rectangle = event->rect();
+
+    // repaint the ruler only if it is outdated or does not cover the area to paint
+    if (!m_imageValid || m_imageRect.height() != height() || rectangle.left() < m_imageRect.left() || rectangle.right() > m_imageRect.right()) {
+        m_imageRect = QRect(rectangle.left(), 0, rectangle.width(), height());
+        paintImage(m_imageRect);
+        m_imageValid = true;
+    }
 
     QPainter painter (this);
-    painter.drawImage(QRect(event->rect().topLeft(), m_image.size()), m_image);
+    painter.setClipRect(rectangle);
+    painter.drawImage(QPoint(rectangle.left(), 0), m_image, QRect(rectangle.left() - m_imageRect.left(), 0, rectangle.width(), m_image.height()));
+
+    // the current frame index is the only part that changes during playback
+    paintIndex(painter);
+}
+
+
+//!
+//! Event handler that reacts to changes of the widget's palette, font
+//! and style.
+//!
+//! \param event The object containing details about the event.
+//!
+void TimelineWidget::changeEvent ( QEvent *event )
+{
+    switch (event->type()) {
+        case QEvent::PaletteChange:
+        case QEvent::FontChange:
+        case QEvent::StyleChange:
+            invalidateImage();
+            break;
+        default:
+            break;
+    }
+
+    QWidget::changeEvent(event);
 }
 
 
@@ -545,12 +584,10 @@ void TimelineWidget::paintImage ( const QRect &rectangle )
     QColor midColor (palette().color(QPalette::Mid));
     QColor baseColor (palette().color(QPalette::Base));
     QColor windowColor (palette().color(QPalette::Window));
-    QColor buttonTextColor (palette().color(QPalette::ButtonText));
-    QColor buttonAlphaColor (buttonColor);
-    buttonAlphaColor.setAlpha(200);
 
-    // (re-)create the image
-    m_image = QImage(rectangle.size(), QImage::Format_RGB32);
+    // (re-)create the image if its size has changed
+    if (m_image.size() != rectangle.size())
+        m_image = QImage(rectangle.size(), QImage::Format_RGB32);
     m_image.fill(windowColor.rgb());
 
     // start painting on the image
@@ -588,6 +625,9 @@ void TimelineWidget::paintImage ( const QRect &rectangle )
         highlightColor = baseColor.darker(104);
     }
 
+    // measure index texts with the same metrics for all frames
+    const QFontMetrics fontMetrics (painter.fontMetrics());
+
     // calculate indices of first and last frame to display in the widget
     int startIndex = horizontalOffset / frameWidth + startFrame - 1;
     int endIndex = startIndex + (rangeWidth - grabberWidth - grabberWidth) / frameWidth + 2;
@@ -619,11 +659,32 @@ void TimelineWidget::paintImage ( const QRect &rectangle )
         // draw index text
         if (((index == 1 || index != 0 && index % m_tickStep == 0) || (m_frameWidth > 35)) && index <= endFrame) {
             QString indexText = QString("%1").arg(index);
-            QSize indexTextSize (painter.fontMetrics().size(0, indexText) + QSize(4, 0));
+            QSize indexTextSize (fontMetrics.size(0, indexText) + QSize(4, 0));
             QRect indexTextRect (QPoint(x + m_frameWidth / 2 - indexTextSize.width() / 2, m_frameHeight + 2), indexTextSize);
             painter.drawText(indexTextRect.adjusted(1, 1, 0, 0), Qt::AlignCenter, indexText);
         }
     }
+}
+
+
+//!
+//! Paints the index of the current or moved frame below its frame
+//! rectangle on top of the ruler image.
+//!
+//! \param painter The painter to paint the index with.
+//!
+void TimelineWidget::paintIndex ( QPainter &painter )
+{
+    int startFrame = m_startGrabber->getFrameIndex();
+    int frameWidth = m_frameWidth - 1;
+    int frameHeight = m_frameHeight - 1;
+    int grabberWidth = GrabberWidget::Width - 1;
+
+    // define colors
+    QColor midColor (palette().color(QPalette::Mid));
+    QColor buttonTextColor (palette().color(QPalette::ButtonText));
+    QColor buttonAlphaColor (palette().color(QPalette::Button));
+    buttonAlphaColor.setAlpha(200);
 
     // set the frame index to display below the corresponding frame rectangle
     int indexToDisplay;
@@ -632,14 +693,14 @@ void TimelineWidget::paintImage ( const QRect &rectangle )
     else
         indexToDisplay = m_currentGrabber->getFrameIndex();
 
-    // calculate the index rectangle and text
-    int frameRectangleX = grabberWidth + (indexToDisplay - startFrame) * frameWidth - horizontalOffset;
+    // calculate the index rectangle and text (the font is the one of the ruler image)
+    QFont font;
+    int frameRectangleX = grabberWidth + (indexToDisplay - startFrame) * frameWidth;
     QString indexText (QString("%1").arg(indexToDisplay));
-    QSize indexTextSize (painter.fontMetrics().size(0, indexText));
+    QSize indexTextSize (QFontMetrics(font).size(0, indexText));
     QRect indexTextRect (QPoint(frameRectangleX + (frameWidth -indexTextSize.width()) / 2 - 2, frameHeight + 4), indexTextSize + QSize(4, -1));
 
     // set the font to use for the index text
-    QFont font (painter.font());
     font.setBold(true);
 
     // draw the index frame rectangle and text
@@ -652,6 +713,16 @@ void TimelineWidget::paintImage ( const QRect &rectangle )
 }
 
 
+//!
+//! Marks the cached ruler image as outdated, so that it is repainted
+//! with the next paint event.
+//!
+void TimelineWidget::invalidateImage ()
+{
+    m_imageValid = false;
+}
+
+
 //!
 //! Returns the grabber at the given mouse pointer position.
 //!
@@ -192,6 +192,14 @@ protected: // event handlers
     //!
     virtual void paintEvent ( QPaintEvent *event );
 
+    //!
+    //! Event handler that reacts to changes of the widget's palette, font
+    //! and style.
+    //!
+    //! \param event The object containing details about the event.
+    //!
+    virtual void changeEvent ( QEvent *event );
+
     //!
     //! Event handler that reacts to key press events.
     //!
@@ -236,12 +244,27 @@ private: // functions
     void updateWidth ();
 
     //!
-    //! Paints a part of the image that is drawn when painting the widget.
+    //! Paints a part of the static ruler image that is drawn when painting
+    //! the widget.
     //!
     //! \param rectangle The area of the image to paint.
     //!
     void paintImage ( const QRect &rectangle );
 
+    //!
+    //! Paints the index of the current or moved frame below its frame
+    //! rectangle on top of the ruler image.
+    //!
+    //! \param painter The painter to paint the index with.
+    //!
+    void paintIndex ( QPainter &painter );
+
+    //!
+    //! Marks the cached ruler image as outdated, so that it is repainted
+    //! with the next paint event.
+    //!
+    void invalidateImage ();
+
     //!
     //! Returns the grabber at the given mouse pointer position.
     //!
@@ -271,10 +294,21 @@ private slots: //
 private: // data
 
     //!
-    //! The image that will be used for painting the widget.
+    //! The cached image of the static ruler that will be used for painting
+    //! the widget.
     //!
     QImage m_image;
 
+    //!
+    //! The area of the widget that is covered by the cached ruler image.
+    //!
+    QRect m_imageRect;
+
+    //!
+    //! Flag that states whether the cached ruler image is up to date.
+    //!
+    bool m_imageValid;
+
     //!
     //! The scroll area in which the timeline widget resides.
     //!
@@ -56,7 +56,6 @@ INIT_INSTANCE_COUNTER(AnimationClipNode)
 //!
 AnimationClipNode::AnimationClipNode ( QString name, ParameterGroup *parameterRoot ) :
 Node(name, parameterRoot),
-m_animation(0),
 m_isExternallyControlled(false),
 m_isPlaying(false),
 m_offsetAnimation(false),
@@ -191,18 +190,15 @@ void AnimationClipNode::processAnimationParameter()
     if (!parameter || (!m_isPlaying && !m_isExternallyControlled) )
         return;
     
-    QString auName(parameter->getName());    
-	QHash<QString, QHash<QString, float> >::iterator iter = m_parameterMap.find(auName);
-    if ( iter != m_parameterMap.end()) {
-        QHash<QString, float> &subParameterMap = iter.value();
+	QHash<Parameter *, ParameterBinding>::const_iterator iter = m_parameterBindings.constFind(parameter);
+    if (iter != m_parameterBindings.constEnd() && m_tracks.isValid()) {
+        const ParameterBinding &binding = iter.value();
 
         Parameter *timeParameter = getParameter("time");
         float length = getDoubleValue("length");
         float time = 0.0;
 		float start = 0.0; 
 		start = getDoubleValue("start");
-		Ogre::TransformKeyFrame offsetTKF(NULL, 0);				// Transform Keyframe to calculate Offset Value(s)
-		offsetTKF.setScale(Ogre::Vector3(0.0f,  0.0f,  0.0f));	// scale.x is used to store values 
         
 		if (m_timeParameter && !timeParameter->isConnected())
             time = m_timeParameter->getValue().toDouble();
@@ -241,86 +237,35 @@ void AnimationClipNode::processAnimationParameter()
 			} 
 		}
 
-		if (subParameterMap.size() == 6) {
-            QHash<QString, float>::iterator subIter = subParameterMap.begin();
-            unsigned int index = 0;
-            QVariantList subParameterList;
-            while (subIter != subParameterMap.end()) {
-                QString suffix = subIter.key();
-                QHash<QString, unsigned short>::iterator idMapIter = m_forwCurveMap.find(auName + "_" + suffix);
-                float progress = 0.0;
-                // if entry exists in m_forwCurveMap interpolate progress, else progress = 0.0
-                if (idMapIter != m_forwCurveMap.end()) {
-					unsigned short id = m_forwCurveMap.value(auName + "_" + suffix);
-                    Ogre::NodeAnimationTrack* track = m_animation->getNodeTrack(id);
-                    if (track) {
-						if (m_offsetAnimation){
-							Ogre::KeyFrame *firstFrame = track->getKeyFrame(0);									
-							track->getInterpolatedKeyFrame(firstFrame->getTime(), &offsetTKF);
-						}
-                        Ogre::TransformKeyFrame interpKeyFrame(NULL, time);
-                        Ogre::TimeIndex timeIndex(time);
-                        track->getInterpolatedKeyFrame(timeIndex, &interpKeyFrame);
-						progress = (interpKeyFrame.getScale().x - offsetTKF.getScale().x) * weight;
-                    }
-                }
-                subParameterList.append(QVariant(progress));
-                ++index;
-                ++subIter;
-            }
-            parameter->setValue(QVariant(subParameterList), true);
-        }
-        else if (subParameterMap.size() == 3) {
-            QHash<QString, float>::iterator subIter = subParameterMap.begin();
-            unsigned int index = 0;
-            //QVariantList subParameterList;
-            Ogre::Vector3 ogreVector(0.0, 0.0, 0.0);
-            for (int i = 0; i < subParameterMap.size(); ++i) {
-                QString suffix = subIter.key();
-                QHash<QString, unsigned short>::iterator idMapIter = m_forwCurveMap.find(auName + "_" + suffix);
-                float progress = 0.0;
-                // if entry exists in m_forwCurveMap interpolate progress, else progress = 0.0
-                if (idMapIter != m_forwCurveMap.end()) {
-					unsigned short id = m_forwCurveMap.value(auName + "_" + suffix);
-                    Ogre::NodeAnimationTrack* track = m_animation->getNodeTrack(id);
-                    if (track) {
-						if (m_offsetAnimation){
-							Ogre::KeyFrame *firstFrame = track->getKeyFrame(0);									
-							track->getInterpolatedKeyFrame(firstFrame->getTime(), &offsetTKF);
-						}
-                        Ogre::TransformKeyFrame interpKeyFrame(NULL, time);
-                        Ogre::TimeIndex timeIndex(time);
-                        track->getInterpolatedKeyFrame(timeIndex, &interpKeyFrame);
-                        progress = (interpKeyFrame.getScale().x - offsetTKF.getScale().x) * weight;
-                    }
-                }
-                if (i == 0)
-                    ogreVector += Ogre::Vector3(progress, 0.0, 0.0);
-                else if (i == 1)
-                    ogreVector += Ogre::Vector3(0.0, progress, 0.0);
-                else if (i == 2)
-                    ogreVector += Ogre::Vector3(0.0, 0.0, progress);
-                
-                ++index;
-                ++subIter;
-            }
-            parameter->setValue(QVariant::fromValue<Ogre::Vector3>(ogreVector), true);
-        }
-        else {
-			unsigned short id = m_forwCurveMap.value(auName);
-            Ogre::NodeAnimationTrack *track = m_animation->getNodeTrack(id);
-            if (track) {								
-				if (m_offsetAnimation){
-					Ogre::KeyFrame *firstFrame = track->getKeyFrame(0);									
-					track->getInterpolatedKeyFrame(firstFrame->getTime(), &offsetTKF);
-				}
-                Ogre::TransformKeyFrame interpKeyFrame(NULL, time);
-                Ogre::TimeIndex timeIndex(time);
-                track->getInterpolatedKeyFrame(timeIndex, &interpKeyFrame);
-				float progress = (interpKeyFrame.getScale().x - offsetTKF.getScale().x)* weight;
-                parameter->setValue(QVariant(progress), true);
-            }
-        }
+		// sample all tracks once per time value
+		m_tracks.sample(time);
+
+		// value of a track relative to its first key frame if offset animation is enabled
+		const int numValues = binding.trackIndices.size();
+		float progress[6];
+		for (int i = 0; i < numValues; ++i) {
+			const int trackIndex = binding.trackIndices[i];
+			if (trackIndex < 0)
+				progress[i] = 0.0;
+			else if (m_offsetAnimation)
+				progress[i] = (m_tracks.getValue(trackIndex) - m_tracks.getOffset(trackIndex)) * weight;
+			else
+				progress[i] = m_tracks.getValue(trackIndex) * weight;
+		}
+
+		if (binding.type == ParameterBinding::T_List) {
+			QVariantList subParameterList;
+			for (int i = 0; i < numValues; ++i)
+				subParameterList.append(QVariant(progress[i]));
+			parameter->setValue(QVariant(subParameterList), true);
+		}
+		else if (binding.type == ParameterBinding::T_Vector3) {
+			Ogre::Vector3 ogreVector(progress[0], progress[1], progress[2]);
+			parameter->setValue(QVariant::fromValue<Ogre::Vector3>(ogreVector), true);
+		}
+		else if (numValues > 0 && binding.trackIndices[0] >= 0) {
+			parameter->setValue(QVariant(progress[0]), true);
+		}
     }
 }
 
@@ -330,12 +275,7 @@ void AnimationClipNode::processAnimationParameter()
 void AnimationClipNode::toggleInterpolationMode()
 {
     // set interpolation type
-    if (m_animation) {
-        if (getBoolValue("splineAnimation"))
-            m_animation->setInterpolationMode(Ogre::Animation::IM_SPLINE);
-        else
-            m_animation->setInterpolationMode(Ogre::Animation::IM_LINEAR);
-    }
+    m_tracks.setSpline(getBoolValue("splineAnimation"));
 }
 
 //!
@@ -430,6 +370,9 @@ void AnimationClipNode::triggerReload ()
 //!
 //! Reads all animation curves from the file with the given name.
 //!
+//! The curves are read from a binary cache next to the file if the cache
+//! is up to date, otherwise the file is parsed and the cache is written.
+//!
 //! \param filename The name of the file with the animation curves to parse.
 //!
 void AnimationClipNode::parseAnimationFile ( const QString &filename )
@@ -438,6 +381,11 @@ void AnimationClipNode::parseAnimationFile ( const QString &filename )
     m_forwCurveMap.clear();
     m_backwCurveMap.clear();
 
+    if (readAnimationCache(filename)) {
+        Log::debug(QString("Animation curves of \"%1\" read from cache.").arg(filename), "AnimationClipNode::parseAnimationFile");
+        return;
+    }
+
     float animationLength = 0.0;
 
 	// xml file
@@ -567,6 +515,56 @@ void AnimationClipNode::parseAnimationFile ( const QString &filename )
 			}
         }
     }
+    file.close();
+
+    writeAnimationCache(filename);
+}
+
+
+//!
+//! Reads the animation curves from the binary cache file of the given
+//! animation file.
+//!
+//! \param filename The name of the animation file.
+//! \return True if the cache exists and is up to date, otherwise False.
+//!
+bool AnimationClipNode::readAnimationCache ( const QString &filename )
+{
+    return AnimationCurveCache::read(filename, getParseOptions(), m_animCurves);
+}
+
+
+//!
+//! Writes the animation curves to the binary cache file of the given
+//! animation file.
+//!
+//! \param filename The name of the animation file.
+//!
+void AnimationClipNode::writeAnimationCache ( const QString &filename ) const
+{
+    if (!AnimationCurveCache::write(filename, getParseOptions(), m_animCurves))
+        Log::warning(QString("Animation cache %1 could not be written.").arg(AnimationCurveCache::getCacheFilename(filename)), "AnimationClipNode::writeAnimationCache");
+}
+
+
+//!
+//! Returns the values of the renaming and exclusion options, which
+//! affect the parsed animation curves.
+//!
+//! \return The option values as a single string.
+//!
+QString AnimationClipNode::getParseOptions () const
+{
+    QStringList options;
+    options << QString::number(getBoolValue("remove global prefix"))
+        << getStringValue("prefix")
+        << QString::number(getBoolValue("identify joints"))
+        << getStringValue("space separated joint names")
+        << getStringValue("joint name delimiter")
+        << QString::number(getBoolValue("remove transformation suffix from non joint clips"))
+        << QString::number(getBoolValue("exclude animations clips"))
+        << getStringValue("space separated animation clip names");
+    return options.join("\n");
 }
 
 
@@ -578,42 +576,7 @@ void AnimationClipNode::parseAnimationFile ( const QString &filename )
 //!
 void AnimationClipNode::createAnimationCurves ( QString clipName, float clipLength )
 {
-    if (m_animation)
-        delete m_animation;
-
-    m_animation = new Ogre::Animation(clipName.toStdString(), clipLength);
-    if (m_animation) {
-        if (getBoolValue("splineAnimation"))
-            m_animation->setInterpolationMode(Ogre::Animation::IM_SPLINE);
-        else
-            m_animation->setInterpolationMode(Ogre::Animation::IM_LINEAR);
-    }
-
-    unsigned short animTrackId = 0;
-
-    QHash<QString, AnimCurve>::const_iterator curveIter = m_animCurves.constBegin();
-    while (curveIter != m_animCurves.constEnd()) {
-        //Ogre::NumericAnimationTrack *animTrack = m_animation->createNumericTrack(animTrackId);
-        Ogre::NodeAnimationTrack *animTrack = m_animation->createNodeTrack(animTrackId);
-        const AnimCurve &tmpCurve = curveIter.value();
-		m_forwCurveMap.insert(tmpCurve.name, animTrackId);
-		m_backwCurveMap.insert(animTrackId, tmpCurve.name);
-        QList<QPair<float, float>>::const_iterator i = (tmpCurve.keys).constBegin();
-        while (i != (tmpCurve.keys).constEnd()) {
-			float time = i->first;
-			float value = i->second;
-            // Use scalingVector to save key values in TransformKeyFrame, because
-            // spline interpolation is not available in NumericKeyFrame.
-            Ogre::TransformKeyFrame *keyFrame = animTrack->createNodeKeyFrame(time);
-            Ogre::Vector3 valueVec (value, 0.0, 0.0);
-            keyFrame->setScale(valueVec);
-            //std::cout << (tmpCurve->name).toStdString() << ":" << time << ": " << value << std::endl;
-            ++i;
-        }
-        ++animTrackId;
-        ++curveIter;
-        //std::cout << (tmpCurve->name).toStdString() << " : " << animTrackId << std::endl;
-    }
+    m_tracks.create(clipName, clipLength, m_animCurves, getBoolValue("splineAnimation"), m_forwCurveMap, m_backwCurveMap);
 }
 
 
@@ -726,6 +689,7 @@ bool AnimationClipNode::removeParameters ()
 		}			
 	}
 	m_parameterMap.clear();
+	m_parameterBindings.clear();
 
     const QList<QString>& oldCurveNames = m_forwCurveMap.keys();
     for(int i = 0; i < oldCurveNames.size(); ++i)
@@ -868,6 +832,7 @@ bool AnimationClipNode::generateParameters ()
             m_animationGroup->addParameter(parameter);
         
         parameter->setProcessingFunction(SLOT(processAnimationParameter()));
+        bindParameter(parameter, iter.value());
         ++iter;
     }
 
@@ -876,6 +841,37 @@ bool AnimationClipNode::generateParameters ()
 }
 
 
+//!
+//! Resolves the tracks of the given dynamic parameter to track indices.
+//!
+//! \param parameter The dynamic parameter to bind.
+//! \param subParameterMap The sub parameters of the dynamic parameter.
+//!
+void AnimationClipNode::bindParameter ( Parameter *parameter, const QHash<QString, float> &subParameterMap )
+{
+    const QString &auName = parameter->getName();
+    ParameterBinding binding;
+
+    if (subParameterMap.size() == 6 || subParameterMap.size() == 3) {
+        binding.type = subParameterMap.size() == 6 ? ParameterBinding::T_List : ParameterBinding::T_Vector3;
+        // the values are ordered like the sub parameter map
+        QHash<QString, float>::const_iterator subIter = subParameterMap.constBegin();
+        while (subIter != subParameterMap.constEnd()) {
+            QHash<QString, unsigned short>::const_iterator idMapIter = m_forwCurveMap.constFind(auName + "_" + subIter.key());
+            binding.trackIndices.append(idMapIter != m_forwCurveMap.constEnd() ? (int) idMapIter.value() : -1);
+            ++subIter;
+        }
+    }
+    else {
+        binding.type = ParameterBinding::T_Float;
+        QHash<QString, unsigned short>::const_iterator idMapIter = m_forwCurveMap.constFind(auName);
+        binding.trackIndices.append(idMapIter != m_forwCurveMap.constEnd() ? (int) idMapIter.value() : -1);
+    }
+
+    m_parameterBindings.insert(parameter, binding);
+}
+
+
 //!
 //! Increase frame count.
 //!
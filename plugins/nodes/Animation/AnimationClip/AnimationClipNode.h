@@ -40,38 +40,39 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <QStandardItem>
 #include <QtCore/QTimer>
 #include <QtCore/QTime>
-
-// OGRE
-#include "Ogre.h"
-#if (OGRE_PLATFORM  == OGRE_PLATFORM_WIN32)
-#include <windows.h>
-#endif
+#include <QtCore/QVector>
+#include "AnimationClipTracks.h"
 
 namespace AnimationClipNode {
 using namespace Frapper;
 
 //!
-//! Data structure for animation curves.
+//! Binding of an animation parameter to the tracks of its values.
 //!
-struct AnimCurve
+struct ParameterBinding
 {
 
-public: // constructors and destructors
+public: // enumerations
 
-    AnimCurve()
-    {
-    }
+    //!
+    //! The type of value the tracks are written to.
+    //!
+    enum Type {
+        T_Float,    //!< single value
+        T_Vector3,  //!< Ogre::Vector3 of 3 tracks
+        T_List      //!< value list of 6 tracks
+    };
+
+public: // constructors and destructors
 
-    ~AnimCurve()
+    ParameterBinding() : type(T_Float)
     {
-        keys.clear();
     }
 
 public: // data
 
-	float length;
-    QString name;
-    QList<QPair<float, float>> keys;
+    Type type;
+    QVector<int> trackIndices;  //!< the index of the track of each value, -1 if no track exists
 
 };
 
@@ -177,6 +178,31 @@ protected: // functions
     //!
     void parseAnimationFile ( const QString &filename );
 
+    //!
+    //! Reads the animation curves from the binary cache file of the given
+    //! animation file.
+    //!
+    //! \param filename The name of the animation file.
+    //! \return True if the cache exists and is up to date, otherwise False.
+    //!
+    bool readAnimationCache ( const QString &filename );
+
+    //!
+    //! Writes the animation curves to the binary cache file of the given
+    //! animation file.
+    //!
+    //! \param filename The name of the animation file.
+    //!
+    void writeAnimationCache ( const QString &filename ) const;
+
+    //!
+    //! Returns the values of the renaming and exclusion options, which
+    //! affect the parsed animation curves.
+    //!
+    //! \return The option values as a single string.
+    //!
+    QString getParseOptions () const;
+
     //!
     //! Generates OGRE animation curves (Ogre::NumericAnimationTrack).
     //!
@@ -200,6 +226,14 @@ protected: // functions
     //!
     bool generateParameters();
 
+    //!
+    //! Resolves the tracks of the given dynamic parameter to track indices.
+    //!
+    //! \param parameter The dynamic parameter to bind.
+    //! \param subParameterMap The sub parameters of the dynamic parameter.
+    //!
+    void bindParameter ( Parameter *parameter, const QHash<QString, float> &subParameterMap );
+
 private slots: //
 
     //!
@@ -224,7 +258,6 @@ private: // data
     ParameterGroup *m_animationGroup;
     ParameterGroup *m_boneGroup;
     ParameterGroup *m_cameraGroup;
-	Ogre::Animation* m_animation;
     QTimer *m_timer;
 	QTime m_lastTimestamp;
     QStringList m_groupSuffixes;
@@ -236,6 +269,16 @@ private: // data
     QHash<QString, unsigned short> m_forwCurveMap;
     QHash<unsigned short, QString> m_backwCurveMap;
     QHash<QString, AnimCurve> m_animCurves;
+
+    //!
+    //! The OGRE animation of the curves and its sampled track values.
+    //!
+    AnimationTracks m_tracks;
+
+    //!
+    //! The track bindings of the dynamic parameters.
+    //!
+    QHash<Parameter *, ParameterBinding> m_parameterBindings;
 };
 } // namespace AnimationClipNode
 
@@ -0,0 +1,308 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AnimationClipTracks.cpp"
+//! \brief Implementation file for AnimationCurveCache and AnimationTracks classes.
+//!
+//! \version    1.0
+//! \date       19.10.2026 (created)
+//!
+
+#include "AnimationClipTracks.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDateTime>
+#include <QtCore/QDataStream>
+
+namespace AnimationClipNode {
+
+#define ANIMATION_CACHE_MAGIC	0x41434c50	// "ACLP"
+#define ANIMATION_CACHE_VERSION	1
+
+///
+/// AnimationCurveCache
+///
+
+
+//!
+//! Returns the name of the cache file of the given animation file.
+//!
+//! \param filename The name of the animation file.
+//! \return The name of the cache file.
+//!
+QString AnimationCurveCache::getCacheFilename ( const QString &filename )
+{
+    return filename + ".clipcache";
+}
+
+
+//!
+//! Reads the animation curves from the binary cache file of the given
+//! animation file.
+//!
+//! \param filename The name of the animation file.
+//! \param parseOptions The options the curves have to be parsed with.
+//! \param curves Receives the animation curves.
+//! \return True if the cache exists and is up to date, otherwise False.
+//!
+bool AnimationCurveCache::read ( const QString &filename, const QString &parseOptions, QHash<QString, AnimCurve> &curves )
+{
+    const QFileInfo fileInfo (filename);
+    QFile cacheFile (getCacheFilename(filename));
+    if (!cacheFile.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream ds (&cacheFile);
+    ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, version;
+    QString sourceName, sourceParseOptions;
+    qint64 sourceSize;
+    QDateTime sourceModified;
+    qint32 curveCount;
+    ds >> magic >> version >> sourceName >> sourceSize >> sourceModified >> sourceParseOptions >> curveCount;
+
+    // only use a cache of the current file, parsed with the current renaming options
+    if (ds.status() != QDataStream::Ok || magic != ANIMATION_CACHE_MAGIC || version != ANIMATION_CACHE_VERSION ||
+        sourceName != fileInfo.absoluteFilePath() || sourceSize != fileInfo.size() ||
+        sourceModified != fileInfo.lastModified() || sourceParseOptions != parseOptions || curveCount < 0)
+        return false;
+
+    curves.reserve(curveCount);
+    for (qint32 i = 0; i < curveCount && ds.status() == QDataStream::Ok; ++i) {
+        AnimCurve animCurve;
+        animCurve.length = 0.0;
+        qint32 keyCount;
+        ds >> animCurve.name >> keyCount;
+        if (keyCount < 0)
+            break;
+
+        animCurve.keys.reserve(keyCount);
+        for (qint32 k = 0; k < keyCount; ++k) {
+            float time, value;
+            ds >> time >> value;
+            animCurve.keys.append(QPair<float, float>(time, value));
+        }
+        curves.insert(animCurve.name, animCurve);
+    }
+
+    if (ds.status() != QDataStream::Ok || curves.size() != curveCount) {
+        curves.clear();
+        return false;
+    }
+    return true;
+}
+
+
+//!
+//! Writes the animation curves to the binary cache file of the given
+//! animation file.
+//!
+//! \param filename The name of the animation file.
+//! \param parseOptions The options the curves have been parsed with.
+//! \param curves The animation curves.
+//! \return True if the cache file was written.
+//!
+bool AnimationCurveCache::write ( const QString &filename, const QString &parseOptions, const QHash<QString, AnimCurve> &curves )
+{
+    const QFileInfo fileInfo (filename);
+    const QString cacheFilename = getCacheFilename(filename);
+
+    // write to a temporary file and rename it, so a node loading the same
+    // clip never reads a partially written cache file
+    const QString tempFilename = QString("%1.%2.tmp").arg(cacheFilename).arg(QCoreApplication::applicationPid());
+    QFile cacheFile (tempFilename);
+    if (!cacheFile.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream ds (&cacheFile);
+    ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    ds << (quint32) ANIMATION_CACHE_MAGIC << (quint32) ANIMATION_CACHE_VERSION << fileInfo.absoluteFilePath()
+       << (qint64) fileInfo.size() << fileInfo.lastModified() << parseOptions
+       << (qint32) curves.size();
+
+    QHash<QString, AnimCurve>::const_iterator curveIter = curves.constBegin();
+    while (curveIter != curves.constEnd()) {
+        const AnimCurve &animCurve = curveIter.value();
+        ds << animCurve.name << (qint32) animCurve.keys.size();
+        QList<QPair<float, float> >::const_iterator keyIter = animCurve.keys.constBegin();
+        while (keyIter != animCurve.keys.constEnd()) {
+            ds << keyIter->first << keyIter->second;
+            ++keyIter;
+        }
+        ++curveIter;
+    }
+    cacheFile.close();
+
+    if (ds.status() != QDataStream::Ok || cacheFile.error() != QFile::NoError) {
+        QFile::remove(tempFilename);
+        return false;
+    }
+
+    QFile::remove(cacheFilename);
+    if (!QFile::rename(tempFilename, cacheFilename)) {
+        QFile::remove(tempFilename);
+        // another node may have written the cache in the meantime
+        return QFile::exists(cacheFilename);
+    }
+    return true;
+}
+
+
+///
+/// AnimationTracks
+///
+
+//!
+//! Constructor of the AnimationTracks class.
+//!
+AnimationTracks::AnimationTracks () :
+m_animation(0),
+m_sampleTime(0.0f),
+m_sampleValid(false)
+{
+}
+
+
+//!
+//! Destructor of the AnimationTracks class.
+//!
+AnimationTracks::~AnimationTracks ()
+{
+    clear();
+}
+
+
+//!
+//! Generates one OGRE node animation track per animation curve. The values
+//! are stored in the scale of the key frames, because spline interpolation
+//! is not available for NumericKeyFrame.
+//!
+//! \param clipName Name of the clip.
+//! \param clipLength Overall length of the animation clip.
+//! \param curves The animation curves.
+//! \param spline Use spline instead of linear interpolation.
+//! \param forwCurveMap Receives the track index of each curve name.
+//! \param backwCurveMap Receives the curve name of each track index.
+//!
+void AnimationTracks::create ( const QString &clipName, float clipLength, const QHash<QString, AnimCurve> &curves, bool spline,
+    QHash<QString, unsigned short> &forwCurveMap, QHash<unsigned short, QString> &backwCurveMap )
+{
+    clear();
+
+    m_animation = new Ogre::Animation(clipName.toStdString(), clipLength);
+    setSpline(spline);
+
+    unsigned short animTrackId = 0;
+
+    QHash<QString, AnimCurve>::const_iterator curveIter = curves.constBegin();
+    while (curveIter != curves.constEnd()) {
+        Ogre::NodeAnimationTrack *animTrack = m_animation->createNodeTrack(animTrackId);
+        const AnimCurve &tmpCurve = curveIter.value();
+        forwCurveMap.insert(tmpCurve.name, animTrackId);
+        backwCurveMap.insert(animTrackId, tmpCurve.name);
+        QList<QPair<float, float>>::const_iterator i = (tmpCurve.keys).constBegin();
+        while (i != (tmpCurve.keys).constEnd()) {
+            Ogre::TransformKeyFrame *keyFrame = animTrack->createNodeKeyFrame(i->first);
+            keyFrame->setScale(Ogre::Vector3(i->second, 0.0, 0.0));
+            ++i;
+        }
+        ++animTrackId;
+        ++curveIter;
+    }
+
+    // resolve the tracks by index and store their values at the first key frame
+    const unsigned short numTracks = m_animation->getNumNodeTracks();
+    m_tracks.resize(numTracks);
+    m_offsets.resize(numTracks);
+    m_values.fill(0.0f, numTracks);
+    for (unsigned short i = 0; i < numTracks; ++i) {
+        Ogre::NodeAnimationTrack *track = m_animation->getNodeTrack(i);
+        m_tracks[i] = track;
+        m_offsets[i] = 0.0;
+        if (track->getNumKeyFrames() > 0)
+            m_offsets[i] = track->getNodeKeyFrame(0)->getScale().x;
+    }
+    m_sampleValid = false;
+}
+
+
+//!
+//! Deletes the animation and its tracks.
+//!
+void AnimationTracks::clear ()
+{
+    delete m_animation;
+    m_animation = 0;
+    m_tracks.clear();
+    m_offsets.clear();
+    m_values.clear();
+    m_sampleValid = false;
+}
+
+
+//!
+//! Sets the interpolation mode of the animation.
+//!
+//! \param spline Use spline instead of linear interpolation.
+//!
+void AnimationTracks::setSpline ( bool spline )
+{
+    if (m_animation) {
+        if (spline)
+            m_animation->setInterpolationMode(Ogre::Animation::IM_SPLINE);
+        else
+            m_animation->setInterpolationMode(Ogre::Animation::IM_LINEAR);
+    }
+    m_sampleValid = false;
+}
+
+
+//!
+//! Samples all tracks at the given time into the value buffer, unless it
+//! already holds the values for that time.
+//!
+//! \param time The time to sample the tracks at.
+//!
+void AnimationTracks::sample ( float time )
+{
+    if (!m_animation || (m_sampleValid && m_sampleTime == time))
+        return;
+
+    // the time index is shared by all tracks and holds the key frame index,
+    // so the tracks do not need to search their key frames
+    Ogre::TimeIndex timeIndex = m_animation->_getTimeIndex(time);
+    Ogre::TransformKeyFrame interpKeyFrame(NULL, time);
+
+    // scale.x is used to store values
+    for (int i = 0; i < m_tracks.size(); ++i) {
+        m_tracks[i]->getInterpolatedKeyFrame(timeIndex, &interpKeyFrame);
+        m_values[i] = interpKeyFrame.getScale().x;
+    }
+
+    m_sampleTime = time;
+    m_sampleValid = true;
+}
+
+} // namespace AnimationClipNode
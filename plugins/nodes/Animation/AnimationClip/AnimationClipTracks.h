@@ -0,0 +1,216 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AnimationClipTracks.h"
+//! \brief Header file for AnimationCurveCache and AnimationTracks classes.
+//!
+//! The animation curves, their cache file and their OGRE tracks do not
+//! depend on the node or the scene manager, so they can be loaded and
+//! sampled without an AnimationClipNode.
+//!
+//! \version    1.0
+//! \date       19.10.2026 (created)
+//!
+
+#ifndef ANIMATIONCLIPTRACKS_H
+#define ANIMATIONCLIPTRACKS_H
+
+#include <QtCore/QString>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QVector>
+
+// OGRE
+#include "Ogre.h"
+#if (OGRE_PLATFORM  == OGRE_PLATFORM_WIN32)
+#include <windows.h>
+#endif
+
+namespace AnimationClipNode {
+
+//!
+//! Data structure for animation curves.
+//!
+struct AnimCurve
+{
+
+public: // constructors and destructors
+
+    AnimCurve()
+    {
+    }
+
+    ~AnimCurve()
+    {
+        keys.clear();
+    }
+
+public: // data
+
+	float length;
+    QString name;
+    QList<QPair<float, float>> keys;
+
+};
+
+
+//!
+//! Class reading and writing the animation curves of an animation file to
+//! a binary cache file next to it.
+//!
+class AnimationCurveCache
+{
+
+public: // functions
+
+    //!
+    //! Returns the name of the cache file of the given animation file.
+    //!
+    static QString getCacheFilename ( const QString &filename );
+
+    //!
+    //! Reads the animation curves from the cache file of the given
+    //! animation file.
+    //!
+    //! \param filename The name of the animation file.
+    //! \param parseOptions The options the curves have to be parsed with.
+    //! \param curves Receives the animation curves.
+    //! \return True if the cache exists and is up to date, otherwise False.
+    //!
+    static bool read ( const QString &filename, const QString &parseOptions, QHash<QString, AnimCurve> &curves );
+
+    //!
+    //! Writes the animation curves to the cache file of the given animation
+    //! file. Readers never see a partially written cache file.
+    //!
+    //! \param filename The name of the animation file.
+    //! \param parseOptions The options the curves have been parsed with.
+    //! \param curves The animation curves.
+    //! \return True if the cache file was written.
+    //!
+    static bool write ( const QString &filename, const QString &parseOptions, const QHash<QString, AnimCurve> &curves );
+};
+
+
+//!
+//! Class holding the OGRE animation of a set of animation curves and the
+//! values of its tracks sampled at a time.
+//!
+class AnimationTracks
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the AnimationTracks class.
+    //!
+    AnimationTracks ();
+
+    //!
+    //! Destructor of the AnimationTracks class.
+    //!
+    ~AnimationTracks ();
+
+public: // functions
+
+    //!
+    //! Creates one track per animation curve, replacing the previous tracks.
+    //!
+    //! \param clipName Name of the clip.
+    //! \param clipLength Overall length of the animation clip.
+    //! \param curves The animation curves.
+    //! \param spline Use spline instead of linear interpolation.
+    //! \param forwCurveMap Receives the track index of each curve name.
+    //! \param backwCurveMap Receives the curve name of each track index.
+    //!
+    void create ( const QString &clipName, float clipLength, const QHash<QString, AnimCurve> &curves, bool spline,
+        QHash<QString, unsigned short> &forwCurveMap, QHash<unsigned short, QString> &backwCurveMap );
+
+    //!
+    //! Deletes the animation and its tracks.
+    //!
+    void clear ();
+
+    //!
+    //! Returns whether the tracks have been created.
+    //!
+    bool isValid () const { return m_animation != 0; }
+
+    //!
+    //! Sets the interpolation mode of the animation.
+    //!
+    //! \param spline Use spline instead of linear interpolation.
+    //!
+    void setSpline ( bool spline );
+
+    //!
+    //! Samples all tracks at the given time, unless the values already
+    //! hold that time.
+    //!
+    //! \param time The time to sample the tracks at.
+    //!
+    void sample ( float time );
+
+    //!
+    //! Returns the number of tracks.
+    //!
+    int getNumTracks () const { return m_tracks.size(); }
+
+    //!
+    //! Returns the value of the given track at the last sampled time.
+    //!
+    float getValue ( int index ) const { return m_values[index]; }
+
+    //!
+    //! Returns the value of the given track at its first key frame.
+    //!
+    float getOffset ( int index ) const { return m_offsets[index]; }
+
+private: // functions
+
+    //!
+    //! Copying would share the animation.
+    //!
+    AnimationTracks ( const AnimationTracks & );
+    AnimationTracks &operator= ( const AnimationTracks & );
+
+private: // data
+
+    Ogre::Animation *m_animation;
+
+    //!
+    //! The tracks of the animation by index, their values at the first key
+    //! frame and their values sampled at m_sampleTime.
+    //!
+    QVector<Ogre::NodeAnimationTrack *> m_tracks;
+    QVector<float> m_offsets;
+    QVector<float> m_values;
+    float m_sampleTime;
+    bool m_sampleValid;
+};
+
+} // namespace AnimationClipNode
+
+#endif
@@ -32,6 +32,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "ImageSaverNode.h"
 #include "Log.h"
+#include "ImageWriter.h"
 
 namespace ImageSaverNode {
 using namespace Frapper;
@@ -110,48 +111,11 @@ ImageSaverNode::~ImageSaverNode ()
 ///
 
 //!
-//! Saves the a texture to a file.
-//!
-//! NOTE: This code snippet is based on the function Ogre::Texture::convertToImage()
-//! that is intruduced with OGRE v.17 RC1
-//!
-//! /todo Christopher: Once FRAPPER is migrated to OGRE v1.7, use
-//! Ogre::Texture::convertToImage() instead to avoid duplicate code
+//! Copies a texture and queues it to be written to a file by the image writer.
 //!
 void ImageSaverNode::saveImage(Ogre::TexturePtr tex, std::string filename)
 {
-	size_t numMips = 1;
-	size_t dataSize = Ogre::Image::calculateSize(numMips,
-		tex->getNumFaces(), tex->getWidth(), tex->getHeight(), tex->getDepth(), tex->getFormat());
-
-	void* pixData = OGRE_MALLOC(dataSize, Ogre::MEMCATEGORY_GENERAL);
-	// if there are multiple faces and mipmaps we must pack them into the data
-	// faces, then mips
-	void* currentPixData = pixData;
-	for (size_t face = 0; face < tex->getNumFaces(); ++face)
-	{
-		for (size_t mip = 0; mip < numMips; ++mip)
-		{
-			size_t mipDataSize = Ogre::PixelUtil::getMemorySize(tex->getWidth(),
-				tex->getHeight(), tex->getDepth(), tex->getFormat());
-
-			Ogre::PixelBox pixBox(tex->getWidth(), tex->getHeight(), tex->getDepth(), tex->getFormat(), currentPixData);
-			tex->getBuffer(face, mip)->blitToMemory(pixBox);
-
-			currentPixData = (void*)((char*)currentPixData + mipDataSize);
-
-		}
-	}
-
-	// load, and tell Image to delete the memory when it's done.
-	Ogre::Image destImage;
-	destImage.loadDynamicImage((Ogre::uchar*)pixData, tex->getWidth(), tex->getHeight(), tex->getDepth(),
-		tex->getFormat(), true, tex->getNumFaces(), numMips - 1);
-
-	destImage.save(filename);
-
-    //OGRE_FREE( pixData, Ogre::MEMCATEGORY_GENERAL);
-
+	ImageWriter::getInstance()->submit(new OgreImageWriteJob(QString::fromStdString(filename), tex));
 }
 
 //!
@@ -225,7 +189,7 @@ void ImageSaverNode::saveAllImages()
 		// add extension
 		filename += fileFormat;
 
-		// save image
+		// queue image for saving
 		saveImage(inputTexture, QString(path + filename).toStdString());
         m_currentFrame++;
 		Log::info(QString(path + filename), "ImageSaverNode::saveAllImages");
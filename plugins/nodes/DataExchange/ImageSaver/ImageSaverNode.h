@@ -77,7 +77,7 @@ protected: // static constants
 
 private:
 	//!
-	//! Converts a texture to an image and then saves it to a file
+	//! Copies a texture to an image and queues it to be saved to a file
 	//!
 	void saveImage(Ogre::TexturePtr tex, std::string filename);
 
@@ -55,8 +55,7 @@ INIT_INSTANCE_COUNTER(ImageSaverCVNode)
 //!
 ImageSaverCVNode::ImageSaverCVNode ( const QString &name, ParameterGroup *parameterRoot ) :
 Node(name, parameterRoot),
-	m_imageCounter(0),
-	m_endThreadRequested(false)
+	m_imageCounter(0)
 {
 	int cp[] = {CV_IMWRITE_JPEG_QUALITY, 50};
 	m_compression_params = std::vector<int>(cp, cp+(sizeof(cp)/sizeof(cp[0])));
@@ -82,8 +81,6 @@ Node(name, parameterRoot),
 	m_timeParameter->setSelfEvaluating(true);
 	parameterRoot->addParameter(m_timeParameter);
 
-	start(QThread::LowestPriority);
-
 	INC_INSTANCE_COUNTER
 }
 
@@ -97,7 +94,6 @@ Node(name, parameterRoot),
 //!
 ImageSaverCVNode::~ImageSaverCVNode ()
 {
-	m_endThreadRequested = true;
     DEC_INSTANCE_COUNTER
 }
 
@@ -107,112 +103,90 @@ ImageSaverCVNode::~ImageSaverCVNode ()
 ///
 
 //!
-//! Saves the a texture to a file.
+//! Copies the input image and queues it to be saved to a file.
 //!
 void ImageSaverCVNode::saveImage()
 {
-	m_sleepThread.wakeOne();
-	//// the base filename
-	//const QStringList &filename = m_filenameParameter->getValue().toString().split('.');
-	//QString timeString = "";
-	//
-	//const int inTime = m_timeParameter->getValue().toInt();
-
-	//if (inTime > 0) {
-	//	div_t qr = div(inTime, 1000);
-	//	const int ms = qr.rem;
-	//	qr = div(qr.quot, 60);
-	//	const int s  = qr.rem;
-	//	qr = div(qr.quot, 60);
-	//	const int m  = qr.rem;
-	//	const int h  = qr.quot;
-
-	//	timeString = QString("%1%2_%3_%4")
-	//		.arg(h, 2, 10, QLatin1Char('0'))
-	//		.arg(m, 2, 10, QLatin1Char('0'))
-	//		.arg(s, 2, 10, QLatin1Char('0'))
-	//		.arg(ms, 4, 10, QLatin1Char('0'));
-	//}
-
-	//if (filename.size() > 1) {
-	//	cv::Mat *cvImage = m_inputImage->getValue().value<cv::Mat*>();
-
-	//	if (cvImage && cvImage->data) {
-	//		const QString finalFilename = QString("%1_%2_%3.%4")
-	//			.arg(filename.at(0))
-	//			.arg(QString::number(m_imageCounter++))
-	//			.arg(timeString)
-	//			.arg(filename.at(1));
-
-	//		cv::Mat cvImageFormated;
-	//		// channel shift R<->B
-	//		//cvtColor(*cvImage, cvImageFormated, CV_BGR2RGB);
-
-	//		QImage qImage = QImage(cvImageFormated.data, cvImage->cols, cvImage->rows, QImage::Format_RGB888);
-	//		qImage.save(finalFilename, filename.at(1).toStdString().c_str(), 95);
-	//	}
-	//}
+	// the base filename
+	const QStringList &filename = m_filenameParameter->getValue().toString().split('.');
+	QString timeString = "";
+
+	const int inTime = m_timeParameter->getValue().toInt();
+
+	if (inTime > 0) {
+		div_t qr = div(inTime, 1000);
+		const int ms = qr.rem;
+		qr = div(qr.quot, 60);
+		const int s  = qr.rem;
+		qr = div(qr.quot, 60);
+		const int m  = qr.rem;
+		const int h  = qr.quot;
+
+		timeString = QString("%1%2_%3_%4")
+			.arg(h, 2, 10, QLatin1Char('0'))
+			.arg(m, 2, 10, QLatin1Char('0'))
+			.arg(s, 2, 10, QLatin1Char('0'))
+			.arg(ms, 4, 10, QLatin1Char('0'));
+	}
+
+	if (filename.size() > 1) {
+		cv::Mat *cvImage = m_inputImage->getValue().value<cv::Mat*>();
+
+		if (cvImage && cvImage->data) {
+			const QString finalFilename = QString("%1_%2_%3.%4")
+				.arg(filename.at(0))
+				.arg(QString::number(m_imageCounter++))
+				.arg(timeString)
+				.arg(filename.at(1));
+
+			// encoding and writing is done by the image writer
+			ImageWriter::getInstance()->submit(new CvImageWriteJob(finalFilename, *cvImage, m_compression_params));
+		}
+	}
 }
 
+
+///
+/// Constructors of CvImageWriteJob
+///
+
+
+//!
+//! Constructor of the CvImageWriteJob class.
 //!
-//! Thread to get newFrame from Camera
+//! \param filename The name of the file to write.
+//! \param image The image to write, it is copied.
+//! \param parameters The encoder parameters passed to cv::imwrite.
 //!
-void ImageSaverCVNode::run()
+CvImageWriteJob::CvImageWriteJob ( const QString &filename, const cv::Mat &image, const std::vector<int> &parameters ) :
+	ImageWriteJob(filename),
+	m_image(image.clone()),
+	m_parameters(parameters)
 {
-	forever {
-		//if stopping of thread has been requested, stop the thread
-		if ( m_endThreadRequested ) { 
-			quit();
-			return;		
-		}
-
-		//QMutexLocker locker(&m_frameVideoMutex); //lock mutex
-		m_sleepThread.wait(&m_frameVideoMutex);
-
-		// the base filename
-		const QStringList &filename = m_filenameParameter->getValue().toString().split('.');
-		QString timeString = "";
-
-		const int inTime = m_timeParameter->getValue().toInt();
-
-		if (inTime > 0) {
-			div_t qr = div(inTime, 1000);
-			const int ms = qr.rem;
-			qr = div(qr.quot, 60);
-			const int s  = qr.rem;
-			qr = div(qr.quot, 60);
-			const int m  = qr.rem;
-			const int h  = qr.quot;
-
-			timeString = QString("%1%2_%3_%4")
-				.arg(h, 2, 10, QLatin1Char('0'))
-				.arg(m, 2, 10, QLatin1Char('0'))
-				.arg(s, 2, 10, QLatin1Char('0'))
-				.arg(ms, 4, 10, QLatin1Char('0'));
-		}
-
-		if (filename.size() > 1) {
-			cv::Mat *cvImage = m_inputImage->getValue().value<cv::Mat*>();
+}
 
-			if (cvImage && cvImage->data) {
-				const QString finalFilename = QString("%1_%2_%3.%4")
-					.arg(filename.at(0))
-					.arg(QString::number(m_imageCounter++))
-					.arg(timeString)
-					.arg(filename.at(1));
 
-				// old qt writeout...
-				//// channel shift R<->B
-				//cv::Mat cvImageFormated;
-				//cvtColor(*cvImage, cvImageFormated, CV_BGR2RGB);
+///
+/// Public Functions of CvImageWriteJob
+///
 
-				//QImage qImage = QImage(cvImage->data, cvImage->cols, cvImage->rows, QImage::Format_RGB888);
-				//qImage.save(finalFilename, filename.at(1).toStdString().c_str(), 95);
 
-				cv::imwrite(finalFilename.toStdString(), *cvImage, m_compression_params);
-			}
-		}
+//!
+//! Encodes and writes the image.
+//!
+//! \param errorMessage The message to set if writing fails.
+//! \return True if the image was written, otherwise False.
+//!
+bool CvImageWriteJob::write ( QString &errorMessage )
+{
+	try {
+		if (cv::imwrite(getFilename().toStdString(), m_image, m_parameters))
+			return true;
+		errorMessage = "No encoder for the file extension or the file could not be opened.";
+	} catch (cv::Exception &e) {
+		errorMessage = QString::fromStdString(e.what());
 	}
+	return false;
 }
 
 
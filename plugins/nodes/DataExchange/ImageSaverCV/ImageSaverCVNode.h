@@ -50,14 +50,53 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #endif
 
 #include "Node.h"
-#include <QtCore/QThread>
-#include <QWaitCondition>
-#include <QMutex>
+#include "ImageWriter.h"
 //#include "InstanceCounterMacros.h"
 
 namespace ImageSaverCVNode {
 using namespace Frapper;
 
+//!
+//! Job writing a copy of an OpenCV matrix to a file.
+//!
+class CvImageWriteJob : public ImageWriteJob
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the CvImageWriteJob class.
+    //!
+    //! \param filename The name of the file to write.
+    //! \param image The image to write, it is copied.
+    //! \param parameters The encoder parameters passed to cv::imwrite.
+    //!
+    CvImageWriteJob ( const QString &filename, const cv::Mat &image, const std::vector<int> &parameters );
+
+public: // functions
+
+    //!
+    //! Encodes and writes the image.
+    //!
+    //! \param errorMessage The message to set if writing fails.
+    //! \return True if the image was written, otherwise False.
+    //!
+    virtual bool write ( QString &errorMessage );
+
+private: // data
+
+    //!
+    //! The copy of the image.
+    //!
+    cv::Mat m_image;
+
+    //!
+    //! The encoder parameters.
+    //!
+    std::vector<int> m_parameters;
+};
+
+
 //!
 //! Class representing nodes that save input images.
 //!
@@ -94,35 +133,13 @@ private slots: //
     //!
     void saveImage ();
 
-private: // methods
-	
-	//!
-	//! Thread to get newFrame from Camera
-	//!
-	virtual void run();
-
 private: // member variables
 
-	//!
-    //! Is termination of run-thread requested?
-    //!
-	bool m_endThreadRequested;
-
     //!
     //! Image counter
     //!
     int m_imageCounter;
 
-	//!
-	//! Is used to set the workerthread to sleep
-	//!
-	QWaitCondition m_sleepThread;
-
-	//!
-	//! Is used by moreFrames to syncronize Mainthread with workerthread
-	//!
-	QMutex m_frameVideoMutex;
-
 	GenericParameter *m_inputImage;
 	FilenameParameter *m_filenameParameter;
 	NumberParameter *m_timeParameter;
@@ -33,6 +33,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "ImageSaverOgreNode.h"
 #include "Log.h"
 #include "OgreTools.h"
+#include "ImageWriter.h"
 #include <QDateTime>
 
 namespace ImageSaverOgreNode {
@@ -105,7 +106,7 @@ ImageSaverOgreNode::~ImageSaverOgreNode ()
 ///
 
 //!
-//! Saves the a texture to a file.
+//! Queues the input texture to be saved to a file.
 //!
 void ImageSaverOgreNode::saveImage()
 {
@@ -141,14 +142,13 @@ void ImageSaverOgreNode::saveImage()
 				.arg(timeString)
 				.arg(filename.at(1));
 
-			OgreTools::HardwareBufferLocker hbl(ogreImage->getBuffer(), Ogre::HardwareBuffer::HBL_NO_OVERWRITE); // use HBL_NORMAL if any problems occur
-			
-			const Ogre::PixelBox &readrefpb = hbl.getCurrentLock();    
-			uchar *readrefdata = static_cast<uchar*>(readrefpb.data);
-
-			Ogre::Image img;
-			img = img.loadDynamicImage(readrefdata, ogreImage->getWidth(), ogreImage->getHeight(), ogreImage->getFormat());    
-			img.save(finalFilename.toStdString());
+			// copy the pixels while the buffer is locked, encoding and writing is done by the image writer
+			ImageWriteJob *job = 0;
+			{
+				OgreTools::HardwareBufferLocker hbl(ogreImage->getBuffer(), Ogre::HardwareBuffer::HBL_NO_OVERWRITE); // use HBL_NORMAL if any problems occur
+				job = new OgreImageWriteJob(finalFilename, hbl.getCurrentLock());
+			}
+			ImageWriter::getInstance()->submit(job);
 		}
 	}
 }
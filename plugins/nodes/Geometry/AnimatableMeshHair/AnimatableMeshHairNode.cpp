@@ -877,108 +877,71 @@ bool AnimatableMeshHairNode::loadMesh ()
 	m_oldResourceGroupName = resourceGroupName;
 	OgreTools::createResourceGroup(resourceGroupName, path);
 
-	int debugFloatCounter = 0;
-
 	// create a new OGRE entity for the mesh file
 	m_entity = sceneManager->createEntity(m_name.toStdString(), filename.toStdString(), resourceGroupName.toStdString());
 
 	if ( m_entity ) {
 		const Ogre::MeshPtr mesh = m_entity->getMesh();
 		const Ogre::Mesh::SubMeshNameMap &nameMap = mesh->getSubMeshNameMap();
-		const int numOfSubentities = m_entity->getNumSubEntities();
 
 		// Create unique name for hair-texture
 		Ogre::String hairCoordName = createUniqueName("HairCoordTexture_AnimatableMeshHairNode");
 		Ogre::String hairTangentsName = createUniqueName("HairTangentsTexture_AnimatableMeshHairNode");
 
-		// Number of guide hairs should be equal than "m_entity->getNumSubEntities() - 1" after loop below;
-		m_NumberOfGuideHairs = 0;
-
-		// Number of segments per guide-hair should be equal for all guide strands
-		m_NumberMaxOfHairSegments = -1;
-
-		// total number of values (number of vertices of all guide hairs)
-		m_NumberOverallHairGuideVertices = 0;
-
-		// Index of vertex buffer
-		const int bufferIdx = 0;
-
-		size_t hairIndexCount = 0;
-		size_t hairGrowthMeshIndexCount = 0;
-		Ogre::SubMesh *meshShapeSubMesh = NULL;
-
-		std::vector<std::vector<Ogre::Vector3>> hairStrands;
-
-		// Loop to figure out the number of segments per guide strand
-		// and check for all guides have the same amount of segments.
-		// In addition the number of guide-hairs is counted
-
 		// Get scalp mesh name
-		bool scalpMeshFound = false;
 		const QString scalpMeshName = getStringValue("Scalp Mesh Name");
 		// Get hair guides name
 		m_hairGuideName = getStringValue("Hair Guides Name");
 
-		for (Ogre::Mesh::SubMeshNameMap::const_iterator &nameMapIter = nameMap.begin(); nameMapIter != nameMap.end(); ++nameMapIter) {
+		// Read guide strands, scalp bindings and curl deviations from the
+		// sidecar cache next to the mesh and extract them only if the cache
+		// is missing or stale
+		const QString meshFilename = path.isEmpty() ? filename : path + "/" + filename;
+		const QString groomFilename = HairGroom::getSidecarFilename(meshFilename);
+		const bool useGroomCache = getBoolValue("Use Groom Cache");
+
+		HairGroom groom;
+		QByteArray groomKey;
+		if (useGroomCache)
+			groomKey = HairGroom::computeKey(meshFilename, scalpMeshName, m_hairGuideName, m_rootVertexToScalpVertexDistance, singleStrandHair);
+
+		if (groom.load(groomFilename, groomKey)) {
+			Log::debug(QString("Hair groom read from \"%1\".").arg(groomFilename), "AnimatableMeshHairNode::loadMesh");
+		}
+		else {
+			if (!groom.extract(mesh, scalpMeshName, m_hairGuideName, m_rootVertexToScalpVertexDistance, singleStrandHair))
+				return false;
+
+			if (useGroomCache && !groomKey.isEmpty() && !groom.save(groomFilename, groomKey))
+				Log::warning(QString("Hair groom cache \"%1\" could not be written.").arg(groomFilename), "AnimatableMeshHairNode::loadMesh");
+		}
+
+		// Scalp mesh and guide strand visibility
+		const bool renderGuideStrands = getBoolValue("Render Guide Strands");
+		for (Ogre::Mesh::SubMeshNameMap::const_iterator nameMapIter = nameMap.begin(); nameMapIter != nameMap.end(); ++nameMapIter) {
 			const QString &subMeshName = nameMapIter->first.c_str();
-			Ogre::SubMesh *subMesh = mesh->getSubMesh(nameMapIter->first);
 
 			if( subMeshName.contains(scalpMeshName, Qt::CaseInsensitive) ) { 
-				scalpMeshFound = true;
-
-				hairGrowthMeshIndexCount = subMesh->indexData->indexCount / 3;
-				meshShapeSubMesh = subMesh;
-				m_scalpMeshSubEntity =  m_entity->getSubEntity(nameMapIter->second);
+				m_scalpMeshSubEntity = m_entity->getSubEntity(nameMapIter->second);
 
 				if(!getBoolValue("Render Scalp Mesh"))
 					m_scalpMeshSubEntity->setVisible(false);
 			}
 
-			// Check for working only on hair geo and not on the groth-mesh
-			if (subMeshName.contains(m_hairGuideName, Qt::CaseInsensitive)) {
-				m_NumberOfGuideHairs++;
-
-				// Number of vertices in current submesh
-				const int numOfGuideVertices = subMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx)->getNumVertices();
-				// Number of segments (calculated from number of vertices minus the start/end vertex)
-				const int tempNumOfGuideHairSegments = numOfGuideVertices - 1;
-
-				m_NumberOverallHairGuideVertices += numOfGuideVertices;
-
-				// This is done only for the first hair submesh
-				//if (m_NumberMaxOfHairSegments < 0)
-				// save maximum number of hair segments
-				if(m_NumberMaxOfHairSegments < tempNumOfGuideHairSegments) {
-					// Number of vertices in current submesh
-					m_NumberMaxOfHairSegments = tempNumOfGuideHairSegments;
-				}
+			if( !renderGuideStrands && subMeshName.contains(m_hairGuideName, Qt::CaseInsensitive) ) {
+				// do not render guide hair
+				m_entity->getSubEntity(nameMapIter->second)->setVisible(false);
 			}
 		}
-		setValue("Number of Hair Segments", QString("%L1").arg(m_NumberMaxOfHairSegments), true);
 
+		m_NumberOfGuideHairs = groom.numberOfGuideHairs;
+		m_NumberMaxOfHairSegments = groom.maxNumberOfSegments;
+		m_NumberOverallHairGuideVertices = groom.getNumberOfStrandVertices();
+		const size_t hairGrowthMeshIndexCount = groom.getNumberOfScalpTriangles();
 
-		if(!scalpMeshFound) {
-			Log::error("Scalp mesh: '" + scalpMeshName + "' has not been found!", "GeometryAnimationNode::loadMesh");
-			return false;
-		}
-
-		if(m_NumberOfGuideHairs == 0) {
-			Log::error("Guide hairs containing name: '" + m_hairGuideName + "' have not been found!", "GeometryAnimationNode::loadMesh");
-			return false;
-		}
-
+		setValue("Number of Hair Segments", QString("%L1").arg(m_NumberMaxOfHairSegments), true);
 		setValue("Number of Guide Hairs", QString("%L1").arg(m_NumberOfGuideHairs), true);
 
-
-		// Search for textures
-		//int lastDotIndex = filename.lastIndexOf('.');
-		//QString meshFilename = filename.mid(0, lastDotIndex);
-		//QString textureFilenamePrefix = path + "/" + meshFilename;
-		//QString textureFilename = textureFilenamePrefix + "_HairCoordTex.png";
-
-		//m_hairCoordTex = Ogre::TextureManager::getSingleton().load(textureFilename.toStdString(), "General");
-
-
 		// Calculate size of texture. (The texture for storing vertex positions)
 		// The texture has to be quadratic and its length has to be always an number power of 2
 		const int texturesizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)m_NumberOverallHairGuideVertices)));
@@ -1008,7 +971,6 @@ bool AnimatableMeshHairNode::loadMesh ()
 		const Ogre::PixelBox &pb = hairPixelBuffer->getCurrentLock();
 		Ogre::Real* pFloat = 0;
 		pFloat = static_cast<Ogre::Real*>(pb.data);
-		int writeVertexPos = 0;
 
 
 		// Create ogre texture manual for hair vertex tangents data
@@ -1030,450 +992,139 @@ bool AnimatableMeshHairNode::loadMesh ()
 		const Ogre::PixelBox &pixelBoxHairTangents = hairTangentsPixelBuffer->getCurrentLock();
 		Ogre::Real* pFloatTangents = 0;
 		pFloatTangents = static_cast<Ogre::Real*>(pixelBoxHairTangents.data);
-		int writeTangentsPos = 0;
-
-		//size_t hairMeshIndexCount = 0;			// how many indices are needed for the final hair
-		int indexTexturesizeXY = 0;
-
-		if( meshShapeSubMesh ) {
-			// guide hair strand data for creation of index buffer
-			std::vector<GuideHairIndexData> guideHairIndexData;
-
-			const bool renderGuideStrands = getBoolValue("Render Guide Strands");
-
-			// Read vertex data, search for corresponding guide strand and save guide strand to texture
-			// --------------------------
-			// Get the format (vertex declaration) of the vertices in the buffer
-			const Ogre::VertexDeclaration* meshShapeDecl = meshShapeSubMesh->vertexData->vertexDeclaration;
-
-			// Get the number of the attributes (elements) in the buffer
-			int numOfElementsInBuffer = meshShapeDecl->getElementCount();
-
-			// Get Vertex Buffer
-			Ogre::HardwareVertexBufferSharedPtr meshShapeVBuffer = meshShapeSubMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx);
-
-			// Lock vertex-buffer to access content
-			unsigned char* meshShapeVertexBufferPtr = static_cast<unsigned char*>(meshShapeVBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-
-			Ogre::Real* pMeshShapeVertex;
-			Ogre::Real* pMeshShapeNormal;
-
-			const size_t numVertices = meshShapeSubMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx)->getNumVertices();
-
-			std::list<Ogre::Vector3> normalList;		// index list of scalp mesh normals
-
-			// Read mesh vertex data to texture buffer
-			for (size_t v = 0; v < numVertices; ++v) {
-				// Get elements
-				const Ogre::VertexDeclaration::VertexElementList &elemsList = meshShapeDecl->findElementsBySource(bufferIdx);
-				Ogre::VertexDeclaration::VertexElementList::const_iterator i, iend;
-
-				// Loop through elements
-				for ( i = elemsList.begin(); i != elemsList.end(); ++i ) {
-
-					if ( i->getSemantic() == Ogre::VertexElementSemantic::VES_POSITION ) {
-						i->baseVertexPointerToElement(meshShapeVertexBufferPtr, &pMeshShapeVertex);
-
-						Ogre::Vector3 meshVertex( pMeshShapeVertex[0], pMeshShapeVertex[1], pMeshShapeVertex[2]);
-
-						bool guideStrandFound = false;
-
-						// Loop through all submeshes again the to write guide strand vertex positions into the texture
-						for (Ogre::Mesh::SubMeshNameMap::const_iterator nameMapIter = nameMap.begin(); nameMapIter != nameMap.end(); ++nameMapIter)  {
-							const QString &subMeshName = nameMapIter->first.c_str();
-							Ogre::SubMesh *subMesh = mesh->getSubMesh(nameMapIter->first);
-							Ogre::SubEntity *subEntity = m_entity->getSubEntity(nameMapIter->second);
-
-							// write positions to texture
-							if( subMeshName.contains(m_hairGuideName, Qt::CaseInsensitive) ) {
-								// Get the format (vertex declaration) of the vertices in the buffer
-								const Ogre::VertexDeclaration* decl = subMesh->vertexData->vertexDeclaration;
-
-								// Get the number of the attributes (elements) in the buffer
-								int numOfElementsInBuffer = decl->getElementCount();
-
-								// Get Vertex Buffer
-								Ogre::HardwareVertexBufferSharedPtr vBuffer = subMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx);
-
-								// Lock vertex-buffer to access content
-								unsigned char* vertexBufferPtr = static_cast<unsigned char*>(vBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-
-								Ogre::Real* pReal;
-
-								// check first vertex if it is the right one we search for
-								// get first vertex
-								// Get elements
-								Ogre::VertexDeclaration::VertexElementList elemsList = decl->findElementsBySource(bufferIdx);
-								Ogre::VertexDeclaration::VertexElementList::const_iterator i, iend;
-
-								// Loop through elements
-								for ( i = elemsList.begin(); i != elemsList.end(); ++i ) {
-									if ( i->getSemantic() == Ogre::VertexElementSemantic::VES_POSITION )
-										i->baseVertexPointerToElement(vertexBufferPtr, &pReal);
-								}
-
-								// check if distance of the vertices is small enough
-								Ogre::Vector3 guideRootVertex(pReal[0], pReal[1], pReal[2]);
-								float distance = meshVertex.distance(guideRootVertex);
-
-								if ( distance <= m_rootVertexToScalpVertexDistance ) {
-									// check if vertices are the same
-									//if(	pReal[0] == pMeshShapeVertex[0] &&
-									//	pReal[1] == pMeshShapeVertex[1] &&
-									//	pReal[2] == pMeshShapeVertex[2] )
-									guideStrandFound = true;
-
-									// found correct guide strand
-									const size_t numVertices = subMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx)->getNumVertices();
-									const float currentNumOfGuideHairSegments = (float)(numVertices - 1);
-
-									// save guide hair data
-									GuideHairIndexData currentGuideHairIndexData;
-									currentGuideHairIndexData.rootTexturePosition = writeVertexPos/4;
-									currentGuideHairIndexData.strandSize = (float)(numVertices-1);
-									guideHairIndexData.push_back(currentGuideHairIndexData);
-
-									// Indices we need to render hair
-									//hairMeshIndexCount = hairMeshIndexCount + numVertices;
-
-									std::list<Ogre::Vector3> currentStrand;
-
-									// needed to save hair strand vector data and use for coordinate frame calculation
-									std::vector<Ogre::Vector3> currentStrandVector;
-
-									// Loop to write guid hair vertex data to texture buffer
-									for (size_t v = 0; v < numVertices; ++v) {
-										// Get elements
-										Ogre::VertexDeclaration::VertexElementList elemsList = decl->findElementsBySource(bufferIdx);
-										Ogre::VertexDeclaration::VertexElementList::const_iterator i, iend;
-
-										// Loop through elements
-										for ( i = elemsList.begin(); i != elemsList.end(); ++i ) {
-
-											if ( i->getSemantic() == Ogre::VertexElementSemantic::VES_POSITION ) {
-												i->baseVertexPointerToElement(vertexBufferPtr, &pReal);
-
-#ifdef WRITE_PREPARE_HAIR_LOG
-												std::cout << "Write to texture Position " << writeVertexPos << " -> " << pReal[0] << " " << pReal[1] << " " << pReal[2] << " 1.0" << std::endl;
-#endif
-												// write vertex
-												pFloat[writeVertexPos++] = pReal[0];
-												pFloat[writeVertexPos++] = pReal[1];
-												pFloat[writeVertexPos++] = pReal[2];
-												pFloat[writeVertexPos++] = (float)(numVertices-1-v);			// position distance to to hair tip
-
-												Ogre::Vector3 currentStrandVertex(pReal[0], pReal[1], pReal[2]);
-												currentStrand.push_back( currentStrandVertex );
-												currentStrandVector.push_back( currentStrandVertex );
-											}
-
-										}
-										vertexBufferPtr += vBuffer->getVertexSize();
-									}
-
-									// Unlock vertex buffer
-									vBuffer->unlock();
-
-									// add hair strand to vector
-									hairStrands.push_back( currentStrandVector );
-
-									// calculate tangents
-									std::list<Ogre::Vector3>::const_iterator iCurrent;
-									std::list<Ogre::Vector3>::const_iterator iPrevious = currentStrand.begin();
-									std::list<Ogre::Vector3>::const_iterator iNext = currentStrand.begin();
-									++iNext;
-
-									for (iCurrent = currentStrand.begin(); iCurrent != currentStrand.end(); ++iCurrent) {
-										Ogre::Vector3 tangent;
-
-										// 1st tangents
-										if( iPrevious == currentStrand.begin() ) {
-											// first element
-											tangent = 0.5 * ( *iNext - *iCurrent );
-											++iNext;
-										}
-										else {
-											Ogre::Vector3 previousVertex = *iPrevious;
-
-											if( iNext == currentStrand.end() ) {
-												// last element
-												tangent = 0.5 * ( *iCurrent - *iPrevious );
-											}
-											else {
-												tangent = 0.5 * ( *iNext - *iPrevious );
-												++iNext;
-											}
-										}
-
-										// write tangent to texture
-										pFloatTangents[writeTangentsPos++] = tangent.x;
-										pFloatTangents[writeTangentsPos++] = tangent.y;
-										pFloatTangents[writeTangentsPos++] = tangent.z;
-										pFloatTangents[writeTangentsPos++] = currentNumOfGuideHairSegments;
-
-										iPrevious = iCurrent;
-									}
-									break;
-								}
-
-								// Unlock vertex buffer
-								vBuffer->unlock();
-							}
-							if(!renderGuideStrands) {
-								// do not render guide hair
-								subEntity->setVisible(false);
-							}
-						}
-
-						if( !guideStrandFound ) {
-							Log::error("Hair mesh file error: no guide strand found for scalp mesh vertex.", "AnimatableMeshHairNode::loadMesh");
-							return false;
-						}
-					}
-					else if ( i->getSemantic() == Ogre::VertexElementSemantic::VES_NORMAL ) {
-						i->baseVertexPointerToElement(meshShapeVertexBufferPtr, &pMeshShapeNormal);
-						Ogre::Vector3 normal(pMeshShapeNormal[0], pMeshShapeNormal[1], pMeshShapeNormal[2]);
-						normalList.push_back(normal);
-					}
 
+		// Write guide strand vertices and tangents, one strand per scalp vertex
+		const int numberOfStrands = static_cast<int>(groom.getNumberOfStrands());
+
+		#pragma omp parallel for schedule(dynamic, 64)
+		for (int s = 0; s < numberOfStrands; ++s) {
+			const unsigned int numVertices = groom.getStrandSize(s);
+			const float currentNumOfGuideHairSegments = (float)(numVertices - 1);
+			Ogre::Real *pVertex = pFloat + groom.strandOffsets[s] * 4;
+			Ogre::Real *pTangent = pFloatTangents + groom.strandOffsets[s] * 4;
+
+			for (unsigned int v = 0; v < numVertices; ++v) {
+				const Ogre::Vector3 vertex = groom.getStrandVertex(s, v);
+
+				// write vertex
+				*pVertex++ = vertex.x;
+				*pVertex++ = vertex.y;
+				*pVertex++ = vertex.z;
+				*pVertex++ = (float)(numVertices-1-v);			// position distance to to hair tip
+
+				// central differences, one sided at the root and the tip
+				Ogre::Vector3 tangent = Ogre::Vector3::ZERO;
+				if (numVertices > 1) {
+					const Ogre::Vector3 previousVertex = groom.getStrandVertex(s, v > 0 ? v-1 : v);
+					const Ogre::Vector3 nextVertex = groom.getStrandVertex(s, v+1 < numVertices ? v+1 : v);
+					tangent = 0.5 * ( nextVertex - previousVertex );
 				}
-				meshShapeVertexBufferPtr += meshShapeVBuffer->getVertexSize();
-			}
-
-			if(normalList.empty()) {
-				// normal were not found -> saved in an extra buffer
-				// Get Vertex Buffer
-				size_t bufferCount = meshShapeSubMesh->vertexData->vertexBufferBinding->getBufferCount();
-
-				for(size_t bufferIdx = 1; normalList.empty() && bufferIdx < bufferCount ; bufferIdx++) {
-					Ogre::HardwareVertexBufferSharedPtr meshShapeVBuffer = meshShapeSubMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx);
-
-					// Lock vertex-buffer to access content
-					unsigned char* meshShapeVertexBufferPtr = static_cast<unsigned char*>(meshShapeVBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-
-					Ogre::Real* pMeshShapeVertex;
-					Ogre::Real* pMeshShapeNormal;
-
-					const size_t numVertices = meshShapeSubMesh->vertexData->vertexBufferBinding->getBuffer(bufferIdx)->getNumVertices();
-
-					// Read mesh vertex data to texture buffer
-					for (size_t v = 0; v < numVertices; ++v) {
-						// Get elements
-						Ogre::VertexDeclaration::VertexElementList elemsList = meshShapeDecl->findElementsBySource(bufferIdx);
-						Ogre::VertexDeclaration::VertexElementList::iterator i, iend;
-
-						// Loop through elements
-						for ( i = elemsList.begin(); i != elemsList.end(); ++i ) {
-
-							if ( i->getSemantic() == Ogre::VertexElementSemantic::VES_NORMAL ) {
-								i->baseVertexPointerToElement(meshShapeVertexBufferPtr, &pMeshShapeNormal);
-								Ogre::Vector3 normal(pMeshShapeNormal[0], pMeshShapeNormal[1], pMeshShapeNormal[2]);
-								normalList.push_back(normal);
-							}
-						}
 
-						meshShapeVertexBufferPtr += meshShapeVBuffer->getVertexSize();
-					}
-					// Unlock vertex buffer
-					meshShapeVBuffer->unlock();
-				}
+				// write tangent
+				*pTangent++ = tangent.x;
+				*pTangent++ = tangent.y;
+				*pTangent++ = tangent.z;
+				*pTangent++ = currentNumOfGuideHairSegments;
 			}
+		}
 
-			// --------------------------
-			// calculate index data texture
-			// --------------------------
-			std::list<Ogre::Vector3> indexDataList;			// start of guide strand segment
-			std::list<Ogre::Vector3> indexEndDataList;		// end of guide strand segment
-			std::list<Ogre::Vector3> indexNormalList;		// index list of scalp mesh normals
-
-			// read scalp mesh index data
-			Ogre::IndexData* index_data = meshShapeSubMesh->indexData;
-
-			size_t numTris = index_data->indexCount / 3;
-			unsigned short* pShort;
-			unsigned int* pInt;
-			Ogre::HardwareIndexBufferSharedPtr ibuf = index_data->indexBuffer;
-			bool use32bitindexes = (ibuf->getType() == Ogre::HardwareIndexBuffer::IT_32BIT);
-
-			if (use32bitindexes) 
-				pInt = static_cast<unsigned int*>(ibuf->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-			else
-				pShort = static_cast<unsigned short*>(ibuf->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-
-			if(use32bitindexes) {
-				for(size_t k = 0; k < numTris; ++k) {
-					unsigned int vindex1 = *pInt++;
-					unsigned int vindex2 = *pInt++;
-					unsigned int vindex3 = *pInt++;
-
-					GuideHairIndexData indexData1 = guideHairIndexData.at(vindex1);
-					GuideHairIndexData indexData2 = guideHairIndexData.at(vindex2);
-					GuideHairIndexData indexData3 = guideHairIndexData.at(vindex3);
-
-					int shortestStrandSize = indexData1.strandSize;
-
-					if( indexData2.strandSize < shortestStrandSize )
-						shortestStrandSize = indexData2.strandSize;
-
-					if( indexData3.strandSize < shortestStrandSize )
-						shortestStrandSize = indexData3.strandSize;
-
-					for(size_t i=0; i < shortestStrandSize; i++) {
-						// start index
-						Ogre::Vector3 indexVector;
-
-						indexVector.x = indexData1.rootTexturePosition + ceil(i * ( ( indexData1.strandSize ) / shortestStrandSize ) );
-						indexVector.y = indexData2.rootTexturePosition + ceil(i * ( ( indexData2.strandSize ) / shortestStrandSize ) );
-						indexVector.z = indexData3.rootTexturePosition + ceil(i * ( ( indexData3.strandSize ) / shortestStrandSize ) );
-
-						indexDataList.push_back(indexVector);
-
-						// end index
-						Ogre::Vector3 indexVectorEnd;
+		// Unlock the buffer again (frees it for use by the GPU)
+		hairPixelBuffer->unlock();
+		hairTangentsPixelBuffer->unlock();
 
-						indexVectorEnd.x = indexData1.rootTexturePosition + ceil((i+1) * ( ( indexData1.strandSize ) / shortestStrandSize ) );
-						indexVectorEnd.y = indexData2.rootTexturePosition + ceil((i+1) * ( ( indexData2.strandSize ) / shortestStrandSize ) );
-						indexVectorEnd.z = indexData3.rootTexturePosition + ceil((i+1) * ( ( indexData3.strandSize ) / shortestStrandSize ) );
+		// --------------------------
+		// calculate index data texture
+		// --------------------------
+		// For every scalp triangle and every segment of its shortest strand
+		// the texture positions of the segment start and end in the three
+		// strands of the triangle and the indices of the scalp normals
+		const int numTris = static_cast<int>(hairGrowthMeshIndexCount);
+		std::vector<unsigned int> indexOffsets (numTris + 1, 0);
+		for (int k = 0; k < numTris; ++k) {
+			int shortestStrandSize = int(groom.getStrandSize(groom.scalpIndices[k*3])) - 1;
+			shortestStrandSize = std::min(shortestStrandSize, int(groom.getStrandSize(groom.scalpIndices[k*3+1])) - 1);
+			shortestStrandSize = std::min(shortestStrandSize, int(groom.getStrandSize(groom.scalpIndices[k*3+2])) - 1);
+			indexOffsets[k+1] = indexOffsets[k] + std::max(shortestStrandSize, 0);
+		}
 
-						indexEndDataList.push_back(indexVectorEnd);
+		const size_t hairIndexCount = indexOffsets[numTris];
+		std::vector<float> indexData (hairIndexCount * 3);			// start of guide strand segment
+		std::vector<float> indexEndData (hairIndexCount * 3);		// end of guide strand segment
+		std::vector<float> indexNormalData (hairIndexCount * 3);	// index list of scalp mesh normals
+
+		#pragma omp parallel for schedule(dynamic, 256)
+		for (int k = 0; k < numTris; ++k) {
+			float rootTexturePosition[3];
+			float strandSize[3];
+			for (int c = 0; c < 3; ++c) {
+				const unsigned int vindex = groom.scalpIndices[k*3+c];
+				rootTexturePosition[c] = (float)groom.strandOffsets[vindex];
+				strandSize[c] = (float)(groom.getStrandSize(vindex) - 1);
+			}
 
-						// index for normals
-						Ogre::Vector3 indexNormalVector(vindex1, vindex2, vindex3);
-						indexNormalList.push_back(indexNormalVector);
-					}
+			const unsigned int numSegments = indexOffsets[k+1] - indexOffsets[k];
+			const float shortestStrandSize = (float)numSegments;
+			for (unsigned int i = 0; i < numSegments; ++i) {
+				const size_t writePos = (indexOffsets[k] + i) * 3;
+				for (int c = 0; c < 3; ++c) {
+					indexData[writePos+c] = rootTexturePosition[c] + ceil(i * ( strandSize[c] / shortestStrandSize ) );
+					indexEndData[writePos+c] = rootTexturePosition[c] + ceil((i+1) * ( strandSize[c] / shortestStrandSize ) );
+					indexNormalData[writePos+c] = (float)groom.scalpIndices[k*3+c];
 				}
 			}
-			else {
-				for(size_t k = 0; k < numTris; ++k) {
-					unsigned int vindex1 = *pShort++;
-					unsigned int vindex2 = *pShort++;
-					unsigned int vindex3 = *pShort++;
-
-					GuideHairIndexData indexData1 = guideHairIndexData.at(vindex1);
-					GuideHairIndexData indexData2 = guideHairIndexData.at(vindex2);
-					GuideHairIndexData indexData3 = guideHairIndexData.at(vindex3);
-
-					float shortestStrandSize = indexData1.strandSize;
-
-					if( indexData2.strandSize < shortestStrandSize )
-						shortestStrandSize = indexData2.strandSize;
-
-					if( indexData3.strandSize < shortestStrandSize )
-						shortestStrandSize = indexData3.strandSize;
-
-					for(size_t i=0; i < shortestStrandSize; i++) {
-						// start index
-						Ogre::Vector3 indexVector;
-
-						indexVector.x = indexData1.rootTexturePosition + ceil(i * ( ( indexData1.strandSize ) / shortestStrandSize ) );
-						indexVector.y = indexData2.rootTexturePosition + ceil(i * ( ( indexData2.strandSize ) / shortestStrandSize ) );
-						indexVector.z = indexData3.rootTexturePosition + ceil(i * ( ( indexData3.strandSize ) / shortestStrandSize ) );
-
-						indexDataList.push_back(indexVector);
-
-						// end index
-						Ogre::Vector3 indexVectorEnd;
-
-						indexVectorEnd.x = indexData1.rootTexturePosition + ceil((i+1) * ( ( indexData1.strandSize ) / shortestStrandSize ) );
-						indexVectorEnd.y = indexData2.rootTexturePosition + ceil((i+1) * ( ( indexData2.strandSize ) / shortestStrandSize ) );
-						indexVectorEnd.z = indexData3.rootTexturePosition + ceil((i+1) * ( ( indexData3.strandSize ) / shortestStrandSize ) );
+		}
 
-						indexEndDataList.push_back(indexVectorEnd);
+		createScalpMeshNormalTexture(groom.scalpNormals, indexNormalData);
 
-						// index for normals
-						Ogre::Vector3 indexNormalVector(vindex1, vindex2, vindex3);
-						indexNormalList.push_back(indexNormalVector);
-					}
-				}
-			}
+		// Index texture for multi strand interpolation
+		//--------------------------------------
+		const int indexTexturesizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)hairIndexCount)));
 
-			createScalpMeshNormalTexture(normalList, indexNormalList);
-
-			ibuf->unlock();
-			// --------------------------
-
-			// Unlock vertex buffer
-			meshShapeVBuffer->unlock();
-
-
-			// Index texture for multi strand interpolation
-			//--------------------------------------
-			hairIndexCount = indexDataList.size();
-			indexTexturesizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)hairIndexCount)));
-
-			Ogre::String hairIndexName = createUniqueName("HairIndexTexture_AnimatableMeshHairNode");
-			// Create ogre texture manual for hair strands index data
-			m_hairIndexTex = Ogre::TextureManager::getSingleton().createManual(
-				hairIndexName,
-				Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
-				Ogre::TEX_TYPE_2D,
-				indexTexturesizeXY,
-				indexTexturesizeXY,
-				0,
-				Ogre::PF_FLOAT32_RGB,
-				Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
-
-			// Pixel Buffer of the texture for guide hair vertex tangets
-			Ogre::HardwarePixelBufferSharedPtr hairIndexPixelBuffer = m_hairIndexTex->getBuffer(0,0);
-
-			// Lock the pixel buffer in a way that we can write to it
-			hairIndexPixelBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL);
-			const Ogre::PixelBox &pixelBoxHairIndex = hairIndexPixelBuffer->getCurrentLock();
-			Ogre::Real* pFloatIndices = 0;
-			pFloatIndices = static_cast<Ogre::Real*>(pixelBoxHairIndex.data);
-			int writeIndexPos = 0;
-			//--------------------------------------
-
-			// write index data
-			for (std::list<Ogre::Vector3>::iterator iterIndexData = indexDataList.begin(); iterIndexData != indexDataList.end(); ++iterIndexData) {
-				pFloatIndices[writeIndexPos++] = (*iterIndexData).x;
-				pFloatIndices[writeIndexPos++] = (*iterIndexData).y;
-				pFloatIndices[writeIndexPos++] = (*iterIndexData).z;
-			}
+		Ogre::String hairIndexName = createUniqueName("HairIndexTexture_AnimatableMeshHairNode");
+		// Create ogre texture manual for hair strands index data
+		m_hairIndexTex = Ogre::TextureManager::getSingleton().createManual(
+			hairIndexName,
+			Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+			Ogre::TEX_TYPE_2D,
+			indexTexturesizeXY,
+			indexTexturesizeXY,
+			0,
+			Ogre::PF_FLOAT32_RGB,
+			Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
 
-			hairIndexPixelBuffer->unlock();
-
-			// Index end texture for multi strand interpolation
-			//--------------------------------------
-			Ogre::String hairIndexEndName = createUniqueName("HairIndexEndTexture_AnimatableMeshHairNode");
-			// Create ogre texture manual for hair strands index data
-			m_hairIndexEndTex = Ogre::TextureManager::getSingleton().createManual(
-				hairIndexEndName,
-				Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
-				Ogre::TEX_TYPE_2D,
-				indexTexturesizeXY,
-				indexTexturesizeXY,
-				0,
-				Ogre::PF_FLOAT32_RGB,
-				Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
-
-			// Pixel Buffer of the texture for guide hair vertex tangets
-			Ogre::HardwarePixelBufferSharedPtr hairIndexEndPixelBuffer = m_hairIndexEndTex->getBuffer(0,0);
-
-			// Lock the pixel buffer in a way that we can write to it
-			hairIndexEndPixelBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL);
-			const Ogre::PixelBox &pixelBoxHairIndexEnd = hairIndexEndPixelBuffer->getCurrentLock();
-			Ogre::Real* pFloatIndicesEnd = 0;
-			pFloatIndicesEnd = static_cast<Ogre::Real*>(pixelBoxHairIndexEnd.data);
-			int writeIndexEndPos = 0;
-			//--------------------------------------
-
-			// write index end data
-			for (std::list<Ogre::Vector3>::iterator iterIndexEndData = indexEndDataList.begin(); iterIndexEndData != indexEndDataList.end(); ++iterIndexEndData) {
-				pFloatIndicesEnd[writeIndexEndPos++] = (*iterIndexEndData).x;
-				pFloatIndicesEnd[writeIndexEndPos++] = (*iterIndexEndData).y;
-				pFloatIndicesEnd[writeIndexEndPos++] = (*iterIndexEndData).z;
-			}
+		// Pixel Buffer of the texture for guide hair vertex tangets
+		Ogre::HardwarePixelBufferSharedPtr hairIndexPixelBuffer = m_hairIndexTex->getBuffer(0,0);
+
+		// Lock the pixel buffer in a way that we can write to it and write index data
+		hairIndexPixelBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL);
+		const Ogre::PixelBox &pixelBoxHairIndex = hairIndexPixelBuffer->getCurrentLock();
+		std::copy(indexData.begin(), indexData.end(), static_cast<Ogre::Real*>(pixelBoxHairIndex.data));
+		hairIndexPixelBuffer->unlock();
+
+		// Index end texture for multi strand interpolation
+		//--------------------------------------
+		Ogre::String hairIndexEndName = createUniqueName("HairIndexEndTexture_AnimatableMeshHairNode");
+		// Create ogre texture manual for hair strands index data
+		m_hairIndexEndTex = Ogre::TextureManager::getSingleton().createManual(
+			hairIndexEndName,
+			Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+			Ogre::TEX_TYPE_2D,
+			indexTexturesizeXY,
+			indexTexturesizeXY,
+			0,
+			Ogre::PF_FLOAT32_RGB,
+			Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
 
-			hairIndexEndPixelBuffer->unlock();
-		}
+		// Pixel Buffer of the texture for guide hair vertex tangets
+		Ogre::HardwarePixelBufferSharedPtr hairIndexEndPixelBuffer = m_hairIndexEndTex->getBuffer(0,0);
 
-		// Unlock the buffer again (frees it for use by the GPU)
-		hairPixelBuffer->unlock();
-		hairTangentsPixelBuffer->unlock();
+		// Lock the pixel buffer in a way that we can write to it and write index end data
+		hairIndexEndPixelBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL);
+		const Ogre::PixelBox &pixelBoxHairIndexEnd = hairIndexEndPixelBuffer->getCurrentLock();
+		std::copy(indexEndData.begin(), indexEndData.end(), static_cast<Ogre::Real*>(pixelBoxHairIndexEnd.data));
+		hairIndexEndPixelBuffer->unlock();
 
 		// remove all guide hairs and the scalp mesh when both are disabled
-		bool renderGuideStrands = getBoolValue("Render Guide Strands");
 		bool renderScalpMesh = getBoolValue("Render Scalp Mesh");
 
 		if( !renderGuideStrands && !renderScalpMesh ) {
@@ -1550,7 +1201,7 @@ bool AnimatableMeshHairNode::loadMesh ()
 
 		if(singleStrandHair) {
 			// curly hair
-			createCurlDeviations(m_NumberOverallHairGuideVertices, m_NumberOfGuideHairs);
+			createCurlDeviations(groom, m_NumberOverallHairGuideVertices);
 
 			// deviant hair strand
 			createStrandLengths();
@@ -1558,7 +1209,7 @@ bool AnimatableMeshHairNode::loadMesh ()
 		}
 		else {
 			// curly hair
-			createCurlDeviations(hairIndexCount, hairGrowthMeshIndexCount);
+			createCurlDeviations(groom, hairIndexCount);
 
 			// deviant hair strand
 			createStrandLengths();
@@ -1566,9 +1217,9 @@ bool AnimatableMeshHairNode::loadMesh ()
 		}
 
 		createRandomCircularCoordinates();
-		createCoordinateFrames(hairStrands);
-		createMaxDistanceAngleTexture(meshShapeSubMesh, hairStrands);
-		createHairStrandBendTexture(hairStrands);
+		createCoordinateFrames(groom);
+		createMaxDistanceAngleTexture(groom);
+		createHairStrandBendTexture(groom);
 
 		// Create custom mesh with empty vertex buffer for hair rendering
 		//-----------------------------------------------------------------
@@ -1911,10 +1562,10 @@ void AnimatableMeshHairNode::BoxMullerTransform(float& var1, float& var2)
 //!
 //! Procedural creation of curly hair deviations
 //!
+//! \param groom The hair groom holding the curl control vertices
 //! \param totalHairGuideVertexNumber Vertex number of all hair guides combined
-//! \param numberOfGuideHairs Number of used guide hairs
 //!
-void AnimatableMeshHairNode::createCurlDeviations(int totalHairGuideVertexNumber, int numberOfGuideHairs)
+void AnimatableMeshHairNode::createCurlDeviations(const HairGroom &groom, int totalHairGuideVertexNumber)
 {
 	// Texture for curl diviation
 	//--------------------------------------
@@ -1942,30 +1593,31 @@ void AnimatableMeshHairNode::createCurlDeviations(int totalHairGuideVertexNumber
 	const Ogre::PixelBox &pixelBoxHairCurlDiviationsIndex = hairCurlDiviationsIndexPixelBuffer->getCurrentLock();
 	Ogre::Real* pFloatCurlDiviations = 0;
 	pFloatCurlDiviations = static_cast<Ogre::Real*>(pixelBoxHairCurlDiviationsIndex.data);
-	int writeCurlDiviationPos = 0;
 	//--------------------------------------
 
-	// Create curl deviations for curly hair
-	int numCVs = 13;		// 13
-	float sd = 1.5;			// 1.5
-	//if(g_useShortHair)
-	//{
-	//	numCVs = 10;
-	//	sd = 1.2f;
-	//}
-	int numSegments = numCVs - 3;
-	int numVerticesPerSegment = ceil( ((m_NumberMaxOfHairSegments+1)*64) /float(numSegments) );
-	float uStep = 1.0/numVerticesPerSegment;
-	Ogre::Vector2* CVs = new Ogre::Vector2[numCVs];
-	CVs[0] = Ogre::Vector2(0,0);
-	CVs[1] = Ogre::Vector2(0,0);
-	CVs[2] = Ogre::Vector2(0,0);
-	CVs[3] = Ogre::Vector2(0,0);
-	float x,y;
-	int index = 0;
-	int lastIndex = 0;
-
-	Ogre::Matrix4 basisMatrix = Ogre::Matrix4
+	// Evaluate the curl deviation curves (uniform cubic B-splines) from the
+	// random control vertices of the groom
+	const int numCVs = HairGroom::CurlControlVertices;
+	const int numRandomCVs = numCVs - HairGroom::CurlFixedControlVertices;
+	const int numSegments = numCVs - 3;
+	const int maxPointsPerCurve = (m_NumberMaxOfHairSegments+1)*64;
+	const int numVerticesPerSegment = ceil( maxPointsPerCurve /float(numSegments) );
+	const float uStep = 1.0/numVerticesPerSegment;
+
+	// Parameter values of a single segment (same float steps for all curves)
+	std::vector<float> segmentParameters;
+	for(float u=0;u<1.0;u+=uStep)
+		segmentParameters.push_back(u);
+
+	// Every curve has the same number of points, so curves can be written in parallel
+	const int pointsPerCurve = std::min(maxPointsPerCurve, numSegments * int(segmentParameters.size()));
+	const size_t texturePoints = size_t(curlTexturesizeXY) * curlTexturesizeXY;
+	const int numberOfCurls = (pointsPerCurve > 0) ? int(std::min<size_t>(groom.numberOfCurls, texturePoints / pointsPerCurve)) : 0;
+
+	if (numberOfCurls < int(groom.numberOfCurls))
+		Log::warning(QString("Curl deviation texture is too small for %1 curves, %2 curves are written.").arg(groom.numberOfCurls).arg(numberOfCurls), "AnimatableMeshHairNode::createCurlDeviations");
+
+	const Ogre::Matrix4 basisMatrix = Ogre::Matrix4
 	(
 	-1/6.0f,	3/6.0f,		-3/6.0f,	1/6.0f,
 	3/6.0f,		-6/6.0f,	0,			4/6.0f,
@@ -1973,43 +1625,38 @@ void AnimatableMeshHairNode::createCurlDeviations(int totalHairGuideVertexNumber
 	1/6.0f,		0,			0,			0
 	);
 
-	//Ogre::Vector2* curlDeviations = new Ogre::Vector2[curlDeviationsCount];
-	for (int i = 0; i < numberOfGuideHairs; i++) 
+	#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < numberOfCurls; i++) 
 	{
-		//create the random CVs
-		for(int j=4;j<numCVs;j++)
-		{
-			BoxMullerTransform(x,y);
-			x *= sd;
-			y *= sd; 
-			CVs[j] = Ogre::Vector2(x,y);
-		}
+		Ogre::Vector2 CVs[HairGroom::CurlControlVertices];
+		for(int j=0;j<HairGroom::CurlFixedControlVertices;j++)
+			CVs[j] = Ogre::Vector2(0,0);
+
+		const float *randomCVs = &groom.curlControlVertices[size_t(i) * numRandomCVs * 2];
+		for(int j=0;j<numRandomCVs;j++)
+			CVs[HairGroom::CurlFixedControlVertices+j] = Ogre::Vector2(randomCVs[j*2], randomCVs[j*2+1]);
+
+		Ogre::Real *pCurve = pFloatCurlDiviations + size_t(i) * pointsPerCurve * 3;
+		int index = 0;
 
 		//create the points
-		for(int s=0;s<numSegments;s++)
+		for(int s=0;s<numSegments && index<pointsPerCurve;s++)
 		{
-			for(float u=0;u<1.0;u+=uStep)
+			for(size_t k=0;k<segmentParameters.size() && index<pointsPerCurve;k++)
 			{
-				Ogre::Vector4 basis;
-				
-				//vectorMatrixMultiply(&basis,basisMatrix,float4(u * u * u, u * u, u, 1));
-				basis = basisMatrix * Ogre::Vector4(u*u*u, u*u, u, 1);
+				const float u = segmentParameters[k];
+				const Ogre::Vector4 basis = basisMatrix * Ogre::Vector4(u*u*u, u*u, u, 1);
 				Ogre::Vector2 position = Ogre::Vector2(0,0);
 				for (int c = 0; c < 4; ++c) 
 					position += basis[c] * CVs[s+c];
-				if( index-lastIndex < (m_NumberMaxOfHairSegments+1)*64 )
-				{
-					//curlDeviations[index++] = position;
-					// write to texture
-					pFloatCurlDiviations[writeCurlDiviationPos++] = position.x;
-					pFloatCurlDiviations[writeCurlDiviationPos++] = position.y;
-					pFloatCurlDiviations[writeCurlDiviationPos++] = 0.0f;
-					index++;
-				}
+
+				// write to texture
+				*pCurve++ = position.x;
+				*pCurve++ = position.y;
+				*pCurve++ = 0.0f;
+				index++;
 			}
 		}
-
-		lastIndex = index;
 	}
 
 	hairCurlDiviationsIndexPixelBuffer->unlock();
@@ -2282,9 +1929,9 @@ void AnimatableMeshHairNode::createRandomCircularCoordinates()
 //!
 //! Creation of coordinate frames per guide hair vertex. One coordinate frame consists of 3 vectors
 //!
-//! \param hairStrands Vector of guide hair strands
+//! \param groom The hair groom holding the guide strands
 //!
-void AnimatableMeshHairNode::createCoordinateFrames(std::vector<std::vector<Ogre::Vector3>> hairStrands)
+void AnimatableMeshHairNode::createCoordinateFrames(const HairGroom &groom)
 {
 	size_t coordinateFramesCount = m_NumberOverallHairGuideVertices * 3 * 3;	//3 vec3s per coordinate frame    -- CVs = control vertices
 
@@ -2296,13 +1943,11 @@ void AnimatableMeshHairNode::createCoordinateFrames(std::vector<std::vector<Ogre
 		coordinateFrames[i] = 0;
 	}
 
-	for(int s=0; s < int(hairStrands.size()); s++)
+	for(int s=0; s < int(groom.getNumberOfStrands()); s++)
 	{
-		for(int i=0;i<int(hairStrands.at(s).size())-1;i++)
+		for(int i=0;i<int(groom.getStrandSize(s))-1;i++)
 		{
-			Ogre::Vector3 x(hairStrands.at(s).at(i+1).x - hairStrands.at(s).at(i).x,
-							hairStrands.at(s).at(i+1).y - hairStrands.at(s).at(i).y,
-							hairStrands.at(s).at(i+1).z - hairStrands.at(s).at(i).z);
+			Ogre::Vector3 x = groom.getStrandVertex(s, i+1) - groom.getStrandVertex(s, i);
 			x.normalise();
 				
 			Ogre::Vector3 y;
@@ -2470,15 +2115,11 @@ void AnimatableMeshHairNode::rotateVector(const Ogre::Vector3& rotationAxis,floa
 //!
 //! Creation of texture which hold the maximum/angle between hair strands of one face.
 //!
-//! \param scalpSubMesh Pointer to scalp sub mesh
-//! \param hairStrands
+//! \param groom The hair groom holding the guide strands and scalp triangles
 //!
-void AnimatableMeshHairNode::createMaxDistanceAngleTexture(Ogre::SubMesh *scalpSubMesh, std::vector<std::vector<Ogre::Vector3>> hairStrands)
+void AnimatableMeshHairNode::createMaxDistanceAngleTexture(const HairGroom &groom)
 {
-	// Get Index Buffer
-	Ogre::HardwareIndexBufferSharedPtr scalpMeshIBuffer = scalpSubMesh->indexData->indexBuffer;
-	
-	size_t numTris = scalpSubMesh->indexData->indexCount / 3;
+	const int numTris = int(groom.getNumberOfScalpTriangles());
 
 	// create texture
 	//--------------------------------------
@@ -2506,62 +2147,34 @@ void AnimatableMeshHairNode::createMaxDistanceAngleTexture(Ogre::SubMesh *scalpS
 	const Ogre::PixelBox &pixelBox = pixelBuffer->getCurrentLock();
 	Ogre::Real* pFloat = 0;
 	pFloat = static_cast<Ogre::Real*>(pixelBox.data);
-	int writePos = 0;
 	//--------------------------------------	
 
-	std::vector<Ogre::Vector3> hairStrand1;
-	std::vector<Ogre::Vector3> hairStrand2;
-	std::vector<Ogre::Vector3> hairStrand3;
-	
-	// lock index buffer
-	unsigned int* pInt;
-	unsigned short* pShort;
-	bool use32bitindexes = (scalpMeshIBuffer->getType() == Ogre::HardwareIndexBuffer::IT_32BIT);
-				
-	if (use32bitindexes) 
-		pInt = static_cast<unsigned int*>(scalpMeshIBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-	else
-		pShort = static_cast<unsigned short*>(scalpMeshIBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
-
-	for(size_t i=0; i<numTris ; i++)
+	#pragma omp parallel for schedule(dynamic, 256)
+	for(int i=0; i<numTris ; i++)
 	{
-		if(use32bitindexes)
-		{
-			// get indices of current triangle
-			unsigned int index1 = *pInt++;
-			unsigned int index2 = *pInt++;
-			unsigned int index3 = *pInt++;
-
-			// get hair strands
-			hairStrand1 = hairStrands.at(index1);
-			hairStrand2 = hairStrands.at(index2);
-			hairStrand3 = hairStrands.at(index3);
-		}
-		else
-		{
-			// get indices of current triangle
-			unsigned short index1 = *pShort++;
-			unsigned short index2 = *pShort++;
-			unsigned short index3 = *pShort++;
-
-			// get hair strands
-			hairStrand1 = hairStrands.at(index1);
-			hairStrand2 = hairStrands.at(index2);
-			hairStrand3 = hairStrands.at(index3);
-		}
+		// get indices of current triangle
+		const unsigned int index1 = groom.scalpIndices[i*3];
+		const unsigned int index2 = groom.scalpIndices[i*3+1];
+		const unsigned int index3 = groom.scalpIndices[i*3+2];
 
 		float maximumDistance = 0.0f;
 		int maximumDistancePosition = 0;
 		float maximumAngle = 0.0f;
 		int maximumAnglePosition = 0;
 
-		// TODO: check for different sizes and handle them
-		for(int j=0; j<int(hairStrand1.size())-1; j++)
+		// only compare the segments all three strands have
+		int numSegments = int(groom.getStrandSize(index1)) - 1;
+		numSegments = std::min(numSegments, int(groom.getStrandSize(index2)) - 1);
+		numSegments = std::min(numSegments, int(groom.getStrandSize(index3)) - 1);
+
+		for(int j=0; j<numSegments; j++)
 		{
+			const Ogre::Vector3 vertex1 = groom.getStrandVertex(index1, j);
+			const Ogre::Vector3 vertex2 = groom.getStrandVertex(index2, j);
+			const Ogre::Vector3 vertex3 = groom.getStrandVertex(index3, j);
+
 			// distance
-			float currentMaximumDistance = calculateMaximumDistance(hairStrand1.at(j), 
-																	hairStrand2.at(j),
-																	hairStrand3.at(j));
+			float currentMaximumDistance = calculateMaximumDistance(vertex1, vertex2, vertex3);
 
 			if( currentMaximumDistance > maximumDistance )
 			{
@@ -2570,33 +2183,25 @@ void AnimatableMeshHairNode::createMaxDistanceAngleTexture(Ogre::SubMesh *scalpS
 			}
 
 			// angle
-			if( j < int(hairStrand1.size())-1 )
-			{
-				// ignore angle of last segment
-				float currentMaximumAngle = calculateMaximumAngle(
-					hairStrand1.at(j+1) - hairStrand1.at(j),
-					hairStrand2.at(j+1) - hairStrand2.at(j),
-					hairStrand3.at(j+1) - hairStrand3.at(j) );
+			float currentMaximumAngle = calculateMaximumAngle(
+				groom.getStrandVertex(index1, j+1) - vertex1,
+				groom.getStrandVertex(index2, j+1) - vertex2,
+				groom.getStrandVertex(index3, j+1) - vertex3 );
 
-				if( currentMaximumAngle > maximumAngle )
-				{
-					maximumAngle = currentMaximumAngle;
-					maximumAnglePosition = j;
-				}
+			if( currentMaximumAngle > maximumAngle )
+			{
+				maximumAngle = currentMaximumAngle;
+				maximumAnglePosition = j;
 			}
 		}
 
 		// write to texture
-		pFloat[writePos++] = maximumDistance;
-		pFloat[writePos++] = maximumDistancePosition;
-		pFloat[writePos++] = maximumAngle;
-		pFloat[writePos++] = maximumAnglePosition;
+		pFloat[i*4]   = maximumDistance;
+		pFloat[i*4+1] = maximumDistancePosition;
+		pFloat[i*4+2] = maximumAngle;
+		pFloat[i*4+3] = maximumAnglePosition;
 	}
 
-
-	// unlock index buffer
-	scalpMeshIBuffer->unlock();
-
 	// unlock texture pixel buffer
 	pixelBuffer->unlock();
 }
@@ -2676,14 +2281,14 @@ float AnimatableMeshHairNode::calculateMaximumAngle(Ogre::Vector3 tangent1, Ogre
 //!
 //! Creation of texture, which holds scalp mesh normals
 //!
-//! \param normalList List of scalp mesh normals
-//! \param indexNormalList Index list of scalp mesh normals
+//! \param normals Scalp mesh normals (xyz)
+//! \param indexNormals Index list of scalp mesh normals (three indices per entry)
 //!
-void AnimatableMeshHairNode::createScalpMeshNormalTexture(std::list<Ogre::Vector3> normalList,std::list<Ogre::Vector3> indexNormalList)
+void AnimatableMeshHairNode::createScalpMeshNormalTexture(const std::vector<float> &normals, const std::vector<float> &indexNormals)
 {
 	// create normal texture
 	//--------------------------------------
-	int textureSizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)normalList.size())));
+	int textureSizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)(normals.size() / 3))));
 	m_scalpNormalsTextureSizeXY = (float)textureSizeXY;
 
 	Ogre::String textureName = createUniqueName("ScalpNormals_AnimatableMeshHairNode");
@@ -2707,22 +2312,16 @@ void AnimatableMeshHairNode::createScalpMeshNormalTexture(std::list<Ogre::Vector
 	const Ogre::PixelBox &pixelBox = pixelBuffer->getCurrentLock();
 	Ogre::Real* pFloat = 0;
 	pFloat = static_cast<Ogre::Real*>(pixelBox.data);
-	int writePos = 0;
 	//--------------------------------------
 
-	// write index data
-	for (std::list<Ogre::Vector3>::iterator iterData = normalList.begin(); iterData != normalList.end(); ++iterData)
-	{
-		pFloat[writePos++] = (*iterData).x;
-		pFloat[writePos++] = (*iterData).y;
-		pFloat[writePos++] = (*iterData).z;
-	}
+	// write normal data
+	std::copy(normals.begin(), normals.end(), pFloat);
 
 	pixelBuffer->unlock();
 
 	// create normal index texture
 	//--------------------------------------
-	int indicesTextureSizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)indexNormalList.size())));
+	int indicesTextureSizeXY = Helpers::MathH::NextPow2(std::ceil(std::sqrt((float)(indexNormals.size() / 3))));
 	m_scalpNormalIndicesTextureSizeXY = (float)indicesTextureSizeXY;
 
 	Ogre::String indicesTextureName = createUniqueName("ScalpNormalIndices_AnimatableMeshHairNode");
@@ -2746,16 +2345,10 @@ void AnimatableMeshHairNode::createScalpMeshNormalTexture(std::list<Ogre::Vector
 	const Ogre::PixelBox &pixelBoxIndices = pixelBufferIndices->getCurrentLock();
 	Ogre::Real* pFloatIndices = 0;
 	pFloatIndices = static_cast<Ogre::Real*>(pixelBoxIndices.data);
-	int writePosIndices = 0;
 	//--------------------------------------
 
 	// write index data
-	for (std::list<Ogre::Vector3>::iterator iterData = indexNormalList.begin(); iterData != indexNormalList.end(); ++iterData)
-	{
-		pFloatIndices[writePosIndices++] = (*iterData).x;
-		pFloatIndices[writePosIndices++] = (*iterData).y;
-		pFloatIndices[writePosIndices++] = (*iterData).z;
-	}
+	std::copy(indexNormals.begin(), indexNormals.end(), pFloatIndices);
 
 	pixelBufferIndices->unlock();
 
@@ -2765,9 +2358,9 @@ void AnimatableMeshHairNode::createScalpMeshNormalTexture(std::list<Ogre::Vector
 //!
 //! Creation of texture, which determines how the hair strand is bended. (Used to calculate detail tessellation factor at run-time)
 //!
-//! \param hairStrands Vector of guide hair strands
+//! \param groom The hair groom holding the guide strands
 //!
-void AnimatableMeshHairNode::createHairStrandBendTexture(std::vector<std::vector<Ogre::Vector3>> hairStrands)
+void AnimatableMeshHairNode::createHairStrandBendTexture(const HairGroom &groom)
 {
 	// create texture
 	//--------------------------------------
@@ -2795,13 +2388,26 @@ void AnimatableMeshHairNode::createHairStrandBendTexture(std::vector<std::vector
 	const Ogre::PixelBox &pixelBox = pixelBuffer->getCurrentLock();
 	Ogre::Real* pFloat = 0;
 	pFloat = static_cast<Ogre::Real*>(pixelBox.data);
-	int writePos = 0;
 	//--------------------------------------	
 
+	// one value per strand segment, strands are processed in parallel
+	const int numberOfStrands = int(groom.getNumberOfStrands());
 
-	for(int i=0; i<int(hairStrands.size()) ; i++)
+	#pragma omp parallel for schedule(dynamic, 64)
+	for(int i=0; i<numberOfStrands ; i++)
 	{
-		for(int j=0; j<int(hairStrands.at(i).size())-1; j++)
+		const int strandSize = int(groom.getStrandSize(i));
+		int writePos = int(groom.strandOffsets[i]) - i;
+
+		// strands without a bend
+		if( strandSize < 3 )
+		{
+			for(int j=0; j<strandSize-1; j++)
+				pFloat[writePos++] = 0.0f;
+			continue;
+		}
+
+		for(int j=0; j<strandSize-1; j++)
 		{
 			float angle = 0;
 			float tessellationScale = 0.0;
@@ -2809,9 +2415,9 @@ void AnimatableMeshHairNode::createHairStrandBendTexture(std::vector<std::vector
 			if( j==0 )
 			{
 				// first segment
-				Ogre::Vector3 vector0 = hairStrands.at(i).at(j);
-				Ogre::Vector3 vector1 = hairStrands.at(i).at(j+1);
-				Ogre::Vector3 vector2 = hairStrands.at(i).at(j+2);
+				Ogre::Vector3 vector0 = groom.getStrandVertex(i, j);
+				Ogre::Vector3 vector1 = groom.getStrandVertex(i, j+1);
+				Ogre::Vector3 vector2 = groom.getStrandVertex(i, j+2);
 
 				Ogre::Vector3 tangent01 = vector1 - vector0;
 				tangent01.normalise();
@@ -2819,12 +2425,12 @@ void AnimatableMeshHairNode::createHairStrandBendTexture(std::vector<std::vector
 				tangent12.normalise();
 				angle = tangent01.angleBetween(tangent12).valueRadians();
 			}
-			else if( j == int(hairStrands.at(i).size())-2 )
+			else if( j == strandSize-2 )
 			{
 				// last segment
-				Ogre::Vector3 vector0 = hairStrands.at(i).at(j-1);
-				Ogre::Vector3 vector1 = hairStrands.at(i).at(j);
-				Ogre::Vector3 vector2 = hairStrands.at(i).at(j+1);
+				Ogre::Vector3 vector0 = groom.getStrandVertex(i, j-1);
+				Ogre::Vector3 vector1 = groom.getStrandVertex(i, j);
+				Ogre::Vector3 vector2 = groom.getStrandVertex(i, j+1);
 
 				Ogre::Vector3 tangent01 = vector1 - vector0;
 				tangent01.normalise();
@@ -2835,9 +2441,9 @@ void AnimatableMeshHairNode::createHairStrandBendTexture(std::vector<std::vector
 			else
 			{
 				// first angle
-				Ogre::Vector3 vector0 = hairStrands.at(i).at(j-1);
-				Ogre::Vector3 vector1 = hairStrands.at(i).at(j);
-				Ogre::Vector3 vector2 = hairStrands.at(i).at(j+1);
+				Ogre::Vector3 vector0 = groom.getStrandVertex(i, j-1);
+				Ogre::Vector3 vector1 = groom.getStrandVertex(i, j);
+				Ogre::Vector3 vector2 = groom.getStrandVertex(i, j+1);
 
 				Ogre::Vector3 tangent01 = vector1 - vector0;
 				tangent01.normalise();
@@ -2846,9 +2452,9 @@ void AnimatableMeshHairNode::createHairStrandBendTexture(std::vector<std::vector
 				float angle0 = tangent01.angleBetween(tangent12).valueRadians();
 
 				// second angle
-				vector0 = hairStrands.at(i).at(j);
-				vector1 = hairStrands.at(i).at(j+1);
-				vector2 = hairStrands.at(i).at(j+2);
+				vector0 = groom.getStrandVertex(i, j);
+				vector1 = groom.getStrandVertex(i, j+1);
+				vector2 = groom.getStrandVertex(i, j+2);
 
 				tangent01 = vector1 - vector0;
 				tangent01.normalise();
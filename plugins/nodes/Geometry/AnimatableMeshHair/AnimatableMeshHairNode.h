@@ -38,6 +38,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #define ANIMATABLEMESHHAIRNODE_H
 
 #include "GeometryAnimationNode.h"
+#include "HairGroom.h"
 
 namespace AnimatableMeshHairNode {
 using namespace Frapper;
@@ -98,10 +99,10 @@ private: // functions
 	//!
 	//! Procedural creation of curly hair deviations
 	//!
+	//! \param groom The hair groom holding the curl control vertices
 	//! \param totalHairGuideVertexNumber Vertex number of all hair guides combined
-	//! \param numberOfGuideHairs Number of used guide hairs
 	//!
-	void createCurlDeviations(int totalHairGuideVertexNumber, int numberOfGuideHairs);
+	void createCurlDeviations(const HairGroom &groom, int totalHairGuideVertexNumber);
 
 	//!
 	//! Procedural creation of hair strand deviations
@@ -123,9 +124,9 @@ private: // functions
 	//!
 	//! Creation of coordinate frames per guide hair vertex. One coordinate frame consists of 3 vectors
 	//!
-	//! \param hairStrands Vector of guide hair strands
+	//! \param groom The hair groom holding the guide strands
 	//!
-	void createCoordinateFrames(std::vector<std::vector<Ogre::Vector3>> hairStrands);
+	void createCoordinateFrames(const HairGroom &groom);
 
 	//!
 	//! Rotate a vector
@@ -142,10 +143,9 @@ private: // functions
 	//!
 	//! Creation of texture which hold the maximum/angle between hair strands of one face.
 	//!
-	//! \param scalpSubMesh Pointer to scalp sub mesh
-	//! \param hairStrands
+	//! \param groom The hair groom holding the guide strands and scalp triangles
 	//!
-	void createMaxDistanceAngleTexture(Ogre::SubMesh *scalpSubMesh, std::vector<std::vector<Ogre::Vector3>> hairStrands);
+	void createMaxDistanceAngleTexture(const HairGroom &groom);
 
 	//!
 	//! Calculate maximum distance between those vectors
@@ -172,17 +172,17 @@ private: // functions
 	//!
 	//! Creation of texture, which holds scalp mesh normals
 	//!
-	//! \param normalList List of scalp mesh normals
-	//! \param indexNormalList Index list of scalp mesh normals
+	//! \param normals Scalp mesh normals (xyz)
+	//! \param indexNormals Index list of scalp mesh normals (three indices per entry)
 	//!
-	void createScalpMeshNormalTexture(std::list<Ogre::Vector3> normalList, std::list<Ogre::Vector3> indexNormalList);
+	void createScalpMeshNormalTexture(const std::vector<float> &normals, const std::vector<float> &indexNormals);
 
 	//!
 	//! Creation of texture, which determines how the hair strand is bended. (Used to calculate detail tessellation factor at run-time)
 	//!
-	//! \param hairStrands Vector of guide hair strands
+	//! \param groom The hair groom holding the guide strands
 	//!
-	void createHairStrandBendTexture(std::vector<std::vector<Ogre::Vector3>> hairStrands);
+	void createHairStrandBendTexture(const HairGroom &groom);
 
 protected: //functions
 
@@ -0,0 +1,471 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation 
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "HairGroom.cpp"
+//! \brief Implementation file for the HairGroom class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "HairGroom.h"
+#include "Log.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace AnimatableMeshHairNode {
+using namespace Frapper;
+
+namespace {
+
+//!
+//! Identifies hair groom sidecar files. Increase the version whenever the
+//! file layout or the extraction changes.
+//!
+const char SidecarMagic[4] = { 'F', 'H', 'G', 'R' };
+const quint32 SidecarVersion = 1;
+
+//!
+//! Cell of the uniform grid over the guide strand roots.
+//!
+struct RootCell
+{
+	qint64 x, y, z;
+	int guide;
+
+	bool operator< ( const RootCell &other ) const
+	{
+		if (x != other.x) return x < other.x;
+		if (y != other.y) return y < other.y;
+		if (z != other.z) return z < other.z;
+		return guide < other.guide;
+	}
+
+	bool sameCell ( const RootCell &other ) const
+	{
+		return x == other.x && y == other.y && z == other.z;
+	}
+};
+
+//!
+//! Reads a three component float vertex element of the given vertex data.
+//!
+//! \return False if the vertex data has no such element.
+//!
+bool readVertexElement ( const Ogre::VertexData *vertexData, Ogre::VertexElementSemantic semantic, std::vector<float> &values )
+{
+	const Ogre::VertexElement *element = vertexData->vertexDeclaration->findElementBySemantic(semantic);
+	if (!element)
+		return false;
+
+	Ogre::HardwareVertexBufferSharedPtr vertexBuffer = vertexData->vertexBufferBinding->getBuffer(element->getSource());
+	const size_t numVertices = vertexBuffer->getNumVertices();
+	const size_t vertexSize = vertexBuffer->getVertexSize();
+	const size_t first = values.size();
+	values.resize(first + numVertices * 3);
+
+	unsigned char *vertexBufferPtr = static_cast<unsigned char*>(vertexBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
+	for (size_t v = 0; v < numVertices; ++v) {
+		float *pReal;
+		element->baseVertexPointerToElement(vertexBufferPtr + v * vertexSize, &pReal);
+		values[first + v*3 + 0] = pReal[0];
+		values[first + v*3 + 1] = pReal[1];
+		values[first + v*3 + 2] = pReal[2];
+	}
+	vertexBuffer->unlock();
+
+	return true;
+}
+
+//!
+//! Returns a well distributed seed for the random stream of an item.
+//!
+unsigned int hashSeed ( quint64 value )
+{
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	value = value ^ (value >> 31);
+	return static_cast<unsigned int>(value % 2147483646u) + 1u;
+}
+
+template <typename T>
+void writeArray ( QDataStream &stream, const std::vector<T> &values )
+{
+	stream << quint32(values.size());
+	if (!values.empty())
+		stream.writeRawData(reinterpret_cast<const char*>(&values[0]), int(values.size() * sizeof(T)));
+}
+
+template <typename T>
+bool readArray ( QDataStream &stream, std::vector<T> &values )
+{
+	quint32 size = 0;
+	stream >> size;
+	if (stream.status() != QDataStream::Ok || size > (quint32(1) << 30) / sizeof(T))
+		return false;
+	values.resize(size);
+	const int bytes = int(size * sizeof(T));
+	return size == 0 || stream.readRawData(reinterpret_cast<char*>(&values[0]), bytes) == bytes;
+}
+
+} // namespace
+
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the HairGroom class.
+//!
+HairGroom::HairGroom () :
+	numberOfGuideHairs(0),
+	maxNumberOfSegments(-1),
+	numberOfCurls(0)
+{
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Returns the key of the sidecar cache, a hash over the mesh file
+//! contents and the extraction parameters.
+//!
+QByteArray HairGroom::computeKey ( const QString &meshFilename, const QString &scalpMeshName, const QString &hairGuideName, float rootDistance, bool singleStrand )
+{
+	QFile file (meshFilename);
+	if (!file.open(QIODevice::ReadOnly))
+		return QByteArray();
+
+	QCryptographicHash hash (QCryptographicHash::Md5);
+	while (!file.atEnd())
+		hash.addData(file.read(1 << 20));
+
+	QByteArray parameters;
+	QDataStream stream (&parameters, QIODevice::WriteOnly);
+	stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+	stream << SidecarVersion << scalpMeshName << hairGuideName << rootDistance << singleStrand;
+	hash.addData(parameters);
+
+	return hash.result();
+}
+
+
+//!
+//! Returns the filename of the sidecar cache of the given hair mesh.
+//!
+QString HairGroom::getSidecarFilename ( const QString &meshFilename )
+{
+	return meshFilename + ".hairgroom";
+}
+
+
+//!
+//! Extracts the guide strands of the given mesh and binds them to the
+//! scalp mesh vertices.
+//!
+bool HairGroom::extract ( const Ogre::MeshPtr &mesh, const QString &scalpMeshName, const QString &hairGuideName, float rootDistance, bool singleStrand )
+{
+	numberOfGuideHairs = 0;
+	maxNumberOfSegments = -1;
+
+	// read all guide strands once (locking vertex buffers is not thread safe)
+	Ogre::SubMesh *scalpSubMesh = NULL;
+	std::vector<float> guideVertices;
+	std::vector<unsigned int> guideOffsets (1, 0);
+
+	const Ogre::Mesh::SubMeshNameMap &nameMap = mesh->getSubMeshNameMap();
+	for (Ogre::Mesh::SubMeshNameMap::const_iterator nameMapIter = nameMap.begin(); nameMapIter != nameMap.end(); ++nameMapIter) {
+		const QString subMeshName = nameMapIter->first.c_str();
+		Ogre::SubMesh *subMesh = mesh->getSubMesh(nameMapIter->second);
+
+		if (subMeshName.contains(scalpMeshName, Qt::CaseInsensitive))
+			scalpSubMesh = subMesh;
+
+		if (subMeshName.contains(hairGuideName, Qt::CaseInsensitive)) {
+			readVertexElement(subMesh->vertexData, Ogre::VES_POSITION, guideVertices);
+			guideOffsets.push_back(static_cast<unsigned int>(guideVertices.size() / 3));
+			++numberOfGuideHairs;
+
+			const int numberOfSegments = int(guideOffsets[numberOfGuideHairs] - guideOffsets[numberOfGuideHairs-1]) - 1;
+			if (maxNumberOfSegments < numberOfSegments)
+				maxNumberOfSegments = numberOfSegments;
+		}
+	}
+
+	if (!scalpSubMesh) {
+		Log::error("Scalp mesh: '" + scalpMeshName + "' has not been found!", "HairGroom::extract");
+		return false;
+	}
+
+	if (numberOfGuideHairs == 0) {
+		Log::error("Guide hairs containing name: '" + hairGuideName + "' have not been found!", "HairGroom::extract");
+		return false;
+	}
+
+	// read scalp mesh vertices, normals and triangles
+	std::vector<float> scalpVertices;
+	readVertexElement(scalpSubMesh->vertexData, Ogre::VES_POSITION, scalpVertices);
+	scalpNormals.clear();
+	readVertexElement(scalpSubMesh->vertexData, Ogre::VES_NORMAL, scalpNormals);
+
+	Ogre::IndexData *indexData = scalpSubMesh->indexData;
+	Ogre::HardwareIndexBufferSharedPtr indexBuffer = indexData->indexBuffer;
+	scalpIndices.resize(indexData->indexCount / 3 * 3);
+	if (indexBuffer->getType() == Ogre::HardwareIndexBuffer::IT_32BIT) {
+		const unsigned int *pInt = static_cast<unsigned int*>(indexBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
+		std::copy(pInt + indexData->indexStart, pInt + indexData->indexStart + scalpIndices.size(), scalpIndices.begin());
+	}
+	else {
+		const unsigned short *pShort = static_cast<unsigned short*>(indexBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
+		std::copy(pShort + indexData->indexStart, pShort + indexData->indexStart + scalpIndices.size(), scalpIndices.begin());
+	}
+	indexBuffer->unlock();
+
+	// uniform grid over the strand roots, cells are at least as large as
+	// the max root distance so only neighbouring cells have to be searched
+	const double cellSize = std::max(double(rootDistance), 1e-6);
+	std::vector<RootCell> rootCells;
+	rootCells.reserve(numberOfGuideHairs);
+	for (unsigned int g = 0; g < numberOfGuideHairs; ++g) {
+		if (guideOffsets[g+1] == guideOffsets[g])
+			continue;
+		const float *root = &guideVertices[guideOffsets[g] * 3];
+		RootCell cell = { qint64(std::floor(root[0] / cellSize)), qint64(std::floor(root[1] / cellSize)), qint64(std::floor(root[2] / cellSize)), int(g) };
+		rootCells.push_back(cell);
+	}
+	std::sort(rootCells.begin(), rootCells.end());
+
+	// bind every scalp vertex to the first guide strand (in submesh order)
+	// whose root lies within the root distance
+	const int numberOfScalpVertices = int(scalpVertices.size() / 3);
+	std::vector<int> binding (numberOfScalpVertices, -1);
+
+	#pragma omp parallel for schedule(dynamic, 256)
+	for (int v = 0; v < numberOfScalpVertices; ++v) {
+		const Ogre::Vector3 scalpVertex (scalpVertices[v*3], scalpVertices[v*3+1], scalpVertices[v*3+2]);
+		const qint64 cx = qint64(std::floor(scalpVertex.x / cellSize));
+		const qint64 cy = qint64(std::floor(scalpVertex.y / cellSize));
+		const qint64 cz = qint64(std::floor(scalpVertex.z / cellSize));
+		int guide = -1;
+
+		for (int dx = -1; dx <= 1; ++dx)
+		for (int dy = -1; dy <= 1; ++dy)
+		for (int dz = -1; dz <= 1; ++dz) {
+			const RootCell key = { cx + dx, cy + dy, cz + dz, -1 };
+			for (std::vector<RootCell>::const_iterator iter = std::lower_bound(rootCells.begin(), rootCells.end(), key); iter != rootCells.end() && iter->sameCell(key); ++iter) {
+				if (guide >= 0 && iter->guide >= guide)
+					break;
+				const float *root = &guideVertices[guideOffsets[iter->guide] * 3];
+				if (scalpVertex.distance(Ogre::Vector3(root[0], root[1], root[2])) <= rootDistance) {
+					guide = iter->guide;
+					break;
+				}
+			}
+		}
+		binding[v] = guide;
+	}
+
+	if (std::find(binding.begin(), binding.end(), -1) != binding.end()) {
+		Log::error("Hair mesh file error: no guide strand found for scalp mesh vertex.", "HairGroom::extract");
+		return false;
+	}
+
+	// store the bound strands consecutively
+	strandOffsets.resize(numberOfScalpVertices + 1);
+	strandOffsets[0] = 0;
+	for (int v = 0; v < numberOfScalpVertices; ++v)
+		strandOffsets[v+1] = strandOffsets[v] + guideOffsets[binding[v]+1] - guideOffsets[binding[v]];
+
+	vertices.resize(strandOffsets[numberOfScalpVertices] * 3);
+
+	#pragma omp parallel for schedule(dynamic, 256)
+	for (int v = 0; v < numberOfScalpVertices; ++v) {
+		const unsigned int first = guideOffsets[binding[v]] * 3;
+		const unsigned int last = guideOffsets[binding[v]+1] * 3;
+		std::copy(guideVertices.begin() + first, guideVertices.begin() + last, vertices.begin() + strandOffsets[v] * 3);
+	}
+
+	numberOfCurls = singleStrand ? numberOfGuideHairs : getNumberOfScalpTriangles();
+	createCurlControlVertices();
+
+	return true;
+}
+
+
+//!
+//! Reads the groom from the sidecar cache.
+//!
+bool HairGroom::load ( const QString &filename, const QByteArray &key )
+{
+	if (key.isEmpty())
+		return false;
+
+	QFile file (filename);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream (&file);
+	char magic[4];
+	quint32 version = 0;
+	if (stream.readRawData(magic, 4) != 4 || !std::equal(magic, magic + 4, SidecarMagic))
+		return false;
+	stream >> version;
+	if (version != SidecarVersion)
+		return false;
+
+	QByteArray storedKey (key.size(), 0);
+	if (stream.readRawData(storedKey.data(), storedKey.size()) != storedKey.size() || storedKey != key)
+		return false;
+
+	qint32 maxSegments = 0;
+	stream >> numberOfGuideHairs >> maxSegments >> numberOfCurls;
+	maxNumberOfSegments = maxSegments;
+
+	if (!readArray(stream, vertices) ||
+		!readArray(stream, strandOffsets) ||
+		!readArray(stream, scalpNormals) ||
+		!readArray(stream, scalpIndices) ||
+		!readArray(stream, curlControlVertices))
+		return false;
+
+	// reject truncated or inconsistent files
+	return stream.status() == QDataStream::Ok &&
+		!strandOffsets.empty() &&
+		strandOffsets.back() * 3 == vertices.size() &&
+		curlControlVertices.size() == size_t(numberOfCurls) * (CurlControlVertices - CurlFixedControlVertices) * 2;
+}
+
+
+//!
+//! Writes the groom to the sidecar cache.
+//!
+bool HairGroom::save ( const QString &filename, const QByteArray &key ) const
+{
+	// write to a temporary file and rename it, so a concurrent reader never
+	// sees a partially written sidecar
+	const QString tempFilename = QString("%1.%2.tmp").arg(filename).arg(QCoreApplication::applicationPid());
+	QFile file (tempFilename);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream stream (&file);
+	stream.writeRawData(SidecarMagic, 4);
+	stream << SidecarVersion;
+	stream.writeRawData(key.constData(), key.size());
+	stream << numberOfGuideHairs << qint32(maxNumberOfSegments) << numberOfCurls;
+	writeArray(stream, vertices);
+	writeArray(stream, strandOffsets);
+	writeArray(stream, scalpNormals);
+	writeArray(stream, scalpIndices);
+	writeArray(stream, curlControlVertices);
+	file.close();
+
+	if (stream.status() != QDataStream::Ok || file.error() != QFile::NoError) {
+		QFile::remove(tempFilename);
+		return false;
+	}
+
+	QFile::remove(filename);
+	if (!QFile::rename(tempFilename, filename)) {
+		QFile::remove(tempFilename);
+		return false;
+	}
+	return true;
+}
+
+
+//!
+//! Returns the number of strands, one per scalp vertex.
+//!
+unsigned int HairGroom::getNumberOfStrands () const
+{
+	return strandOffsets.empty() ? 0 : static_cast<unsigned int>(strandOffsets.size() - 1);
+}
+
+
+//!
+//! Returns the number of vertices of all strands.
+//!
+unsigned int HairGroom::getNumberOfStrandVertices () const
+{
+	return strandOffsets.empty() ? 0 : strandOffsets.back();
+}
+
+
+//!
+//! Returns the number of scalp triangles.
+//!
+unsigned int HairGroom::getNumberOfScalpTriangles () const
+{
+	return static_cast<unsigned int>(scalpIndices.size() / 3);
+}
+
+
+///
+/// Private Functions
+///
+
+
+//!
+//! Creates the random control vertices of the curl deviations. Every curve
+//! draws from its own random stream, so the curves can be created in
+//! parallel and do not depend on the number of threads.
+//!
+void HairGroom::createCurlControlVertices ()
+{
+	const int numRandomCVs = CurlControlVertices - CurlFixedControlVertices;
+	const float sd = 1.5f;
+
+	curlControlVertices.resize(size_t(numberOfCurls) * numRandomCVs * 2);
+
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < int(numberOfCurls); ++i) {
+		std::minstd_rand random (hashSeed(quint64(i)));
+		float *cv = &curlControlVertices[size_t(i) * numRandomCVs * 2];
+
+		for (int j = 0; j < numRandomCVs; ++j) {
+			// Box Muller transformation, uniform values in (0, 1]
+			const float unifVar1 = float(random()) / float(std::minstd_rand::max());
+			const float unifVar2 = float(random()) / float(std::minstd_rand::max());
+			const float temp = std::sqrt(-2.0f * std::log(unifVar1));
+			cv[j*2 + 0] = temp * std::cos(2.0f * Ogre::Math::PI * unifVar2) * sd;
+			cv[j*2 + 1] = temp * std::sin(2.0f * Ogre::Math::PI * unifVar2) * sd;
+		}
+	}
+}
+
+} // namespace AnimatableMeshHairNode
@@ -0,0 +1,204 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation 
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "HairGroom.h"
+//! \brief Header file for the HairGroom class.
+//!
+//! A hair groom holds the guide strands extracted from a hair mesh, bound
+//! to the vertices of the scalp mesh, and the control vertices of the curl
+//! deviations. All data is stored in contiguous arrays and can be written
+//! to a versioned binary sidecar file next to the mesh, so the extraction
+//! only runs when the mesh file or the extraction parameters change.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef HAIRGROOM_H
+#define HAIRGROOM_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <vector>
+
+// OGRE
+#include <Ogre.h>
+#if (OGRE_PLATFORM  == OGRE_PLATFORM_WIN32)
+#include <windows.h>
+#endif
+
+namespace AnimatableMeshHairNode {
+
+//!
+//! Guide strands and scalp bindings of a hair mesh.
+//!
+class HairGroom
+{
+
+public: // constants
+
+	//!
+	//! Number of control vertices of a curl deviation curve, the first
+	//! CurlFixedControlVertices of them are zero.
+	//!
+	static const int CurlControlVertices = 13;
+	static const int CurlFixedControlVertices = 4;
+
+public: // constructors and destructors
+
+	//!
+	//! Constructor of the HairGroom class.
+	//!
+	HairGroom ();
+
+public: // functions
+
+	//!
+	//! Returns the key of the sidecar cache, a hash over the mesh file
+	//! contents and the extraction parameters.
+	//!
+	//! \param meshFilename The absolute filename of the hair mesh.
+	//! \param scalpMeshName Part of the name of the scalp submesh.
+	//! \param hairGuideName Part of the names of the guide strand submeshes.
+	//! \param rootDistance Max distance of a strand root to its scalp vertex.
+	//! \param singleStrand Whether curls are created per guide strand or per scalp triangle.
+	//! \return The key or an empty byte array if the mesh file could not be read.
+	//!
+	static QByteArray computeKey ( const QString &meshFilename, const QString &scalpMeshName, const QString &hairGuideName, float rootDistance, bool singleStrand );
+
+	//!
+	//! Returns the filename of the sidecar cache of the given hair mesh.
+	//!
+	static QString getSidecarFilename ( const QString &meshFilename );
+
+	//!
+	//! Extracts the guide strands of the given mesh and binds them to the
+	//! scalp mesh vertices. Strand roots are matched in parallel (OpenMP)
+	//! through a uniform grid over the guide strand roots.
+	//!
+	//! \return True if every scalp vertex has a guide strand.
+	//!
+	bool extract ( const Ogre::MeshPtr &mesh, const QString &scalpMeshName, const QString &hairGuideName, float rootDistance, bool singleStrand );
+
+	//!
+	//! Reads the groom from the sidecar cache.
+	//!
+	//! \return True if the file exists and was written for the given key.
+	//!
+	bool load ( const QString &filename, const QByteArray &key );
+
+	//!
+	//! Writes the groom to the sidecar cache.
+	//!
+	//! \return True if the file was written.
+	//!
+	bool save ( const QString &filename, const QByteArray &key ) const;
+
+	//!
+	//! Returns the number of strands, one per scalp vertex.
+	//!
+	unsigned int getNumberOfStrands () const;
+
+	//!
+	//! Returns the number of vertices of all strands.
+	//!
+	unsigned int getNumberOfStrandVertices () const;
+
+	//!
+	//! Returns the number of scalp triangles.
+	//!
+	unsigned int getNumberOfScalpTriangles () const;
+
+	//!
+	//! Returns the vertex of a strand.
+	//!
+	inline Ogre::Vector3 getStrandVertex ( unsigned int strand, unsigned int vertex ) const
+	{
+		const float *p = &vertices[(strandOffsets[strand] + vertex) * 3];
+		return Ogre::Vector3(p[0], p[1], p[2]);
+	}
+
+	//!
+	//! Returns the number of vertices of a strand.
+	//!
+	inline unsigned int getStrandSize ( unsigned int strand ) const
+	{
+		return strandOffsets[strand+1] - strandOffsets[strand];
+	}
+
+private: // functions
+
+	//!
+	//! Creates the random control vertices of the curl deviations.
+	//!
+	void createCurlControlVertices ();
+
+public: // data
+
+	//!
+	//! Number of guide strand submeshes of the mesh.
+	//!
+	unsigned int numberOfGuideHairs;
+
+	//!
+	//! Max number of segments of a guide strand.
+	//!
+	int maxNumberOfSegments;
+
+	//!
+	//! Strand vertex positions (xyz), the strands are stored consecutively
+	//! in the order of the scalp vertices they are bound to.
+	//!
+	std::vector<float> vertices;
+
+	//!
+	//! First vertex of each strand, followed by the total vertex count.
+	//!
+	std::vector<unsigned int> strandOffsets;
+
+	//!
+	//! Scalp vertex normals (xyz).
+	//!
+	std::vector<float> scalpNormals;
+
+	//!
+	//! Scalp triangle vertex indices.
+	//!
+	std::vector<unsigned int> scalpIndices;
+
+	//!
+	//! Number of curl deviation curves.
+	//!
+	unsigned int numberOfCurls;
+
+	//!
+	//! Random control vertices (xy) of the curl deviation curves, without
+	//! the fixed control vertices at the root.
+	//!
+	std::vector<float> curlControlVertices;
+};
+
+} // namespace AnimatableMeshHairNode
+
+#endif
@@ -110,90 +110,111 @@ void MocapMeshNode::progressAnimation( const QString &animationName, float time,
 	Ogre::AnimationState *animState = m_entity->getAnimationState(animStateName);
     const float mult = getDoubleValue("mult");
 
-    if (animState) {
-        float animLength = animState->getLength();
-        Ogre::Real pos = mult * time * animLength;
+    if (!animState)
+        return;
 
-        QList<Ogre::Bone*> bonesToFade;
-        QList<Ogre::Vector3> bonePositions;
-        QList<Ogre::Quaternion> boneOrientations;
+    float animLength = animState->getLength();
+    Ogre::Real pos = mult * time * animLength;
 
-        // manually controlled bones might exist - reset them
-        if ( pos > 0 && skeletonInstance->hasAnimation( animationName.toStdString())) 
+    const bool blendBones = m_useBoneBlending && !m_boneBlendingSkipAnimations.contains(animationName);
+    m_fadePose.clear();
+
+    // manually controlled bones might exist - reset them
+    if (pos > 0 && skeletonInstance) 
+    {
+        const std::vector<unsigned short> &trackHandles = getTrackHandles(animationName, skeletonInstance);
+
+        m_manualHandles.clear();
+        for (size_t i = 0; i < trackHandles.size(); ++i)
+            if (skeletonInstance->getBone(trackHandles[i])->isManuallyControlled())
+                m_manualHandles.push_back(trackHandles[i]);
+
+        if (blendBones && !m_manualHandles.empty())
         {
-            Ogre::Animation *animation = skeletonInstance->getAnimation(animationName.toStdString());
-            Ogre::Animation::NodeTrackIterator trackIter = animation->getNodeTrackIterator();
-            while (trackIter.hasMoreElements()) {
-                Ogre::NodeAnimationTrack* track = trackIter.getNext();
-                Ogre::Bone *bone = skeletonInstance->getBone(track->getHandle());
-                if (bone->isManuallyControlled())
-                {
-                    if( m_useBoneBlending )
-                    {
-                        // Store current bone position and orientation for fading
-                        bonesToFade.append(bone);
-                        bonePositions.append(bone->getPosition());
-                        boneOrientations.append(bone->getOrientation());
-                    }
-
-                    bone->reset();
-					m_entityContainer->updateCopies( QString::fromStdString(bone->getName()), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
-                }
-            }
+            // Store current bone positions and orientations for fading
+            m_fadePose.setHandles(m_manualHandles);
+            m_fadePose.capture(skeletonInstance);
         }
 
-        // update all copies created from the entity through the entity container
-        if (m_entityContainer) {
-            m_entityContainer->updateAnimationState(animationName, pos, weight);
-        }
+        // the copies of the entity share its skeleton instance, so the
+        // bones only need to be reset once
+        for (size_t i = 0; i < m_manualHandles.size(); ++i)
+            skeletonInstance->getBone(m_manualHandles[i])->reset();
+    }
+
+    // update all copies created from the entity through the entity container
+    if (m_entityContainer) {
+        m_entityContainer->updateAnimationState(animationName, pos, weight);
+    }
+
+    if (m_fadePose.isEmpty())
+        return;
 
-        if( m_useBoneBlending && !m_boneBlendingSkipAnimations.contains(animationName)) 
+    float alpha = 0.0f;
+    if( time < m_boneBlendingRange )
+    {
+        // inside the dead zone the stored pose is kept
+        if( time < m_boneBlendingDeadZone )
         {
-            if( time < m_boneBlendingRange )
-            {
-				if( time < m_boneBlendingDeadZone )
-				{
-					for( int i=0; i<bonesToFade.size(); i++)
-					{
-						Ogre::Bone* bone = bonesToFade[i];
-
-						bone->setPosition( bonePositions[i] );
-						bone->setOrientation( boneOrientations[i] );
-
-						m_entityContainer->updateCopies( QString::fromStdString(bone->getName()), bonePositions[i], boneOrientations[i] );
-					}
-				}
-
-                const float alpha = time / m_boneBlendingRange;
-                for( size_t i=0; i<bonesToFade.size(); i++)
-                {
-                    Ogre::Bone* bone = bonesToFade[i];
-                    const Ogre::Vector3 position = alpha * bone->getPosition() + (1-alpha) * bonePositions[i];
-                    const Ogre::Quaternion orientation = Ogre::Quaternion::nlerp( alpha, boneOrientations[i], bone->getOrientation(), true);
-
-                    bone->setPosition( position );
-                    bone->setOrientation( orientation );
-
-                    m_entityContainer->updateCopies( QString::fromStdString(bone->getName()), position, orientation );
-                }
-            } 
-            else if( (1-time) < m_boneBlendingRange)
-            {
-				const float alpha = (1-time) / m_boneBlendingRange;
-                for( size_t i=0; i<bonesToFade.size(); i++)
-                {
-                    Ogre::Bone* bone = bonesToFade[i];
-                    const Ogre::Vector3 position = alpha * bone->getPosition() + (1-alpha) * bonePositions[i];
-                    const Ogre::Quaternion orientation = Ogre::Quaternion::nlerp( alpha, boneOrientations[i], bone->getOrientation(), true);
-
-                    bone->setPosition( position );
-                    bone->setOrientation( orientation );
-
-                    m_entityContainer->updateCopies( QString::fromStdString(bone->getName()), position, orientation );
-                }
-            }
+            m_fadePose.apply(skeletonInstance);
+            return;
+        }
+        alpha = time / m_boneBlendingRange;
+    }
+    else if( (1-time) < m_boneBlendingRange)
+        alpha = (1-time) / m_boneBlendingRange;
+    else
+        return;
+
+    // blend the stored pose with the current pose in one pass
+    m_blendPose.setHandles(m_manualHandles);
+    m_blendPose.capture(skeletonInstance);
+    SkeletonPose::blend(m_fadePose, m_blendPose, alpha, m_blendPose);
+    m_blendPose.apply(skeletonInstance);
+}
+
+
+//!
+//! Returns the handles of the bones animated by the skeletal animation
+//! with the given name. The handles are resolved once per skeleton.
+//!
+//! \param animationName The name of the animation.
+//! \param skeletonInstance The skeleton instance of the entity.
+//! \return The handles of the bones with a track in the animation.
+//!
+const std::vector<unsigned short> & MocapMeshNode::getTrackHandles ( const QString &animationName, Ogre::SkeletonInstance *skeletonInstance )
+{
+    QHash<QString, std::vector<unsigned short> >::iterator handlesIter = m_animationTrackHandles.find(animationName);
+    if (handlesIter != m_animationTrackHandles.end())
+        return handlesIter.value();
+
+    std::vector<unsigned short> handles;
+    const Ogre::String name = animationName.toStdString();
+    if (skeletonInstance->hasAnimation(name)) {
+        Ogre::Animation *animation = skeletonInstance->getAnimation(name);
+        handles.reserve(animation->getNumNodeTracks());
+        Ogre::Animation::NodeTrackIterator trackIter = animation->getNodeTrackIterator();
+        while (trackIter.hasMoreElements()) {
+            const unsigned short handle = trackIter.getNext()->getHandle();
+            if (handle < skeletonInstance->getNumBones())
+                handles.push_back(handle);
         }
     }
+    return m_animationTrackHandles.insert(animationName, handles).value();
+}
+
+
+//!
+//! Change function for the Geometry File parameter.
+//!
+void MocapMeshNode::geometryFileChanged ()
+{
+    m_animationTrackHandles.clear();
+    m_manualHandles.clear();
+    m_fadePose.clear();
+    m_blendPose.clear();
+
+    GeometryAnimationNode::geometryFileChanged();
 }
 
 //!
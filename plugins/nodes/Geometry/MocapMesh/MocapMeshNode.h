@@ -36,6 +36,8 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #define MOCAPMESHNODE_H 
 
 #include "GeometryAnimationNode.h"
+#include "SkeletonPose.h"
+#include <vector>
 
 using namespace Frapper;
 
@@ -82,6 +84,23 @@ protected: // functions
 
 	//virtual void transformBone( const QString &name, const Ogre::Vector3& position, const Ogre::Quaternion &orientation );
 
+	//!
+	//! Returns the handles of the bones animated by the skeletal animation
+	//! with the given name. The handles are resolved once per skeleton.
+	//!
+	//! \param animationName The name of the animation.
+	//! \param skeletonInstance The skeleton instance of the entity.
+	//! \return The handles of the bones with a track in the animation.
+	//!
+	const std::vector<unsigned short> & getTrackHandles ( const QString &animationName, Ogre::SkeletonInstance *skeletonInstance );
+
+protected slots:
+
+	//!
+	//! Change function for the Geometry File parameter.
+	//!
+	virtual void geometryFileChanged ();
+
 public slots:
 	void setBoneOrientation();
 
@@ -122,6 +141,23 @@ protected: // data
 
 	Ogre::Bone* m_leftHandBone;
 	Ogre::Bone* m_rightHandBone;
+
+	//!
+	//! Handles of the bones animated by each skeletal animation.
+	//!
+	QHash<QString, std::vector<unsigned short> > m_animationTrackHandles;
+
+	//!
+	//! Handles of the manually controlled bones of the current animation.
+	//!
+	std::vector<unsigned short> m_manualHandles;
+
+	//!
+	//! Pose of the manually controlled bones before they were reset, and the
+	//! pose they are blended with.
+	//!
+	SkeletonPose m_fadePose;
+	SkeletonPose m_blendPose;
 };
 
 #endif
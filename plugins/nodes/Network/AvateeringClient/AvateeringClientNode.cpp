@@ -31,6 +31,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //!
 
 #include "AvateeringClientNode.h"
+#include "AvateeringConnection.h"
 
 #include <OgreQuaternion.h>
 #include <OgreVector3.h>
@@ -89,6 +90,8 @@ QDataStream &operator>>(QDataStream &in,  BoneRetarget &data)
 
 AvateeringClientNode::AvateeringClientNode ( QString name, ParameterGroup *parameterRoot ) :
     ViewNode(name, parameterRoot),
+    m_connection(NULL),
+    m_bufferDelay(50),
     m_boneParams(NULL),
 	m_updateDraw(0),
 	m_selectedBone(-1),
@@ -103,6 +106,10 @@ AvateeringClientNode::AvateeringClientNode ( QString name, ParameterGroup *param
 	setChangeFunction("Bone Retarget > Flip Z", SLOT( FlipValueChanged()));
 	setChangeFunction("Bone Retarget > Retarget Data Filename", SLOT(RetargetDataFilenameChanged()));
 	setChangeFunction("PositionScale", SLOT(updatePositionScale()));
+	setChangeFunction("Jitter Buffer > Use Jitter Buffer", SLOT(updateJitterBuffer()));
+	setChangeFunction("Jitter Buffer > Buffer Delay", SLOT(updateJitterBuffer()));
+	setChangeFunction("Jitter Buffer > Output Rate", SLOT(updateJitterBuffer()));
+	setChangeFunction("Recording > Record", SLOT(toggleRecording()));
 
 	setCommandFunction("Bone Retarget > Load Retarget Data", SLOT(readRetargetSetup()));
 	setCommandFunction("Bone Retarget > Save Retarget Data", SLOT(writeRetargetSetup()));
@@ -117,8 +124,17 @@ AvateeringClientNode::AvateeringClientNode ( QString name, ParameterGroup *param
     m_boneParams = getParameterGroup("Bones");
     assert( m_boneParams );
 
-	// Disable nagels algorithm
-	m_tcpSocket.setSocketOption(QAbstractSocket::LowDelayOption, QVariant(1));
+	// the connection runs on its own thread and pushes decoded frames to the jitter buffer
+	m_clock.start();
+	m_connection = new AvateeringConnection(&m_jitterBuffer, m_clock);
+	m_connection->moveToThread(&m_networkThread);
+	connect(m_connection, SIGNAL(connected()), SLOT(connectionEstablished()));
+	connect(m_connection, SIGNAL(connectionError(const QString &)), SLOT(connectionFailed(const QString &)));
+	connect(m_connection, SIGNAL(framesReceived()), SLOT(processInputData()));
+	m_networkThread.start();
+
+	connect(&m_playoutTimer, SIGNAL(timeout()), SLOT(updatePlayout()));
+	updateJitterBuffer();
 
 	m_CharacterZeroPosition = Ogre::Vector3(0,0,0);
 
@@ -135,6 +151,14 @@ AvateeringClientNode::AvateeringClientNode ( QString name, ParameterGroup *param
 //!
 AvateeringClientNode::~AvateeringClientNode ()
 {
+	m_playoutTimer.stop();
+
+	// close the connection on the network thread and delete it after the thread finished
+	QMetaObject::invokeMethod(m_connection, "close", Qt::BlockingQueuedConnection);
+	m_networkThread.quit();
+	m_networkThread.wait();
+	delete m_connection;
+
 #ifdef DRAW_DEBUG
 	delete DebugDrawer::getSingletonPtr();
 #endif
@@ -168,39 +192,29 @@ void AvateeringClientNode::toggleRun()
 		closeConnection();
 		resetAvateeringData();
 	}
-
-	// get state of connection and set value of run flag
-	bool connected = m_tcpSocket.state() == QAbstractSocket::ConnectedState;
-	setValue("Run", connected );
 }
 
 //!
-//! This function tries to establish a connection to faceshift using the given host and port informations
+//! This function starts to connect to the avateering server using the given host and port informations.
+//! The connection is established on the network thread, the GUI thread does not block.
 //!
 void AvateeringClientNode::establishConnection()
 {
     unsigned int port = getValue("Port").toUInt();
     QString host = getValue("Host").toString();
 
-    if( port > 0 && host != "" )
+    if( port > 0 && port <= 65535 && host != "" )
     {
-        m_tcpSocket.connectToHost( host, port);
-        Log::debug("Trying to connect to "+host+":"+QString::number(port)+"...", "AvateeringClientNode::run()");
+        m_jitterBuffer.clear();
 
-        if (m_tcpSocket.waitForConnected(5000))
-        {
-            // connected
-            Log::debug("Connection established!", "AvateeringClientNode::run()");
+        EnumerationParameter *protocolParameter = getEnumerationParameter("Protocol");
+        const int protocol = protocolParameter ? protocolParameter->getCurrentIndex() : AvateeringConnection::AutoDetect;
 
-            // connect events
-            connect( &m_tcpSocket, SIGNAL(readyRead()), this, SLOT(processInputData()));
+        QMetaObject::invokeMethod(m_connection, "open", Qt::QueuedConnection, 
+            Q_ARG(QString, host), Q_ARG(int, int(port)), Q_ARG(int, protocol));
 
-            m_stopWatch.start();
-        }
-        else
-        {
-            Log::error("Connection timed out after 5s! "+m_tcpSocket.errorString());
-        }
+        m_stopWatch.start();
+        updateJitterBuffer();
     }
 }
 
@@ -209,14 +223,100 @@ void AvateeringClientNode::establishConnection()
 //!
 void AvateeringClientNode::closeConnection()
 {
-    Log::debug("Closing Connection", "AvateeringClientNode::threadFinished");
-    m_tcpSocket.abort();
+    m_playoutTimer.stop();
+    QMetaObject::invokeMethod(m_connection, "close", Qt::QueuedConnection);
+}
+
+//!
+//! Slot which is called when the network thread established the connection.
+//!
+void AvateeringClientNode::connectionEstablished()
+{
+    // start a pending recording with the connection
+    toggleRecording();
+}
+
+//!
+//! Slot which is called when the connection failed or was lost.
+//!
+//! \param message The error message of the connection.
+//!
+void AvateeringClientNode::connectionFailed( const QString &message )
+{
+    Log::error("Connection failed! "+message, "AvateeringClientNode::connectionFailed");
+    if( getBoolValue("Run") )
+        setValue("Run", false, true);
 }
 
 //!
-//! Slot which is called when new datagrams are availabled on udp socket.
+//! Slot which is called when the network thread received new frames.
+//! Without jitter buffer the newest frame is applied directly.
 //!
 void AvateeringClientNode::processInputData()
+{
+    if( !m_playoutTimer.isActive() )
+    {
+        AvateeringFrame frame;
+        if( m_jitterBuffer.latest(frame) )
+            applyFrame(frame);
+    }
+    updateRate();
+}
+
+//!
+//! Slot which is called by the playout timer. Samples the jitter buffer 
+//! at the current time minus the buffer delay.
+//!
+void AvateeringClientNode::updatePlayout()
+{
+    AvateeringFrame frame;
+    if( m_jitterBuffer.sample(m_clock.elapsed() - m_bufferDelay, frame) )
+        applyFrame(frame);
+}
+
+//!
+//! Slot which is called when the jitter buffer settings change.
+//!
+void AvateeringClientNode::updateJitterBuffer()
+{
+    m_bufferDelay = getIntValue("Jitter Buffer > Buffer Delay");
+
+    const int outputRate = getIntValue("Jitter Buffer > Output Rate");
+    m_playoutTimer.setInterval( outputRate > 0 ? 1000 / outputRate : 16 );
+
+    if( getBoolValue("Jitter Buffer > Use Jitter Buffer") && getBoolValue("Run") )
+        m_playoutTimer.start();
+    else
+        m_playoutTimer.stop();
+}
+
+//!
+//! Slot which is called when the record flag is toggled.
+//!
+void AvateeringClientNode::toggleRecording()
+{
+    if( getBoolValue("Recording > Record") )
+    {
+        const QString filename = getStringValue("Recording > Record Filename");
+        if( filename.isEmpty() )
+        {
+            Log::error("Filename is invalid!", "AvateeringClientNode::toggleRecording");
+            return;
+        }
+        QMetaObject::invokeMethod(m_connection, "startRecording", Qt::QueuedConnection, Q_ARG(QString, filename));
+    }
+    else
+    {
+        QMetaObject::invokeMethod(m_connection, "stopRecording", Qt::QueuedConnection);
+    }
+}
+
+//!
+//! Copies the joints of the given frame and updates the bone parameters.
+//!
+//! \param frame The frame to apply, joints missing in it are kept.
+//!
+void AvateeringClientNode::applyFrame( const AvateeringFrame& frame )
 {
 #ifdef DRAW_DEBUG
 	++m_updateDraw %= 2;
@@ -228,95 +328,15 @@ void AvateeringClientNode::processInputData()
 		DebugDrawer::getSingleton().clear();
 	}
 #endif
-	
-	// record frames
-	int frames_decoded = 1;
-
-	// read complete stream
-	QStringList lines;
-	while( m_tcpSocket.canReadLine())
-	{
-		lines.append(m_tcpSocket.readLine());
-		//frames_decoded++;
-	}
-
-	bool bonesDataReceived[NumberOfJoints];
-	for( int i=0; i<NumberOfJoints; i++)
-		bonesDataReceived[i] = false;
 
-	while( !lines.empty())
+	for( int bone=0; bone<NumberOfJoints; bone++)
 	{
-		QString text = lines.last();
-		lines.removeLast();
-
-		text = text.replace(",","."); // convert de_DE to en_US
-		QStringList values = text.split(" ");
-
-		int bone = -1;
-		float qw=0, qx=1, qy=0, qz=0;
-		float px=0, py=0, pz=0;
-		bool tracked = true;
-
-		if( values.size() >= 5 )
-		{
-			// read joint indices
-			bone = values[0].toInt();
-
-			if( bone>0 && bonesDataReceived[bone] )
-				continue;
-			else
-				bonesDataReceived[bone]=true;
-
-			// read hierarchical rotation of bone
-			qw = values[1].toFloat();
-			qx = values[2].toFloat();
-			qy = values[3].toFloat();
-			qz = values[4].toFloat();
-
-			// read position of bone (optional)
-			if( values.size() >= 8 )
-			{
-				// read hierarchical rotation of bone
-				px = values[5].toFloat();
-				py = values[6].toFloat();
-				pz = values[7].toFloat();
-
-				if( values.size() >= 9 )
-				{
-					tracked = (values[8].contains("True")); // damn u, c#
-				}
-			}
-		}
-		if( bone >= 0 && bone < NumberOfJoints)
-		{
-			AvateeringBoneData& refBoneData = m_boneData[bone];
-			refBoneData.joint = (JointType) bone;
-			refBoneData.orientation = Ogre::Quaternion( qw, qx, qy, qz);
-			refBoneData.position = Ogre::Vector3( px, py, pz);
-			refBoneData.tracked = tracked;
-		}
+		if( frame.jointMask & (1u << bone) )
+			m_boneData[bone] = frame.bones[bone];
 	}
 
 	updateBoneParameter();
 
-    if( frames_decoded )
-    {
-        // measure time since the last data received
-        int time = m_stopWatch.elapsed();
-        int rate = frames_decoded*1000 / ((time+1)*20); // 20 lines per frame
-
-        m_updateRates.push_back(rate);
-        while( m_updateRates.size() > 5)
-            m_updateRates.pop_front();
-
-        rate = 0;
-        foreach( int value, m_updateRates)
-            rate += value;
-        
-        this->getParameter("Update Rate")->setValue(QVariant(rate));
-        m_stopWatch.restart();
-    }
-
 #ifdef DRAW_DEBUG
 	if( m_updateDraw)
 	{
@@ -325,6 +345,20 @@ void AvateeringClientNode::processInputData()
 #endif
 }
 
+//!
+//! Updates the rate of received frames once per second.
+//!
+void AvateeringClientNode::updateRate()
+{
+    const int time = m_stopWatch.elapsed();
+    if( time < 1000 )
+        return;
+
+    const int rate = m_jitterBuffer.takeReceivedCount()*1000 / time;
+    this->getParameter("Update Rate")->setValue(QVariant(rate));
+    m_stopWatch.restart();
+}
+
 Ogre::SceneNode * AvateeringClientNode::getSceneNode()
 {
 	return m_sceneNode;
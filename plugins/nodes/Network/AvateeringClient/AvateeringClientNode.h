@@ -34,105 +34,21 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #define AVATEERINGCLIENTNODE_H
 
 #include <QtCore/QDataStream>
-#include <QtNetwork/QTcpSocket>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QTime>
 #include <QDataStream> // file I/O
 
 #include "ViewNode.h"
 #include "ParameterGroup.h"
+#include "AvateeringProtocol.h"
+#include "AvateeringJitterBuffer.h"
 
 namespace AvateeringClientNode {
 using namespace Frapper;
 
-// Summary:
-//     This contains all of the possible joint types.
-enum JointType
-{
-	// Summary:
-	//     The center of the hip.
-	HipCenter = 0,
-	//
-	// Summary:
-	//     The bottom of the spine.
-	Spine = 1,
-	//
-	// Summary:
-	//     The center of the shoulders.
-	ShoulderCenter = 2,
-	//
-	// Summary:
-	//     The players head.
-	Head = 3,
-	//
-	// Summary:
-	//     The left shoulder.
-	ShoulderLeft = 4,
-	//
-	// Summary:
-	//     The left elbow.
-	ElbowLeft = 5,
-	//
-	// Summary:
-	//     The left wrist.
-	WristLeft = 6,
-	//
-	// Summary:
-	//     The left hand.
-	HandLeft = 7,
-	//
-	// Summary:
-	//     The right shoulder.
-	ShoulderRight = 8,
-	//
-	// Summary:
-	//     The right elbow.
-	ElbowRight = 9,
-	//
-	// Summary:
-	//     The right wrist.
-	WristRight = 10,
-	//
-	// Summary:
-	//     The right hand.
-	HandRight = 11,
-	//
-	// Summary:
-	//     The left hip.
-	HipLeft = 12,
-	//
-	// Summary:
-	//     The left knee.
-	KneeLeft = 13,
-	//
-	// Summary:
-	//     The left ankle.
-	AnkleLeft = 14,
-	//
-	// Summary:
-	//     The left foot.
-	FootLeft = 15,
-	//
-	// Summary:
-	//     The right hip.
-	HipRight = 16,
-	//
-	// Summary:
-	//     The right knee.
-	KneeRight = 17,
-	//
-	// Summary:
-	//     The right ankle.
-	AnkleRight = 18,
-	//
-	// Summary:
-	//     The right foot.
-	FootRight = 19,
-
-	//
-	// Summary:
-	//     The total number of joints in this list
-	NumberOfJoints = 20,
-};
+class AvateeringConnection;
 
 // Enumeration of possible mappings of coordinate spaces
 enum CoordinateMapping 
@@ -170,26 +86,6 @@ struct BoneRetarget
 QDataStream &operator<<(QDataStream &out, const BoneRetarget &data);
 QDataStream &operator>>(QDataStream &in,  BoneRetarget &data);
 
-//!
-//! This struct is used to store the data that is streamed from 
-//! the Avateering application
-//!
-struct AvateeringBoneData
-{
-	//! The type of joint
-	JointType joint;
-
-	//! The joint orientation (hierarchical)
-	Ogre::Quaternion orientation;
-
-	//! The type of joint
-	Ogre::Vector3 position;
-
-	//! Joint was tracked sucessfully
-	bool tracked;
-};
-
-
 //!
 //! Input node for Avateering tracking data via tcp
 //!
@@ -237,9 +133,24 @@ private slots: //
 	//! Close the current connection
 	void closeConnection();
 
-    //! Slot which is called when running flag on node is toggled.
+	//! Slot which is called when the network thread established the connection.
+	void connectionEstablished();
+
+	//! Slot which is called when the connection failed or was lost.
+	void connectionFailed( const QString &message );
+
+    //! Slot which is called when the network thread received new frames.
     void processInputData();
 
+	//! Slot which is called by the playout timer to sample the jitter buffer.
+	void updatePlayout();
+
+	//! Slot which is called when the jitter buffer settings change.
+	void updateJitterBuffer();
+
+	//! Slot which is called when the record flag is toggled.
+	void toggleRecording();
+
 	//! Slot which is called when the current bone in setup tab changes
 	void BoneValueChanged();
 
@@ -279,14 +190,41 @@ private: // functions
 	void setBoneParameter( const int& bone, const Ogre::Quaternion& rot, const Ogre::Vector3& pos );
 	void updateBoneParameter();
 
+	//! Copies the joints of a received or interpolated frame and updates the bones
+	void applyFrame( const AvateeringFrame& frame );
+
+	//! Updates the rate of received frames once per second
+	void updateRate();
+
 	void initAvateeringData();
 
 private: // data
 
     //!
-    //! The udp socket.
+    //! The network thread and the connection running on it.
+    //!
+    QThread m_networkThread;
+    AvateeringConnection *m_connection;
+
+    //!
+    //! The buffer of received frames.
+    //!
+    AvateeringJitterBuffer m_jitterBuffer;
+
+    //!
+    //! The clock received frames are timestamped with.
     //!
-    QTcpSocket m_tcpSocket;
+    QElapsedTimer m_clock;
+
+    //!
+    //! Timer to sample the jitter buffer at the output rate.
+    //!
+    QTimer m_playoutTimer;
+
+    //!
+    //! The playout delay of the jitter buffer in milliseconds.
+    //!
+    int m_bufferDelay;
 
    
     //!
@@ -299,10 +237,6 @@ private: // data
     //!
     QTime m_stopWatch;
 
-    //!
-    //! The last rates
-    //!
-    QList<int> m_updateRates;
 
 	//!
 	//! The scene node for the skeleton drawing
@@ -0,0 +1,291 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringConnection.cpp"
+//! \brief Implementation file for AvateeringConnection class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "AvateeringConnection.h"
+#include "AvateeringJitterBuffer.h"
+#include "Log.h"
+
+namespace AvateeringClientNode {
+using namespace Frapper;
+
+//!
+//! Constructor of the AvateeringConnection class.
+//!
+//! \param jitterBuffer The buffer to push received frames to.
+//! \param clock The clock to timestamp received frames with.
+//!
+AvateeringConnection::AvateeringConnection ( AvateeringJitterBuffer *jitterBuffer, const QElapsedTimer &clock ) :
+	m_socket(0),
+	m_jitterBuffer(jitterBuffer),
+	m_clock(clock),
+	m_protocol(AutoDetect),
+	m_lastTextJoint(-1),
+	m_clockOffset(0),
+	m_clockOffsetValid(false)
+{
+}
+
+
+//!
+//! Destructor of the AvateeringConnection class.
+//!
+AvateeringConnection::~AvateeringConnection ()
+{
+	m_recording.close();
+}
+
+
+//!
+//! Starts to connect to the given host and returns immediately. The socket
+//! is created on first use, so it lives on the network thread.
+//!
+//! \param host The host of the Avateering server.
+//! \param port The port of the Avateering server.
+//! \param protocol The Protocol of the stream, AutoDetect detects it from the first bytes.
+//!
+void AvateeringConnection::open ( const QString &host, int port, int protocol )
+{
+	close();
+
+	if (!m_socket) {
+		m_socket = new QTcpSocket(this);
+		connect(m_socket, SIGNAL(connected()), SLOT(socketConnected()));
+		connect(m_socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(socketError()));
+		connect(m_socket, SIGNAL(readyRead()), SLOT(readData()));
+	}
+
+	m_protocol = protocol;
+	m_receiveBuffer.clear();
+	m_textFrame.clear();
+	m_lastTextJoint = -1;
+	m_clockOffsetValid = false;
+
+	Log::debug("Trying to connect to "+host+":"+QString::number(port)+"...", "AvateeringConnection::open");
+	m_socket->connectToHost(host, quint16(port));
+}
+
+
+//!
+//! Closes the connection and a running recording.
+//!
+void AvateeringConnection::close ()
+{
+	if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
+		Log::debug("Closing Connection", "AvateeringConnection::close");
+		m_socket->abort();
+	}
+	m_recording.close();
+}
+
+
+//!
+//! Starts to record the received frames to the given file.
+//!
+//! \param filename The name of the recording file.
+//!
+void AvateeringConnection::startRecording ( const QString &filename )
+{
+	if (m_recording.openForWriting(filename, m_clock.elapsed()))
+		Log::debug(QString("Recording to \"%1\".").arg(filename), "AvateeringConnection::startRecording");
+	else
+		Log::error(QString("Could not create recording \"%1\".").arg(filename), "AvateeringConnection::startRecording");
+}
+
+
+//!
+//! Stops recording.
+//!
+void AvateeringConnection::stopRecording ()
+{
+	m_recording.close();
+}
+
+
+//!
+//! Slot which is called when the socket is connected.
+//!
+void AvateeringConnection::socketConnected ()
+{
+	// Disable nagels algorithm
+	m_socket->setSocketOption(QAbstractSocket::LowDelayOption, QVariant(1));
+
+	Log::debug("Connection established!", "AvateeringConnection::socketConnected");
+	emit connected();
+}
+
+
+//!
+//! Slot which is called when the socket reports an error.
+//!
+void AvateeringConnection::socketError ()
+{
+	emit connectionError(m_socket->errorString());
+}
+
+
+//!
+//! Slot which is called when new data is available on the socket. Detects
+//! the protocol if needed and decodes the complete frames.
+//!
+void AvateeringConnection::readData ()
+{
+	m_receiveBuffer.append(m_socket->readAll());
+
+	if (m_protocol == AutoDetect) {
+		if (m_receiveBuffer.size() < 4)
+			return;
+		m_protocol = AvateeringProtocol::isBinaryFrame(m_receiveBuffer.constData(), m_receiveBuffer.size()) ? Binary : Text;
+		Log::debug(QString("Detected %1 protocol.").arg(m_protocol == Binary ? "binary" : "text"), "AvateeringConnection::readData");
+	}
+
+	const bool received = (m_protocol == Binary) ? decodeBinary() : decodeText();
+	if (received)
+		emit framesReceived();
+}
+
+
+//!
+//! Decodes the binary frames in the receive buffer and removes them from it.
+//! An invalid frame closes the connection.
+//!
+//! \return True if at least one frame was delivered.
+//!
+bool AvateeringConnection::decodeBinary ()
+{
+	bool received = false;
+	int position = 0;
+	AvateeringFrame frame;
+
+	while (position < m_receiveBuffer.size()) {
+		const int consumed = AvateeringProtocol::decodeFrame(m_receiveBuffer.constData() + position, m_receiveBuffer.size() - position, frame);
+		if (consumed == 0)
+			break;
+
+		if (consumed < 0) {
+			Log::error("Invalid binary frame received, closing connection.", "AvateeringConnection::decodeBinary");
+			m_receiveBuffer.clear();
+			m_socket->abort();
+			emit connectionError("Invalid binary frame");
+			return received;
+		}
+
+		deliverFrame(frame, true);
+		position += consumed;
+		received = true;
+	}
+
+	m_receiveBuffer.remove(0, position);
+	return received;
+}
+
+
+//!
+//! Decodes the text lines in the receive buffer and removes them from it.
+//! A frame is delivered when it is complete or the next frame starts.
+//!
+//! \return True if at least one frame was delivered.
+//!
+bool AvateeringConnection::decodeText ()
+{
+	bool received = false;
+	int position = 0;
+
+	int lineEnd;
+	while ((lineEnd = m_receiveBuffer.indexOf('\n', position)) >= 0) {
+		AvateeringBoneData bone;
+		const QByteArray line = QByteArray::fromRawData(m_receiveBuffer.constData() + position, lineEnd - position);
+		position = lineEnd + 1;
+
+		if (!AvateeringProtocol::parseTextLine(line, bone))
+			continue;
+
+		// joints are sent in order, a lower or repeated joint starts a new frame
+		if (bone.joint <= m_lastTextJoint && m_textFrame.jointMask) {
+			deliverFrame(m_textFrame, false);
+			m_textFrame.clear();
+			received = true;
+		}
+
+		m_textFrame.bones[bone.joint] = bone;
+		m_textFrame.jointMask |= 1u << bone.joint;
+		m_lastTextJoint = bone.joint;
+
+		// deliver complete frames without waiting for the next one
+		if (m_textFrame.jointMask == (1u << NumberOfJoints) - 1) {
+			deliverFrame(m_textFrame, false);
+			m_textFrame.clear();
+			m_lastTextJoint = -1;
+			received = true;
+		}
+	}
+
+	m_receiveBuffer.remove(0, position);
+	return received;
+}
+
+
+//!
+//! Timestamps a decoded frame with the local clock, records it and pushes
+//! it to the jitter buffer.
+//!
+//! \param frame The decoded frame, receives its timestamps.
+//! \param hasSenderTime True if the frame carries the sender time.
+//!
+void AvateeringConnection::deliverFrame ( AvateeringFrame &frame, bool hasSenderTime )
+{
+	const qint64 now = m_clock.elapsed();
+
+	if (hasSenderTime) {
+		// map the sender clock to the local clock, the min offset belongs
+		// to the frame with the least network delay
+		const qint64 offset = now - qint64(frame.senderTime);
+		if (!m_clockOffsetValid || offset < m_clockOffset) {
+			m_clockOffset = offset;
+			m_clockOffsetValid = true;
+		}
+		frame.time = qint64(frame.senderTime) + m_clockOffset;
+	}
+	else {
+		frame.senderTime = quint32(now);
+		frame.time = now;
+	}
+
+	if (m_recording.isOpen()) {
+		// recordings keep the receive time to replay the original jitter
+		AvateeringFrame recordedFrame = frame;
+		recordedFrame.time = now;
+		m_recording.writeFrame(recordedFrame);
+	}
+
+	m_jitterBuffer->push(frame);
+}
+
+} // namespace AvateeringClientNode 
@@ -0,0 +1,202 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringConnection.h"
+//! \brief Header file for AvateeringConnection class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef AVATEERINGCONNECTION_H
+#define AVATEERINGCONNECTION_H
+
+#include "AvateeringProtocol.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtNetwork/QTcpSocket>
+
+namespace AvateeringClientNode {
+
+class AvateeringJitterBuffer;
+
+//!
+//! Receives the Avateering stream on a network thread. The connection is
+//! moved to its own thread and controlled through queued slot calls, the
+//! decoded frames are pushed to the jitter buffer and can be recorded.
+//!
+class AvateeringConnection : public QObject
+{
+
+    Q_OBJECT
+
+public: // enumerations
+
+	//!
+	//! The stream protocols.
+	//!
+	enum Protocol
+	{
+		AutoDetect = 0,
+		Text = 1,
+		Binary = 2
+	};
+
+public: // constructors and destructors
+
+	//!
+	//! Constructor of the AvateeringConnection class.
+	//!
+	//! \param jitterBuffer The buffer to push received frames to.
+	//! \param clock The clock to timestamp received frames with.
+	//!
+	AvateeringConnection ( AvateeringJitterBuffer *jitterBuffer, const QElapsedTimer &clock );
+
+	//!
+	//! Destructor of the AvateeringConnection class.
+	//!
+	~AvateeringConnection ();
+
+public slots: //
+
+	//!
+	//! Starts to connect to the given host, returns immediately.
+	//!
+	void open ( const QString &host, int port, int protocol );
+
+	//!
+	//! Closes the connection.
+	//!
+	void close ();
+
+	//!
+	//! Starts to record the received frames to the given file.
+	//!
+	void startRecording ( const QString &filename );
+
+	//!
+	//! Stops recording.
+	//!
+	void stopRecording ();
+
+signals: //
+
+	//!
+	//! Signal that is emitted when the connection was established.
+	//!
+	void connected ();
+
+	//!
+	//! Signal that is emitted when the connection failed or was lost.
+	//!
+	void connectionError ( const QString &message );
+
+	//!
+	//! Signal that is emitted after new frames were pushed to the buffer.
+	//!
+	void framesReceived ();
+
+private slots: //
+
+	//!
+	//! Slot which is called when the socket is connected.
+	//!
+	void socketConnected ();
+
+	//!
+	//! Slot which is called when the socket reports an error.
+	//!
+	void socketError ();
+
+	//!
+	//! Slot which is called when new data is available on the socket.
+	//!
+	void readData ();
+
+private: // functions
+
+	//!
+	//! Decodes the binary frames in the receive buffer.
+	//!
+	bool decodeBinary ();
+
+	//!
+	//! Decodes the text lines in the receive buffer.
+	//!
+	bool decodeText ();
+
+	//!
+	//! Timestamps a decoded frame and pushes it to the buffer.
+	//!
+	void deliverFrame ( AvateeringFrame &frame, bool hasSenderTime );
+
+private: // data
+
+	//!
+	//! The tcp socket, created on the network thread.
+	//!
+	QTcpSocket *m_socket;
+
+	//!
+	//! The buffer of received frames.
+	//!
+	AvateeringJitterBuffer *m_jitterBuffer;
+
+	//!
+	//! The clock of the node.
+	//!
+	const QElapsedTimer &m_clock;
+
+	//!
+	//! The selected and the detected protocol.
+	//!
+	int m_protocol;
+
+	//!
+	//! Received data not decoded yet.
+	//!
+	QByteArray m_receiveBuffer;
+
+	//!
+	//! The text frame that is currently assembled.
+	//!
+	AvateeringFrame m_textFrame;
+	int m_lastTextJoint;
+
+	//!
+	//! Offset of the local clock to the sender clock, the min seen so far.
+	//!
+	qint64 m_clockOffset;
+	bool m_clockOffsetValid;
+
+	//!
+	//! The recording, open while recording.
+	//!
+	AvateeringRecording m_recording;
+};
+
+} // namespace AvateeringClientNode 
+
+#endif
@@ -0,0 +1,174 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringJitterBuffer.cpp"
+//! \brief Implementation file for AvateeringJitterBuffer class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "AvateeringJitterBuffer.h"
+
+#include <QtCore/QMutexLocker>
+
+namespace AvateeringClientNode {
+
+//!
+//! Constructor of the AvateeringJitterBuffer class.
+//!
+//! \param capacity The max number of buffered frames, at least 2.
+//!
+AvateeringJitterBuffer::AvateeringJitterBuffer ( int capacity ) :
+	m_capacity(capacity > 2 ? capacity : 2),
+	m_receivedCount(0)
+{
+}
+
+
+//!
+//! Adds a frame. Frames older than the newest frame are dropped, missing
+//! joints are completed from the previous frame.
+//!
+//! \param frame The frame to add.
+//!
+void AvateeringJitterBuffer::push ( const AvateeringFrame &frame )
+{
+	QMutexLocker locker(&m_mutex);
+	++m_receivedCount;
+
+	if (m_frames.empty()) {
+		m_frames.push_back(frame);
+		return;
+	}
+
+	const AvateeringFrame &previous = m_frames.back();
+	if (frame.time < previous.time)
+		return;
+
+	// complete the frame with the joints of the previous frame
+	AvateeringFrame completeFrame = frame;
+	for (int i = 0; i < NumberOfJoints; ++i) {
+		if (!(frame.jointMask & (1u << i)) && (previous.jointMask & (1u << i))) {
+			completeFrame.bones[i] = previous.bones[i];
+			completeFrame.jointMask |= 1u << i;
+		}
+	}
+
+	m_frames.push_back(completeFrame);
+	while (int(m_frames.size()) > m_capacity)
+		m_frames.pop_front();
+}
+
+
+//!
+//! Interpolates the frames at the given time and drops the frames that are
+//! no longer needed.
+//!
+//! \param time The time to sample at.
+//! \param frame Receives the interpolated frame.
+//! \return True if the buffer held a frame.
+//!
+bool AvateeringJitterBuffer::sample ( qint64 time, AvateeringFrame &frame )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_frames.empty())
+		return false;
+
+	// drop the frames that are no longer needed for interpolation
+	while (m_frames.size() > 1 && m_frames[1].time <= time)
+		m_frames.pop_front();
+
+	const AvateeringFrame &first = m_frames.front();
+	if (time <= first.time || m_frames.size() == 1) {
+		frame = first;
+		return true;
+	}
+
+	const AvateeringFrame &second = m_frames[1];
+	const float t = float(time - first.time) / float(second.time - first.time);
+
+	frame = first;
+	frame.time = time;
+	frame.jointMask = first.jointMask | second.jointMask;
+	for (int i = 0; i < NumberOfJoints; ++i) {
+		const quint32 bit = 1u << i;
+		if ((first.jointMask & bit) && (second.jointMask & bit)) {
+			AvateeringBoneData &bone = frame.bones[i];
+			bone.orientation = Ogre::Quaternion::Slerp(t, first.bones[i].orientation, second.bones[i].orientation, true);
+			bone.position = first.bones[i].position + (second.bones[i].position - first.bones[i].position) * t;
+			bone.tracked = t < 0.5f ? first.bones[i].tracked : second.bones[i].tracked;
+		}
+		else if (second.jointMask & bit) {
+			frame.bones[i] = second.bones[i];
+		}
+	}
+	return true;
+}
+
+
+//!
+//! Returns the newest frame.
+//!
+//! \param frame Receives the newest frame.
+//! \return True if the buffer held a frame.
+//!
+bool AvateeringJitterBuffer::latest ( AvateeringFrame &frame )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_frames.empty())
+		return false;
+
+	frame = m_frames.back();
+	return true;
+}
+
+
+//!
+//! Removes all frames and resets the received count.
+//!
+void AvateeringJitterBuffer::clear ()
+{
+	QMutexLocker locker(&m_mutex);
+	m_frames.clear();
+	m_receivedCount = 0;
+}
+
+
+//!
+//! Returns the number of frames pushed since the last call and resets it.
+//!
+//! \return The number of received frames.
+//!
+int AvateeringJitterBuffer::takeReceivedCount ()
+{
+	QMutexLocker locker(&m_mutex);
+	const int count = m_receivedCount;
+	m_receivedCount = 0;
+	return count;
+}
+
+} // namespace AvateeringClientNode 
@@ -0,0 +1,103 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringJitterBuffer.h"
+//! \brief Header file for AvateeringJitterBuffer class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef AVATEERINGJITTERBUFFER_H
+#define AVATEERINGJITTERBUFFER_H
+
+#include "AvateeringProtocol.h"
+
+#include <QtCore/QMutex>
+#include <deque>
+
+namespace AvateeringClientNode {
+
+//!
+//! Thread safe buffer of timestamped joint frames. Frames are pushed by the
+//! network thread and sampled by the node at the render time minus a
+//! playout delay, the joint rotations are interpolated between the two
+//! neighbouring frames.
+//!
+class AvateeringJitterBuffer
+{
+
+public: // constructors and destructors
+
+	//!
+	//! Constructor of the AvateeringJitterBuffer class.
+	//!
+	//! \param capacity The max number of buffered frames.
+	//!
+	AvateeringJitterBuffer ( int capacity = 256 );
+
+public: // functions
+
+	//!
+	//! Adds a frame. Joints missing in the frame are taken from the
+	//! previous frame. Frames older than the newest frame are dropped.
+	//!
+	void push ( const AvateeringFrame &frame );
+
+	//!
+	//! Interpolates the joint data at the given local time. Before the
+	//! first frame and after the last frame the nearest frame is held.
+	//!
+	//! \return False if the buffer is empty.
+	//!
+	bool sample ( qint64 time, AvateeringFrame &frame );
+
+	//!
+	//! Returns the newest frame.
+	//!
+	//! \return False if the buffer is empty.
+	//!
+	bool latest ( AvateeringFrame &frame );
+
+	//!
+	//! Removes all frames.
+	//!
+	void clear ();
+
+	//!
+	//! Returns the number of frames pushed since the last call.
+	//!
+	int takeReceivedCount ();
+
+private: // data
+
+	QMutex m_mutex;
+	std::deque<AvateeringFrame> m_frames;
+	int m_capacity;
+	int m_receivedCount;
+};
+
+} // namespace AvateeringClientNode 
+
+#endif
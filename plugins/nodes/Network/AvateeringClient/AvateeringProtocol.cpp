@@ -0,0 +1,411 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringProtocol.cpp"
+//! \brief Implementation file for the Avateering stream protocol and recording format.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "AvateeringProtocol.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QList>
+#include <cstring>
+
+namespace AvateeringClientNode {
+
+namespace {
+
+const char FrameMagic[4] = { 'A', 'V', 'F', '1' };
+const char RecordingMagic[4] = { 'A', 'V', 'R', '1' };
+
+//!
+//! Sets the byte order and float precision of the protocol.
+//!
+//! \param stream The stream to prepare.
+//!
+void prepareStream ( QDataStream &stream )
+{
+	stream.setByteOrder(QDataStream::LittleEndian);
+	stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+}
+
+} // namespace
+
+
+///
+/// AvateeringFrame
+///
+
+//!
+//! Constructor of the AvateeringFrame class.
+//!
+AvateeringFrame::AvateeringFrame () :
+	frameNumber(0),
+	senderTime(0),
+	time(0),
+	jointMask(0)
+{
+	for (int i = 0; i < NumberOfJoints; ++i) {
+		bones[i].joint = (JointType) i;
+		bones[i].orientation = Ogre::Quaternion::IDENTITY;
+		bones[i].position = Ogre::Vector3::ZERO;
+		bones[i].tracked = false;
+	}
+}
+
+
+//!
+//! Marks all joints as missing.
+//!
+void AvateeringFrame::clear ()
+{
+	jointMask = 0;
+}
+
+
+///
+/// AvateeringProtocol
+///
+
+//!
+//! Returns whether the given data starts with the binary frame magic.
+//!
+//! \param data The received data.
+//! \param size The size of the data in bytes.
+//! \return True if the data starts a binary frame.
+//!
+bool AvateeringProtocol::isBinaryFrame ( const char *data, int size )
+{
+	return size >= 4 && std::memcmp(data, FrameMagic, 4) == 0;
+}
+
+
+//!
+//! Encodes the joints of the given frame as binary frame.
+//!
+//! \param frame The frame to encode.
+//! \return The binary frame.
+//!
+QByteArray AvateeringProtocol::encodeFrame ( const AvateeringFrame &frame )
+{
+	quint8 numberOfJoints = 0;
+	for (int i = 0; i < NumberOfJoints; ++i)
+		if (frame.jointMask & (1u << i))
+			++numberOfJoints;
+
+	QByteArray data;
+	data.reserve(FrameHeaderSize + numberOfJoints * FrameJointSize);
+
+	QDataStream out(&data, QIODevice::WriteOnly);
+	prepareStream(out);
+	out.writeRawData(FrameMagic, 4);
+	out << frame.frameNumber << frame.senderTime << numberOfJoints;
+
+	for (int i = 0; i < NumberOfJoints; ++i) {
+		if (!(frame.jointMask & (1u << i)))
+			continue;
+
+		const AvateeringBoneData &bone = frame.bones[i];
+		out << quint8(i) << quint8(bone.tracked ? 1 : 0)
+			<< bone.orientation.w << bone.orientation.x << bone.orientation.y << bone.orientation.z
+			<< bone.position.x << bone.position.y << bone.position.z;
+	}
+
+	return data;
+}
+
+
+//!
+//! Encodes the joints of the given frame as text lines.
+//!
+//! \param frame The frame to encode.
+//! \return One text line per joint.
+//!
+QByteArray AvateeringProtocol::encodeTextFrame ( const AvateeringFrame &frame )
+{
+	QByteArray data;
+	for (int i = 0; i < NumberOfJoints; ++i) {
+		if (!(frame.jointMask & (1u << i)))
+			continue;
+
+		const AvateeringBoneData &bone = frame.bones[i];
+		data += QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+			.arg(i)
+			.arg(bone.orientation.w).arg(bone.orientation.x).arg(bone.orientation.y).arg(bone.orientation.z)
+			.arg(bone.position.x).arg(bone.position.y).arg(bone.position.z)
+			.arg(bone.tracked ? "True" : "False")
+			.toLatin1();
+	}
+	return data;
+}
+
+
+//!
+//! Decodes the binary frame at the start of the given data.
+//!
+//! \param data The received data.
+//! \param size The size of the data in bytes.
+//! \param frame Receives the decoded joints.
+//! \return The size of the frame, 0 if it is incomplete or -1 if it is invalid.
+//!
+int AvateeringProtocol::decodeFrame ( const char *data, int size, AvateeringFrame &frame )
+{
+	if (size < 4)
+		return 0;
+	if (!isBinaryFrame(data, size))
+		return -1;
+	if (size < FrameHeaderSize)
+		return 0;
+
+	const quint8 numberOfJoints = static_cast<quint8>(data[FrameHeaderSize-1]);
+	if (numberOfJoints > NumberOfJoints)
+		return -1;
+
+	const int frameSize = FrameHeaderSize + numberOfJoints * FrameJointSize;
+	if (size < frameSize)
+		return 0;
+
+	QDataStream in(QByteArray::fromRawData(data + 4, frameSize - 4));
+	prepareStream(in);
+
+	quint8 jointCount;
+	in >> frame.frameNumber >> frame.senderTime >> jointCount;
+	frame.jointMask = 0;
+
+	for (int j = 0; j < numberOfJoints; ++j) {
+		quint8 joint, flags;
+		float qw, qx, qy, qz, px, py, pz;
+		in >> joint >> flags >> qw >> qx >> qy >> qz >> px >> py >> pz;
+
+		if (joint >= NumberOfJoints)
+			return -1;
+
+		AvateeringBoneData &bone = frame.bones[joint];
+		bone.joint = (JointType) joint;
+		bone.orientation = Ogre::Quaternion(qw, qx, qy, qz);
+		bone.position = Ogre::Vector3(px, py, pz);
+		bone.tracked = (flags & 1) != 0;
+		frame.jointMask |= 1u << joint;
+	}
+
+	return frameSize;
+}
+
+
+//!
+//! Parses one joint line of the text protocol. Decimal commas are accepted,
+//! the position and the tracking state are optional.
+//!
+//! \param line The text line.
+//! \param bone Receives the joint.
+//! \return True if the line holds a valid joint.
+//!
+bool AvateeringProtocol::parseTextLine ( const QByteArray &line, AvateeringBoneData &bone )
+{
+	// convert de_DE to en_US
+	QByteArray text = line.trimmed();
+	text.replace(',', '.');
+	const QList<QByteArray> values = text.split(' ');
+
+	if (values.size() < 5)
+		return false;
+
+	// read joint indices
+	bool ok = false;
+	const int joint = values[0].toInt(&ok);
+	if (!ok || joint < 0 || joint >= NumberOfJoints)
+		return false;
+
+	bone.joint = (JointType) joint;
+
+	// read hierarchical rotation of bone
+	bone.orientation = Ogre::Quaternion(values[1].toFloat(), values[2].toFloat(), values[3].toFloat(), values[4].toFloat());
+
+	// read position of bone (optional)
+	bone.position = Ogre::Vector3::ZERO;
+	bone.tracked = true;
+	if (values.size() >= 8) {
+		bone.position = Ogre::Vector3(values[5].toFloat(), values[6].toFloat(), values[7].toFloat());
+
+		if (values.size() >= 9)
+			bone.tracked = values[8].contains("True"); // damn u, c#
+	}
+
+	return true;
+}
+
+
+///
+/// AvateeringRecording
+///
+
+//!
+//! Constructor of the AvateeringRecording class.
+//!
+AvateeringRecording::AvateeringRecording () :
+	m_startTime(0)
+{
+}
+
+
+//!
+//! Destructor of the AvateeringRecording class.
+//!
+AvateeringRecording::~AvateeringRecording ()
+{
+	close();
+}
+
+
+//!
+//! Creates the given recording file.
+//!
+//! \param filename The name of the recording file.
+//! \param startTime The time the recorded frame times are relative to.
+//! \return True if the file was created.
+//!
+bool AvateeringRecording::openForWriting ( const QString &filename, qint64 startTime )
+{
+	close();
+
+	m_file.setFileName(filename);
+	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+
+	m_file.write(RecordingMagic, 4);
+	m_startTime = startTime;
+	return true;
+}
+
+
+//!
+//! Opens the given recording file.
+//!
+//! \param filename The name of the recording file.
+//! \return True if the file was opened and is a recording.
+//!
+bool AvateeringRecording::openForReading ( const QString &filename )
+{
+	close();
+
+	m_file.setFileName(filename);
+	if (!m_file.open(QIODevice::ReadOnly))
+		return false;
+
+	char magic[4];
+	if (m_file.read(magic, 4) != 4 || std::memcmp(magic, RecordingMagic, 4) != 0) {
+		m_file.close();
+		return false;
+	}
+	return true;
+}
+
+
+//!
+//! Closes the recording file.
+//!
+void AvateeringRecording::close ()
+{
+	if (m_file.isOpen())
+		m_file.close();
+}
+
+
+//!
+//! Returns whether the recording file is open.
+//!
+bool AvateeringRecording::isOpen () const
+{
+	return m_file.isOpen();
+}
+
+
+//!
+//! Writes the given frame with its time relative to the start time.
+//!
+//! \param frame The frame to write.
+//!
+void AvateeringRecording::writeFrame ( const AvateeringFrame &frame )
+{
+	if (!m_file.isOpen())
+		return;
+
+	QDataStream out(&m_file);
+	prepareStream(out);
+	out << qint64(frame.time - m_startTime);
+	const QByteArray data = AvateeringProtocol::encodeFrame(frame);
+	out.writeRawData(data.constData(), data.size());
+}
+
+
+//!
+//! Reads the next frame.
+//!
+//! \param frame Receives the frame and its recorded time.
+//! \return True if a complete frame was read.
+//!
+bool AvateeringRecording::readFrame ( AvateeringFrame &frame )
+{
+	if (!m_file.isOpen())
+		return false;
+
+	QDataStream in(&m_file);
+	prepareStream(in);
+
+	qint64 time;
+	in >> time;
+
+	char header[AvateeringProtocol::FrameHeaderSize];
+	if (in.readRawData(header, sizeof(header)) != sizeof(header))
+		return false;
+
+	const int numberOfJoints = static_cast<quint8>(header[AvateeringProtocol::FrameHeaderSize-1]);
+	QByteArray data(header, sizeof(header));
+	data.resize(AvateeringProtocol::FrameHeaderSize + numberOfJoints * AvateeringProtocol::FrameJointSize);
+	const int jointBytes = data.size() - AvateeringProtocol::FrameHeaderSize;
+	if (in.readRawData(data.data() + AvateeringProtocol::FrameHeaderSize, jointBytes) != jointBytes)
+		return false;
+
+	if (AvateeringProtocol::decodeFrame(data.constData(), data.size(), frame) <= 0)
+		return false;
+
+	frame.time = time;
+	return true;
+}
+
+
+//!
+//! Moves to the first frame of the recording.
+//!
+//! \return True if the recording is open.
+//!
+bool AvateeringRecording::rewind ()
+{
+	return m_file.isOpen() && m_file.seek(4);
+}
+
+} // namespace AvateeringClientNode 
@@ -0,0 +1,314 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringProtocol.h"
+//! \brief Header file for the Avateering stream protocol and recording format.
+//!
+//! Joint frames are either streamed as text, one line per joint
+//! ("joint qw qx qy qz [px py pz [tracked]]"), or as compact binary frames:
+//!
+//!     char[4]  magic "AVF1"
+//!     quint32  frame number
+//!     quint32  sender timestamp in milliseconds
+//!     quint8   number of joints
+//!     per joint:
+//!         quint8   joint index
+//!         quint8   flags (bit 0: tracked)
+//!         float    orientation w, x, y, z
+//!         float    position x, y, z
+//!
+//! All numbers are little endian. A recording starts with the magic "AVR1"
+//! and stores every frame as a qint64 receive time in milliseconds relative
+//! to the start of the recording followed by the binary frame.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef AVATEERINGPROTOCOL_H
+#define AVATEERINGPROTOCOL_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+
+namespace AvateeringClientNode {
+
+// Summary:
+//     This contains all of the possible joint types.
+enum JointType
+{
+	// Summary:
+	//     The center of the hip.
+	HipCenter = 0,
+	//
+	// Summary:
+	//     The bottom of the spine.
+	Spine = 1,
+	//
+	// Summary:
+	//     The center of the shoulders.
+	ShoulderCenter = 2,
+	//
+	// Summary:
+	//     The players head.
+	Head = 3,
+	//
+	// Summary:
+	//     The left shoulder.
+	ShoulderLeft = 4,
+	//
+	// Summary:
+	//     The left elbow.
+	ElbowLeft = 5,
+	//
+	// Summary:
+	//     The left wrist.
+	WristLeft = 6,
+	//
+	// Summary:
+	//     The left hand.
+	HandLeft = 7,
+	//
+	// Summary:
+	//     The right shoulder.
+	ShoulderRight = 8,
+	//
+	// Summary:
+	//     The right elbow.
+	ElbowRight = 9,
+	//
+	// Summary:
+	//     The right wrist.
+	WristRight = 10,
+	//
+	// Summary:
+	//     The right hand.
+	HandRight = 11,
+	//
+	// Summary:
+	//     The left hip.
+	HipLeft = 12,
+	//
+	// Summary:
+	//     The left knee.
+	KneeLeft = 13,
+	//
+	// Summary:
+	//     The left ankle.
+	AnkleLeft = 14,
+	//
+	// Summary:
+	//     The left foot.
+	FootLeft = 15,
+	//
+	// Summary:
+	//     The right hip.
+	HipRight = 16,
+	//
+	// Summary:
+	//     The right knee.
+	KneeRight = 17,
+	//
+	// Summary:
+	//     The right ankle.
+	AnkleRight = 18,
+	//
+	// Summary:
+	//     The right foot.
+	FootRight = 19,
+
+	//
+	// Summary:
+	//     The total number of joints in this list
+	NumberOfJoints = 20,
+};
+
+//!
+//! This struct is used to store the data that is streamed from 
+//! the Avateering application
+//!
+struct AvateeringBoneData
+{
+	//! The type of joint
+	JointType joint;
+
+	//! The joint orientation (hierarchical)
+	Ogre::Quaternion orientation;
+
+	//! The type of joint
+	Ogre::Vector3 position;
+
+	//! Joint was tracked sucessfully
+	bool tracked;
+};
+
+//!
+//! A frame of joint data with the local time it is due.
+//!
+struct AvateeringFrame
+{
+	AvateeringFrame ();
+
+	//! Resets the frame to no received joints
+	void clear ();
+
+	//! The frame number as sent by the server
+	quint32 frameNumber;
+
+	//! The sender timestamp in milliseconds
+	quint32 senderTime;
+
+	//! The local time of the frame in milliseconds
+	qint64 time;
+
+	//! Bit mask of the joints contained in the frame
+	quint32 jointMask;
+
+	//! The joint data, valid where the joint mask is set
+	AvateeringBoneData bones[NumberOfJoints];
+};
+
+//!
+//! Encoding and decoding of the Avateering stream formats.
+//!
+class AvateeringProtocol
+{
+
+public: // constants
+
+	//!
+	//! Size of the binary frame header and of a single joint in bytes.
+	//!
+	static const int FrameHeaderSize = 13;
+	static const int FrameJointSize = 30;
+
+public: // functions
+
+	//!
+	//! Returns whether the given data starts with a binary frame magic.
+	//! Needs at least four bytes.
+	//!
+	static bool isBinaryFrame ( const char *data, int size );
+
+	//!
+	//! Encodes a frame in the binary format.
+	//!
+	static QByteArray encodeFrame ( const AvateeringFrame &frame );
+
+	//!
+	//! Encodes a frame in the text format, one line per joint.
+	//!
+	static QByteArray encodeTextFrame ( const AvateeringFrame &frame );
+
+	//!
+	//! Decodes a binary frame.
+	//!
+	//! \param data The received data.
+	//! \param size The number of received bytes.
+	//! \param frame The frame to fill, the local time is not set.
+	//! \return The number of bytes consumed, 0 if the frame is incomplete or
+	//!     -1 if the data does not start with a valid frame.
+	//!
+	static int decodeFrame ( const char *data, int size, AvateeringFrame &frame );
+
+	//!
+	//! Parses a text line of a single joint.
+	//!
+	//! \return True if the line holds valid joint data.
+	//!
+	static bool parseTextLine ( const QByteArray &line, AvateeringBoneData &bone );
+};
+
+//!
+//! Reads and writes Avateering recordings.
+//!
+class AvateeringRecording
+{
+
+public: // constructors and destructors
+
+	//!
+	//! Constructor of the AvateeringRecording class.
+	//!
+	AvateeringRecording ();
+
+	//!
+	//! Destructor of the AvateeringRecording class.
+	//!
+	~AvateeringRecording ();
+
+public: // functions
+
+	//!
+	//! Creates a new recording. The receive times of written frames are
+	//! stored relative to the given start time.
+	//!
+	bool openForWriting ( const QString &filename, qint64 startTime );
+
+	//!
+	//! Opens an existing recording.
+	//!
+	bool openForReading ( const QString &filename );
+
+	//!
+	//! Closes the recording.
+	//!
+	void close ();
+
+	//!
+	//! Returns whether a recording is open.
+	//!
+	bool isOpen () const;
+
+	//!
+	//! Appends a frame to the recording.
+	//!
+	void writeFrame ( const AvateeringFrame &frame );
+
+	//!
+	//! Reads the next frame, the local time of the frame is set to the
+	//! receive time relative to the start of the recording.
+	//!
+	//! \return False at the end of the recording or if the data is invalid.
+	//!
+	bool readFrame ( AvateeringFrame &frame );
+
+	//!
+	//! Restarts reading at the first frame.
+	//!
+	bool rewind ();
+
+private: // data
+
+	QFile m_file;
+	qint64 m_startTime;
+};
+
+} // namespace AvateeringClientNode 
+
+#endif
@@ -0,0 +1,171 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringReplayServer.cpp"
+//! \brief Implementation file for AvateeringReplayServer class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "AvateeringReplayServer.h"
+
+#include <iostream>
+
+namespace AvateeringClientNode {
+
+//!
+//! Constructor of the AvateeringReplayServer class.
+//!
+//! \param textProtocol Send the text instead of the binary protocol.
+//! \param loop Restart the recording after the last frame.
+//!
+AvateeringReplayServer::AvateeringReplayServer ( bool textProtocol, bool loop ) :
+	m_nextFrame(0),
+	m_loopOffset(0),
+	m_frameNumber(0),
+	m_textProtocol(textProtocol),
+	m_loop(loop)
+{
+	m_timer.setSingleShot(true);
+	connect(&m_timer, SIGNAL(timeout()), SLOT(sendFrames()));
+	connect(&m_server, SIGNAL(newConnection()), SLOT(acceptConnection()));
+}
+
+
+//!
+//! Loads all frames of the given recording.
+//!
+//! \param filename The name of the recording file.
+//! \return True if the recording holds at least one frame.
+//!
+bool AvateeringReplayServer::loadRecording ( const QString &filename )
+{
+	AvateeringRecording recording;
+	if (!recording.openForReading(filename)) {
+		std::cerr << "Could not read recording \"" << filename.toStdString() << "\"." << std::endl;
+		return false;
+	}
+
+	m_frames.clear();
+	AvateeringFrame frame;
+	while (recording.readFrame(frame))
+		m_frames.append(frame);
+
+	std::cout << "Loaded " << m_frames.size() << " frames from \"" << filename.toStdString() << "\"." << std::endl;
+	return !m_frames.isEmpty();
+}
+
+
+//!
+//! Starts to listen for a client on the given port.
+//!
+//! \param port The port to listen on.
+//! \return True if the server listens.
+//!
+bool AvateeringReplayServer::listen ( quint16 port )
+{
+	if (!m_server.listen(QHostAddress::Any, port)) {
+		std::cerr << "Could not listen on port " << port << ": " << m_server.errorString().toStdString() << std::endl;
+		return false;
+	}
+
+	std::cout << "Listening on port " << port << (m_textProtocol ? " (text protocol)" : " (binary protocol)") << std::endl;
+	return true;
+}
+
+
+//!
+//! Slot which is called when a client connects. Replaces the current client
+//! and starts the replay.
+//!
+void AvateeringReplayServer::acceptConnection ()
+{
+	QTcpSocket *socket = m_server.nextPendingConnection();
+
+	// a new client replaces the current one
+	if (m_client)
+		m_client->abort();
+
+	m_client = socket;
+	m_client->setSocketOption(QAbstractSocket::LowDelayOption, QVariant(1));
+	connect(m_client, SIGNAL(disconnected()), SLOT(clientDisconnected()));
+	connect(m_client, SIGNAL(disconnected()), m_client, SLOT(deleteLater()));
+
+	std::cout << "Client connected from " << m_client->peerAddress().toString().toStdString() << std::endl;
+
+	m_nextFrame = 0;
+	m_loopOffset = -m_frames.first().time;
+	m_frameNumber = 0;
+	m_clock.start();
+	sendFrames();
+}
+
+
+//!
+//! Slot which is called when the client disconnected.
+//!
+void AvateeringReplayServer::clientDisconnected ()
+{
+	std::cout << "Client disconnected." << std::endl;
+	m_timer.stop();
+}
+
+
+//!
+//! Slot which sends all frames that are due and waits for the next one.
+//!
+void AvateeringReplayServer::sendFrames ()
+{
+	if (!m_client || m_client->state() != QAbstractSocket::ConnectedState)
+		return;
+
+	const qint64 now = m_clock.elapsed();
+
+	while (m_nextFrame < m_frames.size() && m_frames[m_nextFrame].time + m_loopOffset <= now) {
+		AvateeringFrame frame = m_frames[m_nextFrame++];
+		frame.frameNumber = m_frameNumber++;
+		frame.senderTime = quint32(frame.time + m_loopOffset);
+
+		m_client->write(m_textProtocol ? AvateeringProtocol::encodeTextFrame(frame) : AvateeringProtocol::encodeFrame(frame));
+
+		if (m_nextFrame == m_frames.size() && m_loop) {
+			// continue one average frame interval after the last frame
+			const qint64 duration = m_frames.last().time - m_frames.first().time;
+			const qint64 interval = m_frames.size() > 1 ? duration / (m_frames.size() - 1) : 33;
+			m_loopOffset += duration + interval;
+			m_nextFrame = 0;
+		}
+	}
+
+	if (m_nextFrame < m_frames.size()) {
+		const qint64 wait = m_frames[m_nextFrame].time + m_loopOffset - now;
+		m_timer.start(int(wait > 0 ? wait : 0));
+	}
+	else {
+		std::cout << "Replay finished." << std::endl;
+	}
+}
+
+} // namespace AvateeringClientNode 
@@ -0,0 +1,116 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "AvateeringReplayServer.h"
+//! \brief Header file for AvateeringReplayServer class.
+//!
+//! Stand-in for the Avateering application that replays a recording to
+//! connected clients with the original frame timing, for testing and
+//! profiling the AvateeringClient node without a tracking device.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef AVATEERINGREPLAYSERVER_H
+#define AVATEERINGREPLAYSERVER_H
+
+#include "AvateeringProtocol.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+namespace AvateeringClientNode {
+
+//!
+//! Replays an Avateering recording over tcp.
+//!
+class AvateeringReplayServer : public QObject
+{
+
+    Q_OBJECT
+
+public: // constructors and destructors
+
+	//!
+	//! Constructor of the AvateeringReplayServer class.
+	//!
+	//! \param textProtocol Whether frames are sent as text instead of binary.
+	//! \param loop Whether the recording is replayed endlessly.
+	//!
+	AvateeringReplayServer ( bool textProtocol, bool loop );
+
+public: // functions
+
+	//!
+	//! Reads all frames of the given recording.
+	//!
+	bool loadRecording ( const QString &filename );
+
+	//!
+	//! Starts to listen on the given port.
+	//!
+	bool listen ( quint16 port );
+
+private slots: //
+
+	//!
+	//! Slot which is called when a client connects.
+	//!
+	void acceptConnection ();
+
+	//!
+	//! Slot which is called when the client disconnects.
+	//!
+	void clientDisconnected ();
+
+	//!
+	//! Sends all frames that are due and schedules the next frame.
+	//!
+	void sendFrames ();
+
+private: // data
+
+	QTcpServer m_server;
+	QPointer<QTcpSocket> m_client;
+	QTimer m_timer;
+	QElapsedTimer m_clock;
+
+	QVector<AvateeringFrame> m_frames;
+	int m_nextFrame;
+	qint64 m_loopOffset;
+	quint32 m_frameNumber;
+
+	bool m_textProtocol;
+	bool m_loop;
+};
+
+} // namespace AvateeringClientNode 
+
+#endif
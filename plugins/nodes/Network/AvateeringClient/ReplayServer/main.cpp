@@ -0,0 +1,79 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "main.cpp"
+//! \brief Main file of the Avateering replay server.
+//!
+//! Usage: AvateeringReplayServer <recording.avr> [port] [--text] [--loop]
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "AvateeringReplayServer.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStringList>
+#include <iostream>
+
+
+//!
+//! The application's entry point.
+//!
+//! \param argc     the number of parameters passed to the program
+//! \param argv     the list of parameters passed to the program
+//!
+int main ( int argc, char *argv[] )
+{
+	QCoreApplication application(argc, argv);
+
+	QString filename;
+	quint16 port = 33434;
+	bool textProtocol = false;
+	bool loop = false;
+
+	QStringList arguments = application.arguments();
+	arguments.removeFirst();
+	foreach (const QString &argument, arguments) {
+		if (argument == "--text")
+			textProtocol = true;
+		else if (argument == "--loop")
+			loop = true;
+		else if (filename.isEmpty())
+			filename = argument;
+		else
+			port = argument.toUShort();
+	}
+
+	if (filename.isEmpty() || port == 0) {
+		std::cerr << "Usage: AvateeringReplayServer <recording.avr> [port] [--text] [--loop]" << std::endl;
+		return 1;
+	}
+
+	AvateeringClientNode::AvateeringReplayServer server(textProtocol, loop);
+	if (!server.loadRecording(filename) || !server.listen(port))
+		return 1;
+
+	return application.exec();
+}
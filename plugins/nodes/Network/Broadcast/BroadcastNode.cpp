@@ -37,6 +37,8 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 #include <QtCore/QDir>
+#include <QtCore/QtEndian>
+#include <string.h>
 
 namespace BroadcastNode {
 using namespace Frapper;
@@ -44,6 +46,21 @@ using namespace Frapper;
 INIT_INSTANCE_COUNTER(BroadcastNode)
 
 
+///
+/// Macro Definitions
+///
+
+//!
+//! The size of the datagram header in bytes.
+//!
+#define HEADER_SIZE 12
+
+//!
+//! The size of a channel value in bytes.
+//!
+#define VALUE_SIZE 4
+
+
 ///
 /// Constructors and Destructors
 ///
@@ -59,7 +76,10 @@ BroadcastNode::BroadcastNode ( QString name, ParameterGroup *parameterRoot ) :
     Node(name, parameterRoot),
     m_timer(0),
     m_sequenceIdLow(0),
-    m_sequenceIdHigh(0)
+    m_sequenceIdHigh(0),
+    m_encoding(E_Text),
+    m_planValid(false),
+    m_sendAll(true)
 {
     // Set animation timer.
     m_timer = new QTimer(this);
@@ -79,10 +99,17 @@ BroadcastNode::BroadcastNode ( QString name, ParameterGroup *parameterRoot ) :
     Parameter *runParameter = getParameter("run");
     if (runParameter)
         runParameter->setChangeFunction(SLOT(toggleRun()));
+    Parameter *encodingParameter = getParameter("encoding");
+    if (encodingParameter)
+        encodingParameter->setChangeFunction(SLOT(setEncoding()));
+
+    // collect the channels again when parameters are added or removed
+    connect(this, SIGNAL(nodeChanged()), SLOT(invalidatePlan()));
 
     setHostAddress();
     setPort();
     setInterval();
+    setEncoding();
 }
 
 //!
@@ -137,6 +164,7 @@ void BroadcastNode::toggleRun()
     if (run) {
         m_sequenceIdLow = 0;
         m_sequenceIdHigh = 0;
+        m_sendAll = true;
         m_timer->stop();
         m_timer->start(interval);
     }
@@ -144,15 +172,34 @@ void BroadcastNode::toggleRun()
         m_timer->stop();
 }
 
+//!
+//! Slot which is called when the encoding is changed.
+//!
+void BroadcastNode::setEncoding()
+{
+    EnumerationParameter *encodingParameter = getEnumerationParameter("encoding");
+    if (encodingParameter)
+        m_encoding = (Encoding) qBound((int) E_Text, encodingParameter->getCurrentIndex(), (int) E_BinaryChangedOnly);
+    m_sendAll = true;
+}
+
+//!
+//! Slot which is called when the parameters of the node changed.
+//! The send plan is compiled again before the next datagram is sent.
+//!
+void BroadcastNode::invalidatePlan()
+{
+    m_planValid = false;
+}
+
 //!
 //! Slot which is called on timer timeout.
 //!
 void BroadcastNode::updateTimer ()
 {
-    QByteArray datagram;
-    datagram.append((char) 128);
-    datagram.append((char) 105);
-    
+    if (!m_planValid)
+        compilePlan();
+
     if (m_sequenceIdLow < 255)
         m_sequenceIdLow++;
     else {
@@ -163,42 +210,138 @@ void BroadcastNode::updateTimer ()
             m_sequenceIdHigh = 0;
     }
 
-    datagram.append((char) m_sequenceIdHigh);
-    datagram.append((char) m_sequenceIdLow);
-
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-    datagram.append((char) 0);
-
-    //std::cout << datagram.size() << std::endl;
-
-    ParameterGroup *parameterGroup = getParameterRoot();
-    QList<AbstractParameter *> parameterList = parameterGroup->filterParameters("", true, true);
-    for (int i = 0; i < parameterList.size(); ++i)
-    {
-        Parameter *parameter = (Parameter*) parameterList[i];
-        if (!parameter)
+    switch (m_encoding) {
+        case E_Binary:
+            sendBinary(false);
+            break;
+        case E_BinaryChangedOnly:
+            sendBinary(true);
+            break;
+        default:
+            sendText();
+    }
+}
+
+
+///
+/// Private Functions
+///
+
+//!
+//! Collects the channels and preallocates the datagrams.
+//!
+void BroadcastNode::compilePlan ()
+{
+    m_channels.clear();
+
+    const QList<AbstractParameter *> parameterList = getParameterRoot()->filterParameters("", true, true);
+    int offset = HEADER_SIZE;
+    for (int i = 0; i < parameterList.size(); ++i) {
+        if (!parameterList[i] || parameterList[i]->isGroup())
+            continue;
+        Parameter *parameter = static_cast<Parameter *>(parameterList[i]);
+        if (parameter->getName().left(5) != "input")
             continue;
-        QString parameterName = parameter->getName();
-        if (parameterName.left(5) == "input") {
-            if (parameter->getType() == Parameter::T_Float) {
-                double value = parameter->getValue(true).toDouble();
-                float floatValue = (float) value;
-                //datagram.append((char*) &floatValue, sizeof(float));
-                datagram += QByteArray::number(value, 'f', 4);
-            }
-            if (parameter->getType() == Parameter::T_UnsignedInt) {
-                int value = parameter->getValue(true).toInt();
-                datagram += QByteArray::number(value);
-            }
+        const Parameter::Type type = parameter->getType();
+        if (type != Parameter::T_Float && type != Parameter::T_UnsignedInt)
+            continue;
+
+        Channel channel;
+        channel.parameter = parameter;
+        channel.isFloat = type == Parameter::T_Float;
+        channel.offset = offset;
+        m_channels.append(channel);
+        offset += VALUE_SIZE;
+    }
+
+    m_datagram.fill(0, offset);
+    m_sentValues.fill(0, m_channels.size() * VALUE_SIZE);
+    m_variableDatagram.reserve(HEADER_SIZE + m_channels.size() * (sizeof(quint16) + VALUE_SIZE));
+    m_planValid = true;
+    m_sendAll = true;
+}
+
+//!
+//! Writes the header with the current sequence id to the given datagram.
+//!
+void BroadcastNode::writeHeader ( QByteArray &datagram, Encoding encoding ) const
+{
+    char *header = datagram.data();
+    header[0] = (char) 128;
+    header[1] = (char) 105;
+    header[2] = (char) m_sequenceIdHigh;
+    header[3] = (char) m_sequenceIdLow;
+    header[4] = (char) encoding;
+    memset(header + 5, 0, HEADER_SIZE - 5);
+}
+
+//!
+//! Sends the channel values as text.
+//!
+void BroadcastNode::sendText ()
+{
+    m_variableDatagram.resize(HEADER_SIZE);
+    writeHeader(m_variableDatagram, E_Text);
+
+    for (int i = 0; i < m_channels.size(); ++i) {
+        const Channel &channel = m_channels.at(i);
+        if (channel.isFloat)
+            m_variableDatagram += QByteArray::number(channel.parameter->getValue(true).toDouble(), 'f', 4);
+        else
+            m_variableDatagram += QByteArray::number(channel.parameter->getValue(true).toInt());
+    }
+    m_udpSocket->writeDatagram(m_variableDatagram.constData(), m_variableDatagram.size(), m_hostAddress, m_port);
+}
+
+//!
+//! Sends the channel values as binary datagram, or only the changed values.
+//!
+//! \param changedOnly Flag to only send the values that changed since the last datagram.
+//!
+void BroadcastNode::sendBinary ( bool changedOnly )
+{
+    // copy the raw values into the preallocated datagram
+    char *data = m_datagram.data();
+    for (int i = 0; i < m_channels.size(); ++i) {
+        const Channel &channel = m_channels.at(i);
+        const QVariant value = channel.parameter->getValue(true);
+        quint32 bits;
+        if (channel.isFloat) {
+            const float floatValue = value.toFloat();
+            memcpy(&bits, &floatValue, sizeof(bits));
+        } else
+            bits = value.toUInt();
+        qToLittleEndian<quint32>(bits, reinterpret_cast<uchar *>(data + channel.offset));
+    }
+
+    // send all values, regularly also when only changes are requested
+    if (!changedOnly || m_sendAll || m_sequenceIdLow == 0) {
+        writeHeader(m_datagram, E_Binary);
+        m_udpSocket->writeDatagram(m_datagram.constData(), m_datagram.size(), m_hostAddress, m_port);
+        if (changedOnly) {
+            memcpy(m_sentValues.data(), data + HEADER_SIZE, m_sentValues.size());
+            m_sendAll = false;
         }
+        return;
+    }
+
+    m_variableDatagram.resize(HEADER_SIZE);
+    writeHeader(m_variableDatagram, E_BinaryChangedOnly);
+
+    char *sentValues = m_sentValues.data();
+    for (int i = 0; i < m_channels.size(); ++i) {
+        const char *value = data + HEADER_SIZE + i * VALUE_SIZE;
+        char *sentValue = sentValues + i * VALUE_SIZE;
+        if (memcmp(value, sentValue, VALUE_SIZE) == 0)
+            continue;
+
+        uchar index [sizeof(quint16)];
+        qToLittleEndian<quint16>((quint16) i, index);
+        m_variableDatagram.append(reinterpret_cast<const char *>(index), sizeof(index));
+        m_variableDatagram.append(value, VALUE_SIZE);
+        memcpy(sentValue, value, VALUE_SIZE);
     }
-    m_udpSocket->writeDatagram(datagram.data(), datagram.size(), m_hostAddress, m_port);
+    m_udpSocket->writeDatagram(m_variableDatagram.constData(), m_variableDatagram.size(), m_hostAddress, m_port);
 }
 
 } // namespace BroadcastNode 
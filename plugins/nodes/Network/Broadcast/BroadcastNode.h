@@ -30,12 +30,26 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //! \version    1.0
 //! \date       30.06.2009 (last updated)
 //!
+//! Every datagram starts with a 12 byte header: the bytes 128 and 105, the
+//! high and low byte of the sequence id, the encoding and eight reserved bytes
+//! (the encoding byte is 0 for text datagrams, so their header is unchanged).
+//! The channels are the Float and UnsignedInt parameters named "input...".
+//!
+//! - Text (0): the values are appended as decimal text.
+//! - Binary (1): one little-endian float or uint32 per channel at offset
+//!   12 + 4 * channel index.
+//! - Binary changed only (2): a little-endian uint16 channel index and the
+//!   4 value bytes for each channel that changed since the last datagram.
+//!   Every 256th datagram and the first one after the channels changed are
+//!   sent as full binary datagrams, so receivers can resynchronize.
+//!
 
 #ifndef BroadcastNode_H
 #define BroadcastNode_H
 
 #include "Node.h"
 #include <QtCore/QTimer>
+#include <QtCore/QVector>
 #include <QtNetwork/QUdpSocket>
 
 // OGRE
@@ -97,13 +111,64 @@ public slots: //
     //!
     void toggleRun();
 
+    //!
+    //! Slot which is called when the encoding is changed.
+    //!
+    void setEncoding();
+
+    //!
+    //! Slot which is called when the parameters of the node changed.
+    //! The send plan is compiled again before the next datagram is sent.
+    //!
+    void invalidatePlan();
+
     //!
     //! On timer update.
     //!
     void updateTimer ();
 
-protected: // functions
+private: // type definitions
+
+    //!
+    //! Encodings of the datagrams.
+    //!
+    enum Encoding {
+        E_Text = 0,
+        E_Binary,
+        E_BinaryChangedOnly
+    };
+
+    //!
+    //! A channel of the send plan.
+    //!
+    struct Channel
+    {
+        Parameter *parameter;   //!< the parameter providing the value
+        bool isFloat;           //!< whether the value is sent as float or as uint32
+        int offset;             //!< offset of the value in the binary datagram
+    };
+
+private: // functions
+
+    //!
+    //! Collects the channels and preallocates the datagrams.
+    //!
+    void compilePlan ();
 
+    //!
+    //! Writes the header with the current sequence id to the given datagram.
+    //!
+    void writeHeader ( QByteArray &datagram, Encoding encoding ) const;
+
+    //!
+    //! Sends the channel values as text.
+    //!
+    void sendText ();
+
+    //!
+    //! Sends the channel values as binary datagram, or only the changed values.
+    //!
+    void sendBinary ( bool changedOnly );
 
 private: // data
 
@@ -132,6 +197,41 @@ private: // data
     //!
     unsigned int m_sequenceIdHigh;
     unsigned int m_sequenceIdLow;
+
+    //!
+    //! The selected encoding.
+    //!
+    Encoding m_encoding;
+
+    //!
+    //! The channels of the send plan.
+    //!
+    QVector<Channel> m_channels;
+
+    //!
+    //! Flag that is cleared when the channels have to be collected again.
+    //!
+    bool m_planValid;
+
+    //!
+    //! Flag that is set when the next changed-only datagram must contain all values.
+    //!
+    bool m_sendAll;
+
+    //!
+    //! The preallocated datagram holding all values.
+    //!
+    QByteArray m_datagram;
+
+    //!
+    //! The preallocated datagram of variable length, holding text or changed values.
+    //!
+    QByteArray m_variableDatagram;
+
+    //!
+    //! The values of the last datagram, in binary layout.
+    //!
+    QByteArray m_sentValues;
 };
 
 } // namespace BroadcastNode 
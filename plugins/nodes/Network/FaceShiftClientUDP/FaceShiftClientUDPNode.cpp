@@ -31,7 +31,9 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //!
 
 #include "FaceShiftClientUDPNode.h"
+#include "FaceShiftReceiver.h"
 #include "NumberParameter.h"
+#include <algorithm>
 
 namespace FaceShiftClientUDPNode {
 using namespace Frapper;
@@ -52,15 +54,50 @@ INIT_INSTANCE_COUNTER(FaceShiftClientUDPNode)
 //!
 FaceShiftClientUDPNode::FaceShiftClientUDPNode ( QString name, ParameterGroup *parameterRoot ) :
     Node(name, parameterRoot),
+    m_receiver(NULL),
+    m_updateMode(LatestFrame),
+    m_interpolationDelay(33),
     m_animParams(NULL)
 {   
     setChangeFunction("Run", SLOT(toggleRun()));
+    setChangeFunction("Update Mode", SLOT(updateMode()));
+    setChangeFunction("Interpolation Delay", SLOT(updateMode()));
+    setChangeFunction("Output Rate", SLOT(updateMode()));
 
     m_animParams = getParameterGroup("Animations");
     assert( m_animParams );
 
-    m_socket.setSocketOption(QAbstractSocket::LowDelayOption, QVariant(1));
-    
+    // cache the output parameters, the blendshapes are stored in stream order
+    const AbstractParameter::List &blendshapes = m_animParams->getParameterList();
+    m_blendshapeParameters.reserve(blendshapes.size());
+    for ( int i=0; i<blendshapes.size(); i++)
+    {
+        Parameter* blendshapeParam = dynamic_cast<Parameter *>(blendshapes.at(i));
+        assert( blendshapeParam );
+        m_blendshapeParameters.append(blendshapeParam);
+    }
+
+    m_headTranslateParameter = getNumberParameter("Head > HeadTranslate");
+    m_headRotateParameter = getNumberParameter("Head > HeadRotate");
+    m_headTurnRightParameter = getNumberParameter("Head > HeadTurnRight");
+    m_headTurnLeftParameter = getNumberParameter("Head > HeadTurnLeft");
+    m_headUpParameter = getNumberParameter("Head > HeadUp");
+    m_headDownParameter = getNumberParameter("Head > HeadDown");
+    m_headTiltLeftParameter = getNumberParameter("Head > HeadTiltLeft");
+    m_headTiltRightParameter = getNumberParameter("Head > HeadTiltRight");
+    m_eyeGazeLeftParameter = getNumberParameter("Eyes > EyeGazeLeft");
+    m_eyeGazeRightParameter = getNumberParameter("Eyes > EyeGazeRight");
+
+    // the socket is read and decoded on the network thread
+    m_clock.start();
+    m_receiver = new FaceShiftReceiver(m_clock);
+    m_receiver->moveToThread(&m_networkThread);
+    connect(m_receiver, SIGNAL(framesReceived()), SLOT(processInputData()));
+    connect(m_receiver, SIGNAL(receiverError(const QString &)), SLOT(receiverFailed(const QString &)));
+    m_networkThread.start();
+
+    connect(&m_outputTimer, SIGNAL(timeout()), SLOT(updateInterpolated()));
+    updateMode();
 }
 
 //!
@@ -68,132 +105,190 @@ FaceShiftClientUDPNode::FaceShiftClientUDPNode ( QString name, ParameterGroup *p
 //!
 FaceShiftClientUDPNode::~FaceShiftClientUDPNode ()
 {
-    quit();
-    wait();
+    m_outputTimer.stop();
+
+    // close the socket on the network thread and delete the receiver after the thread finished
+    QMetaObject::invokeMethod(m_receiver, "close", Qt::BlockingQueuedConnection);
+    m_networkThread.quit();
+    m_networkThread.wait();
+    delete m_receiver;
 }
 
 ///
-/// Public Slots
+/// Private Slots
 ///
 
 //!
-//! Function which is called to establish a connection
-//! Executed by QThread::start()
+//! Slot which is called when the receiver decoded new frames. Depending on
+//! the update mode every frame or only the newest frame is applied, bursts
+//! of datagrams are coalesced into one notification.
 //!
-void FaceShiftClientUDPNode::run()
+void FaceShiftClientUDPNode::processInputData()
 {
-    unsigned int port = getValue("Port").toUInt();
-    QString host = getValue("Host").toString();
-
-    if( port > 0 && host != "" )
+    if( m_updateMode == EveryFrame )
     {
-        if( m_socket.bind( port ))
-        {
-            Log::debug("Listening on port "+QString::number(port)+"...", "FaceShiftClientUDPNode::run()");
+        QList<fs::fsTrackingData> frames;
+        m_receiver->takeFrames(frames);
+        foreach( const fs::fsTrackingData &td, frames)
+            applyTrackingData(td);
+    }
+    else if( m_updateMode == LatestFrame )
+    {
+        fs::fsTrackingData td;
+        if( m_receiver->takeLatest(td))
+            applyTrackingData(td);
+    }
 
-            // connect events
-            connect(&m_socket, SIGNAL(readyRead()), this, SLOT(processInputData()), Qt::DirectConnection);
-            connect(this, SIGNAL(finished()), this, SLOT(threadFinished()), Qt::DirectConnection);
+    updateRate();
+}
 
-            m_stopWatch.start();
+//!
+//! Slot which is called by the output timer in the interpolated mode.
+//!
+void FaceShiftClientUDPNode::updateInterpolated()
+{
+    fs::fsTrackingData td;
+    if( m_receiver->sample(m_clock.elapsed() - m_interpolationDelay, td))
+        applyTrackingData(td);
+}
 
-            // enter execution loop
-            exec();
+//!
+//! Slot which is called when running flag on node is toggled.
+//!
+void FaceShiftClientUDPNode::toggleRun()
+{
+    bool run = getBoolValue("Run");
+    if (run) {
+        unsigned int port = getValue("Port").toUInt();
+        if( port > 0 && port <= 65535 )
+        {
+            QMetaObject::invokeMethod(m_receiver, "open", Qt::QueuedConnection, Q_ARG(int, int(port)));
+            m_stopWatch.start();
         }
     }
+    else {
+        QMetaObject::invokeMethod(m_receiver, "close", Qt::QueuedConnection);
+    }
+    updateMode();
 }
 
-
 //!
-//! Slot which is called when new datagrams are availabled on udp socket.
+//! Slot which is called when the update mode settings change.
 //!
-void FaceShiftClientUDPNode::processInputData()
+void FaceShiftClientUDPNode::updateMode()
 {
-    m_trackingStream.append( m_socket.readAll());
-    //Log::debug("Tracking data received!", "FaceShiftClientUDPNode::processInputData");
+    EnumerationParameter *modeParameter = getEnumerationParameter("Update Mode");
+    if( modeParameter )
+        m_updateMode = (UpdateMode) modeParameter->getCurrentIndex();
 
-    // record frames
-    int frames_decoded = 0;
-    fs::fsTrackingData td;
-    while ( m_trackingStream.decode( td, true))
-    {
-        frames_decoded++;
+    m_interpolationDelay = getIntValue("Interpolation Delay");
 
-        //Log::debug("Tracking data decoded!", "FaceShiftClientUDPNode::processInputData");
-        int numBlendshapes = td.m_coeffs.size();
-        assert( numBlendshapes == m_animParams->getParameterList().size());
+    const int outputRate = getIntValue("Output Rate");
+    m_outputTimer.setInterval( outputRate > 0 ? 1000 / outputRate : 16 );
 
-        for ( int i=0; i< numBlendshapes; i++)
-        {
-            Parameter* blendshapeParam = dynamic_cast<Parameter *>(m_animParams->getParameterList().at(i));
-            assert( blendshapeParam );
-            blendshapeParam->setValue( QVariant( td.m_coeffs[i]*100.0f), true);
-        }
+    if( m_updateMode == Interpolated && getBoolValue("Run") )
+        m_outputTimer.start();
+    else
+        m_outputTimer.stop();
+}
 
-        // head translation
-        UpdateHeadTranslation( td.m_headTranslation );
+//!
+//! Slot which is called when the receiver could not open the socket.
+//!
+//! \param message The error message of the socket.
+//!
+void FaceShiftClientUDPNode::receiverFailed( const QString &message )
+{
+    Log::error("Could not listen for tracking data! "+message, "FaceShiftClientUDPNode::receiverFailed");
+    if( getBoolValue("Run") )
+        setValue("Run", false, true);
+}
 
-        // head rotation
-        UpdateHeadRotation( td.m_headRotation );
+///
+/// Private Functions
+///
+
+//!
+//! Sets all output values of the given frame without dirtying and
+//! propagates the changed parameters once afterwards.
+//!
+//! \param td The tracking data to apply.
+//!
+void FaceShiftClientUDPNode::applyTrackingData( const fs::fsTrackingData &td )
+{
+    m_changedParameters.clear();
 
-        // UpdateEyeGaze
-        UpdateEyeGaze( td.m_eyeGazeLeftPitch, td.m_eyeGazeRightPitch, td.m_eyeGazeLeftYaw, td.m_eyeGazeRightYaw );
+    const int numBlendshapes = std::min<int>(int(td.m_coeffs.size()), m_blendshapeParameters.size());
 
-    };
+    for ( int i=0; i< numBlendshapes; i++)
+        setParameterValue( m_blendshapeParameters[i], QVariant( td.m_coeffs[i]*100.0f));
 
-    if( frames_decoded )
-    {
-        // measure time since the last data received
-        int time = m_stopWatch.elapsed();
-        int rate = frames_decoded*1000 / time+1;
-        this->getParameter("Update Rate")->setValue(QVariant(rate));
-        m_stopWatch.restart();
+    // head translation
+    UpdateHeadTranslation( td.m_headTranslation );
 
-        Log::debug("Received and decoded "+QString::number(frames_decoded)+ " frames", "FaceShiftClientUDPNode::processInputData");
-    }
-}
+    // head rotation
+    UpdateHeadRotation( td.m_headRotation );
 
-///
-/// Private Slots
-///
+    // UpdateEyeGaze
+    UpdateEyeGaze( td.m_eyeGazeLeftPitch, td.m_eyeGazeRightPitch, td.m_eyeGazeLeftYaw, td.m_eyeGazeRightYaw );
 
+    // downstream nodes reached by several outputs are evaluated once per frame
+    Parameter::propagateDirty(m_changedParameters);
+    m_changedParameters.clear();
+}
 
 //!
-//! Slot which is called when running flag on node is toggled.
+//! Sets the value of the given parameter without dirtying and remembers
+//! the parameter if its value changed.
 //!
-void FaceShiftClientUDPNode::toggleRun()
+//! \param parameter The parameter to set, may be 0.
+//! \param value The new value.
+//!
+void FaceShiftClientUDPNode::setParameterValue( Parameter *parameter, const QVariant &value )
 {
-    bool run = getBoolValue("Run");
-    if (run || !isRunning()) {
-        start();   
-    }
-    else {
-        quit();
+    if( parameter && parameter->getValue() != value )
+    {
+        parameter->setValue(value, false);
+        m_changedParameters.append(parameter);
     }
-
 }
 
 //!
-//! Slot which is called when thread has finished.
+//! Updates the rate of decoded frames once per second.
 //!
-void FaceShiftClientUDPNode::threadFinished()
+void FaceShiftClientUDPNode::updateRate()
 {
-    Log::debug("Closing Connection", "FaceShiftClientUDPNode::threadFinished");
-    m_socket.abort();
-    m_trackingStream.clear();
+    const int time = m_stopWatch.elapsed();
+    if( time < 1000 )
+        return;
+
+    const int rate = m_receiver->takeReceivedCount()*1000 / time;
+    this->getParameter("Update Rate")->setValue(QVariant(rate));
+    m_stopWatch.restart();
 }
 
+//!
+//! Sets the head translation output.
+//!
+//! \param trans The head translation.
+//!
 void FaceShiftClientUDPNode::UpdateHeadTranslation( Ogre::Vector3 trans )
 {
     QVariantList values  = QVariantList() << trans.x << trans.y << trans.z;
-    this->getNumberParameter("Head > HeadTranslate")->setValue(QVariant(values), true);
+    setParameterValue(m_headTranslateParameter, QVariant(values));
 
 }
 
+//!
+//! Sets the head rotation output and the head turn, up, down and tilt
+//! outputs derived from it, 90 degrees being full displacement.
+//!
+//! \param rot The head rotation.
+//!
 void FaceShiftClientUDPNode::UpdateHeadRotation( Ogre::Quaternion rot )
 {
     QVariantList values  = QVariantList() << rot.w << rot.x << rot.y << rot.z;
-    this->getNumberParameter("Head > HeadRotate")->setValue(QVariant(values), true);
+    setParameterValue(m_headRotateParameter, QVariant(values));
 
     float radToAnim = 100.0 / Ogre::Math::HALF_PI; // 90 -> full displacement
     float yaw = rot.getYaw().valueRadians() * radToAnim;
@@ -217,14 +312,22 @@ void FaceShiftClientUDPNode::UpdateHeadRotation( Ogre::Quaternion rot )
     else
         headTiltLeft = -roll;
 
-    this->getNumberParameter("Head > HeadTurnRight")->setValue(QVariant(headRight), true);
-    this->getNumberParameter("Head > HeadTurnLeft")->setValue(QVariant(headLeft), true);
-    this->getNumberParameter("Head > HeadUp")->setValue(QVariant(headUp), true);
-    this->getNumberParameter("Head > HeadDown")->setValue(QVariant(headDown), true);
-    this->getNumberParameter("Head > HeadTiltLeft")->setValue(QVariant(headTiltLeft), true);
-    this->getNumberParameter("Head > HeadTiltRight")->setValue(QVariant(headTiltRight), true);
+    setParameterValue(m_headTurnRightParameter, QVariant(headRight));
+    setParameterValue(m_headTurnLeftParameter, QVariant(headLeft));
+    setParameterValue(m_headUpParameter, QVariant(headUp));
+    setParameterValue(m_headDownParameter, QVariant(headDown));
+    setParameterValue(m_headTiltLeftParameter, QVariant(headTiltLeft));
+    setParameterValue(m_headTiltRightParameter, QVariant(headTiltRight));
 }
 
+//!
+//! Sets the eye gaze outputs.
+//!
+//! \param pitchLeft The pitch of the left eye in degrees.
+//! \param pitchRight The pitch of the right eye in degrees.
+//! \param yawLeft The yaw of the left eye in degrees.
+//! \param yawRight The yaw of the right eye in degrees.
+//!
 void FaceShiftClientUDPNode::UpdateEyeGaze( float pitchLeft, float pitchRight, float yawLeft, float yawRight )
 {
     const float degToRad = Ogre::Math::PI / 180.0f;
@@ -232,8 +335,8 @@ void FaceShiftClientUDPNode::UpdateEyeGaze( float pitchLeft, float pitchRight, f
     QVariantList eyeGazeLeft  = QVariantList() << degToRad*pitchLeft  << degToRad*yawLeft  << 0.0 << 0.0 << 0.0 << 0.0;
     QVariantList eyeGazeRight = QVariantList() << degToRad*pitchRight << degToRad*yawRight << 0.0 << 0.0 << 0.0 << 0.0;
 
-    this->getNumberParameter("Eyes > EyeGazeLeft")->setValue(QVariant( eyeGazeLeft ), true);
-    this->getNumberParameter("Eyes > EyeGazeRight")->setValue(QVariant( eyeGazeRight ), true);
+    setParameterValue(m_eyeGazeLeftParameter, QVariant( eyeGazeLeft ));
+    setParameterValue(m_eyeGazeRightParameter, QVariant( eyeGazeRight ));
 };
 
 } // namespace FaceShiftClientUDPNode 
@@ -35,8 +35,12 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "Node.h"
 #include "ParameterGroup.h"
+#include "NumberParameter.h"
 #include <QtCore/QDataStream>
-#include <QtNetwork/QUdpSocket>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
 #include <QTime>
 
 // FaceShift binary network stream format
@@ -45,6 +49,8 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 namespace FaceShiftClientUDPNode {
 using namespace Frapper;
 
+class FaceShiftReceiver;
+
 //!
 //! Input node for FaceShift tracking data via tcp
 //!
@@ -69,10 +75,17 @@ public: // constructors and destructors
     //!
     ~FaceShiftClientUDPNode ();
 
-public: // functions
-
-    virtual void run();
+public: // enumerations
 
+    //!
+    //! How received frames are applied to the output parameters.
+    //!
+    enum UpdateMode
+    {
+        EveryFrame = 0,
+        LatestFrame = 1,
+        Interpolated = 2
+    };
 
 private slots: //
 
@@ -82,26 +95,69 @@ private slots: //
     void toggleRun();
 
     //!
-    //! Slot which is called when running flag on node is toggled.
+    //! Slot which is called when the receiver decoded new frames.
     //!
     void processInputData();
 
     //!
-    //! Slot which is called when thread has finished.
+    //! Slot which is called by the output timer in the interpolated mode.
     //!
-    void threadFinished();
+    void updateInterpolated();
+
+    //!
+    //! Slot which is called when the update mode settings change.
+    //!
+    void updateMode();
+
+    //!
+    //! Slot which is called when the receiver could not open the socket.
+    //!
+    void receiverFailed( const QString &message );
 
 private: // data
 
     //!
-    //! The udp socket.
+    //! The network thread and the receiver running on it.
+    //!
+    QThread m_networkThread;
+    FaceShiftReceiver *m_receiver;
+
+    //!
+    //! The clock received frames are timestamped with.
+    //!
+    QElapsedTimer m_clock;
+
+    //!
+    //! Timer to apply interpolated frames at the output rate.
+    //!
+    QTimer m_outputTimer;
+
+    //!
+    //! The selected update mode and the interpolation delay in milliseconds.
     //!
-    QUdpSocket m_socket;
+    UpdateMode m_updateMode;
+    int m_interpolationDelay;
 
     //!
-    //! Decoder for binary FaceShift network stream
+    //! Cached output parameters, the blendshapes in stream order.
     //!
-    fs::fsBinaryTrackingStream m_trackingStream;
+    QVector<Parameter *> m_blendshapeParameters;
+    NumberParameter *m_headTranslateParameter;
+    NumberParameter *m_headRotateParameter;
+    NumberParameter *m_headTurnRightParameter;
+    NumberParameter *m_headTurnLeftParameter;
+    NumberParameter *m_headUpParameter;
+    NumberParameter *m_headDownParameter;
+    NumberParameter *m_headTiltLeftParameter;
+    NumberParameter *m_headTiltRightParameter;
+    NumberParameter *m_eyeGazeLeftParameter;
+    NumberParameter *m_eyeGazeRightParameter;
+
+    //!
+    //! Parameters changed by the current frame, dirtied once after all
+    //! values were set.
+    //!
+    QList<Parameter *> m_changedParameters;
     
     //!
     //! The parameter group of animation parameters
@@ -116,6 +172,15 @@ private: // data
 
 private: // functions
 
+    // apply all values of a frame and propagate the changes once
+    void applyTrackingData( const fs::fsTrackingData &td );
+
+    // set a parameter value without dirtying and remember the change
+    void setParameterValue( Parameter *parameter, const QVariant &value );
+
+    // update the rate of decoded frames once per second
+    void updateRate();
+
     // write decoded head translation to output parameters
     void UpdateHeadTranslation( Ogre::Vector3 trans);
 
@@ -0,0 +1,244 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "FaceShiftReceiver.cpp"
+//! \brief Implementation file for FaceShiftReceiver class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "FaceShiftReceiver.h"
+#include "Log.h"
+
+#include <QtCore/QMutexLocker>
+
+namespace FaceShiftClientUDPNode {
+using namespace Frapper;
+
+//!
+//! Max number of frames kept for the node in the every frame mode.
+//!
+static const int MaxPendingFrames = 64;
+
+//!
+//! Constructor of the FaceShiftReceiver class.
+//!
+//! \param clock The clock to timestamp decoded frames with.
+//!
+FaceShiftReceiver::FaceShiftReceiver ( const QElapsedTimer &clock ) :
+    m_socket(0),
+    m_clock(clock),
+    m_numberOfFrames(0),
+    m_receivedCount(0),
+    m_notificationPending(0)
+{
+    m_frameTimes[0] = m_frameTimes[1] = 0;
+}
+
+//!
+//! Destructor of the FaceShiftReceiver class.
+//!
+FaceShiftReceiver::~FaceShiftReceiver ()
+{
+}
+
+//!
+//! Starts to listen for datagrams on the given port. The socket is created
+//! on first use, so it lives on the network thread.
+//!
+//! \param port The UDP port to listen on.
+//!
+void FaceShiftReceiver::open ( int port )
+{
+    close();
+
+    if (!m_socket) {
+        m_socket = new QUdpSocket(this);
+        connect(m_socket, SIGNAL(readyRead()), SLOT(readData()));
+    }
+
+    if (m_socket->bind(quint16(port)))
+        Log::debug("Listening on port "+QString::number(port)+"...", "FaceShiftReceiver::open");
+    else
+        emit receiverError(m_socket->errorString());
+}
+
+//!
+//! Closes the socket and drops all received frames.
+//!
+void FaceShiftReceiver::close ()
+{
+    if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
+        Log::debug("Closing Connection", "FaceShiftReceiver::close");
+        m_socket->abort();
+    }
+    m_trackingStream.clear();
+
+    QMutexLocker locker(&m_mutex);
+    m_pendingFrames.clear();
+    m_numberOfFrames = 0;
+    m_receivedCount = 0;
+}
+
+//!
+//! Slot which is called when datagrams are available on the socket. Decodes
+//! all complete frames and notifies the node once until it takes them.
+//!
+void FaceShiftReceiver::readData ()
+{
+    while (m_socket->hasPendingDatagrams()) {
+        QByteArray datagram;
+        datagram.resize(int(m_socket->pendingDatagramSize()));
+        const qint64 size = m_socket->readDatagram(datagram.data(), datagram.size());
+        if (size > 0) {
+            datagram.resize(int(size));
+            m_trackingStream.append(datagram);
+        }
+    }
+
+    const qint64 now = m_clock.elapsed();
+    int framesDecoded = 0;
+    fs::fsTrackingData td;
+    while (m_trackingStream.decode(td, true)) {
+        ++framesDecoded;
+
+        QMutexLocker locker(&m_mutex);
+        m_pendingFrames.append(td);
+        if (m_pendingFrames.size() > MaxPendingFrames)
+            m_pendingFrames.removeFirst();
+
+        if (m_numberOfFrames == 2) {
+            m_frames[0] = m_frames[1];
+            m_frameTimes[0] = m_frameTimes[1];
+            m_numberOfFrames = 1;
+        }
+        m_frames[m_numberOfFrames] = td;
+        m_frameTimes[m_numberOfFrames] = now;
+        ++m_numberOfFrames;
+        ++m_receivedCount;
+    }
+
+    // notify the node once until it has taken the frames
+    if (framesDecoded && m_notificationPending.testAndSetOrdered(0, 1))
+        emit framesReceived();
+}
+
+//!
+//! Allows the next framesReceived notification.
+//!
+void FaceShiftReceiver::acknowledge ()
+{
+    m_notificationPending.fetchAndStoreOrdered(0);
+}
+
+//!
+//! Returns the frames decoded since the last call and removes them.
+//!
+//! \param frames Receives the frames, oldest first.
+//!
+void FaceShiftReceiver::takeFrames ( QList<fs::fsTrackingData> &frames )
+{
+    QMutexLocker locker(&m_mutex);
+    acknowledge();
+    frames = m_pendingFrames;
+    m_pendingFrames.clear();
+}
+
+//!
+//! Returns the newest frame decoded since the last call and removes all
+//! pending frames.
+//!
+//! \param frame Receives the newest frame.
+//! \return True if a frame was decoded since the last call.
+//!
+bool FaceShiftReceiver::takeLatest ( fs::fsTrackingData &frame )
+{
+    QMutexLocker locker(&m_mutex);
+    acknowledge();
+    if (m_pendingFrames.isEmpty())
+        return false;
+
+    frame = m_pendingFrames.last();
+    m_pendingFrames.clear();
+    return true;
+}
+
+//!
+//! Interpolates between the two newest frames at the given time and removes
+//! all pending frames. The newest frame is returned if the frames can not
+//! be interpolated.
+//!
+//! \param time The time to sample at.
+//! \param frame Receives the interpolated frame.
+//! \return True if a frame was decoded yet.
+//!
+bool FaceShiftReceiver::sample ( qint64 time, fs::fsTrackingData &frame )
+{
+    QMutexLocker locker(&m_mutex);
+    acknowledge();
+    m_pendingFrames.clear();
+
+    if (m_numberOfFrames == 0)
+        return false;
+
+    const fs::fsTrackingData &newest = m_frames[m_numberOfFrames-1];
+    if (m_numberOfFrames == 1 || time >= m_frameTimes[1] || m_frameTimes[1] <= m_frameTimes[0]
+        || m_frames[0].m_coeffs.size() != newest.m_coeffs.size()) {
+        frame = newest;
+        return true;
+    }
+
+    const fs::fsTrackingData &previous = m_frames[0];
+    float t = float(time - m_frameTimes[0]) / float(m_frameTimes[1] - m_frameTimes[0]);
+    if (t < 0.0f)
+        t = 0.0f;
+
+    frame = newest;
+    for (size_t i = 0; i < frame.m_coeffs.size(); ++i)
+        frame.m_coeffs[i] = previous.m_coeffs[i] + (newest.m_coeffs[i] - previous.m_coeffs[i]) * t;
+
+    frame.m_headRotation = Ogre::Quaternion::Slerp(t, previous.m_headRotation, newest.m_headRotation, true);
+    frame.m_headTranslation = previous.m_headTranslation + (newest.m_headTranslation - previous.m_headTranslation) * t;
+    frame.m_eyeGazeLeftPitch = previous.m_eyeGazeLeftPitch + (newest.m_eyeGazeLeftPitch - previous.m_eyeGazeLeftPitch) * t;
+    frame.m_eyeGazeLeftYaw = previous.m_eyeGazeLeftYaw + (newest.m_eyeGazeLeftYaw - previous.m_eyeGazeLeftYaw) * t;
+    frame.m_eyeGazeRightPitch = previous.m_eyeGazeRightPitch + (newest.m_eyeGazeRightPitch - previous.m_eyeGazeRightPitch) * t;
+    frame.m_eyeGazeRightYaw = previous.m_eyeGazeRightYaw + (newest.m_eyeGazeRightYaw - previous.m_eyeGazeRightYaw) * t;
+    return true;
+}
+
+//!
+//! Returns the number of frames decoded since the last call and resets it.
+//!
+//! \return The number of decoded frames.
+//!
+int FaceShiftReceiver::takeReceivedCount ()
+{
+    QMutexLocker locker(&m_mutex);
+    const int count = m_receivedCount;
+    m_receivedCount = 0;
+    return count;
+}
+
+} // namespace FaceShiftClientUDPNode 
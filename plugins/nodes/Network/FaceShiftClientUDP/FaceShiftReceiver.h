@@ -0,0 +1,186 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "FaceShiftReceiver.h"
+//! \brief Header file for FaceShiftReceiver class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef FACESHIFTRECEIVER_H
+#define FACESHIFTRECEIVER_H
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtNetwork/QUdpSocket>
+
+// FaceShift binary network stream format
+#include <fsstream.h>
+
+namespace FaceShiftClientUDPNode {
+
+//!
+//! Receives and decodes the FaceShift udp stream on a network thread.
+//! Decoded frames are kept with their local receive time, the node is
+//! notified with a single queued signal until it takes the frames, so a
+//! burst of datagrams results in one update on the GUI thread.
+//!
+class FaceShiftReceiver : public QObject
+{
+
+    Q_OBJECT
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the FaceShiftReceiver class.
+    //!
+    //! \param clock The clock to timestamp received frames with.
+    //!
+    FaceShiftReceiver ( const QElapsedTimer &clock );
+
+    //!
+    //! Destructor of the FaceShiftReceiver class.
+    //!
+    ~FaceShiftReceiver ();
+
+public: // functions
+
+    //!
+    //! Moves all frames received since the last call to the given list.
+    //!
+    void takeFrames ( QList<fs::fsTrackingData> &frames );
+
+    //!
+    //! Returns the newest frame and drops the older ones.
+    //!
+    //! \return False if no new frame was received since the last call.
+    //!
+    bool takeLatest ( fs::fsTrackingData &frame );
+
+    //!
+    //! Interpolates the received frames at the given local time. The two
+    //! newest frames are kept for interpolation, later times hold the
+    //! newest frame.
+    //!
+    //! \return False if no frame was received yet.
+    //!
+    bool sample ( qint64 time, fs::fsTrackingData &frame );
+
+    //!
+    //! Returns the number of frames decoded since the last call.
+    //!
+    int takeReceivedCount ();
+
+public slots: //
+
+    //!
+    //! Binds the udp socket to the given port.
+    //!
+    void open ( int port );
+
+    //!
+    //! Closes the socket and drops all frames.
+    //!
+    void close ();
+
+signals: //
+
+    //!
+    //! Signal that is emitted when new frames were decoded and the node
+    //! has not been notified yet.
+    //!
+    void framesReceived ();
+
+    //!
+    //! Signal that is emitted when the socket could not be bound.
+    //!
+    void receiverError ( const QString &message );
+
+private slots: //
+
+    //!
+    //! Reads the pending datagrams and decodes the tracking data.
+    //!
+    void readData ();
+
+private: // functions
+
+    //!
+    //! Rearms the notification, called with the mutex locked.
+    //!
+    void acknowledge ();
+
+private: // data
+
+    //!
+    //! The udp socket, created on the network thread.
+    //!
+    QUdpSocket *m_socket;
+
+    //!
+    //! Decoder for binary FaceShift network stream
+    //!
+    fs::fsBinaryTrackingStream m_trackingStream;
+
+    //!
+    //! The clock of the node.
+    //!
+    const QElapsedTimer &m_clock;
+
+    //!
+    //! Guards the frame lists.
+    //!
+    QMutex m_mutex;
+
+    //!
+    //! Frames not taken by the node yet.
+    //!
+    QList<fs::fsTrackingData> m_pendingFrames;
+
+    //!
+    //! The two newest frames and their receive times for interpolation.
+    //!
+    fs::fsTrackingData m_frames[2];
+    qint64 m_frameTimes[2];
+    int m_numberOfFrames;
+
+    //!
+    //! Number of decoded frames since the last query.
+    //!
+    int m_receivedCount;
+
+    //!
+    //! Set while a notification is queued and not handled.
+    //!
+    QAtomicInt m_notificationPending;
+};
+
+} // namespace FaceShiftClientUDPNode 
+
+#endif
@@ -52,8 +52,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //! \param outputImageName The name of the geometry output parameter.
 //!
 LooseAndSketchyNode::LooseAndSketchyNode ( const QString &name, ParameterGroup *parameterRoot ) :
-    RenderNode(name, parameterRoot),
-    m_gradientMap(0)
+    RenderNode(name, parameterRoot)
 {
     // Create a material using the texture
     Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().create("LooseAndSketchyMaterial", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
@@ -126,11 +125,11 @@ void LooseAndSketchyNode::progressLooseAndSketchy()
     //lock input map as gradient map buffer
     Ogre::HardwarePixelBufferSharedPtr inputPixelBuffer = inputTexture->getBuffer();
     const Ogre::PixelBox &inputPixelBox = inputPixelBuffer->lock(Ogre::Image::Box(0, 0, m_renderWidth, m_renderHeight), Ogre::HardwareBuffer::HBL_READ_ONLY);
-    m_gradientMap = static_cast<float *>(inputPixelBox.data);
+    m_strokeTracer.setGradientMap(static_cast<const float *>(inputPixelBox.data), m_renderWidth, m_renderHeight);
 
     //compute strokes
     computeLooseAndSketchy();
-    Log::info(QString::number((unsigned int) m_strokes.size()) + "# strokes");
+    Log::info(QString::number((unsigned int) m_strokeTracer.getStrokes().size()) + "# strokes");
 
     //unlock input map
     inputPixelBuffer->unlock();
@@ -148,186 +147,18 @@ void LooseAndSketchyNode::progressLooseAndSketchy()
 //!
 void LooseAndSketchyNode::computeLooseAndSketchy()
 {
-    //settings that cannot be adjusted so far
-    double minStrokeLength            = 0.05;
-    double minGradient                = 0.2;
-    double strokeContourCurvature    = 0.85;                    //curvature measure
-    //double strokeContourCurvature    = 0.1;
-    double trackingStep                = 2.0;                    //tracking step in pixel
-    int lineLength                    = 40;                    //line length in iterations (times pixel, times 2)
-    unsigned int lineCount            = 2000;                    //line count
-    unsigned int particleCount        = 10000; 
-
-    particleCount = getUnsignedIntValue("Particle Count");
-    lineCount = getUnsignedIntValue("Line Count");
-    lineLength = getUnsignedIntValue("Line Length");
-    minStrokeLength = getDoubleValue("Min Stroke Length");
-    minGradient = getDoubleValue("Min Gradient");
-    strokeContourCurvature = getDoubleValue("Stroke Contour Curvature");
-    trackingStep = getDoubleValue("Tracking Step");
-    
-
-    //delete strokes
-    m_strokes.erase(m_strokes.begin(), m_strokes.end());
-
-    for (int i = 0; i < particleCount; ++i)
-    {
-        //create new stroke
-        Stroke lineStroke;
-
-        //create particle
-        Vector2d particlePos = Vector2d(getRandom(), getRandom());
-        Vector2d particlePos0 = particlePos;
-
-        //gradient field lookup
-        Vector2d gradient = getGradientMap(particlePos);
-        //float intensity = getGradientMapIntensity(particlePos);
-        Vector2d prevGradient;
-
-        //stroke direction (within gradient map space)
-        gradient.normalize();
-        Vector2d strokeDir = Vector2d(-gradient.y / (double)m_renderWidth, gradient.x / (double)m_renderHeight);
-
-
-        //begin tracking
-        if (gradient.length() > minGradient)
-        //if (true)
-        {
-            //store first particle
-            lineStroke.vertices.push_back( Vector2d(particlePos.x * 2.0 - 1.0, particlePos.y * 2.0 - 1.0, 1.0) );
-            lineStroke.e0 = lineStroke.vertices.front();
-
-            //forward tracking
-            for (int t = 0; t < lineLength; ++t)
-            {
-                //update particle position
-                gradient.normalize();
-                Vector2d newStrokeDir = (1.0 - strokeContourCurvature) * Vector2d(-gradient.y / (double)m_renderWidth, gradient.x / (double)m_renderHeight);
-                strokeDir = strokeContourCurvature * strokeDir + newStrokeDir;
-                particlePos += strokeDir * trackingStep;
-
-                //store particle
-                lineStroke.vertices.push_back( Vector2d(particlePos.x * 2.0 - 1.0, particlePos.y * 2.0 - 1.0, 1.0) );
-
-                //lookup gradient
-                prevGradient = gradient;
-                gradient = getGradientMap(particlePos);
-                //intensity = getGradientMapIntensity(particlePos);
-
-
-                //realign gradient if inverse
-                //if (Vector2d::dotProduct(prevGradient, gradient) < 0.0)
-                //    gradient = -gradient;
-
-                //end if gradient is approx. zero
-                if (gradient.length() < minGradient * 0.5)
-                    break;
-            }
-
-            //restore initial particle
-            particlePos = particlePos0;
-            gradient = -getGradientMap(particlePos);
-            //intensity = getGradientMapIntensity(particlePos);
-            gradient.normalize();
-            strokeDir = Vector2d(-gradient.y / (double)m_renderWidth, gradient.x / (double)m_renderHeight);
-
-            //backward tracking
-            for (int t = 0; t < lineLength; ++t)
-            {
-                //update particle position
-                gradient.normalize();
-                strokeDir = strokeContourCurvature * strokeDir + (1.0 - strokeContourCurvature) * Vector2d(-gradient.y / (double)m_renderWidth, gradient.x / (double)m_renderHeight);
-                particlePos += strokeDir * trackingStep;
-
-                //store particle
-                lineStroke.vertices.insert(lineStroke.vertices.begin(), Vector2d(particlePos.x * 2.0 - 1.0, particlePos.y * 2.0 - 1.0, 1.0) );
-
-                //lookup gradient
-                prevGradient = gradient;
-                gradient = -getGradientMap(particlePos);
-                //intensity = getGradientMapIntensity(particlePos);
-
-                //realign gradient if inverse
-                //if (Vector2d::dotProduct(prevGradient, gradient) < 0.0)
-                //gradient = -gradient;
-
-                //end if gradient is approx. zero
-                if (gradient.length() < minGradient * 0.5)
-                    break;
-            }
-
-            //add line stroke
-            lineStroke.computeLength();
-
-            //keep min length and restrict strokes to mid area (say a circle)
-            //if ((lineStroke.length >= minStrokeLength) && (lineStroke.e0.length() < 0.95))
-            if (lineStroke.length >= minStrokeLength)
-                addStroke(lineStroke);
-
-        } //end tracking
-
-        if (m_strokes.size() > lineCount) break;
-    }
-
-
-    //sort by length
-    std::sort(m_strokes.begin(), m_strokes.end(), sortByLength);
-}
-
-//
-// Add a new stroke.
-//
-// \param stroke The stroke which should be added.
-//
-void LooseAndSketchyNode::addStroke(Stroke& stroke)
-{
-    double lineAbstraction = 0.005;
-
-    //simplify stroke
-    Stroke abstractStroke;
-    abstractStroke.vertices.reserve(stroke.vertices.size());
-
-
-    //abstraction process
-    abstractStroke.vertices.push_back( stroke.vertices.front() );
-
-    for (std::vector<Vector2d>::const_iterator v = stroke.vertices.begin(); v != stroke.vertices.end(); ++v)
-    {
-        if (Vector2d::getLength( *v - abstractStroke.vertices.back() ) > lineAbstraction) abstractStroke.vertices.push_back( *v );
-    }
-
-    abstractStroke.vertices.push_back( stroke.vertices.back() );
-
-    if (stroke.vertices.size() < 4) return;
-
-    abstractStroke.e0 = stroke.e0;
-
-
-    ////settings that cannot be adjusted so far
-    double strokeMinDistance = 0.005;
-
-    //keep certain density
-    for (std::vector<Stroke>::iterator s = m_strokes.begin(); s != m_strokes.end(); ++s)
-    {
-        for (UINT i = 0; i < s->vertices.size(); i += 1)
-        {
-            if (Vector2d::getLength(abstractStroke.e0 - s->vertices[i]) < strokeMinDistance)
-            {
-                return;
-            }
-        }
-    }
-
-    //fade in and out
-    abstractStroke.vertices.front().w = 0.0;
-    abstractStroke.vertices.back().w = 0.0;
-
-    //length
-    abstractStroke.computeLength();
-
-
-    //add stroke
-    m_strokes.push_back(abstractStroke);
+    StrokeTracerSettings settings;
+    settings.particleCount = getUnsignedIntValue("Particle Count");
+    settings.lineCount = getUnsignedIntValue("Line Count");
+    settings.lineLength = getUnsignedIntValue("Line Length");
+    settings.minStrokeLength = getDoubleValue("Min Stroke Length");
+    settings.minGradient = getDoubleValue("Min Gradient");
+    settings.strokeContourCurvature = getDoubleValue("Stroke Contour Curvature");
+    settings.trackingStep = getDoubleValue("Tracking Step");
+    settings.reuseSeeds = getBoolValue("Reuse Seeds");
+    settings.randomSeed = getUnsignedIntValue("Random Seed");
+
+    m_strokeTracer.trace(settings);
 }
 
 
@@ -339,7 +170,8 @@ void LooseAndSketchyNode::renderLooseAndSketchy()
     Ogre::SceneNode *sceneNode = m_sceneManager->getRootSceneNode()->createChildSceneNode();
     int index = 0;
     float countY = 0.0;
-    for (std::vector<Stroke>::const_iterator stroke = m_strokes.begin(); stroke != m_strokes.end(); ++stroke)
+    const std::vector<Stroke> &strokes = m_strokeTracer.getStrokes();
+    for (std::vector<Stroke>::const_iterator stroke = strokes.begin(); stroke != strokes.end(); ++stroke)
     {
         Ogre::ManualObject *strokeObject = m_sceneManager->createManualObject(QString("stroke%1").arg(index++).toStdString());
         
@@ -375,70 +207,3 @@ void LooseAndSketchyNode::redrawTriggered ()
     progressLooseAndSketchy();
 }
 
-//!
-//! Private Helper Methods
-//!
-
-//!
-//! Converts 2D texture position in 1D array index.
-//!
-//! \param Position which should be converted.
-//! \return Index in gradient map array.
-//!
-unsigned int LooseAndSketchyNode::getGradientMapIndex(const Vector2d& pos)
-{
-    int w = (int)(pos.x * m_renderWidth);
-    int h = (int)(pos.y * m_renderHeight);
-
-    w = std::max<int>(0, std::min<int>(m_renderWidth-1, w));
-    h = std::max<int>(0, std::min<int>(m_renderHeight-1, h));
-
-    return h * m_renderWidth + w;
-}
-
-//!
-//! Returns value of gradient map at position pos.
-//!
-//! \param Position in gradient map.
-//! \return Value of gradient map at position pos.
-//!
-Vector2d LooseAndSketchyNode::getGradientMap(const Vector2d& pos)
-{
-    unsigned int tmpLookupIndex = getGradientMapIndex(pos);
-
-    float gradientX = (float) m_gradientMap[tmpLookupIndex * 4 + 0];
-    float gradientY = (float) m_gradientMap[tmpLookupIndex * 4 + 1];
-    Vector2d gradient(gradientX, gradientY);
-    return gradient;
-}
-
-
-//float getGradientMapIntensity(const Vector2d& pos)
-//{
-//    unsigned int tmpLookupIndex = getGradientMapIndex(pos);
-//
-//    return m_gradientMap[tmpLookupIndex * 4 + 2] / 255.0;
-//}
-
-//!
-//! Returns a random double value.
-//!
-//! \return Value of gradient map at position pos.
-//!
-double LooseAndSketchyNode::getRandom()
-{
-    return rand()/(double)RAND_MAX;
-}
-
-//!
-//! Returns whether length of stroke s0 is greater than the
-//! length of s1.
-//!
-//! \return True if length(s0) > length(s1).
-//!
-bool LooseAndSketchyNode::sortByLength(Stroke s0, Stroke s1)
-{
-    return s0.length > s1.length;
-}
-
-
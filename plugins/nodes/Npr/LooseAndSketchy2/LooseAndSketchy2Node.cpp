@@ -36,7 +36,6 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "Parameter.h"
 #include "OgreTools.h"
 #include "OgreManager.h"
-#include <random>
 
 namespace LooseAndSketchy2Node {
 	using namespace Frapper;
@@ -53,7 +52,8 @@ namespace LooseAndSketchy2Node {
 //! \param outputImageName The name of the geometry output parameter.
 //!
 LooseAndSketchy2Node::LooseAndSketchy2Node ( const QString &name, ParameterGroup *parameterRoot ) :
-    RenderNode(name, parameterRoot)
+    RenderNode(name, parameterRoot),
+	m_seedsRandomSeed(0)
 {
     Parameter *outputParameter = getParameter(m_outputImageName);
     if (outputParameter) {
@@ -63,6 +63,7 @@ LooseAndSketchy2Node::LooseAndSketchy2Node ( const QString &name, ParameterGroup
         // set the processing function for the output image parameter
         outputParameter->setProcessingFunction(SLOT(processOutputImage()));
 		setChangeFunction("numberSeeds", SIGNAL(triggerRedraw()));
+		setChangeFunction("randomSeed", SIGNAL(triggerRedraw()));
 		setChangeFunction("seedingThreshold", SIGNAL(triggerRedraw()));
 		setChangeFunction("numberSteps", SIGNAL(triggerRedraw()));
 		setChangeFunction("stepSize", SIGNAL(triggerRedraw()));
@@ -151,15 +152,15 @@ void LooseAndSketchy2Node::progressLooseAndSketchy2()
 
 void LooseAndSketchy2Node::computeLooseAndSketchy2()
 {
-	m_seeds.clear();
-
-	std::default_random_engine generator;
-	std::uniform_real_distribution<double> distribution(0.f, 1.f);
-
-	for (int i = 0; i < getIntValue("numberSeeds"); ++i)
-	{
-		m_seeds.push_back(Vector2d(distribution(generator), distribution(generator)));
-	}
+	// the seeds only depend on their count and the random seed, keep them
+	// across frames so the strokes traced on the GPU stay coherent
+	const unsigned int numberSeeds = (unsigned int) std::max(0, getIntValue("numberSeeds"));
+	const unsigned int randomSeed = (unsigned int) std::max(0, getIntValue("randomSeed"));
+	if (m_seeds.size() == numberSeeds && m_seedsRandomSeed == randomSeed)
+		return;
+
+	StrokeTracer::generateSeeds(numberSeeds, randomSeed, m_seeds);
+	m_seedsRandomSeed = randomSeed;
 }
 
 
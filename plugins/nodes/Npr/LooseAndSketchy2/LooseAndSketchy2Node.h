@@ -35,7 +35,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "RenderNode.h"
 #include <gl/gl.h>
-#include "Vector2d.h"
+#include "StrokeTracer.h"
 
 namespace LooseAndSketchy2Node {
 
@@ -95,9 +95,17 @@ private: // Private Methods
 
     void renderLooseAndSketchy2();
 
-private: // Private Helper Methods
+private: // Private Member Variables
 
+	//!
+	//! Stroke seeds, regenerated only when their count or random seed changes.
+	//!
 	std::vector<Vector2d> m_seeds;
+
+	//!
+	//! Random seed the current stroke seeds were generated with.
+	//!
+	unsigned int m_seedsRandomSeed;
 };
 
 } // end namespace
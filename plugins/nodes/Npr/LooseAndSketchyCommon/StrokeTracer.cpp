@@ -0,0 +1,506 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "StrokeTracer.cpp"
+//! \brief Implementation file for the StrokeTracer class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "StrokeTracer.h"
+#include <algorithm>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+//!
+//! Number of particles sharing one random stream.
+//!
+const int ParticleBlockSize = 256;
+
+//!
+//! Number of particle blocks traced in parallel before merging.
+//!
+const int BlocksPerBatch = 16;
+
+//!
+//! Number of hill climbing steps when advecting a seed.
+//!
+const int SeedAdvectionSteps = 2;
+
+//!
+//! Returns the seed of the random stream of the given particle block.
+//!
+inline unsigned int getStreamSeed ( unsigned int randomSeed, unsigned int block )
+{
+    // splitmix style mixing to decorrelate neighbouring streams
+    unsigned int z = randomSeed + 0x9E3779B9u * (block + 1);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z = z ^ (z >> 16);
+    // minstd_rand must not be seeded with zero
+    return z ? z : 1u;
+}
+
+//!
+//! Fills count seeds of the given particle block.
+//!
+inline void fillBlock ( unsigned int randomSeed, unsigned int block, Vector2d *seeds, int count )
+{
+    std::minstd_rand generator(getStreamSeed(randomSeed, block));
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (int i = 0; i < count; ++i) {
+        const float x = distribution(generator);
+        const float y = distribution(generator);
+        seeds[i] = Vector2d(x, y);
+    }
+}
+
+//!
+//! Returns whether length of stroke s0 is greater than the
+//! length of s1.
+//!
+inline bool sortByLength ( const Stroke &s0, const Stroke &s1 )
+{
+    return s0.length > s1.length;
+}
+
+} // end anonymous namespace
+
+
+///
+/// Constructors and Destructors
+///
+
+//!
+//! Constructor of the StrokeTracer class.
+//!
+StrokeTracer::StrokeTracer () :
+    m_gradientMap(0),
+    m_width(0),
+    m_height(0),
+    m_gridSize(0),
+    m_gridCellSize(0.0f),
+    m_gridMinDistanceSq(0.0f)
+{
+}
+
+//!
+//! Destructor of the StrokeTracer class.
+//!
+StrokeTracer::~StrokeTracer ()
+{
+}
+
+
+///
+/// Public Functions
+///
+
+//!
+//! Sets the gradient map to trace.
+//!
+//! \param data The gradient map data.
+//! \param width The width of the gradient map.
+//! \param height The height of the gradient map.
+//!
+void StrokeTracer::setGradientMap ( const float *data, unsigned int width, unsigned int height )
+{
+    // seeds are stored in normalized coordinates and survive resolution changes
+    m_gradientMap = data;
+    m_width = width;
+    m_height = height;
+}
+
+//!
+//! Traces the strokes of the current gradient map.
+//!
+//! \param settings The tracer settings.
+//!
+void StrokeTracer::trace ( const StrokeTracerSettings &settings )
+{
+    m_strokes.clear();
+    if (!m_gradientMap || m_width == 0 || m_height == 0)
+        return;
+
+    // reset the density grid, one cell per min distance in [-1, 1]^2
+    const float minDistance = (float) std::max(settings.strokeMinDistance, 0.0001);
+    m_gridSize = std::max(1, std::min(1024, (int) (2.0f / minDistance)));
+    m_gridCellSize = 2.0f / (float) m_gridSize;
+    m_gridMinDistanceSq = minDistance * minDistance;
+    m_gridHeads.assign(m_gridSize * m_gridSize, -1);
+    m_gridNext.clear();
+    m_gridPoints.clear();
+
+    // seeds of the previous frame come first so their strokes win against new ones
+    std::vector<Vector2d> reusedSeeds;
+    if (settings.reuseSeeds) {
+        advectSeeds(settings);
+        reusedSeeds.swap(m_seeds);
+    }
+    m_seeds.clear();
+
+    const int reusedCount = (int) reusedSeeds.size();
+    const int particleCount = (int) settings.particleCount;
+    const int totalCount = reusedCount + particleCount;
+    const int batchSize = BlocksPerBatch * ParticleBlockSize;
+
+    m_candidates.resize(batchSize);
+    m_candidateValid.resize(batchSize);
+    std::vector<Vector2d> batchSeeds(batchSize);
+
+    bool done = false;
+    for (int batchStart = 0; batchStart < totalCount && !done; batchStart += batchSize) {
+        const int batchCount = std::min(batchSize, totalCount - batchStart);
+        const int blockCount = (batchCount + ParticleBlockSize - 1) / ParticleBlockSize;
+
+        // every block of random particles draws from its own stream
+        #pragma omp parallel for schedule(dynamic)
+        for (int b = 0; b < blockCount; ++b) {
+            const int begin = b * ParticleBlockSize;
+            const int end = std::min(begin + ParticleBlockSize, batchCount);
+            int i = begin;
+            for (; i < end && batchStart + i < reusedCount; ++i)
+                batchSeeds[i] = reusedSeeds[batchStart + i];
+            if (i < end) {
+                const int particle = batchStart + i - reusedCount;
+                // random blocks are aligned to the particle index, not the batch
+                const unsigned int block = (unsigned int) (particle / ParticleBlockSize);
+                const int offset = particle % ParticleBlockSize;
+                Vector2d blockSeeds[ParticleBlockSize];
+                fillBlock(settings.randomSeed, block, blockSeeds, ParticleBlockSize);
+                for (int j = offset; i < end && j < ParticleBlockSize; ++i, ++j)
+                    batchSeeds[i] = blockSeeds[j];
+                if (i < end) {
+                    fillBlock(settings.randomSeed, block + 1, blockSeeds, ParticleBlockSize);
+                    for (int j = 0; i < end; ++i, ++j)
+                        batchSeeds[i] = blockSeeds[j];
+                }
+            }
+
+            for (i = begin; i < end; ++i)
+                m_candidateValid[i] = traceCandidate(batchSeeds[i], settings, m_candidates[i]);
+        }
+
+        // merge in particle order to stay independent of the thread count
+        for (int i = 0; i < batchCount; ++i) {
+            if (!m_candidateValid[i] || !isFree(m_candidates[i].e0))
+                continue;
+
+            insertIntoGrid(m_candidates[i]);
+            m_seeds.push_back(m_candidates[i].seed);
+            m_strokes.push_back(Stroke());
+            m_strokes.back().vertices.swap(m_candidates[i].vertices);
+            m_strokes.back().e0 = m_candidates[i].e0;
+            m_strokes.back().seed = m_candidates[i].seed;
+            m_strokes.back().length = m_candidates[i].length;
+
+            if (m_strokes.size() > settings.lineCount) {
+                done = true;
+                break;
+            }
+        }
+    }
+
+    //sort by length
+    if (settings.sortByLength)
+        std::sort(m_strokes.begin(), m_strokes.end(), sortByLength);
+}
+
+//!
+//! Returns the strokes of the last trace() call.
+//!
+//! \return The accepted strokes.
+//!
+const std::vector<Stroke> & StrokeTracer::getStrokes () const
+{
+    return m_strokes;
+}
+
+//!
+//! Drops the strokes and the seeds kept for the next frame.
+//!
+void StrokeTracer::reset ()
+{
+    m_strokes.clear();
+    m_seeds.clear();
+}
+
+//!
+//! Fills the given vector with uniformly distributed seeds in [0, 1]^2.
+//!
+//! \param count The number of seeds to generate.
+//! \param randomSeed The base seed of the random streams.
+//! \param seeds The vector to fill.
+//!
+void StrokeTracer::generateSeeds ( unsigned int count, unsigned int randomSeed, std::vector<Vector2d> &seeds )
+{
+    seeds.resize(count);
+    const int blockCount = ((int) count + ParticleBlockSize - 1) / ParticleBlockSize;
+
+    #pragma omp parallel for
+    for (int b = 0; b < blockCount; ++b) {
+        const int begin = b * ParticleBlockSize;
+        const int blockLength = std::min(ParticleBlockSize, (int) count - begin);
+        fillBlock(randomSeed, (unsigned int) b, &seeds[begin], blockLength);
+    }
+}
+
+
+///
+/// Private Functions
+///
+
+//!
+//! Traces and simplifies a single candidate stroke.
+//!
+//! \param seed The particle position in gradient map space.
+//! \param settings The tracer settings.
+//! \param stroke The stroke to fill.
+//! \return True if the stroke is a valid candidate.
+//!
+bool StrokeTracer::traceCandidate ( const Vector2d &seed, const StrokeTracerSettings &settings, Stroke &stroke ) const
+{
+    const double curvature = settings.strokeContourCurvature;
+    const double stopGradientSq = settings.minGradient * settings.minGradient * settings.terminationRatio * settings.terminationRatio;
+    const double lineAbstractionSq = settings.lineAbstraction * settings.lineAbstraction;
+    const float invWidth = 1.0f / (float) m_width;
+    const float invHeight = 1.0f / (float) m_height;
+
+    std::vector<Vector2d> &vertices = stroke.vertices;
+    vertices.clear();
+
+    //gradient field lookup
+    Vector2d gradient = getGradientMap(seed);
+    if (!isStartGradient(gradient, settings))
+        return false;
+
+    //backward tracking first, the vertices are reversed afterwards
+    for (int direction = -1; direction <= 1; direction += 2) {
+        Vector2d particlePos = seed;
+        gradient = (float) direction * getGradientMap(particlePos);
+        if (settings.normalizeGradient)
+            gradient.normalize();
+        Vector2d strokeDir = Vector2d(-gradient.y * invWidth, gradient.x * invHeight);
+
+        if (direction > 0) {
+            //store first particle
+            vertices.push_back( Vector2d(particlePos.x * 2.0f - 1.0f, particlePos.y * 2.0f - 1.0f, 1.0f) );
+        }
+
+        for (unsigned int t = 0; t < settings.lineLength; ++t)
+        {
+            //update particle position
+            if (settings.normalizeGradient)
+                gradient.normalize();
+            strokeDir = curvature * strokeDir + (1.0 - curvature) * Vector2d(-gradient.y * invWidth, gradient.x * invHeight);
+            particlePos += strokeDir * settings.trackingStep;
+
+            //store particle
+            vertices.push_back( Vector2d(particlePos.x * 2.0f - 1.0f, particlePos.y * 2.0f - 1.0f, 1.0f) );
+
+            //lookup gradient
+            gradient = (float) direction * getGradientMap(particlePos);
+
+            //end if gradient is approx. zero
+            if (gradient.lengthSq() < stopGradientSq)
+                break;
+        }
+
+        if (direction < 0)
+            std::reverse(vertices.begin(), vertices.end());
+    }
+
+    stroke.seed = seed;
+    stroke.e0 = Vector2d(seed.x * 2.0f - 1.0f, seed.y * 2.0f - 1.0f, 1.0f);
+    stroke.computeLength();
+    if (stroke.length < settings.minStrokeLength || vertices.size() < 4)
+        return false;
+
+    //simplify stroke in place, keeping the first and the last vertex
+    const Vector2d last = vertices.back();
+    size_t count = 1;
+    for (size_t i = 1; i + 1 < vertices.size(); ++i)
+    {
+        if (Vector2d::getLengthSq(vertices[i] - vertices[count-1]) > lineAbstractionSq)
+            vertices[count++] = vertices[i];
+    }
+    vertices[count++] = last;
+    vertices.resize(count);
+
+    //fade in and out
+    vertices.front().w = 0.0f;
+    vertices.back().w = 0.0f;
+
+    //length
+    stroke.computeLength();
+    return true;
+}
+
+//!
+//! Moves the seeds of the previous frame to the locally strongest gradient
+//! and drops the seeds that no longer lie on an edge.
+//!
+//! \param settings The tracer settings.
+//!
+void StrokeTracer::advectSeeds ( const StrokeTracerSettings &settings )
+{
+    const float dx = 1.0f / (float) m_width;
+    const float dy = 1.0f / (float) m_height;
+    const int seedCount = (int) m_seeds.size();
+    std::vector<char> keep(seedCount);
+
+    #pragma omp parallel for
+    for (int i = 0; i < seedCount; ++i) {
+        Vector2d &seed = m_seeds[i];
+        float best = getGradientMap(seed).lengthSq();
+
+        // follow the edge by climbing to the strongest neighbouring gradient
+        for (int step = 0; step < SeedAdvectionSteps; ++step) {
+            Vector2d bestPos = seed;
+            for (int y = -1; y <= 1; ++y)
+                for (int x = -1; x <= 1; ++x) {
+                    const Vector2d pos(seed.x + x * dx, seed.y + y * dy);
+                    const float magnitude = getGradientMap(pos).lengthSq();
+                    if (magnitude > best) {
+                        best = magnitude;
+                        bestPos = pos;
+                    }
+                }
+            if (bestPos == seed)
+                break;
+            seed = bestPos;
+        }
+
+        keep[i] = isStartGradient(getGradientMap(seed), settings) && seed.x >= 0.0f && seed.x <= 1.0f && seed.y >= 0.0f && seed.y <= 1.0f;
+    }
+
+    int count = 0;
+    for (int i = 0; i < seedCount; ++i)
+        if (keep[i])
+            m_seeds[count++] = m_seeds[i];
+    m_seeds.resize(count);
+}
+
+//!
+//! Returns whether a stroke may start at the given gradient. With
+//! normalizeGradient, the normalized gradient is compared to minGradient,
+//! as the online node always did, so every non-zero gradient passes a
+//! threshold below 1. Otherwise the raw gradient magnitude is compared.
+//!
+//! \param gradient The gradient at the start position.
+//! \param settings The tracer settings.
+//! \return True if a stroke may start at the gradient.
+//!
+bool StrokeTracer::isStartGradient ( const Vector2d &gradient, const StrokeTracerSettings &settings ) const
+{
+    Vector2d startGradient = gradient;
+    if (startGradient.lengthSq() == 0.0f)
+        return false;
+    if (settings.normalizeGradient)
+        startGradient.normalize();
+    return startGradient.lengthSq() > settings.minGradient * settings.minGradient;
+}
+
+//!
+//! Returns whether a stroke starting at e0 keeps the min distance to all
+//! accepted strokes.
+//!
+bool StrokeTracer::isFree ( const Vector2d &e0 ) const
+{
+    const int cx = std::max(0, std::min(m_gridSize - 1, (int) ((e0.x + 1.0f) / m_gridCellSize)));
+    const int cy = std::max(0, std::min(m_gridSize - 1, (int) ((e0.y + 1.0f) / m_gridCellSize)));
+
+    for (int y = std::max(0, cy - 1); y <= std::min(m_gridSize - 1, cy + 1); ++y)
+        for (int x = std::max(0, cx - 1); x <= std::min(m_gridSize - 1, cx + 1); ++x)
+            for (int p = m_gridHeads[y * m_gridSize + x]; p >= 0; p = m_gridNext[p])
+                if (Vector2d::getLengthSq(e0 - m_gridPoints[p]) < m_gridMinDistanceSq)
+                    return false;
+    return true;
+}
+
+//!
+//! Adds the vertices of an accepted stroke to the density grid.
+//!
+void StrokeTracer::insertIntoGrid ( const Stroke &stroke )
+{
+    for (std::vector<Vector2d>::const_iterator v = stroke.vertices.begin(); v != stroke.vertices.end(); ++v) {
+        const int cell = getGridCell(v->x, v->y);
+        if (cell < 0)
+            continue;
+        m_gridNext.push_back(m_gridHeads[cell]);
+        m_gridHeads[cell] = (int) m_gridPoints.size();
+        m_gridPoints.push_back(*v);
+    }
+}
+
+//!
+//! Returns the density grid cell of the given position, -1 if the position
+//! is too far outside of the grid to affect any stroke start.
+//!
+int StrokeTracer::getGridCell ( float x, float y ) const
+{
+    const float gx = (x + 1.0f) / m_gridCellSize;
+    const float gy = (y + 1.0f) / m_gridCellSize;
+    if (gx < -1.0f || gy < -1.0f || gx > m_gridSize + 1.0f || gy > m_gridSize + 1.0f)
+        return -1;
+
+    const int cx = std::max(0, std::min(m_gridSize - 1, (int) gx));
+    const int cy = std::max(0, std::min(m_gridSize - 1, (int) gy));
+    return cy * m_gridSize + cx;
+}
+
+//!
+//! Converts 2D texture position in 1D array index.
+//!
+//! \param Position which should be converted.
+//! \return Index in gradient map array.
+//!
+unsigned int StrokeTracer::getGradientMapIndex ( const Vector2d &pos ) const
+{
+    int w = (int)(pos.x * m_width);
+    int h = (int)(pos.y * m_height);
+
+    w = std::max<int>(0, std::min<int>(m_width-1, w));
+    h = std::max<int>(0, std::min<int>(m_height-1, h));
+
+    return h * m_width + w;
+}
+
+//!
+//! Returns value of gradient map at position pos.
+//!
+//! \param Position in gradient map.
+//! \return Value of gradient map at position pos.
+//!
+Vector2d StrokeTracer::getGradientMap ( const Vector2d &pos ) const
+{
+    const unsigned int index = getGradientMapIndex(pos);
+    return Vector2d(m_gradientMap[index * 4 + 0], m_gradientMap[index * 4 + 1]);
+}
@@ -0,0 +1,262 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "StrokeTracer.h"
+//! \brief Header file for the StrokeTracer class shared by the LooseAndSketchy nodes.
+//!
+//! The tracer follows the isolines of a gradient map to build line strokes.
+//! Candidate strokes are traced in parallel (OpenMP), every block of particles
+//! draws from its own deterministic random stream, and accepted strokes are
+//! merged serially in particle order, so the result does not depend on the
+//! number of threads. The seeds of accepted strokes are kept and re-used in
+//! the next frame to keep the strokes temporally coherent.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef STROKETRACER_H
+#define STROKETRACER_H
+
+#include "Vector2d.h"
+#include <vector>
+
+//!
+//! A traced line stroke in normalized device coordinates.
+//!
+class Stroke
+{
+public:
+    std::vector<Vector2d> vertices;
+    Vector2d e0;
+    Vector2d seed;
+    float length;
+
+public:
+    Stroke () : length(0.0f) {}
+
+    void computeLength()
+    {
+        length = 0;
+        for (size_t i = 1; i < vertices.size(); ++i)
+        {
+            length += (vertices[i-1] - vertices[i]).length();
+        }
+    }
+};
+
+//!
+//! Settings of the stroke tracer.
+//!
+struct StrokeTracerSettings
+{
+    StrokeTracerSettings () :
+        particleCount(10000),
+        lineCount(2000),
+        lineLength(40),
+        minStrokeLength(0.05),
+        minGradient(0.2),
+        strokeContourCurvature(0.85),
+        trackingStep(2.0),
+        lineAbstraction(0.005),
+        strokeMinDistance(0.005),
+        terminationRatio(0.5),
+        normalizeGradient(true),
+        sortByLength(true),
+        reuseSeeds(true),
+        randomSeed(0)
+    {}
+
+    unsigned int particleCount;     //!< number of random particles to trace
+    unsigned int lineCount;         //!< maximum number of accepted strokes
+    unsigned int lineLength;        //!< tracking iterations per direction
+    double minStrokeLength;         //!< min length of a traced stroke
+    double minGradient;             //!< min gradient magnitude to start a stroke, of the normalized gradient with normalizeGradient
+    double strokeContourCurvature;  //!< curvature measure
+    double trackingStep;            //!< tracking step in pixel
+    double lineAbstraction;         //!< min vertex distance of simplified strokes
+    double strokeMinDistance;       //!< min distance of a stroke start to other strokes
+    double terminationRatio;        //!< tracking ends below minGradient * terminationRatio
+    bool normalizeGradient;         //!< track along normalized gradient directions
+    bool sortByLength;              //!< sort accepted strokes by descending length
+    bool reuseSeeds;                //!< re-use the seeds of the previous frame
+    unsigned int randomSeed;        //!< base seed of the random streams
+};
+
+//!
+//! Parallel, temporally coherent stroke tracer.
+//!
+class StrokeTracer
+{
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the StrokeTracer class.
+    //!
+    StrokeTracer ();
+
+    //!
+    //! Destructor of the StrokeTracer class.
+    //!
+    ~StrokeTracer ();
+
+public: // functions
+
+    //!
+    //! Sets the gradient map to trace. The map holds four floats per pixel,
+    //! the gradient is stored in the first two channels. The data must stay
+    //! valid until trace() returns.
+    //!
+    //! \param data The gradient map data.
+    //! \param width The width of the gradient map.
+    //! \param height The height of the gradient map.
+    //!
+    void setGradientMap ( const float *data, unsigned int width, unsigned int height );
+
+    //!
+    //! Traces the strokes of the current gradient map.
+    //!
+    //! \param settings The tracer settings.
+    //!
+    void trace ( const StrokeTracerSettings &settings );
+
+    //!
+    //! Returns the strokes of the last trace() call.
+    //!
+    //! \return The accepted strokes.
+    //!
+    const std::vector<Stroke> & getStrokes () const;
+
+    //!
+    //! Drops the strokes and the seeds kept for the next frame.
+    //!
+    void reset ();
+
+    //!
+    //! Fills the given vector with uniformly distributed seeds in [0, 1]^2.
+    //! The seeds only depend on the count and the random seed.
+    //!
+    //! \param count The number of seeds to generate.
+    //! \param randomSeed The base seed of the random streams.
+    //! \param seeds The vector to fill.
+    //!
+    static void generateSeeds ( unsigned int count, unsigned int randomSeed, std::vector<Vector2d> &seeds );
+
+private: // functions
+
+    //!
+    //! Traces and simplifies a single candidate stroke.
+    //!
+    //! \param seed The particle position in gradient map space.
+    //! \param settings The tracer settings.
+    //! \param stroke The stroke to fill.
+    //! \return True if the stroke is a valid candidate.
+    //!
+    bool traceCandidate ( const Vector2d &seed, const StrokeTracerSettings &settings, Stroke &stroke ) const;
+
+    //!
+    //! Moves the seeds of the previous frame to the locally strongest gradient
+    //! and drops the seeds that no longer lie on an edge.
+    //!
+    //! \param settings The tracer settings.
+    //!
+    void advectSeeds ( const StrokeTracerSettings &settings );
+
+    //!
+    //! Returns whether a stroke may start at the given gradient. With
+    //! normalizeGradient, the normalized gradient is compared to minGradient,
+    //! so every non-zero gradient passes a threshold below 1.
+    //!
+    bool isStartGradient ( const Vector2d &gradient, const StrokeTracerSettings &settings ) const;
+
+    //!
+    //! Returns whether a stroke starting at e0 keeps the min distance to all
+    //! accepted strokes.
+    //!
+    bool isFree ( const Vector2d &e0 ) const;
+
+    //!
+    //! Adds the vertices of an accepted stroke to the density grid.
+    //!
+    void insertIntoGrid ( const Stroke &stroke );
+
+    //!
+    //! Returns the density grid cell of the given position.
+    //!
+    int getGridCell ( float x, float y ) const;
+
+    //!
+    //! Converts 2D texture position in 1D array index.
+    //!
+    unsigned int getGradientMapIndex ( const Vector2d &pos ) const;
+
+    //!
+    //! Returns value of gradient map at position pos.
+    //!
+    Vector2d getGradientMap ( const Vector2d &pos ) const;
+
+private: // data
+
+    //!
+    //! The gradient map.
+    //!
+    const float *m_gradientMap;
+    unsigned int m_width;
+    unsigned int m_height;
+
+    //!
+    //! The accepted strokes.
+    //!
+    std::vector<Stroke> m_strokes;
+
+    //!
+    //! Candidate strokes of the current batch, kept to re-use their memory.
+    //!
+    std::vector<Stroke> m_candidates;
+
+    //!
+    //! Validity flags of the candidate strokes.
+    //!
+    std::vector<char> m_candidateValid;
+
+    //!
+    //! Seeds of the accepted strokes of the previous frame.
+    //!
+    std::vector<Vector2d> m_seeds;
+
+    //!
+    //! Density grid over the accepted stroke vertices (cell heads, linked
+    //! vertex indices and vertex positions). Cells are at least as large as
+    //! the min stroke distance.
+    //!
+    int m_gridSize;
+    float m_gridCellSize;
+    float m_gridMinDistanceSq;
+    std::vector<int> m_gridHeads;
+    std::vector<int> m_gridNext;
+    std::vector<Vector2d> m_gridPoints;
+};
+
+#endif
@@ -34,31 +34,12 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #define LOOSEANDSKETCHYOFFLINENODE_H
 
 #include "RenderNode.h"
-//#include "ree/Stroke.h"
-#include "Vector2d.h"
+#include "StrokeTracer.h"
 #include <gl/gl.h>
 
 namespace LooseAndSketchyOfflineNode {
 	using namespace Frapper;
 
-class Stroke
-{
-public:
-    std::vector<Vector2d> vertices;
-    Vector2d e0;
-    float length;
-
-public:
-    void computeLength()
-    {
-        length = 0;
-        for (int i = 0; i < vertices.size()-1; ++i)
-        {
-            length += (vertices[i] - vertices[i+1]).length();
-        }
-    }
-};
-
 
 using namespace Frapper;
 
@@ -115,64 +96,17 @@ private: // Private Methods
     //!
     void computeLooseAndSketchyOffline();
 
-    //
-    // Add a new stroke.
-    //
-    // \param stroke The stroke which should be added.
-    //
-    void addStroke(Stroke& stroke);
-
     //!
     //! Render the stroke geometry.
     //!
     void renderLooseAndSketchyOffline();
 
-private: // Private Helper Methods
-
-    //!
-    //! Converts 2D texture position in 1D array index.
-    //!
-    //! \param Position which should be converted.
-    //! \return Index in gradient map array.
-    //!
-    unsigned int getGradientMapIndex(const Vector2d& pos);
-
-    //!
-    //! Returns value of gradient map at position pos.
-    //!
-    //! \param Position in gradient map.
-    //! \return Value of gradient map at position pos.
-    //!
-    Vector2d getGradientMap(const Vector2d& pos);
-
-    //float getGradientMapIntensity(const Vector2d& pos);
-    
-    //!
-    //! Returns a random double value.
-    //!
-    //! \return Value of gradient map at position pos.
-    //!
-    double getRandom();
-
-    //!
-    //! Returns whether length of stroke s0 is greater than the
-    //! length of s1.
-    //!
-    //! \return True if length(s0) > length(s1).
-    //!
-    static bool sortByLength(Stroke s0, Stroke s1);
-
 private: // Private Member Variables
 
     //!
-    //! Vector of strokes.
-    //!
-    std::vector<Stroke> m_strokes;
-    
-    //!
-    //! Gradient map array.
+    //! Parallel stroke tracer, keeps the stroke seeds across frames.
     //!
-    float *m_gradientMap;
+    StrokeTracer m_strokeTracer;
 
 };
 
@@ -26,30 +26,31 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //! \brief Implementation file for DualScatterMath class.
 //!
 //! \author     Simon Spielmann <sspielma@filmakademie.de>
-//! \version    1.0
-//! \date       07.02.2011 (last updated)
+//! \version    1.1
+//! \date       18.10.2026 (last updated)
 //!
 
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <stdlib.h>
+#include <algorithm>
 #include "DualScatterMath.h"
 
 #define INTEGRAL_PRECISION 512
 
-namespace HairRenderNode {
-
-DualScatterMath::DualScatterMath(const unsigned int tableSize /*= 128*/) :
-	m_tableSize(tableSize),
-	m_eta(1.55f),
-	m_sigma_a(2.f),
+DualScatterMath::DualScatterMath(const DualScatterFiber &fiber, const unsigned int tableSize /*= DualScatterTables::DefaultTableSize*/) :
+	m_eta(fiber.eta),
+	m_sigma_a(fiber.sigma_a),
 	m_a(0.89f),
-	m_alpha_R(GToR(-8.f)),
+	m_alpha_R(GToR(fiber.alpha_R)),
 	m_alpha_TT(-0.5f*m_alpha_R),
 	m_alpha_TRT(-1.5f*m_alpha_R),
-	m_beta_R(GToR(8.f)),
+	m_beta_R(GToR(fiber.beta_R)),
 	m_beta_TT(0.5f*m_beta_R),
 	m_beta_TRT(2.f*m_beta_R),
+	m_gamma_TT(GToR(fiber.gamma_TT)),
+	m_gamma_G(GToR(fiber.gamma_G)),
+	m_G(GToR(fiber.glintAngle)),
 	m_k_g(2.f),
 	m_w_c(GToR(15.f)),
 	m_dEta(0.3f),
@@ -60,24 +61,13 @@ DualScatterMath::DualScatterMath(const unsigned int tableSize /*= 128*/) :
 	m_I_R(1.f),
 	m_I_TT(1.f),
 	m_I_TRT(1.f),
-	m_I_G(1.f)
+	m_I_G(1.f),
+	m_tableSize(tableSize)
 {
-	m_A_b = (Ogre::ColourValue*) malloc(m_tableSize*sizeof(Ogre::ColourValue));
-	m_delta_b = (Ogre::ColourValue*) malloc(m_tableSize*sizeof(Ogre::ColourValue));
-	m_sigma_b = (Ogre::ColourValue*) malloc(m_tableSize*sizeof(Ogre::ColourValue));
-	m_N_gR = (float*) malloc(m_tableSize*sizeof(float));
-	m_N_gTT = (float*) malloc(m_tableSize*sizeof(float));
-	m_N_gTRT = (float*) malloc(m_tableSize*sizeof(float));
 }
 
 DualScatterMath::~DualScatterMath()
 {
-	free(m_A_b);
-	free(m_delta_b);
-	free(m_sigma_b);
-	free(m_N_gR);
-	free(m_N_gTT);
-	free(m_N_gTRT); 
 }
 
 unsigned int DualScatterMath::getTablesize() const
@@ -85,6 +75,29 @@ unsigned int DualScatterMath::getTablesize() const
 	return m_tableSize;
 }
 
+//!
+//! Fills all lookup tables for theta in [0, pi/2].
+//!
+//! \param tables The tables to fill, resized to the table size.
+//!
+void DualScatterMath::computeTables(DualScatterTables &tables)
+{
+	tables.tableSize = m_tableSize;
+	tables.A_b.resize(m_tableSize);
+	tables.delta_b.resize(m_tableSize);
+	tables.sigma_b.resize(m_tableSize);
+	tables.N_gR.resize(m_tableSize);
+	tables.N_gTT.resize(m_tableSize);
+	tables.N_gTRT.resize(m_tableSize);
+
+	fill_A_b(tables.A_b, 0.f, M_PI_2);
+	fill_delta_b(tables.delta_b, 0.f, M_PI_2);
+	fill_sigma_b(tables.sigma_b, 0.f, M_PI_2);
+	fillN_gR(tables.N_gR);
+	fillN_gTT(tables.N_gTT);
+	fillN_gTRT(tables.N_gTRT);
+}
+
 inline float DualScatterMath::GToR(const float grad)
 {
 	return grad/180.f*M_PI;
@@ -145,10 +158,9 @@ inline float DualScatterMath::N_TT(const float phi, const float gamma)
 
 inline float DualScatterMath::N_TRT(const float phi, const float gamma)
 {
-	// G = random angle between 30 und 45 in 0.1 steps
-	const float G = GToR(static_cast<float>(rand() % 150 + 300)/10.f);
-
-	return N_R(phi) + m_I_G*g(G - phi, gamma*gamma);
+	// G is the glint angle of the fiber (30 to 45 degrees); a fixed value keeps
+	// the tables deterministic and the integration thread safe
+	return N_R(phi) + m_I_G*g(m_G - phi, gamma*gamma);
 }
 
 // integrals
@@ -196,7 +208,7 @@ inline Ogre::ColourValue DualScatterMath::beta_fb(const float phi, const float f
 
 inline Ogre::ColourValue DualScatterMath::SX_f_s(const float theta, const float from, const float to)
 {
-	const float G = GToR(static_cast<float>(rand() % 150 + 300)/10.f);
+	const float G = m_G;
 
 	const float SN_R   =				S(&DualScatterMath::N_R,      from,        to, INTEGRAL_PRECISION, 0.f);
 	const float SN_TT  =				S(&DualScatterMath::g, M_PI - from, M_PI - to, INTEGRAL_PRECISION, m_gamma_TT*m_gamma_TT);
@@ -267,60 +279,53 @@ inline Ogre::ColourValue DualScatterMath::sigma_b(const float theta)
 	return Ogre::ColourValue();
 }
 
-float* DualScatterMath::fillN_gR()
+void DualScatterMath::fillN_gR(std::vector<float> &table)
 {
+	// the azimuthal integrals do not depend on theta, integrate once
 	const float n = 2.f/M_PI;
-	for (unsigned int i=0; i<m_tableSize; ++i)
-		m_N_gR[i] = S(&DualScatterMath::N_R, M_PI_2, M_PI, INTEGRAL_PRECISION, 0.f)*n;
-	return m_N_gR;
+	const float N_g = S(&DualScatterMath::N_R, M_PI_2, M_PI, INTEGRAL_PRECISION, 0.f)*n;
+	std::fill(table.begin(), table.end(), N_g);
 }
 
-float* DualScatterMath::fillN_gTT()
+void DualScatterMath::fillN_gTT(std::vector<float> &table)
 {
 	const float n = 2.f/M_PI;
 	const float gammaTTSquare = m_gamma_TT*m_gamma_TT;
-	for (unsigned int i=0; i<m_tableSize; ++i)
-		m_N_gTT[i] = S(&DualScatterMath::g, M_PI_2, 0.f, INTEGRAL_PRECISION, gammaTTSquare)*n;
-	return m_N_gTT;
+	const float N_g = S(&DualScatterMath::g, M_PI_2, 0.f, INTEGRAL_PRECISION, gammaTTSquare)*n;
+	std::fill(table.begin(), table.end(), N_g);
 }
 
-float* DualScatterMath::fillN_gTRT()
+void DualScatterMath::fillN_gTRT(std::vector<float> &table)
 {
 	const float n = 2.f/M_PI;
-	// investigate local G or const global G?
-	const float G = GToR(static_cast<float>(rand() % 150 + 300)/10.f);
-
 	const float gammaGSquare = m_gamma_G*m_gamma_G;
-	for (unsigned int i=0; i<m_tableSize; ++i)
-		m_N_gTRT[i] = S(&DualScatterMath::g, G - M_PI_2, G - M_PI, INTEGRAL_PRECISION, gammaGSquare)*n;
-	return m_N_gTT;
+	const float N_g = S(&DualScatterMath::g, m_G - M_PI_2, m_G - M_PI, INTEGRAL_PRECISION, gammaGSquare)*n;
+	std::fill(table.begin(), table.end(), N_g);
 }
 
-Ogre::ColourValue* DualScatterMath::fill_A_b(const float from, const float to)
+void DualScatterMath::fill_A_b(std::vector<Ogre::ColourValue> &table, const float from, const float to)
 {
-	float theta = 0.f;
 	const float stepsize = (to - from)/m_tableSize;
-	for (unsigned int i=0; i<m_tableSize; ++i, theta+=stepsize)
-		m_A_b[i] = A_b(theta);
-	return m_A_b;
+	const int tableSize = static_cast<int>(m_tableSize);
+	#pragma omp parallel for schedule(dynamic)
+	for (int i=0; i<tableSize; ++i)
+		table[i] = A_b(from + i*stepsize);
 }
 
-Ogre::ColourValue* DualScatterMath::fill_delta_b(const float from, const float to)
+void DualScatterMath::fill_delta_b(std::vector<Ogre::ColourValue> &table, const float from, const float to)
 {
-	float theta = 0.f;
 	const float stepsize = (to - from)/m_tableSize;
-	for (unsigned int i=0; i<m_tableSize; ++i, theta+=stepsize)
-		m_delta_b[i] = delta_b(theta);
-	return m_delta_b;
+	const int tableSize = static_cast<int>(m_tableSize);
+	#pragma omp parallel for schedule(dynamic)
+	for (int i=0; i<tableSize; ++i)
+		table[i] = delta_b(from + i*stepsize);
 }
 
-Ogre::ColourValue* DualScatterMath::fill_sigma_b(const float from, const float to)
+void DualScatterMath::fill_sigma_b(std::vector<Ogre::ColourValue> &table, const float from, const float to)
 {
-	float theta = 0.f;
 	const float stepsize = (to - from)/m_tableSize;
-	for (unsigned int i=0; i<m_tableSize; ++i, theta+=stepsize)
-		m_sigma_b[i] = sigma_b(theta);
-	return m_sigma_b;
+	const int tableSize = static_cast<int>(m_tableSize);
+	#pragma omp parallel for schedule(dynamic)
+	for (int i=0; i<tableSize; ++i)
+		table[i] = sigma_b(from + i*stepsize);
 }
-
-} // namespace HairRenderNode 
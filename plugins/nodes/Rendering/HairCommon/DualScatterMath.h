@@ -25,31 +25,43 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //! \file "DualScatterMath.h"
 //! \brief Header file for DualScatterMath class.
 //!
+//! The lookup tables only depend on the fiber parameters and the table
+//! size. They are filled in parallel (OpenMP) and are not meant to be used
+//! directly by the render nodes, which obtain them through the shared
+//! DualScatterTables cache.
+//!
 //! \author     Simon Spielmann <sspielma@filmakademie.de>
-//! \version    1.0
-//! \date       07.02.2011 (last updated)
+//! \version    1.1
+//! \date       18.10.2026 (last updated)
 //!
 
 #ifndef DUALSCATTERMATH_H
 #define DUALSCATTERMATH_H
 
+#include "DualScatterTables.h"
+
 // OGRE
 #include <Ogre.h>
 #if (OGRE_PLATFORM  == OGRE_PLATFORM_WIN32)
 #include <windows.h>
 #endif
 
-namespace HairRenderNode {
-
 class DualScatterMath
 {
 public:
-	DualScatterMath(const unsigned int tableSize = 128);
+	DualScatterMath(const DualScatterFiber &fiber, const unsigned int tableSize = DualScatterTables::DefaultTableSize);
 	~DualScatterMath();
 
 public:
 	unsigned int getTablesize() const;
 
+	//!
+	//! Fills all lookup tables for theta in [0, pi/2].
+	//!
+	//! \param tables The tables to fill, resized to the table size.
+	//!
+	void computeTables(DualScatterTables &tables);
+
 private:
 	typedef float (DualScatterMath::*funcPtr) (float, float);
 
@@ -84,7 +96,7 @@ private:
 
 	inline Ogre::ColourValue f_TRT(const float theta, const float I, const float phi, Ogre::ColourValue &colour);
 
-	inline Ogre::ColourValue DualScatterMath::f_s(const float theta, const float phi, const float I_R, const float I_TT, const float I_TRT, const float I_G, Ogre::ColourValue &colour_R, Ogre::ColourValue &colour_TT, Ogre::ColourValue &colour_TRT);
+	inline Ogre::ColourValue f_s(const float theta, const float phi, const float I_R, const float I_TT, const float I_TRT, const float I_G, Ogre::ColourValue &colour_R, Ogre::ColourValue &colour_TT, Ogre::ColourValue &colour_TRT);
 
 	inline Ogre::ColourValue alpha_fb(const float phi, const float from, const float to);
 
@@ -100,13 +112,13 @@ private:
 
 	inline Ogre::ColourValue sigma_b(const float theta);
 
-	float* fillN_gR();
-	float* fillN_gTT();
-	float* fillN_gTRT();
+	void fillN_gR(std::vector<float> &table);
+	void fillN_gTT(std::vector<float> &table);
+	void fillN_gTRT(std::vector<float> &table);
 
-	Ogre::ColourValue* fill_A_b(const float from, const float to);
-	Ogre::ColourValue* fill_delta_b(const float from, const float to);
-	Ogre::ColourValue* fill_sigma_b(const float from, const float to);
+	void fill_A_b(std::vector<Ogre::ColourValue> &table, const float from, const float to);
+	void fill_delta_b(std::vector<Ogre::ColourValue> &table, const float from, const float to);
+	void fill_sigma_b(std::vector<Ogre::ColourValue> &table, const float from, const float to);
 
 private:
 	// hair fibre
@@ -132,6 +144,7 @@ private:
 	float m_beta_TRT;
 	float m_gamma_TT;
 	float m_gamma_G;
+	float m_G;
 
 	// highlights
 	float m_k_g;
@@ -139,16 +152,7 @@ private:
 	float m_dEta;
 	float m_dh_M;
 
-
-	Ogre::ColourValue *m_A_b;
-	Ogre::ColourValue *m_delta_b;
-	Ogre::ColourValue *m_sigma_b;
-	float *m_N_gR;
-	float *m_N_gTT;
-	float *m_N_gTRT;
 	unsigned int m_tableSize;
 };
 
-} // namespace HairRenderNode 
-
 #endif
@@ -0,0 +1,252 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation 
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "DualScatterTables.cpp"
+//! \brief Implementation file for the DualScatterTables class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "DualScatterTables.h"
+#include "DualScatterMath.h"
+#include "Log.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+using namespace Frapper;
+
+namespace {
+
+//!
+//! Identifies dual scattering cache files. Increase the version whenever the
+//! table layout or the table math changes.
+//!
+const quint32 CacheMagic = 0x44535442; // "DSTB"
+const quint32 CacheVersion = 1;
+
+//!
+//! Serializes the table computation of all nodes of the process.
+//!
+QMutex s_tableMutex;
+
+void writeFiber ( QDataStream &stream, const DualScatterFiber &fiber )
+{
+	stream << fiber.eta << fiber.sigma_a << fiber.alpha_R << fiber.beta_R
+		<< fiber.gamma_TT << fiber.gamma_G << fiber.glintAngle;
+}
+
+} // namespace
+
+const QString DualScatterTables::TextureUnitName = "dualScatterTables";
+
+
+QString DualScatterTables::getKey ( const DualScatterFiber &fiber, unsigned int tableSize )
+{
+	QByteArray data;
+	QDataStream stream(&data, QIODevice::WriteOnly);
+	stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+	stream << CacheVersion << tableSize;
+	writeFiber(stream, fiber);
+	return QString(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+}
+
+
+Ogre::TexturePtr DualScatterTables::acquireTexture ( const DualScatterFiber &fiber, unsigned int tableSize )
+{
+	if (tableSize == 0)
+		tableSize = DefaultTableSize;
+
+	QMutexLocker locker (&s_tableMutex);
+
+	const QString key = getKey(fiber, tableSize);
+	const Ogre::String textureName = QString("DualScatterTables/%1").arg(key).toStdString();
+
+	Ogre::TextureManager &textureManager = Ogre::TextureManager::getSingleton();
+	if (textureManager.resourceExists(textureName))
+		return Ogre::TexturePtr(textureManager.getByName(textureName));
+
+	DualScatterTables tables;
+	const QString filename = getCacheFilename(key);
+	if (!tables.load(filename, fiber, tableSize)) {
+		DualScatterMath math (fiber, tableSize);
+		math.computeTables(tables);
+		if (!tables.save(filename, fiber))
+			Log::warning(QString("Could not write dual scattering cache file %1.").arg(filename), "DualScatterTables::acquireTexture");
+	}
+
+	Ogre::TexturePtr texture;
+	try {
+		texture = textureManager.createManual(textureName,
+			Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+			Ogre::TEX_TYPE_2D, tableSize, 4, 0, Ogre::PF_FLOAT32_RGBA, Ogre::TU_STATIC_WRITE_ONLY);
+	}
+	catch (Ogre::Exception &e) {
+		Log::error(QString("Could not create dual scattering table texture: %1").arg(e.getFullDescription().c_str()), "DualScatterTables::acquireTexture");
+		return Ogre::TexturePtr();
+	}
+
+	std::vector<float> pixels (tableSize * 4 * 4);
+	for (unsigned int i = 0; i < tableSize; ++i) {
+		float *a = &pixels[(0 * tableSize + i) * 4];
+		float *d = &pixels[(1 * tableSize + i) * 4];
+		float *s = &pixels[(2 * tableSize + i) * 4];
+		float *n = &pixels[(3 * tableSize + i) * 4];
+		a[0] = tables.A_b[i].r;     a[1] = tables.A_b[i].g;     a[2] = tables.A_b[i].b;     a[3] = 1.f;
+		d[0] = tables.delta_b[i].r; d[1] = tables.delta_b[i].g; d[2] = tables.delta_b[i].b; d[3] = 1.f;
+		s[0] = tables.sigma_b[i].r; s[1] = tables.sigma_b[i].g; s[2] = tables.sigma_b[i].b; s[3] = 1.f;
+		n[0] = tables.N_gR[i];      n[1] = tables.N_gTT[i];     n[2] = tables.N_gTRT[i];    n[3] = 1.f;
+	}
+	const Ogre::PixelBox pixelBox (tableSize, 4, 1, Ogre::PF_FLOAT32_RGBA, &pixels[0]);
+	texture->getBuffer()->blitFromMemory(pixelBox);
+
+	return texture;
+}
+
+
+bool DualScatterTables::bindToMaterial ( const QString &materialName, const DualScatterFiber &fiber, unsigned int tableSize )
+{
+	Ogre::MaterialPtr material = Ogre::MaterialPtr(Ogre::MaterialManager::getSingleton().getByName(materialName.toStdString()));
+	if (material.isNull())
+		return false;
+
+	// collect the texture units first, so materials without one cost nothing
+	std::vector<Ogre::TextureUnitState *> textureUnits;
+	const Ogre::String textureUnitName = TextureUnitName.toStdString();
+	Ogre::Material::TechniqueIterator techniqueIter = material->getTechniqueIterator();
+	while (techniqueIter.hasMoreElements()) {
+		Ogre::Technique::PassIterator passIter = techniqueIter.getNext()->getPassIterator();
+		while (passIter.hasMoreElements()) {
+			Ogre::TextureUnitState *textureUnit = passIter.getNext()->getTextureUnitState(textureUnitName);
+			if (textureUnit)
+				textureUnits.push_back(textureUnit);
+		}
+	}
+	if (textureUnits.empty())
+		return false;
+
+	Ogre::TexturePtr texture = acquireTexture(fiber, tableSize);
+	if (texture.isNull())
+		return false;
+
+	for (size_t i = 0; i < textureUnits.size(); ++i) {
+		textureUnits[i]->setTextureName(texture->getName());
+		textureUnits[i]->setTextureFiltering(Ogre::TFO_BILINEAR);
+		textureUnits[i]->setTextureAddressingMode(Ogre::TextureUnitState::TAM_CLAMP);
+	}
+	return true;
+}
+
+
+QString DualScatterTables::getCacheFilename ( const QString &key )
+{
+	return QDir::tempPath() + "/frapper/dualscatter/" + key + ".dst";
+}
+
+
+bool DualScatterTables::load ( const QString &filename, const DualScatterFiber &fiber, unsigned int size )
+{
+	QFile file (filename);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream (&file);
+	stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+	quint32 magic, version, storedSize;
+	stream >> magic >> version >> storedSize;
+	if (magic != CacheMagic || version != CacheVersion || storedSize != size)
+		return false;
+
+	// the key is only a hash, compare the stored parameters as well
+	QByteArray expected, stored;
+	QDataStream expectedStream (&expected, QIODevice::WriteOnly);
+	expectedStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+	writeFiber(expectedStream, fiber);
+	stored.resize(expected.size());
+	if (stream.readRawData(stored.data(), stored.size()) != stored.size() || stored != expected)
+		return false;
+
+	tableSize = size;
+	A_b.resize(size);
+	delta_b.resize(size);
+	sigma_b.resize(size);
+	N_gR.resize(size);
+	N_gTT.resize(size);
+	N_gTRT.resize(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		stream >> A_b[i].r >> A_b[i].g >> A_b[i].b;
+		stream >> delta_b[i].r >> delta_b[i].g >> delta_b[i].b;
+		stream >> sigma_b[i].r >> sigma_b[i].g >> sigma_b[i].b;
+		stream >> N_gR[i] >> N_gTT[i] >> N_gTRT[i];
+	}
+
+	return stream.status() == QDataStream::Ok;
+}
+
+
+bool DualScatterTables::save ( const QString &filename, const DualScatterFiber &fiber ) const
+{
+	if (!QDir().mkpath(QFileInfo(filename).absolutePath()))
+		return false;
+
+	// write to a temporary file and rename it, so concurrent readers never
+	// see a partially written cache file
+	const QString tempFilename = QString("%1.%2.tmp").arg(filename).arg(QCoreApplication::applicationPid());
+	QFile file (tempFilename);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream stream (&file);
+	stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+	stream << CacheMagic << CacheVersion << quint32(tableSize);
+	writeFiber(stream, fiber);
+	for (unsigned int i = 0; i < tableSize; ++i) {
+		stream << A_b[i].r << A_b[i].g << A_b[i].b;
+		stream << delta_b[i].r << delta_b[i].g << delta_b[i].b;
+		stream << sigma_b[i].r << sigma_b[i].g << sigma_b[i].b;
+		stream << N_gR[i] << N_gTT[i] << N_gTRT[i];
+	}
+	file.close();
+
+	if (stream.status() != QDataStream::Ok || file.error() != QFile::NoError) {
+		QFile::remove(tempFilename);
+		return false;
+	}
+
+	QFile::remove(filename);
+	if (!QFile::rename(tempFilename, filename)) {
+		QFile::remove(tempFilename);
+		// another process may have written the same tables in the meantime
+		return QFile::exists(filename);
+	}
+	return true;
+}
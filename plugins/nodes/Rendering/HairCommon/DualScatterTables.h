@@ -0,0 +1,156 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation 
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "DualScatterTables.h"
+//! \brief Header file for the DualScatterTables class.
+//!
+//! The dual scattering lookup tables are shared by the HairRender,
+//! HairRenderAlpha and HairSingleScatterRender nodes. Tables are looked up by
+//! a key over the fiber parameters, first in the Ogre texture manager (which
+//! is shared by all plugins of the process), then in a disk cache in the temp
+//! directory, and only computed if neither holds them.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef DUALSCATTERTABLES_H
+#define DUALSCATTERTABLES_H
+
+#include <QtCore/QString>
+#include <vector>
+
+// OGRE
+#include <Ogre.h>
+#if (OGRE_PLATFORM  == OGRE_PLATFORM_WIN32)
+#include <windows.h>
+#endif
+
+//!
+//! Fiber parameters the dual scattering tables depend on. Angles in degrees.
+//!
+struct DualScatterFiber
+{
+	DualScatterFiber () :
+		eta(1.55f),
+		sigma_a(2.f),
+		alpha_R(-8.f),
+		beta_R(8.f),
+		gamma_TT(5.f),
+		gamma_G(15.f),
+		glintAngle(37.5f)
+	{}
+
+	float eta;          //!< index of refraction
+	float sigma_a;      //!< absorption coefficient
+	float alpha_R;      //!< longitudinal shift of the R lobe
+	float beta_R;       //!< longitudinal width of the R lobe
+	float gamma_TT;     //!< azimuthal width of the TT lobe
+	float gamma_G;      //!< azimuthal width of the glints
+	float glintAngle;   //!< azimuthal position of the glints
+};
+
+//!
+//! Dual scattering lookup tables over theta in [0, pi/2].
+//!
+class DualScatterTables
+{
+
+public: // constants
+
+	//!
+	//! The default number of table entries.
+	//!
+	static const unsigned int DefaultTableSize = 512;
+
+	//!
+	//! The name of the texture unit the tables are bound to.
+	//!
+	static const QString TextureUnitName;
+
+public: // functions
+
+	//!
+	//! Returns the cache key of the given fiber parameters and table size.
+	//!
+	static QString getKey ( const DualScatterFiber &fiber, unsigned int tableSize );
+
+	//!
+	//! Returns the texture holding the tables of the given fiber. The texture
+	//! is PF_FLOAT32_RGBA, tableSize wide and four rows high (A_b, delta_b,
+	//! sigma_b and N_gR/N_gTT/N_gTRT).
+	//!
+	//! \param fiber The fiber parameters.
+	//! \param tableSize The number of table entries.
+	//! \return The texture or a null pointer if it could not be created.
+	//!
+	static Ogre::TexturePtr acquireTexture ( const DualScatterFiber &fiber, unsigned int tableSize );
+
+	//!
+	//! Binds the tables of the given fiber to all texture units named
+	//! TextureUnitName of the given material. Materials without such a unit
+	//! are left untouched and no tables are computed for them.
+	//! Materials are shared between node instances, so nodes with their own
+	//! fiber parameters should bind to a per-node clone of their material.
+	//!
+	//! \param materialName The name of the material.
+	//! \param fiber The fiber parameters.
+	//! \param tableSize The number of table entries.
+	//! \return True if a texture unit was bound.
+	//!
+	static bool bindToMaterial ( const QString &materialName, const DualScatterFiber &fiber, unsigned int tableSize );
+
+public: // data
+
+	unsigned int tableSize;
+	std::vector<Ogre::ColourValue> A_b;
+	std::vector<Ogre::ColourValue> delta_b;
+	std::vector<Ogre::ColourValue> sigma_b;
+	std::vector<float> N_gR;
+	std::vector<float> N_gTT;
+	std::vector<float> N_gTRT;
+
+private: // functions
+
+	//!
+	//! Returns the path of the disk cache file of the given key.
+	//!
+	static QString getCacheFilename ( const QString &key );
+
+	//!
+	//! Reads the tables from the disk cache.
+	//!
+	//! \return True if a valid cache file for the fiber was found.
+	//!
+	bool load ( const QString &filename, const DualScatterFiber &fiber, unsigned int size );
+
+	//!
+	//! Writes the tables to the disk cache.
+	//!
+	//! \return True if the cache file was written.
+	//!
+	bool save ( const QString &filename, const DualScatterFiber &fiber ) const;
+};
+
+#endif
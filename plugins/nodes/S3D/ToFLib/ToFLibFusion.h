@@ -0,0 +1,95 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2014 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ToFLibFusion.h"
+//! \brief Header file for the fusion settings of the ToFLibNode class.
+//!
+//! The settings and the result copy do not depend on toflib, so they can
+//! be used without the fusion algorithms.
+//!
+//! \version	1.0
+//! \date		19.10.2026 (created)
+//!
+
+#ifndef ToFLibFUSION_H
+#define ToFLibFUSION_H
+
+#include <Ogre.h>
+#include <QtCore/QVariant>
+
+namespace ToFLibNode {
+
+//!
+//! The settings a fusion algorithm was created with.
+//!
+struct FusionSettings
+{
+	FusionSettings () : algorithmIndex(-1), fov(0.0f), baselineLeftToF(0.0f), baselineLeftRight(0.0f)
+	{
+		for (int i = 0; i < 6; ++i)
+			shape[i] = 0;
+	}
+
+	bool operator== ( const FusionSettings &other ) const
+	{
+		for (int i = 0; i < 6; ++i)
+			if (shape[i] != other.shape[i])
+				return false;
+
+		return algorithmIndex == other.algorithmIndex &&
+			fov == other.fov &&
+			baselineLeftToF == other.baselineLeftToF &&
+			baselineLeftRight == other.baselineLeftRight &&
+			optionValues == other.optionValues;
+	}
+
+	int algorithmIndex;
+	int shape[6]; // width and height of the left, right and ToF input
+	float fov, baselineLeftToF, baselineLeftRight;
+	QVariantList optionValues;
+};
+
+//!
+//! Copies the depth channel of a fusion result into the given locked
+//! PF_FLOAT32_R pixel box, respecting its row pitch.
+//!
+//! \param depth The depth values, one row after another.
+//! \param width The width of the result.
+//! \param height The height of the result.
+//! \param pixelBox The locked pixel box of the output texture.
+//!
+inline void copyDepthToPixelBox ( const float *depth, int width, int height, const Ogre::PixelBox &pixelBox )
+{
+	float* dst = (float*) pixelBox.data;
+
+	for( int y=0; y<height; ++y, depth += width, dst += pixelBox.rowPitch )
+	{
+		for( int x=0; x<width; ++x )
+			dst[x] = (depth[x] / 7.0f); // normalize, should not be done here, uses memcpy instead!
+	}
+}
+
+} // namespace ToFLibNode
+
+#endif
@@ -33,6 +33,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include <oxofyuzit.hxx>
 #include "ToFLibNode.h"
+#include "ToFLibFusion.h"
 
 #define WITH_OCV 1
 
@@ -45,6 +46,55 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 namespace ToFLibNode {
 using namespace Frapper;
 
+//!
+//! The names of the option groups, in the order of the algorithm enumeration.
+//!
+static const char *OptionsGroupNames[] = {
+	"Just Reproject Options",
+	"Block Matching Options",
+	"Full Model Options",
+	"TV Fusion Options"
+};
+
+//!
+//! The fusion algorithm, its options and the working buffers of a node.
+//!
+struct FusionContext
+{
+	FusionContext () : algorithm(0) {}
+	~FusionContext () { delete algorithm; }
+
+	oxo::OptionsBase* getOptions ( int algorithmIndex )
+	{
+		switch (algorithmIndex) {
+			case 0: return &justReprojectOptions.base;
+			case 1: return &blockMatchingOptions.base;
+			case 2: return &fullModelOptions.base;
+			case 3: return &tvFusionOptions.base;
+		}
+		return 0;
+	}
+
+	// the current algorithm and the settings used to create it
+	oxo::FusionAlgorithm<>* algorithm;
+	FusionSettings algorithmSettings;
+	FusionSettings settings;
+
+	// the option state of the algorithms
+	oxo::JustReproject<>::OptionsT justReprojectOptions;
+	oxo::BlockMatchingFusion<>::OptionsT blockMatchingOptions;
+	oxo::FullModel<>::OptionsT fullModelOptions;
+	oxo::TVFusion<>::OptionsT tvFusionOptions;
+
+	// the calibration of the input images
+	oxo::FusionCalibrationData calibData;
+
+	// working buffers of the input images and the result
+	std::vector<unsigned char> left, right;
+	std::vector<float> tof;
+	vigra::MultiArray<3, float> output;
+};
+
 ///
 /// Public Constructors
 ///
@@ -56,7 +106,8 @@ using namespace Frapper;
 //!
 ToFLibNode::ToFLibNode ( QString name, ParameterGroup *parameterRoot) :
 	ImageNode(name, parameterRoot),
-	m_tofRenderer(NULL)
+	m_tofRenderer(NULL),
+	m_fusionContext(new FusionContext())
 {
 	
 	addAffection("Input Map Left",  m_outputImageName);
@@ -80,6 +131,7 @@ ToFLibNode::ToFLibNode ( QString name, ParameterGroup *parameterRoot) :
 ToFLibNode::~ToFLibNode ()
 {
 	//delete m_tofRenderer;
+	delete m_fusionContext;
 }
 
 ///
@@ -109,110 +161,57 @@ void ToFLibNode::processOutputImage()
 
 	Frapper::Log::debug("Loading Data...", "ToFLibNode::processOutputImage");
 
-	Ogre::Image inputL;
-	Ogre::Image inputR;
-	Ogre::Image inputT;
-
-	createImageFromTexture(inputMapL, inputL, Ogre::PF_R8G8B8 ); // conversion required -> slow!!
-	createImageFromTexture(inputMapT, inputT, Ogre::PF_FLOAT32_RGB ); // But toflib can't handle 4 chan data
+	FusionContext &context = *m_fusionContext;
 
+	// download the inputs into the reused buffers of the context,
+	// toflib expects 3 channel data
+	copyTextureToBuffer(inputMapL, Ogre::PF_R8G8B8, context.left );
+	copyTextureToBuffer(inputMapT, Ogre::PF_FLOAT32_RGB, context.tof );
 	if( useRight )	{
-		createImageFromTexture(inputMapR, inputR, Ogre::PF_R8G8B8 ); // you want PF_A8R8G8B8 or PF_X8R8G8B8
+		copyTextureToBuffer(inputMapR, Ogre::PF_R8G8B8, context.right );
+	}
+
+	// collect the settings the algorithm depends on
+	FusionSettings &settings = context.settings;
+	settings.algorithmIndex = getEnumerationParameter("ToF Sensor Fusion > Algorithm")->getCurrentIndex();
+	if( settings.algorithmIndex < 0 || settings.algorithmIndex > 3 ) {
+		Frapper::Log::error("Invalid Fusion Algorithm", "ToFLibNode::processOutputImage");
+		return;
 	}
+	settings.shape[0] = (int) inputMapL->getWidth();
+	settings.shape[1] = (int) inputMapL->getHeight();
+	settings.shape[2] = useRight ? (int) inputMapR->getWidth() : 0;
+	settings.shape[3] = useRight ? (int) inputMapR->getHeight() : 0;
+	settings.shape[4] = (int) inputMapT->getWidth();
+	settings.shape[5] = (int) inputMapT->getHeight();
+	settings.fov = getFloatValue("Input Image Options > FOV");
+	settings.baselineLeftToF = getFloatValue("Input Image Options > Baseline Left-ToF");
+	settings.baselineLeftRight = getFloatValue("Input Image Options > Baseline Left-Right");
+	settings.optionValues = getOptionValues(OptionsGroupNames[settings.algorithmIndex]);
+
+	QString algoName = getEnumerationParameter("ToF Sensor Fusion > Algorithm")->getCurrentLiteral();
 
 	// store current (Ogre) context to restore later on
 	HGLRC ogreOglContext = wglGetCurrentContext();
 	HDC   ogreDC = wglGetCurrentDC();
 
-	// ref to data from algorithm
-	int width = 0, height = 0;
-	vigra::MultiArray<3, float> output;
-	
 	// create pipe from std::cout to frapper log
 	StreamBuffer sb;
 	std::streambuf* old_buf = std::cout.rdbuf();
 
 	try{
 
-		Frapper::Log::debug("Initializing Algorithm...", "ToFLibNode::processOutputImage");
-
-		float fov = getFloatValue("Input Image Options > FOV");
-
-		oxo::FusionCalibrationData calib_data;
-		calib_data.left.setShape(	3,	inputMapL->getWidth(),	inputMapL->getHeight()).setFOV(fov);
-		if( useRight )
-			calib_data.right.setShape(	3,	inputMapR->getWidth(),	inputMapR->getHeight()).setFOV(fov);
-		else
-			calib_data.right.setShape(	3, 0, 0).setFOV(fov);
-		calib_data.tof.setShape(	3,	inputMapT->getWidth(),	inputMapT->getHeight()).setFOV(fov);
-
-		float baseline_lt = getFloatValue("Input Image Options > Baseline Left-ToF");
-		float baseline_lr = getFloatValue("Input Image Options > Baseline Left-Right");
-
-		calib_data.left_tof.setBaseline( baseline_lt );
-		calib_data.left_right.setBaseline( baseline_lr );
-
-		int algoIndex = getEnumerationParameter("ToF Sensor Fusion > Algorithm")->getCurrentIndex();
-		QString algoName = getEnumerationParameter("ToF Sensor Fusion > Algorithm")->getCurrentLiteral();
-
 		std::cout.rdbuf(&sb);
 
-		// select algorithm
-		oxo::FusionAlgorithm<>* algorithm = 0;
-		if( algoIndex == 0) { // Just Reproject
-
-			oxo::JustReproject<>::OptionsT opts;
-			setOptionsFromParameter("Just Reproject Options", &(opts.base) );
-			std::stringstream sout; 
-			sout << opts.depth_cutoff();
-			Frapper::Log::info(QString::fromStdString(sout.str()));
-			opts.set_init_in_constructor(true);
-			algorithm = new oxo::JustReproject<>( calib_data, opts);
-		
-		} else if( algoIndex == 1) { // Block Matching
-
-			if( !useRight ){
-				throw std::exception( QString("Block Matching Algorithm requires Stereo Images!").toStdString().c_str() );
-			}
-
-			oxo::BlockMatchingFusion<>::OptionsT opts;
-			setOptionsFromParameter("Block Matching Options", &(opts.base) );
-			algorithm = new oxo::BlockMatchingFusion<>( calib_data, opts);
-
-		} else if( algoIndex == 2) { // Full Model
-
-			if( !useRight ){
-				throw std::exception( QString("Full Model Algorithm requires Stereo Images!").toStdString().c_str() );
-			}
-
-			oxo::FullModel<>::OptionsT opts;
-			setOptionsFromParameter("Full Model Options", &(opts.base));
-			algorithm = new oxo::FullModel<>( calib_data, opts);
-			//throw std::exception( QString("Full Model Algorithm not implemented!").toStdString().c_str() );
-
-		} else if( algoIndex == 3) { // TV Fusion
-
-				if( !useRight ){
-					throw std::exception( QString("TV Fusion Algorithm requires Stereo Images!").toStdString().c_str() );
-				}
-				oxo::TVFusion<>::OptionsT opts;
-				setOptionsFromParameter("TV Fusion Options", &(opts.base));
-				algorithm = new oxo::TVFusion<>( calib_data, opts);
-		}
-
-		width  = algorithm->getOutputShape()[1];
-		height = algorithm->getOutputShape()[2];
-		output = vigra::MultiArray<3, float>( vigra::TinyVectorView<int, 3>(algorithm->getOutputShape()));
+		updateAlgorithm(useRight);
 
-		const unsigned char* leftdata  = (const unsigned char*) inputL.getPixelBox().data;
-		const unsigned char* rightdata = useRight ? (const unsigned char*) inputR.getPixelBox().data : 0;
-		float* tofdata = (float*) inputT.getPixelBox().data;
+		const unsigned char* leftdata  = &context.left[0];
+		const unsigned char* rightdata = useRight ? &context.right[0] : 0;
+		float* tofdata = &context.tof[0];
 
 		// fire computation
 		Frapper::Log::debug("Executing "+algoName+"...", "ToFLibNode::processOutputImage");
-		algorithm->compute(leftdata, rightdata, tofdata, output.data());
-
-		delete algorithm;
+		context.algorithm->compute(leftdata, rightdata, tofdata, context.output.data());
 
 	} catch (std::exception e) {
 
@@ -220,6 +219,10 @@ void ToFLibNode::processOutputImage()
 
 		Frapper::Log::error( e.what(), "ToFLibNode::processOutputImage" );
 
+		// the algorithm is re-created on the next update
+		delete context.algorithm;
+		context.algorithm = 0;
+
 		// restore Ogre context
 		wglMakeCurrent( ogreDC, ogreOglContext);
 
@@ -235,43 +238,137 @@ void ToFLibNode::processOutputImage()
 	// restore Ogre context
 	wglMakeCurrent( ogreDC, ogreOglContext);
 
-	// create output image texture
+	const int width  = context.algorithm->getOutputShape()[1];
+	const int height = context.algorithm->getOutputShape()[2];
+
+	// re-use the output texture unless its size changed
 	Ogre::TexturePtr outputTexture = getTextureValue(m_outputImageName);
-	if (!outputTexture.isNull()) {
+	if (!outputTexture.isNull() &&
+		((int) outputTexture->getWidth() != width || (int) outputTexture->getHeight() != height || outputTexture->getFormat() != Ogre::PF_FLOAT32_R)) {
 		Ogre::TextureManager::getSingletonPtr()->remove(outputTexture->getHandle());
 		outputTexture.setNull();
 	}
 
-	Ogre::String textureName = QString("%1OutputTexture").arg(m_name).toStdString();
-	outputTexture = 
-		Ogre::TextureManager::getSingletonPtr()->createManual( textureName, 
-		Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, 
-		Ogre::TEX_TYPE_2D, width, height, 1, Ogre::PF_FLOAT32_R, Ogre::TU_DEFAULT);
-
-	OgreTools::HardwareBufferLocker hbl( outputTexture->getBuffer(0,0));
-	
-	// mem size in bytes
-	size_t memorySize = Ogre::PixelUtil::getMemorySize( width, height, 1, Ogre::PF_FLOAT32_R );
+	if (outputTexture.isNull()) {
+		Ogre::String textureName = QString("%1OutputTexture").arg(m_name).toStdString();
+		outputTexture = 
+			Ogre::TextureManager::getSingletonPtr()->createManual( textureName, 
+			Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, 
+			Ogre::TEX_TYPE_2D, width, height, 1, Ogre::PF_FLOAT32_R, Ogre::TU_DYNAMIC_WRITE_ONLY);
+	}
 
-	const Ogre::PixelBox pb = hbl.getCurrentLock();
-	
-	// copy result
-	vigra::MultiArray<2, float> result = output.bindInner(0);
-	float* src = result.data();
-	float* dst = ((float*)pb.data);
-	
-	size_t memSizeFloat = memorySize / sizeof(float);
-	for( int i=0; i<memSizeFloat; i++) 
 	{
-		dst[i] = (src[i] / 7.0f); // normalize, should not be done here, uses memcpy instead!
+		OgreTools::HardwareBufferLocker hbl( outputTexture->getBuffer(0,0));
+		const Ogre::PixelBox &pb = hbl.getCurrentLock();
+
+		// copy result, the first channel of the output holds the depth
+		vigra::MultiArray<2, float> result = context.output.bindInner(0);
+		copyDepthToPixelBox(result.data(), width, height, pb);
 	}
-	//memcpy( dst, src, memorySize);
 
 	setOutputImage(outputTexture);
 
 	emit viewNodeUpdated();
 }
 
+void ToFLibNode::updateAlgorithm( bool useRight )
+{
+	FusionContext &context = *m_fusionContext;
+	const FusionSettings &settings = context.settings;
+
+	if( context.algorithm && context.algorithmSettings == settings )
+		return;
+
+	delete context.algorithm;
+	context.algorithm = 0;
+
+	Frapper::Log::debug("Initializing Algorithm...", "ToFLibNode::updateAlgorithm");
+
+	oxo::FusionCalibrationData &calib_data = context.calibData;
+	calib_data.left.setShape(	3,	settings.shape[0],	settings.shape[1]).setFOV(settings.fov);
+	calib_data.right.setShape(	3,	settings.shape[2],	settings.shape[3]).setFOV(settings.fov);
+	calib_data.tof.setShape(	3,	settings.shape[4],	settings.shape[5]).setFOV(settings.fov);
+
+	calib_data.left_tof.setBaseline( settings.baselineLeftToF );
+	calib_data.left_right.setBaseline( settings.baselineLeftRight );
+
+	const int algoIndex = settings.algorithmIndex;
+	setOptionsFromParameter(OptionsGroupNames[algoIndex], context.getOptions(algoIndex));
+
+	// select algorithm
+	if( algoIndex == 0) { // Just Reproject
+
+		oxo::JustReproject<>::OptionsT &opts = context.justReprojectOptions;
+		std::stringstream sout; 
+		sout << opts.depth_cutoff();
+		Frapper::Log::info(QString::fromStdString(sout.str()));
+		opts.set_init_in_constructor(true);
+		context.algorithm = new oxo::JustReproject<>( calib_data, opts);
+
+	} else if( algoIndex == 1) { // Block Matching
+
+		if( !useRight ){
+			throw std::exception( QString("Block Matching Algorithm requires Stereo Images!").toStdString().c_str() );
+		}
+
+		context.algorithm = new oxo::BlockMatchingFusion<>( calib_data, context.blockMatchingOptions);
+
+	} else if( algoIndex == 2) { // Full Model
+
+		if( !useRight ){
+			throw std::exception( QString("Full Model Algorithm requires Stereo Images!").toStdString().c_str() );
+		}
+
+		context.algorithm = new oxo::FullModel<>( calib_data, context.fullModelOptions);
+
+	} else if( algoIndex == 3) { // TV Fusion
+
+		if( !useRight ){
+			throw std::exception( QString("TV Fusion Algorithm requires Stereo Images!").toStdString().c_str() );
+		}
+
+		context.algorithm = new oxo::TVFusion<>( calib_data, context.tvFusionOptions);
+	}
+
+	if( !context.algorithm ) {
+		throw std::exception( QString("Unknown Fusion Algorithm!").toStdString().c_str() );
+	}
+
+	context.algorithmSettings = settings;
+
+	// the result buffer only changes with the algorithm
+	context.output = vigra::MultiArray<3, float>( vigra::TinyVectorView<int, 3>(context.algorithm->getOutputShape()));
+}
+
+template <typename T>
+void ToFLibNode::copyTextureToBuffer( const Ogre::TexturePtr &texture, Ogre::PixelFormat format, std::vector<T> &buffer )
+{
+	const size_t width = texture->getWidth();
+	const size_t height = texture->getHeight();
+
+	const size_t memorySize = Ogre::PixelUtil::getMemorySize(width, height, 1, format);
+	buffer.resize( (memorySize + sizeof(T) - 1) / sizeof(T) );
+
+	// blit directly into the buffer, Ogre converts the format if required
+	const Ogre::PixelBox pixelBox(width, height, 1, format, &buffer[0]);
+	texture->getBuffer()->blitToMemory(pixelBox);
+}
+
+QVariantList ToFLibNode::getOptionValues( QString optionsGroupName )
+{
+	QVariantList values;
+
+	ParameterGroup* optionsGroup = getParameterGroup("ToF Sensor Fusion")->getParameterGroup(optionsGroupName);
+	if( optionsGroup ){
+		foreach ( AbstractParameter* optionParameterBase, optionsGroup->getParameterList()) {
+			Parameter* optionParameter = dynamic_cast<Parameter*>(optionParameterBase);
+			if( optionParameter )
+				values.append(optionParameter->getValue());
+		}
+	}
+	return values;
+}
+
 void ToFLibNode::initOptions()
 {
 	ParameterGroup* algoOptionsGroup = 0;
@@ -279,25 +376,12 @@ void ToFLibNode::initOptions()
 	// get algorithm options
 	oxo::OptionsBase* options = 0;
 
-	// Just Reproject
-	options = &(new oxo::JustReproject<>::OptionsT())->base;
-	algoOptionsGroup = getOrCreateParameterGroup("Just Reproject Options");
-	parametersFromOption(options, algoOptionsGroup);
-
-	// Block Matching
-	options = &(new oxo::BlockMatchingFusion<>::OptionsT())->base;
-	algoOptionsGroup = getOrCreateParameterGroup("Block Matching Options");
-	parametersFromOption(options, algoOptionsGroup);
-
-	// Full Model
-	options = &(new oxo::FullModel<>::OptionsT())->base;
-	algoOptionsGroup = getOrCreateParameterGroup("Full Model Options");
-	parametersFromOption(options, algoOptionsGroup);
-	
-	// TV Fusion
-	options = &(new oxo::TVFusion<>::OptionsT())->base;
-	algoOptionsGroup = getOrCreateParameterGroup("TV Fusion Options");
-	parametersFromOption(options, algoOptionsGroup);
+	// Just Reproject, Block Matching, Full Model, TV Fusion
+	for( int i = 0; i < 4; ++i ) {
+		options = m_fusionContext->getOptions(i);
+		algoOptionsGroup = getOrCreateParameterGroup(OptionsGroupNames[i]);
+		parametersFromOption(options, algoOptionsGroup);
+	}
 
 	forcePanelUpdate();
 }
@@ -38,6 +38,8 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "OgreTools.h"
 #include "ImageNode.h"
 
+#include <vector>
+
 namespace oxo {
 	struct OptionsBase;
 }
@@ -46,6 +48,7 @@ namespace ToFLibNode {
 using namespace Frapper;
 
 class ToFLibRenderer;
+struct FusionContext;
 
 //!
 //! Class representing ToFLib
@@ -88,11 +91,44 @@ private: // functions
 
 	void setOptionsFromParameter( QString optionsGroupName, oxo::OptionsBase* optionsPtr );
 
+	//!
+	//! Returns the current values of the parameters in the given options group.
+	//!
+	//! \param optionsGroupName The name of the options group.
+	//! \return The values of the option parameters.
+	//!
+	QVariantList getOptionValues( QString optionsGroupName );
+
+	//!
+	//! Creates the fusion algorithm for the current settings of the fusion
+	//! context, unless the existing one was created with the same settings.
+	//!
+	//! \param useRight Flag whether a right input image is given.
+	//!
+	void updateAlgorithm( bool useRight );
+
+	//!
+	//! Copies the given texture into the given buffer, converting it to the
+	//! given pixel format. The buffer is resized to fit the texture.
+	//!
+	//! \param texture The texture to copy.
+	//! \param format The pixel format of the buffer data.
+	//! \param buffer The buffer to copy the texture data to.
+	//!
+	template <typename T>
+	void copyTextureToBuffer( const Ogre::TexturePtr &texture, Ogre::PixelFormat format, std::vector<T> &buffer );
+
 	Frapper::ParameterGroup* getOrCreateParameterGroup(QString name);
 
 private: //data
 
 	ToFLibRenderer* m_tofRenderer;
+
+	//!
+	//! The fusion algorithm, its options and the working buffers, which are
+	//! kept between the updates of the node.
+	//!
+	FusionContext* m_fusionContext;
 };
 
 } // namespace ToFLibNode
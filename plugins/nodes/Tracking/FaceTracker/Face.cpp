@@ -80,6 +80,7 @@ Face::Face(RectNDC initialRect)
 {
     m_rect        = initialRect;
     m_probability = PROBABILITY_INCREASE_PER_DETECTION;
+    m_tracked     = false;
 }
 
 
@@ -139,9 +140,10 @@ float Face::getProbability()
 //! Checks if the given detected face rect is considered a detection of this face.
 //!
 //! \param detectionRect    the rectangle to test for a match with the current NDC of this face
+//! \param updateRect       whether a matching rect replaces the face rect, False keeps a more recent tracked rect
 //! \return True, if the rect is considered a detection of this face, otherwise False.
 //!
-bool Face::checkDetectionRect(RectNDC detectionRect)
+bool Face::checkDetectionRect(RectNDC detectionRect, bool updateRect)
 {
     // check if the given detection rect is considered equal to the face rect
     bool result = abs(detectionRect.x - m_rect.x) < THRESHOLD
@@ -150,18 +152,82 @@ bool Face::checkDetectionRect(RectNDC detectionRect)
                && abs(detectionRect.h - m_rect.h) < THRESHOLD;
     if (result) {
         // update the member rect's coordinates with the coordinates of the given rect
-        m_rect = detectionRect;
-        // increase probability
-        if (m_probability < 1.0f) {
-            m_probability += PROBABILITY_INCREASE_PER_DETECTION;
-            if (m_probability > 1.0f)
-                m_probability = 1.0f;
-        }
+        if (updateRect)
+            m_rect = detectionRect;
+        increaseProbability();
     }
     return result;
 }
 
 
+//!
+//! Stores the image region of the face as template for tracking.
+//!
+//! \param image   the grayscale image the face rect refers to
+//!
+void Face::updateTemplate(const cv::Mat &image)
+{
+    cv::Rect r = toPixelRect(image);
+    if (r.width > 0 && r.height > 0)
+        m_template = image(r).clone();
+    else
+        m_template.release();
+}
+
+
+//!
+//! Follows the face into the given image by matching its template inside a
+//! search region around the last position. A successful track counts as
+//! detection and refreshes the template.
+//!
+//! \param image           the grayscale image to track the face in
+//! \param searchMargin    margin around the face rect to search in, relative to the face size
+//! \param minCorrelation  min normalized correlation of a successful match
+//! \return True, if the face was found.
+//!
+bool Face::track(const cv::Mat &image, float searchMargin, float minCorrelation)
+{
+    m_tracked = false;
+    if (m_template.empty())
+        return false;
+
+    // search region around the last position, clamped to the image
+    const int marginX = cvRound(m_template.cols * searchMargin);
+    const int marginY = cvRound(m_template.rows * searchMargin);
+    cv::Rect face = toPixelRect(image);
+    cv::Rect search(face.x - marginX, face.y - marginY, m_template.cols + 2*marginX, m_template.rows + 2*marginY);
+    search &= cv::Rect(0, 0, image.cols, image.rows);
+    if (search.width < m_template.cols || search.height < m_template.rows)
+        return false;
+
+    cv::Mat correlation;
+    cv::matchTemplate(image(search), m_template, correlation, CV_TM_CCOEFF_NORMED);
+
+    double maxValue = 0.0;
+    cv::Point maxLocation;
+    cv::minMaxLoc(correlation, 0, &maxValue, 0, &maxLocation);
+    if (maxValue < minCorrelation)
+        return false;
+
+    m_rect.x = (float) (search.x + maxLocation.x) / image.cols;
+    m_rect.y = (float) (search.y + maxLocation.y) / image.rows;
+    m_template = image(cv::Rect(search.x + maxLocation.x, search.y + maxLocation.y, m_template.cols, m_template.rows)).clone();
+    increaseProbability();
+
+    m_tracked = true;
+    return true;
+}
+
+
+//!
+//! Returns whether the last call to track() found the face.
+//!
+bool Face::isTracked()
+{
+    return m_tracked;
+}
+
+
 //!
 //! Decreases the probability value of a face detection by a constant value.
 //! Is used to decrease probability by time, if no more matches of face detection rects occur.
@@ -175,4 +241,34 @@ void Face::decreaseProbability ()
     }
 }
 
+
+///
+///   PRIVATE FUNCTIONS
+///
+
+
+//!
+//! Increases the probability value of a face detection by a constant value.
+//!
+void Face::increaseProbability ()
+{
+    if (m_probability < 1.0f) {
+        m_probability += PROBABILITY_INCREASE_PER_DETECTION;
+        if (m_probability > 1.0f)
+            m_probability = 1.0f;
+    }
+}
+
+
+//!
+//! Returns the face rect in pixel coordinates of the given image, clamped
+//! to the image.
+//!
+cv::Rect Face::toPixelRect (const cv::Mat &image)
+{
+    cv::Rect r(cvRound(m_rect.x * image.cols), cvRound(m_rect.y * image.rows),
+               cvRound(m_rect.w * image.cols), cvRound(m_rect.h * image.rows));
+    return r & cv::Rect(0, 0, image.cols, image.rows);
+}
+
 } // namespace FaceTrackerNode 
@@ -39,6 +39,16 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 
 #include "Helper.h"
 
+#ifdef _WIN32
+#include "cv.h"         // from OpenCV
+#endif
+#ifdef _OSX
+#include <cv.h>
+#endif
+#ifdef _LINUX
+#include <opencv/cv.h>
+#endif
+
 namespace FaceTrackerNode {
 
 //!
@@ -55,13 +65,32 @@ public:
     PointNDC getPointOfAttraction();
     RectNDC getRect();
     float getProbability();
-    bool checkDetectionRect(RectNDC detectionRect);
+    bool checkDetectionRect(RectNDC detectionRect, bool updateRect = true);
     void decreaseProbability();
 
+    void updateTemplate(const cv::Mat &image);
+    bool track(const cv::Mat &image, float searchMargin, float minCorrelation);
+    bool isTracked();
+
+private:
+    void increaseProbability();
+    cv::Rect toPixelRect(const cv::Mat &image);
+
 private:
     RectNDC m_rect;
     float m_probability;
 
+    //!
+    //! Appearance of the face at its last detection or successful track,
+    //! used to follow the face between two detections.
+    //!
+    cv::Mat m_template;
+
+    //!
+    //! Whether the last call to track() found the face.
+    //!
+    bool m_tracked;
+
 };
 
 } // namespace FaceTrackerNode 
@@ -0,0 +1,182 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "FaceDetector.cpp"
+//! \brief Implementation file for FaceDetector class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "FaceDetector.h"
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutexLocker>
+
+namespace FaceTrackerNode {
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the FaceDetector class.
+//!
+//! \param cascadeFileName The file name of the Haar classifier cascade.
+//!
+FaceDetector::FaceDetector ( const std::string &cascadeFileName ) :
+	QObject(),
+	m_loaded(false),
+	m_busy(false),
+	m_hasResults(false),
+	m_resultWidth(0),
+	m_resultHeight(0)
+{
+	m_loaded = m_cascadeClassifier.load(cascadeFileName);
+}
+
+
+//!
+//! Destructor of the FaceDetector class.
+//!
+FaceDetector::~FaceDetector ()
+{
+}
+
+
+///
+/// Public Methods
+///
+
+
+//!
+//! Returns whether the cascade file could be loaded.
+//!
+bool FaceDetector::isLoaded () const
+{
+	return m_loaded;
+}
+
+
+//!
+//! Detects faces in the given image on the calling thread.
+//!
+//! \param image    the equalized grayscale image to detect faces in
+//! \param rects    the detected face rects in pixel coordinates
+//!
+void FaceDetector::detect ( const cv::Mat &image, std::vector<cv::Rect> &rects )
+{
+	rects.clear();
+	if (!m_loaded)
+		return;
+
+	QMutexLocker locker(&m_classifierMutex);
+	m_cascadeClassifier.detectMultiScale(
+		image,						// Matrix of type CV_8U containing the image in which to detect objects.
+		rects,						// Vector of rectangles such that each rectangle contains the detected object.
+		1.1,						// Specifies how much the image size is reduced at each image scale.
+		3,							// Speficifes how many neighbors should each candiate rectangle have to retain it.
+		CV_HAAR_DO_CANNY_PRUNING,	// This parameter is not used for new cascade and have the same meaning for old cascade as in function cvHaarDetectObjects.
+		cv::Size(30,30));			// The minimum possible object size. Objects smaller than that are ignored
+}
+
+
+//!
+//! Queues the given image for detection on the detector's thread. Does
+//! nothing if a detection is still running.
+//!
+//! \param image    the equalized grayscale image to detect faces in
+//! \return True, if the image was queued.
+//!
+bool FaceDetector::submit ( const cv::Mat &image )
+{
+	{
+		QMutexLocker locker(&m_mutex);
+		if (m_busy || !m_loaded)
+			return false;
+		m_busy = true;
+		image.copyTo(m_image);
+	}
+
+	QMetaObject::invokeMethod(this, "process", Qt::QueuedConnection);
+	return true;
+}
+
+
+//!
+//! Returns whether a detection is queued or running.
+//!
+bool FaceDetector::isBusy () const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_busy;
+}
+
+
+//!
+//! Takes the results of the last finished detection.
+//!
+//! \param rects    the detected face rects in pixel coordinates
+//! \param width    the width of the image the rects refer to
+//! \param height   the height of the image the rects refer to
+//! \return True, if new results were available.
+//!
+bool FaceDetector::takeResults ( std::vector<cv::Rect> &rects, int &width, int &height )
+{
+	QMutexLocker locker(&m_mutex);
+	if (!m_hasResults)
+		return false;
+
+	rects.swap(m_results);
+	width  = m_resultWidth;
+	height = m_resultHeight;
+	m_results.clear();
+	m_hasResults = false;
+	return true;
+}
+
+
+///
+/// Private Slots
+///
+
+
+//!
+//! Runs the detection of the queued image.
+//!
+void FaceDetector::process ()
+{
+	// the image is only written by submit() while the detector is not busy
+	std::vector<cv::Rect> rects;
+	detect(m_image, rects);
+
+	QMutexLocker locker(&m_mutex);
+	m_results.swap(rects);
+	m_resultWidth  = m_image.cols;
+	m_resultHeight = m_image.rows;
+	m_hasResults = true;
+	m_busy = false;
+}
+
+} // namespace FaceTrackerNode
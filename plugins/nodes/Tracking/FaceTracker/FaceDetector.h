@@ -0,0 +1,155 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "FaceDetector.h"
+//! \brief Header file for FaceDetector class.
+//!
+//! Runs the full frame cascade detection of the face tracker on a worker
+//! thread. The node submits a frame whenever its trackers need fresh
+//! detections and merges the results as soon as they are available.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef FACEDETECTOR_H
+#define FACEDETECTOR_H
+
+#include <QtCore/QObject>
+#include <QtCore/QMutex>
+
+#ifdef _WIN32
+#include "cv.h"         // from OpenCV
+#endif
+#ifdef _OSX
+#include <cv.h>
+#endif
+#ifdef _LINUX
+#include <opencv/cv.h>
+#endif
+
+#include <string>
+#include <vector>
+
+namespace FaceTrackerNode {
+
+//!
+//! Asynchronous full frame face detector.
+//!
+class FaceDetector : public QObject
+{
+
+	Q_OBJECT
+
+public: /// constructors and destructors
+
+    //!
+    //! Constructor of the FaceDetector class.
+    //!
+    //! \param cascadeFileName The file name of the Haar classifier cascade.
+    //!
+	FaceDetector ( const std::string &cascadeFileName );
+
+    //!
+    //! Destructor of the FaceDetector class.
+    //!
+	~FaceDetector ();
+
+public: /// methods
+
+    //!
+    //! Returns whether the cascade file could be loaded.
+    //!
+	bool isLoaded () const;
+
+    //!
+    //! Detects faces in the given image on the calling thread.
+    //!
+    //! \param image    the equalized grayscale image to detect faces in
+    //! \param rects    the detected face rects in pixel coordinates
+    //!
+	void detect ( const cv::Mat &image, std::vector<cv::Rect> &rects );
+
+    //!
+    //! Queues the given image for detection on the detector's thread. Does
+    //! nothing if a detection is still running.
+    //!
+    //! \param image    the equalized grayscale image to detect faces in
+    //! \return True, if the image was queued.
+    //!
+	bool submit ( const cv::Mat &image );
+
+    //!
+    //! Returns whether a detection is queued or running.
+    //!
+	bool isBusy () const;
+
+    //!
+    //! Takes the results of the last finished detection.
+    //!
+    //! \param rects    the detected face rects in pixel coordinates
+    //! \param width    the width of the image the rects refer to
+    //! \param height   the height of the image the rects refer to
+    //! \return True, if new results were available.
+    //!
+	bool takeResults ( std::vector<cv::Rect> &rects, int &width, int &height );
+
+private slots:
+
+    //!
+    //! Runs the detection of the queued image.
+    //!
+	void process ();
+
+private: /// attributes
+
+    //!
+    //! OpenCV haar classifier cascade, owned by the detector since classifiers
+    //! must not be shared between threads.
+    //!
+	cv::CascadeClassifier m_cascadeClassifier;
+
+    //!
+    //! Serializes the use of the classifier.
+    //!
+	QMutex m_classifierMutex;
+
+    //!
+    //! Guards the queued image and the results.
+    //!
+	mutable QMutex m_mutex;
+
+	bool m_loaded;
+	bool m_busy;
+	bool m_hasResults;
+	cv::Mat m_image;
+	std::vector<cv::Rect> m_results;
+	int m_resultWidth;
+	int m_resultHeight;
+
+};
+
+} // namespace FaceTrackerNode
+
+#endif
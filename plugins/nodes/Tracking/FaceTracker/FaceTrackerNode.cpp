@@ -215,10 +215,19 @@ FaceTrackerNode::FaceTrackerNode ( QString name, ParameterGroup *parameterRoot )
 	std::string cascadeFileName = HAAR_FILENAME;
 	m_detectedObjects.clear();
 
-	m_cascadeClassifier = new CascadeClassifier();
+	m_detector = new FaceDetector(cascadeFileName);
 	// check if the cascade file exists
-	if(!m_cascadeClassifier->load(cascadeFileName))
+	if(!m_detector->isLoaded())
 		Log::error("Could not load the cascade file.", "FaceTrackerNode::FaceTrackerNode");
+	m_detector->moveToThread(&m_detectorThread);
+	m_detectorThread.start();
+
+	m_framesSinceDetection = 0;
+	setChangeFunction("asyncDetection", SLOT(trackingSettings()));
+	setChangeFunction("detectionInterval", SLOT(trackingSettings()));
+	setChangeFunction("searchMargin", SLOT(trackingSettings()));
+	setChangeFunction("trackingThreshold", SLOT(trackingSettings()));
+	trackingSettings();
 
 	Parameter *drawDebugInformationParameter = getParameter("drawDebugInformation");
     if (drawDebugInformationParameter)
@@ -236,7 +245,11 @@ FaceTrackerNode::~FaceTrackerNode ()
     for (unsigned int i = 0; i < m_faces.size(); ++i)
         delete m_faces.at(i);
     m_faces.clear();
-	delete m_cascadeClassifier;
+
+	// a running detection finishes before the thread quits
+	m_detectorThread.quit();
+	m_detectorThread.wait();
+	delete m_detector;
 
 }
 
@@ -341,6 +354,17 @@ void FaceTrackerNode::drawDebugInformation ()
 	m_drawDebugInformation = getValue("drawDebugInformation").toBool();
 }
 
+//!
+//! Sets the detection and tracking settings
+//!
+void FaceTrackerNode::trackingSettings ()
+{
+	m_asyncDetection = getBoolValue("asyncDetection");
+	m_detectionInterval = getIntValue("detectionInterval");
+	m_searchMargin = getDoubleValue("searchMargin");
+	m_trackingThreshold = getDoubleValue("trackingThreshold");
+}
+
 
 void FaceTrackerNode::processInputMatrix()
 {
@@ -501,56 +525,94 @@ void FaceTrackerNode::processAttractors ()
 
 
 //!
-//! Detects all faces in the given image, and creates or updates face objects for each detected face.
+//! Follows the known faces in the given image and merges the results of
+//! the full frame detection, which runs periodically or on track loss.
 //!
 //! \param image    the image to detect faces in
 //!
 void FaceTrackerNode::detectFaces(Mat image)
 {
-    RectNDC detectionRect;
- 
 	float   scale = 2.0;
 
-	Mat gray = image.clone();
-	cvtColor(gray, gray, CV_BGR2GRAY, 1);
+	Mat gray;
+	cvtColor(image, gray, CV_BGR2GRAY, 1);
 	cv::resize(gray, gray, cvSize( cvRound (m_width/scale), cvRound (m_height/scale)), CV_INTER_LINEAR);
+	cv::equalizeHist(gray, gray);
+
+	// full frame detection on every frame
+	if (!m_asyncDetection) {
+		m_detector->detect(gray, m_detectedObjects);
+		mergeDetections(gray, m_detectedObjects);
+		m_detectedObjectsCount = (int) m_detectedObjects.size();
+		return;
+	}
+
+	// merge the results of a finished background detection
+	int detectionWidth, detectionHeight;
+	if (m_detector->takeResults(m_detectedObjects, detectionWidth, detectionHeight)) {
+		if (detectionWidth == gray.cols && detectionHeight == gray.rows)
+			mergeDetections(gray, m_detectedObjects);
+		m_detectedObjectsCount = (int) m_detectedObjects.size();
+	}
+
+	// follow the known faces inside their search regions
+	bool trackLost = m_faces.empty();
+	for (unsigned int i = 0; i < m_faces.size(); ++i) {
+		if (!m_faces.at(i)->track(gray, m_searchMargin, m_trackingThreshold))
+			trackLost = true;
+	}
+
+	// start a new full frame detection periodically or if a face got lost
+	++m_framesSinceDetection;
+	if (trackLost || m_framesSinceDetection >= m_detectionInterval) {
+		if (m_detector->submit(gray))
+			m_framesSinceDetection = 0;
+	}
+}
+
+
+//!
+//! Creates or updates face objects for each detected face. Faces that
+//! are still tracked keep their more recent rect.
+//!
+//! \param gray     the current grayscale image, of the size the rects were detected in
+//! \param rects    the detected face rects in pixel coordinates
+//!
+void FaceTrackerNode::mergeDetections(const Mat &gray, const vector<cv::Rect> &rects)
+{
+    RectNDC detectionRect;
 	int imageWidth  = gray.cols;
     int imageHeight = gray.rows;
-	cv::equalizeHist(gray, gray);
- 
-	m_detectedObjects.empty();
-
-	m_cascadeClassifier->detectMultiScale(
-		gray,						// Matrix of type CV_8U containing the image in which to detect objects.
-		m_detectedObjects,			// Vector of rectangles such that each rectangle contains the detected object.
-		1.1,						// Specifies how much the image size is reduced at each image scale.
-		3,							// Speficifes how many neighbors should each candiate rectangle have to retain it.
-		CV_HAAR_DO_CANNY_PRUNING,							// This parameter is not used for new cascade and have the same meaning for old cascade as in function cvHaarDetectObjects.
-		Size(30,30));				// The minimum possible object size. Objects smaller than that are ignored
-
-	unsigned int i;
-	for(i=0; i < m_detectedObjects.size(); i++){
-        //CvRect *r = (CvRect *) cvGetSeqElem(m_cascadeClassifier->s, i);
-		cv::Rect r = m_detectedObjects.at(i);
+
+	for(unsigned int i=0; i < rects.size(); i++){
+		cv::Rect r = rects.at(i);
         // get normalized device coordinates of rectangle
         detectionRect.x = (float) r.x      / imageWidth;
         detectionRect.y = (float) r.y      / imageHeight;
         detectionRect.w = (float) r.width  / imageWidth;
         detectionRect.h = (float) r.height / imageHeight;
-        // iterate over all existing faces and check if detected object can be assigned to a face
+        // iterate over all existing faces and check if detected object can be assigned to a face,
+        // an asynchronous detection is older than the rect of a face that is still tracked
         unsigned int n = 0;
         bool found = false;
+        bool updated = false;
         while (n < m_faces.size() && !found) {
-			found = m_faces.at(n)->checkDetectionRect(detectionRect);
+			updated = !m_asyncDetection || !m_faces.at(n)->isTracked();
+			found = m_faces.at(n)->checkDetectionRect(detectionRect, updated);
 			if (!found)
                 ++n;
         }
         // create new Face object if detection rect could not be associated with any existing face
-    
-		if (!found && detectionRect.w > m_minSize && detectionRect.w < m_maxSize)
-				m_faces.push_back(new Face(detectionRect));	
+		if (!found && detectionRect.w > m_minSize && detectionRect.w < m_maxSize) {
+				m_faces.push_back(new Face(detectionRect));
+				n = (unsigned int) m_faces.size() - 1;
+				found = true;
+				updated = true;
+		}
+		// re-seed the tracking template of each face whose rect was taken from the detection
+		if (found && updated && m_asyncDetection)
+			m_faces.at(n)->updateTemplate(gray);
     }
-	m_detectedObjectsCount = i;
 }
 
 
@@ -45,6 +45,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <vector>
 
 #include "Face.h"
+#include "FaceDetector.h"
 #include "Helper.h"
 
 namespace FaceTrackerNode {
@@ -139,6 +140,11 @@ private slots:
 	//!
 	void drawDebugInformation();
 
+	//!
+	//! Sets the detection and tracking settings
+	//!
+	void trackingSettings();
+
 	//!
 	//! SLOT that is used on the matrixParameter
 	//!
@@ -146,12 +152,22 @@ private slots:
 
 private: /// methods
     //!
-    //! Detects all faces in the given image, and creates or updates face objects for each detected face.
+    //! Follows the known faces in the given image and merges the results of
+    //! the full frame detection, which runs periodically or on track loss.
     //!
     //! \param image    the image to detect faces in
     //!
 	void detectFaces(cv::Mat image);
 
+    //!
+    //! Creates or updates face objects for each detected face. Faces that
+    //! are still tracked keep their more recent rect.
+    //!
+    //! \param gray     the current grayscale image, of the size the rects were detected in
+    //! \param rects    the detected face rects in pixel coordinates
+    //!
+	void mergeDetections(const cv::Mat &gray, const vector<cv::Rect> &rects);
+
     //!
     //! Draws an overlay onto the image that shows the locations of detected faces in the scene.
     //!
@@ -253,9 +269,35 @@ private: /// attributes
 	vector<cv::Rect> m_detectedObjects;
 
 	//!
-    //! OpenCV haar classifier cascade.
+    //! Full frame face detector and the thread it runs on.
     //!
-	cv::CascadeClassifier *m_cascadeClassifier;
+	FaceDetector *m_detector;
+	QThread m_detectorThread;
+
+	//!
+	//! Run the full frame detection asynchronously and track faces in between
+	//!
+	bool m_asyncDetection;
+
+	//!
+	//! Number of frames between two full frame detections
+	//!
+	int m_detectionInterval;
+
+	//!
+	//! Number of frames since the last full frame detection was submitted
+	//!
+	int m_framesSinceDetection;
+
+	//!
+	//! Margin around a face to search it in, relative to the face size
+	//!
+	double m_searchMargin;
+
+	//!
+	//! Min correlation of a tracked face
+	//!
+	double m_trackingThreshold;
 
     //!
     //! Configuration parameter group.
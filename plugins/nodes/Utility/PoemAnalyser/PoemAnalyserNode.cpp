@@ -36,19 +36,20 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 namespace PoemAnalyserNode {
 using namespace Frapper;
 
-#define PLEASANT	0
-#define NICE		1
-#define PASSIVE		2
-#define SAD			3
-#define UNPLEASANT	4
-#define NASTY		5
-#define ACTIVE		6
-#define FUN			7
-#define HIMAGERY	8
-#define LOIMAGERY	9
+#define PLEASANT	PoemLexicon::Pleasant
+#define NICE		PoemLexicon::Nice
+#define PASSIVE		PoemLexicon::Passive
+#define SAD			PoemLexicon::Sad
+#define UNPLEASANT	PoemLexicon::Unpleasant
+#define NASTY		PoemLexicon::Nasty
+#define ACTIVE		PoemLexicon::Active
+#define FUN			PoemLexicon::Fun
+#define HIMAGERY	PoemLexicon::HImagery
+#define LOIMAGERY	PoemLexicon::LoImagery
 
 #define NRSTATES	8	//number of emotional states from the Whissell analysis -> 8 because we will not include "Low Imagery" and "high Imagery"
 #define POEMSTATES	3	//the number of states to consider for the poem
+#define WORDSTATES	PoemLexicon::NumStates	//number of states stored per word in the lexicon
 
 ///
 /// Constructors and Destructors
@@ -64,7 +65,6 @@ using namespace Frapper;
 PoemAnalyserNode::PoemAnalyserNode ( const QString &name, ParameterGroup *parameterRoot ) :
     Node(name, parameterRoot)
 {
-	m_wordAnalysisGroup = new ParameterGroup("Word Analysis");
 	m_poemAnalysisGroup = new ParameterGroup("Poem Analysis");
 	m_poemTextGroup = new ParameterGroup("Poem Text");
 
@@ -119,86 +119,55 @@ PoemAnalyserNode::~PoemAnalyserNode ()
 //! 
 //! Reads the file obtained by the WDAL. This contains the analysis values of each word of the text
 //!
-//! returns: wordAnalysisGroup
+//! The lexicon is read from a binary cache next to the DAT file if the cache
+//! is up to date, otherwise the DAT file is parsed and the cache is written.
+//!
+//! returns: m_lexicon
 //!
 void PoemAnalyserNode::readDATFile()
 {
+	m_lexicon.clear();
+
+	const QString filename = getStringValue("Filename DAT");
+	if (filename.isEmpty() || m_lexicon.readCache(filename))
+		return;
+
 	QFile *file = fileManagement("Filename DAT", "read");
 
-	if (file->isReadable())
+	if (file && file->isReadable())
 	{
 		QTextStream ts(file);
-		QStringList stateNames = ts.readLine().split(',');
-
-		// Explanation: The first line is of the form: sample,word,emotion,activation,kpleasant,kactive,imagery,frequency,pleasant,nice,passive,sad,unpleasant,nasty,active,fun,himagery,loimagery
-		// From this, we just need: word,emotion,activation,pleasant,nice,passive,sad,unpleasant,nasty,active,fun,himagery,loimagery 
-		// Meaning positions 1, 2, 3, and the last 10 elements
-
-		while(!ts.atEnd())
-		{
-			QStringList wordValues = ts.readLine().split(',');
+		m_lexicon.parse(ts);
 
-			//Look for position 1 (second word) to get the name 
-			QString wordName = wordValues.at(1).toLower();
-			ParameterGroup *parameterGroup = m_wordAnalysisGroup->getParameterGroup(wordName);
+		Log::info(QString("Read %1 words from %2.").arg(m_lexicon.size()).arg(filename), "PoemAnalyserNode::readDATFile");
+		delete file;
 
-			//if (!m_wordAnalysisGroup->contains(wordName + "Parameter"))
-			if (parameterGroup == 0)
-			{
-				ParameterGroup *g = new ParameterGroup(wordName);
-
-				int j=0;
-				// to get emotion, activation (OJO: "emotion" stands for "pleasantness")
-				for (int i=2; i<= 3; i++)
-				{
-					QString nameParameter = stateNames.at(i);
-					QString valueParameter = wordValues.at(i+j) + "," + wordValues.at(i+j+1);
-
-					if (valueParameter.toFloat() > 3.0)
-					{
-						// Get the values one position before
-						valueParameter = wordValues.at(i+j-1) + "," + wordValues.at(i+j);
-					}
-					else if (valueParameter.compare(",")==0)
-						valueParameter = "0,0";
-
-					j++;
-
-					Parameter *p = new Parameter(nameParameter+"Parameter", Parameter::T_String, QVariant(valueParameter));
-					g->addParameter(p);
-					Log::warning("poemAnalysisGroup: " + p->getName());	
-				}
-
-				// to get nice,pleasant,fun,active,nasty,unpleasant,sad,passive,himagery,loimagery
-				int lengthNames = stateNames.length();
-				int lengthValues = wordValues.length();
-				for (int i=1; i<=10; i++)
-				{
-					QString nameParameter = stateNames.at(lengthNames-i);
-					QString valueParameter = wordValues.at(lengthValues-i);
-
-					if (valueParameter.compare("") == 0)
-						valueParameter = "0";
-
-					Parameter *p = new Parameter(nameParameter+"Parameter", Parameter::T_String, QVariant(valueParameter));
-					g->addParameter(p);
-					Log::warning("poemAnalysisGroup: " + p->getName());
-				}
-
-				// Now I add the word to the group of words
-				m_wordAnalysisGroup->addParameter(g);
-				Log::warning("wordAnalysisGroup: " + g->getName());
-			}
-		}
+		if (!m_lexicon.writeCache(filename))
+			Log::warning(QString("Lexicon cache %1 could not be written.").arg(PoemLexicon::getCacheFilename(filename)), "PoemAnalyserNode::readDATFile");
 	}
 	else
 	{
-		Log::error(QString("File %1 could not be loaded!").arg(file->fileName()), "PoemReaderNode::readSUMFile");
+		Log::error(QString("File %1 could not be loaded!").arg(filename), "PoemAnalyserNode::readDATFile");
+		delete file;
 		return;
 	}
 }
 
 
+//!
+//! Returns the lexicon entry of the given word of a poem line.
+//!
+//! \param word The word as it appears in the line.
+//! \return The state values of the word or 0 if the word is unknown.
+//!
+const PoemAnalyserNode::WordStates * PoemAnalyserNode::findWord( QString word ) const
+{
+	static const QRegExp rx1("[\"!#$%&()*+,./:;?@_{|}~-]");
+
+	return m_lexicon.find(word.remove(rx1).toLower());
+}
+
+
 //!
 //! readFORFile()
 //!
@@ -375,7 +344,10 @@ void PoemAnalyserNode::reloadFORFile(){
 //!
 void PoemAnalyserNode::reloadDATFile(){
 	
-	m_wordAnalysisGroup->clear();
+	// drop the cache to read the DAT file itself
+	const QString filename = getStringValue("Filename DAT");
+	if (!filename.isEmpty())
+		QFile::remove(PoemLexicon::getCacheFilename(filename));
 
 	readDATFile();
 }
@@ -511,13 +483,13 @@ ParameterGroup* PoemAnalyserNode::getPoemState()
 //! 1.- We checked the 0 and 1 values of the states of each word. We sum them up and store in a table to know which is the predominant state.
 QString PoemAnalyserNode::lineAnalysisAndTagging( QString poemLine, ParameterGroup *poemState)
 {
-	QTableWidget *tStates = new QTableWidget(10, 2); 	
-	tStates = getLineStates(poemLine, tStates);
+	int stateValues[WORDSTATES];
+	getLineStates(poemLine, stateValues);
 	
 	//Get the most predominant state
-	tStates = getLinePredominantState(tStates);
+	const StateList states = getLinePredominantState(stateValues);
 
-	if (tStates->rowCount() == 0)
+	if (states.isEmpty())
 	{
 		//NO TAGGING
 		poemLine = setLineProsodyTagging(poemLine, "", 0.0, poemState);	//We tag the line with prosodic values: speed and pitch
@@ -525,9 +497,9 @@ QString PoemAnalyserNode::lineAnalysisAndTagging( QString poemLine, ParameterGro
 	}
 	else
 	{
-		ParameterGroup *lStateGroup = getLineTaggingState(tStates, poemState);
-		QString lState = lStateGroup->getParameter("Line State Name")->getValueString();
-		float lValue = lStateGroup->getParameter("Line State Value")->getValue().toFloat();
+		const QPair<QString, float> lineState = getLineTaggingState(states, poemState);
+		const QString lState = lineState.first;
+		const float lValue = lineState.second;
 
 		poemLine = setLineProsodyTagging(poemLine, lState, lValue, poemState);	//We tag the line with prosodic values: speed and pitch
 		poemLine = setLineTagging(lState, poemLine);
@@ -537,131 +509,60 @@ QString PoemAnalyserNode::lineAnalysisAndTagging( QString poemLine, ParameterGro
 }
 
 //!
-//! Table with the states of the word according to the data in the FOR file
-QTableWidget* PoemAnalyserNode::getLineStates(QString poemLine, QTableWidget* table)
+//! Sums up the state values of the words of the line according to the data in the DAT file
+//! States: "pleasant" << "nice" << "passive" << "sad" << "unpleasant" << "nasty" << "active" << "fun" << "himagery" << "loimagery"
+void PoemAnalyserNode::getLineStates( const QString &poemLine, int *stateValues ) const
 {
-	QRegExp rx1("[\"!#$%&()*+,./:;?@_{|}~-]");	
-	QStringList wordList = poemLine.split(" ");
-
-	//Initialization of the table: "pleasant" << "nice" << "passive" << "sad" << "unpleasant" << "nasty" << "active" << "fun" << "himagery" << "loimagery";
-	for (int i=0; i<10; i++)
-	{
-		QTableWidgetItem *name = new QTableWidgetItem(transformNumberToString(i));
-		QTableWidgetItem *val = new QTableWidgetItem(0);
-		table->setItem(i, 0, name);
-		table->setItem(i, 1, val);
-	}
+	for (int i=0; i<WORDSTATES; i++)
+		stateValues[i] = 0;
 
-	for (int i=0; i<wordList.length(); i++)
+	const QStringList wordList = poemLine.split(" ");
+	foreach (const QString &word, wordList)
 	{
-		QString word = wordList.at(i);
-
-		if (word.compare("") != 0 && wordIsOk(word))
-		{		
-			word = word.remove(rx1).toLower();
-			ParameterGroup *w = m_wordAnalysisGroup->getParameterGroup(word);
-
-			if (w != 0)
-			{
-				const AbstractParameter::List& lStates = w->getParameterList();
+		if (word.isEmpty() || !wordIsOk(word))
+			continue;
 
-				foreach(AbstractParameter *a, lStates)
-				{
-					//ahora estan aqui los estados
-					QString name = a->getName();	// name of the state
-
-					if (!name.contains("tion")) // we do not store "emotion" and "activation" values
-					{
-						// From where to take the value of the state+
-						int sValue = ((Parameter *)a)->getValue().toInt();
-
-						if (sValue != 0)
-						{				
-							// Where to store the value of the state
-							name = name.remove("Parameter");
-							QTableWidgetItem *sItem = table->findItems( name, Qt::MatchContains ).first();
-							int rowNr = table->row(sItem);
-							sItem = table->item(rowNr, 1);	//
-							int tmp = sItem->text().toInt() + sValue;
-							sItem->setText(QString::number(tmp));
-							table->setItem(rowNr, 1, sItem);
-						}
-					}			
-				}
-			}
-		}
+		const WordStates *states = findWord(word);
+		if (states)
+			for (int i=0; i<WORDSTATES; i++)
+				stateValues[i] += states->values[i];
 	}
-	return table;
 }
 
 //! geLinePredominantState
 //!
 //! gets the predominant state among nice, pleasant, fun, nasty, unpleasant and sad
 //!
-QTableWidget * PoemAnalyserNode::getLinePredominantState( QTableWidget * tStates ) 
+PoemAnalyserNode::StateList PoemAnalyserNode::getLinePredominantState( const int *stateValues ) const
 {
-	int greatervalue = -1;
-	tStates->sortByColumn(1, Qt::DescendingOrder);
-
-	for (int i=0; i<tStates->rowCount(); i++)
-	{
-		int tmp = tStates->item(i, 1)->text().toInt();
-		QString name = tStates->item(i, 0)->text();
-		if (tmp >= greatervalue && tmp!=0 && !name.contains("imagery") && !name.contains("ive"))
-		{
-			greatervalue = tmp;
-		}
-		else
-		{
-			//Delete this cell. Now we are also removing "himagery" and "loimagery"
-			tStates->removeRow(i);
-			i--;
-		}
-	}
-	return tStates;
+	// the states with the greatest value, "himagery", "loimagery", "passive" and "active" are not considered
+	int greatervalue = 0;
+	for (int i=0; i<NRSTATES; i++)
+		if (i != PASSIVE && i != ACTIVE && stateValues[i] > greatervalue)
+			greatervalue = stateValues[i];
+
+	StateList states;
+	if (greatervalue > 0)
+		for (int i=0; i<NRSTATES; i++)
+			if (i != PASSIVE && i != ACTIVE && stateValues[i] == greatervalue)
+				states.append(qMakePair(transformNumberToString(i), stateValues[i]));
+
+	return states;
 }
 
 
 //!
 //! analyzes the states and returns the one to tag the line
-ParameterGroup* PoemAnalyserNode::getLineTaggingState( QTableWidget * tStates, ParameterGroup * poemState )
+QPair<QString, float> PoemAnalyserNode::getLineTaggingState( const StateList &states, ParameterGroup * poemState ) const
 {
-	ParameterGroup* state = new ParameterGroup("Line State");
-	QString statename;
-	QString statevalue;
-	bool sameState = false;
-	int rows = tStates->rowCount();
+	const QString pState = poemState->getParameter("State Name")->getValueString().remove("Parameter");
 
-	QString pState = poemState->getParameter("State Name")->getValueString().remove("Parameter");
-	float pValue = poemState->getParameter("State Value")->getValue().toFloat();
-		
-	for (int i=0; i<rows; i++)
-	{
-		QString lState = tStates->item(i, 0)->text();
-		QString lValue = tStates->item(i,1)->text();
-
-		if (lState.compare(pState, Qt::CaseInsensitive) == 0)
-		{
-			statename = lState;
-			statevalue = lValue;
-			i = rows;	//finish the for-loop
-			sameState = true;
-		}
-	}
-
-	if (!sameState)
-	{
-		//we get the first state in the table
-		statename = tStates->item(0, 0)->text();
-		statevalue = tStates->item(0,1)->text();
-	}
-
-	Parameter *sName = new Parameter("Line State Name", Parameter::T_String, QVariant(statename));
-	Parameter *sValue = new Parameter("Line State Value", Parameter::T_Float, QString::number(statevalue.toFloat()));
-	state->addParameter(sName);
-	state->addParameter(sValue);
+	foreach (const StateList::value_type &state, states)
+		if (state.first.compare(pState, Qt::CaseInsensitive) == 0)
+			return qMakePair(state.first, (float) state.second);
 
-	return state;
+	//we get the first state in the table
+	return qMakePair(states.first().first, (float) states.first().second);
 }
 
 //! 
@@ -753,21 +654,20 @@ QString PoemAnalyserNode::setLineProsodyTagging( QString poemLine, QString lStat
 
 QString PoemAnalyserNode::setPitchTagging(QString poemLine, QString lState, float wValue)
 {
-	QRegExp rx1("[\"!#$%&()*+,./:;?@_{|}~-]");	
+	const int stateIndex = transformStringToNumber(lState);
+	if (stateIndex < 0)
+		return poemLine;
+
 	QStringList listWords = poemLine.split(" ");
 
 	for (int i=0; i<listWords.size(); i++)
 	{
 		QString word = listWords.at(i);
-		QString wordTmp = listWords.at(i);
-		wordTmp = wordTmp.remove(rx1).toLower();
+		const WordStates *states = findWord(word);
 
-		ParameterGroup* group = m_wordAnalysisGroup->getParameterGroup(wordTmp);
-
-		if (group != 0)
+		if (states != 0)
 		{
-			Parameter *p = group->getParameter(lState+"Parameter");
-			float val = p->getValue().toFloat();
+			float val = states->values[stateIndex];
 
 			if (val != 0)
 			{
@@ -816,7 +716,7 @@ char PoemAnalyserNode::getFirstCharacter( QString line )
 }
 
 //! to get rid of words that do not have meaning and biased the result
-bool PoemAnalyserNode::wordIsOk( QString word )
+bool PoemAnalyserNode::wordIsOk( QString word ) const
 {
 	bool isOk = true;
 
@@ -832,7 +732,7 @@ bool PoemAnalyserNode::wordIsOk( QString word )
 }
 
 
-QString PoemAnalyserNode::transformNumberToString(int number){
+QString PoemAnalyserNode::transformNumberToString(int number) const {
 
 	QString state;
 
@@ -877,28 +777,7 @@ QString PoemAnalyserNode::transformNumberToString(int number){
 
 int PoemAnalyserNode::transformStringToNumber(QString state)
 {
-	if (state.toLower().compare("pleasant"))
-		return PLEASANT;
-	else if (state.toLower().compare("nice"))
-		return NICE;
-	else if (state.toLower().compare("passive"))
-		return PASSIVE;
-	else if (state.toLower().compare("sad"))
-		return SAD;
-	else if(state.toLower().compare("unpleasant"))
-		return UNPLEASANT;
-	else if (state.toLower().compare("nasty"))
-		return NASTY;
-	else if (state.toLower().compare("active"))
-		return ACTIVE;
-	else if (state.toLower().compare("fun"))
-		return FUN;
-	else if (state.toLower().compare("himagery"))
-		return HIMAGERY;
-	else if (state.toLower().compare("loimagery"))
-		return LOIMAGERY;
-	else
-		return -1;
+	return PoemLexicon::getStateIndex(state);
 }
 
 //!
@@ -44,6 +44,9 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <QtWidgets>
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include "PoemLexicon.h"
 
 // OGRE
 #include <Ogre.h>
@@ -98,7 +101,18 @@ private slots:
 
 private:
 
-	ParameterGroup *m_wordAnalysisGroup;
+	//!
+	//! The values of the states of a lexicon word, indexed like the states
+	//! of transformNumberToString().
+	//!
+	typedef PoemLexicon::WordStates WordStates;
+
+	//!
+	//! List of state names and their values in a line.
+	//!
+	typedef QList<QPair<QString, int> > StateList;
+
+	PoemLexicon m_lexicon;
 	ParameterGroup *m_poemAnalysisGroup;
 	ParameterGroup *m_poemTextGroup;
 	NumberParameter *m_buttonParameter;
@@ -119,21 +133,29 @@ private:
 	QString setLineProsodyTagging( QString poemLine, QString lState, float lValue, ParameterGroup* poemState);
 	QString setPitchTagging( QString poemLine, QString lState, float wValue );
 		
-	QTableWidget*	getLineStates(QString line, QTableWidget* table);
-	QTableWidget *	getLinePredominantState( QTableWidget * tStates );
+	void			getLineStates( const QString &line, int *stateValues ) const;
+	StateList		getLinePredominantState( const int *stateValues ) const;
 	ParameterGroup* getPoemState();
-	ParameterGroup* getLineTaggingState( QTableWidget * tStates, ParameterGroup * poemState );
+	QPair<QString, float> getLineTaggingState( const StateList &states, ParameterGroup * poemState ) const;
 	char			getLastCharacter( QString line );
 	char			getFirstCharacter( QString lineTmp );
 
 	void checkNegationInLines( QString line );
 	void writePoemInFile( QString poemXML );
 	int transformStringToNumber(QString state);
-	QString transformNumberToString(int number);
-	bool wordIsOk(QString word);
+	QString transformNumberToString(int number) const;
+	bool wordIsOk(QString word) const;
 
 	QFile * fileManagement(QString filename, QString mode);
 
+	//!
+	//! Returns the lexicon entry of the given word of a poem line.
+	//!
+	//! \param word The word as it appears in the line.
+	//! \return The state values of the word or 0 if the word is unknown.
+	//!
+	const WordStates * findWord( QString word ) const;
+
 public:
 
 
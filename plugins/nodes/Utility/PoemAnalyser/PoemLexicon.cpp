@@ -0,0 +1,242 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "PoemLexicon.cpp"
+//! \brief Implementation file for PoemLexicon class.
+//!
+//! \version    1.0
+//! \date       19.10.2026 (created)
+//!
+
+#include "PoemLexicon.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QStringList>
+
+
+namespace PoemAnalyserNode {
+
+#define LEXICON_CACHE_MAGIC		0x50414c58	// "PALX"
+#define LEXICON_CACHE_VERSION	1
+
+
+//!
+//! Returns the state of the given state name.
+//!
+//! \param state The name of the state, in any case.
+//! \return The State or -1 if the name is unknown.
+//!
+int PoemLexicon::getStateIndex( QString state )
+{
+	state = state.toLower();
+
+	if (state == "pleasant")
+		return Pleasant;
+	else if (state == "nice")
+		return Nice;
+	else if (state == "passive")
+		return Passive;
+	else if (state == "sad")
+		return Sad;
+	else if (state == "unpleasant")
+		return Unpleasant;
+	else if (state == "nasty")
+		return Nasty;
+	else if (state == "active")
+		return Active;
+	else if (state == "fun")
+		return Fun;
+	else if (state == "himagery")
+		return HImagery;
+	else if (state == "loimagery")
+		return LoImagery;
+	else
+		return -1;
+}
+
+
+//!
+//! Returns the name of the cache file of the given DAT file.
+//!
+//! \param filename The name of the DAT file.
+//! \return The name of the cache file.
+//!
+QString PoemLexicon::getCacheFilename( const QString &filename )
+{
+	return filename + ".lexicon";
+}
+
+
+//!
+//! Parses the lines of a DAT file into the lexicon. The first entry of a
+//! word is kept.
+//!
+//! \param stream The text of the DAT file, starting with the header line.
+//!
+void PoemLexicon::parse( QTextStream &stream )
+{
+	const QStringList stateNames = stream.readLine().split(',');
+
+	// Explanation: The first line is of the form: sample,word,emotion,activation,kpleasant,kactive,imagery,frequency,pleasant,nice,passive,sad,unpleasant,nasty,active,fun,himagery,loimagery
+	// From this, we just need the word (position 1) and the last 10 elements.
+	// Emotion and activation are not used for the tagging and are not stored.
+
+	// map the last 10 columns to the state indices once
+	int stateColumns[NumStates];
+	const int lengthNames = stateNames.length();
+	for (int i=1; i<=NumStates; i++)
+		stateColumns[i-1] = lengthNames-i >= 0 ? getStateIndex(stateNames.at(lengthNames-i)) : -1;
+
+	while(!stream.atEnd())
+	{
+		const QStringList wordValues = stream.readLine().split(',');
+		const int lengthValues = wordValues.length();
+		if (lengthValues < 2 + NumStates)
+			continue;
+
+		//Look for position 1 (second word) to get the name, the first entry of a word is kept
+		const QString wordName = wordValues.at(1).toLower();
+		if (m_words.contains(wordName))
+			continue;
+
+		// to get nice,pleasant,fun,active,nasty,unpleasant,sad,passive,himagery,loimagery (empty values are 0)
+		WordStates states;
+		for (int i=0; i<NumStates; i++)
+			states.values[i] = 0;
+		for (int i=1; i<=NumStates; i++)
+			if (stateColumns[i-1] >= 0)
+				states.values[stateColumns[i-1]] = wordValues.at(lengthValues-i).toInt();
+
+		m_words.insert(wordName, states);
+	}
+}
+
+
+//!
+//! Reads the lexicon from the binary cache file of the given DAT file.
+//!
+//! \param filename The name of the DAT file.
+//! \return True if the cache exists and is up to date, otherwise False.
+//!
+bool PoemLexicon::readCache( const QString &filename )
+{
+	const QFileInfo datInfo (filename);
+	QFile cacheFile (getCacheFilename(filename));
+	if (!cacheFile.open(QFile::ReadOnly))
+		return false;
+
+	QDataStream ds(&cacheFile);
+	quint32 magic, version;
+	qint64 datSize;
+	QDateTime datModified;
+	qint32 count;
+	ds >> magic >> version >> datSize >> datModified >> count;
+
+	// only use a cache of the current DAT file
+	if (ds.status() != QDataStream::Ok || magic != LEXICON_CACHE_MAGIC || version != LEXICON_CACHE_VERSION ||
+		datSize != datInfo.size() || datModified != datInfo.lastModified() || count < 0)
+		return false;
+
+	m_words.reserve(count);
+	QString word;
+	WordStates states;
+	for (qint32 i=0; i<count; i++)
+	{
+		ds >> word;
+		for (int j=0; j<NumStates; j++)
+			ds >> states.values[j];
+		m_words.insert(word, states);
+	}
+
+	if (ds.status() != QDataStream::Ok)
+	{
+		m_words.clear();
+		return false;
+	}
+	return true;
+}
+
+
+//!
+//! Writes the lexicon to the binary cache file of the given DAT file.
+//!
+//! \param filename The name of the DAT file.
+//! \return True if the cache file was written.
+//!
+bool PoemLexicon::writeCache( const QString &filename ) const
+{
+	const QFileInfo datInfo (filename);
+	const QString cacheFilename = getCacheFilename(filename);
+
+	// write to a temporary file and rename it, so a node reading the same
+	// DAT file never reads a partially written cache file
+	const QString tempFilename = QString("%1.%2.tmp").arg(cacheFilename).arg(QCoreApplication::applicationPid());
+	QFile cacheFile (tempFilename);
+	if (!cacheFile.open(QFile::WriteOnly))
+		return false;
+
+	QDataStream ds(&cacheFile);
+	ds << (quint32) LEXICON_CACHE_MAGIC << (quint32) LEXICON_CACHE_VERSION << (qint64) datInfo.size() << datInfo.lastModified() << (qint32) m_words.size();
+
+	for (QHash<QString, WordStates>::const_iterator iter = m_words.constBegin(); iter != m_words.constEnd(); ++iter)
+	{
+		ds << iter.key();
+		for (int j=0; j<NumStates; j++)
+			ds << iter.value().values[j];
+	}
+	cacheFile.close();
+
+	if (ds.status() != QDataStream::Ok || cacheFile.error() != QFile::NoError)
+	{
+		QFile::remove(tempFilename);
+		return false;
+	}
+
+	QFile::remove(cacheFilename);
+	if (!QFile::rename(tempFilename, cacheFilename))
+	{
+		QFile::remove(tempFilename);
+		// another node may have written the cache in the meantime
+		return QFile::exists(cacheFilename);
+	}
+	return true;
+}
+
+
+//!
+//! Returns the state values of the given lower case word.
+//!
+//! \param word The word.
+//! \return The state values of the word or 0 if the word is unknown.
+//!
+const PoemLexicon::WordStates * PoemLexicon::find( const QString &word ) const
+{
+	QHash<QString, WordStates>::const_iterator iter = m_words.constFind(word);
+	return iter != m_words.constEnd() ? &iter.value() : 0;
+}
+
+} // namespace PoemAnalyserNode
@@ -0,0 +1,144 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "PoemLexicon.h"
+//! \brief Header file for PoemLexicon class.
+//!
+//! \version    1.0
+//! \date       19.10.2026 (created)
+//!
+//! \description
+//!		The lexicon of the WDAL (Whissell Dictionary of Affect in Language) DAT file,
+//!		mapping every word to its state values. It does not depend on the node, so it
+//!		can be loaded without a PoemAnalyserNode.
+//!
+
+#ifndef POEMLEXICON_H
+#define POEMLEXICON_H
+
+#include <QtCore/QString>
+#include <QtCore/QHash>
+#include <QtCore/QTextStream>
+
+namespace PoemAnalyserNode {
+
+//!
+//! Class for the lexicon of a DAT file.
+//!
+class PoemLexicon
+{
+
+public: // nested type definitions
+
+	//!
+	//! The states of a word, in the order of PoemAnalyserNode::transformNumberToString().
+	//!
+	enum State {
+		Pleasant,
+		Nice,
+		Passive,
+		Sad,
+		Unpleasant,
+		Nasty,
+		Active,
+		Fun,
+		HImagery,
+		LoImagery,
+		NumStates
+	};
+
+	//!
+	//! The values of the states of a lexicon word, indexed by State.
+	//!
+	struct WordStates
+	{
+		qint32 values[NumStates];
+	};
+
+public: // functions
+
+	//!
+	//! Returns the state of the given state name.
+	//!
+	//! \param state The name of the state, in any case.
+	//! \return The State or -1 if the name is unknown.
+	//!
+	static int getStateIndex ( QString state );
+
+	//!
+	//! Returns the name of the cache file of the given DAT file.
+	//!
+	static QString getCacheFilename ( const QString &filename );
+
+	//!
+	//! Parses the lines of a DAT file into the lexicon. The first entry of
+	//! a word is kept.
+	//!
+	//! \param stream The text of the DAT file, starting with the header line.
+	//!
+	void parse ( QTextStream &stream );
+
+	//!
+	//! Reads the lexicon from the binary cache file of the given DAT file.
+	//!
+	//! \param filename The name of the DAT file.
+	//! \return True if the cache exists and is up to date, otherwise False.
+	//!
+	bool readCache ( const QString &filename );
+
+	//!
+	//! Writes the lexicon to the binary cache file of the given DAT file.
+	//! Readers never see a partially written cache file.
+	//!
+	//! \param filename The name of the DAT file.
+	//! \return True if the cache file was written.
+	//!
+	bool writeCache ( const QString &filename ) const;
+
+	//!
+	//! Returns the state values of the given lower case word.
+	//!
+	//! \param word The word.
+	//! \return The state values of the word or 0 if the word is unknown.
+	//!
+	const WordStates * find ( const QString &word ) const;
+
+	//!
+	//! Returns the number of words.
+	//!
+	int size () const { return m_words.size(); }
+
+	//!
+	//! Removes all words.
+	//!
+	void clear () { m_words.clear(); }
+
+private: // data
+
+	QHash<QString, WordStates> m_words;
+};
+
+} // namespace PoemAnalyserNode
+
+#endif
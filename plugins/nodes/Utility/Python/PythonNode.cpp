@@ -31,40 +31,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 //!
 
 #include "PythonNode.h"
-#include <iostream>
-#include <boost/python.hpp>
-#include <QtCore/QDir>
-
-#define str(s) #s
-
-static QString log_buffer("");
-
-void write_to_frapper_log( const char* text ) {
-
-	QString msg(text);
-	QStringList lines = msg.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
-
-	// write all lines except the last to frapper log, starting with the previously buffered output
-	for( size_t i = 0; i< lines.size()-1; i++){		
-		if( i==0) {
-			Frapper::Log::info( log_buffer, "PythonNode::execute");
-			log_buffer = "";
-		}
-		Frapper::Log::info( lines[i], "PythonNode::execute");
-	}
-
-	// store last line in buffer if fragment
-	if( lines.size() > 0 && !msg.endsWith("\n")) {
-		log_buffer += lines.last();
-	} else {
-		Frapper::Log::info( lines.last(), "PythonNode::execute");
-	}
-}
-
-BOOST_PYTHON_MODULE(pythonnode)
-{
-	boost::python::def("write", write_to_frapper_log);
-}
+#include <QtCore/QElapsedTimer>
 
 namespace PythonNode {
 using namespace Frapper;
@@ -81,9 +48,15 @@ using namespace Frapper;
 //! \param parameterRoot A copy of the parameter tree specific for the type of the node.
 //!
 PythonNode::PythonNode ( const QString &name, ParameterGroup *parameterRoot ) :
-    Node(name, parameterRoot)
+    Node(name, parameterRoot),
+	m_namespace(NULL),
+	m_values(2*NumValues, 0.0)
 {
 	setCommandFunction("Execute Script", SLOT(runScript()));
+	setCommandFunction("Reset Namespace", SLOT(resetNamespace()));
+
+	for( int i = 0; i < NumValues; i++)
+		setProcessingFunction(QString("Values > Output %1").arg(i+1), SLOT(processOutputs()));
 }
 
 
@@ -96,26 +69,86 @@ PythonNode::PythonNode ( const QString &name, ParameterGroup *parameterRoot ) :
 //!
 PythonNode::~PythonNode ()
 {
+	resetNamespace();
 }
 
+//!
+//! Runs the script in the node's namespace.
+//!
 void PythonNode::runScript()
 {
-	//StreamListener s(std::cout);
-	
-	Py_Initialize();
-		
-	QString script = getStringValue("Script");
-	QString path = QDir::currentPath()+"/plugins/nodes";
-	QString setpath = "os.environ['PATH'] = '" + path + "';os.environ['PATH']";
-
-	PyRun_SimpleString( "import os");
-	PyRun_SimpleString( setpath.toStdString().c_str());
-	PyRun_SimpleString( "import pythonnode");	
-	PyRun_SimpleString( "import sys");	
-	PyRun_SimpleString( "sys.stdout = FrapperLog");	
-	PyRun_SimpleString( "sys.stderr = FrapperLog");	
-	PyRun_SimpleString( script.toStdString().c_str());
-	Py_Finalize();
+	execute(true);
+}
+
+//!
+//! Processing function of the output values, runs the script if the
+//! node is set to run on evaluation.
+//!
+void PythonNode::processOutputs()
+{
+	if( getBoolValue("Run On Evaluation"))
+		execute(false);
+}
+
+//!
+//! Drops the node's namespace and all state the script built in it.
+//!
+void PythonNode::resetNamespace()
+{
+	// the namespace died with the interpreter if the application already shut down
+	if( m_namespace && PythonRuntime::isRunning()) {
+		PythonRuntime::instance().releaseNamespace(m_namespace);
+	}
+	m_namespace = NULL;
+}
+
+///
+/// Private Functions
+///
+
+//!
+//! Exposes the input values to the script, runs it and writes back the
+//! output values.
+//!
+void PythonNode::execute( bool triggerDirtying )
+{
+	if( !createNamespace())
+		return;
+
+	for( int i = 0; i < NumValues; i++)
+		m_values[i] = getDoubleValue(QString("Values > Input %1").arg(i+1), true);
+
+	QElapsedTimer timer;
+	timer.start();
+
+	PythonRuntime::instance().execute(getStringValue("Script"), getName(), m_namespace);
+
+	Log::debug(QString("Script executed in %1 us.").arg(timer.nsecsElapsed() / 1000), "PythonNode::runScript");
+
+	for( int i = 0; i < NumValues; i++)
+		setValue(QString("Values > Output %1").arg(i+1), m_values[NumValues+i], triggerDirtying);
+}
+
+//!
+//! Creates the node's namespace and exposes the values buffer in it.
+//!
+//! \return True if the namespace is available.
+//!
+bool PythonNode::createNamespace()
+{
+	if( m_namespace )
+		return true;
+
+	PythonRuntime &runtime = PythonRuntime::instance();
+	m_namespace = runtime.createNamespace(getName());
+	if( !m_namespace ) {
+		Log::error("The Python interpreter is not available.", "PythonNode::createNamespace");
+		return false;
+	}
+
+	// m_values is never resized, the buffer stays valid for the lifetime of the namespace
+	runtime.setBuffer(m_namespace, "values", m_values.data(), m_values.size()*sizeof(double));
+	return true;
 }
 
 } // namespace PythonNode 
@@ -42,16 +42,9 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #endif
 
 // Python API
-#ifdef _DEBUG
-/* We don't want to debug Python and most distribution packages come without python debug library
- * Be sure to include python.h _after_ including standart headers like <stdio.h>, <string.h>, <errno.h>, 
- * <limits.h>, <assert.h> and <stdlib.h>, otherwise you will get strange linker errors. */
-	#undef _DEBUG
-		#include <Python.h> 
-	#define _DEBUG
-#else
-	#include <Python.h>
-#endif
+#include "PythonRuntime.h"
+
+#include <QtCore/QVector>
 
 namespace PythonNode {
 using namespace Frapper;
@@ -86,8 +79,57 @@ public: // constructors and destructors
 
 protected slots:
 
+	//!
+	//! Runs the script in the node's namespace.
+	//!
 	void runScript();
 
+	//!
+	//! Processing function of the output values, runs the script if the
+	//! node is set to run on evaluation.
+	//!
+	void processOutputs();
+
+	//!
+	//! Drops the node's namespace and all state the script built in it.
+	//!
+	void resetNamespace();
+
+private: // functions
+
+	//!
+	//! Exposes the input values to the script, runs it and writes back the
+	//! output values.
+	//!
+	//! \param triggerDirtying Flag to control whether to dirty the outputs.
+	//!
+	void execute ( bool triggerDirtying );
+
+	//!
+	//! Creates the node's namespace and exposes the values buffer in it.
+	//!
+	//! \return True if the namespace is available.
+	//!
+	bool createNamespace();
+
+private: // data
+
+	//!
+	//! Number of input and output values exposed to the script.
+	//!
+	static const int NumValues = 4;
+
+	//!
+	//! The node's namespace in the shared interpreter.
+	//!
+	PyObject *m_namespace;
+
+	//!
+	//! The input values followed by the output values, exposed to the script
+	//! as read-write buffer named "values".
+	//!
+	QVector<double> m_values;
+
 };
 
 } // namespace PythonNode 
@@ -0,0 +1,313 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "PythonRuntime.cpp"
+//! \brief Implementation file for PythonRuntime class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "PythonRuntime.h"
+#include "Log.h"
+#include <boost/python.hpp>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRegExp>
+#include <QtCore/QStringList>
+
+static QString log_buffer("");
+
+void write_to_frapper_log( const char* text ) {
+
+	// continue the previously buffered fragment
+	QString msg = log_buffer + QString(text);
+	log_buffer = "";
+
+	QStringList lines = msg.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
+	if( lines.isEmpty())
+		return;
+
+	// write all complete lines to frapper log, store last line in buffer if fragment
+	if( !msg.endsWith("\n") && !msg.endsWith("\r"))
+		log_buffer = lines.takeLast();
+
+	foreach( const QString &line, lines)
+		Frapper::Log::info( line, "PythonNode::execute");
+}
+
+BOOST_PYTHON_MODULE(pythonnode)
+{
+	boost::python::def("write", write_to_frapper_log);
+}
+
+namespace PythonNode {
+using namespace Frapper;
+
+static PythonRuntime *s_runtime = 0;
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the PythonRuntime class.
+//!
+//! Registers the pythonnode module, initializes the interpreter and
+//! redirects the Python output to the Frapper log once.
+//!
+PythonRuntime::PythonRuntime () :
+	m_initialized(false)
+{
+	if( PyImport_AppendInittab( const_cast<char *>("pythonnode"), initpythonnode ) == -1) {
+		Log::error("Could not register the pythonnode module.", "PythonRuntime::PythonRuntime");
+		return;
+	}
+
+	Py_Initialize();
+	m_initialized = Py_IsInitialized() != 0;
+	if( !m_initialized ) {
+		Log::error("Could not initialize the Python interpreter.", "PythonRuntime::PythonRuntime");
+		return;
+	}
+
+	QString path = QDir::currentPath()+"/plugins/nodes";
+	QString setpath = "os.environ['PATH'] = '" + path + "' + os.pathsep + os.environ.get('PATH', '')";
+
+	PyRun_SimpleString( "import os");
+	PyRun_SimpleString( setpath.toStdString().c_str());
+	PyRun_SimpleString( "import pythonnode");
+	PyRun_SimpleString( "import sys");
+	PyRun_SimpleString( "sys.stdout = pythonnode");
+	PyRun_SimpleString( "sys.stderr = pythonnode");
+}
+
+
+//!
+//! Destructor of the PythonRuntime class.
+//!
+PythonRuntime::~PythonRuntime ()
+{
+	if( m_initialized ) {
+		foreach( PyObject *code, m_codeCache)
+			Py_XDECREF(code);
+		m_codeCache.clear();
+		m_codeCacheOrder.clear();
+		Py_Finalize();
+	}
+}
+
+
+///
+/// Public Static Functions
+///
+
+
+//!
+//! Returns the runtime, initializing the interpreter on first use.
+//!
+//! \return The process wide runtime.
+//!
+PythonRuntime & PythonRuntime::instance ()
+{
+	if( !s_runtime ) {
+		s_runtime = new PythonRuntime();
+		qAddPostRoutine(PythonRuntime::shutdown);
+	}
+	return *s_runtime;
+}
+
+
+//!
+//! Returns whether the runtime exists and was not shut down yet.
+//!
+bool PythonRuntime::isRunning ()
+{
+	return s_runtime != 0;
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Returns whether the interpreter is initialized.
+//!
+bool PythonRuntime::isInitialized () const
+{
+	return m_initialized;
+}
+
+
+//!
+//! Creates a new module namespace for a node.
+//!
+//! \param name The value of __name__ in the new namespace.
+//! \return A new reference to the namespace dictionary or NULL.
+//!
+PyObject * PythonRuntime::createNamespace ( const QString &name )
+{
+	QMutexLocker locker(&m_mutex);
+	if( !m_initialized )
+		return NULL;
+
+	PyObject *ns = PyDict_New();
+	PyObject *moduleName = PyString_FromString(name.toStdString().c_str());
+	PyDict_SetItemString(ns, "__builtins__", PyEval_GetBuiltins());
+	PyDict_SetItemString(ns, "__name__", moduleName);
+	Py_XDECREF(moduleName);
+	return ns;
+}
+
+
+//!
+//! Releases a namespace created with createNamespace().
+//!
+//! \param ns The namespace dictionary.
+//!
+void PythonRuntime::releaseNamespace ( PyObject *ns )
+{
+	QMutexLocker locker(&m_mutex);
+	if( m_initialized && ns ) {
+		// break reference cycles between the script's globals and functions
+		PyDict_Clear(ns);
+		Py_DECREF(ns);
+	}
+}
+
+
+//!
+//! Stores a read-write buffer view onto the given memory in the namespace.
+//! The memory must stay valid as long as the namespace exists.
+//!
+//! \param ns The namespace dictionary.
+//! \param name The variable name of the buffer.
+//! \param data The memory to expose.
+//! \param size The size of the memory in bytes.
+//!
+void PythonRuntime::setBuffer ( PyObject *ns, const char *name, void *data, int size )
+{
+	QMutexLocker locker(&m_mutex);
+	if( !m_initialized || !ns )
+		return;
+
+	PyObject *buffer = PyBuffer_FromReadWriteMemory(data, size);
+	if( buffer ) {
+		PyDict_SetItemString(ns, name, buffer);
+		Py_DECREF(buffer);
+	} else {
+		PyErr_Print();
+	}
+}
+
+
+//!
+//! Executes the given source in the given namespace. The source is only
+//! compiled if no cached code object for the same source exists.
+//!
+//! \param source The script source.
+//! \param fileName The file name used in tracebacks.
+//! \param ns The namespace dictionary.
+//! \return True if the script ran without an exception.
+//!
+bool PythonRuntime::execute ( const QString &source, const QString &fileName, PyObject *ns )
+{
+	QMutexLocker locker(&m_mutex);
+	if( !m_initialized || !ns )
+		return false;
+
+	PyObject *code = getCode(source.toUtf8(), fileName);
+	if( !code )
+		return false;
+
+	PyObject *result = PyEval_EvalCode((PyCodeObject *) code, ns, ns);
+	if( !result ) {
+		PyErr_Print();
+		return false;
+	}
+
+	Py_DECREF(result);
+	return true;
+}
+
+
+///
+/// Private Functions
+///
+
+
+//!
+//! Returns the cached code object of the given source, compiling it if
+//! necessary. When the cache is full, the least recently used code
+//! object is dropped. Must be called with the mutex locked.
+//!
+PyObject * PythonRuntime::getCode ( const QByteArray &source, const QString &fileName )
+{
+	const QByteArray key = QCryptographicHash::hash(source, QCryptographicHash::Sha1);
+
+	QHash<QByteArray, PyObject *>::const_iterator iter = m_codeCache.constFind(key);
+	if( iter != m_codeCache.constEnd()) {
+		// mark the entry as most recently used, unless it already is
+		if( m_codeCacheOrder.last() != key ) {
+			m_codeCacheOrder.removeOne(key);
+			m_codeCacheOrder.append(key);
+		}
+		return iter.value();
+	}
+
+	PyObject *code = Py_CompileString(source.constData(), fileName.toStdString().c_str(), Py_file_input);
+	if( !code ) {
+		PyErr_Print();
+		return NULL;
+	}
+
+	// scripts being edited produce a new entry per change, keep the cache
+	// bounded without dropping the scripts of the other nodes
+	if( m_codeCache.size() >= MaxCachedScripts ) {
+		const QByteArray leastRecentKey = m_codeCacheOrder.takeFirst();
+		Py_XDECREF(m_codeCache.take(leastRecentKey));
+	}
+
+	m_codeCache.insert(key, code);
+	m_codeCacheOrder.append(key);
+	return code;
+}
+
+
+//!
+//! Drops all cached code objects and finalizes the interpreter. Called
+//! when the application shuts down.
+//!
+void PythonRuntime::shutdown ()
+{
+	delete s_runtime;
+	s_runtime = 0;
+}
+
+} // namespace PythonNode
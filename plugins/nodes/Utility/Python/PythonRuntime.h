@@ -0,0 +1,181 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "PythonRuntime.h"
+//! \brief Header file for PythonRuntime class.
+//!
+//! The runtime keeps one embedded Python interpreter alive for the whole
+//! process instead of initializing and finalizing it for every script run.
+//! Compiled scripts are cached by the hash of their source and every Python
+//! node executes in its own namespace, so state survives between runs.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef PYTHONRUNTIME_H
+#define PYTHONRUNTIME_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// Python API
+#ifdef _DEBUG
+/* We don't want to debug Python and most distribution packages come without python debug library
+ * Be sure to include python.h _after_ including standart headers like <stdio.h>, <string.h>, <errno.h>, 
+ * <limits.h>, <assert.h> and <stdlib.h>, otherwise you will get strange linker errors. */
+	#undef _DEBUG
+		#include <Python.h> 
+	#define _DEBUG
+#else
+	#include <Python.h>
+#endif
+
+namespace PythonNode {
+
+//!
+//! Process-lifetime embedded Python interpreter shared by all Python nodes.
+//!
+class PythonRuntime
+{
+
+public: // static functions
+
+    //!
+    //! Returns the runtime, initializing the interpreter on first use.
+    //!
+    //! \return The process wide runtime.
+    //!
+    static PythonRuntime & instance ();
+
+    //!
+    //! Returns whether the runtime exists and was not shut down yet.
+    //!
+    static bool isRunning ();
+
+public: // functions
+
+    //!
+    //! Returns whether the interpreter is initialized.
+    //!
+    bool isInitialized () const;
+
+    //!
+    //! Creates a new module namespace for a node.
+    //!
+    //! \param name The value of __name__ in the new namespace.
+    //! \return A new reference to the namespace dictionary or NULL.
+    //!
+    PyObject * createNamespace ( const QString &name );
+
+    //!
+    //! Releases a namespace created with createNamespace().
+    //!
+    //! \param ns The namespace dictionary.
+    //!
+    void releaseNamespace ( PyObject *ns );
+
+    //!
+    //! Stores a read-write buffer view onto the given memory in the namespace.
+    //! The memory must stay valid as long as the namespace exists.
+    //!
+    //! \param ns The namespace dictionary.
+    //! \param name The variable name of the buffer.
+    //! \param data The memory to expose.
+    //! \param size The size of the memory in bytes.
+    //!
+    void setBuffer ( PyObject *ns, const char *name, void *data, int size );
+
+    //!
+    //! Executes the given source in the given namespace. The source is only
+    //! compiled if no cached code object for the same source exists.
+    //!
+    //! \param source The script source.
+    //! \param fileName The file name used in tracebacks.
+    //! \param ns The namespace dictionary.
+    //! \return True if the script ran without an exception.
+    //!
+    bool execute ( const QString &source, const QString &fileName, PyObject *ns );
+
+private: // constructors and destructors
+
+    //!
+    //! Constructor of the PythonRuntime class.
+    //!
+    PythonRuntime ();
+
+    //!
+    //! Destructor of the PythonRuntime class.
+    //!
+    ~PythonRuntime ();
+
+private: // functions
+
+    //!
+    //! Returns the cached code object of the given source, compiling it if
+    //! necessary. When the cache is full, the least recently used code
+    //! object is dropped. Must be called with the mutex locked.
+    //!
+    PyObject * getCode ( const QByteArray &source, const QString &fileName );
+
+    //!
+    //! Drops all cached code objects and finalizes the interpreter. Called
+    //! when the application shuts down.
+    //!
+    static void shutdown ();
+
+private: // data
+
+    //!
+    //! Max number of cached code objects.
+    //!
+    static const int MaxCachedScripts = 64;
+
+    //!
+    //! Flag that states whether the interpreter is initialized.
+    //!
+    bool m_initialized;
+
+    //!
+    //! Cached code objects keyed by the hash of their source.
+    //!
+    QHash<QByteArray, PyObject *> m_codeCache;
+
+    //!
+    //! The keys of the cached code objects, least recently used first.
+    //!
+    QList<QByteArray> m_codeCacheOrder;
+
+    //!
+    //! Serializes all calls into the interpreter.
+    //!
+    mutable QMutex m_mutex;
+};
+
+} // namespace PythonNode
+
+#endif
@@ -78,7 +78,8 @@ S3DGame::S3DGame ( const QString &name, ParameterGroup *parameterRoot ) :
     mLavaTimer(0.0f),
     mEndScreenTime(0),
     mEndScreenTimeMax(15),
-    mElapsed(0)
+    mElapsed(0),
+    mTutorialPath(NULL)
 {
     // Connect the frapper-timebar signal with the update function of the game
     connect(this, SIGNAL(frameChanged(int)), SLOT(updateGame()));
@@ -86,6 +87,8 @@ S3DGame::S3DGame ( const QString &name, ParameterGroup *parameterRoot ) :
 
     // Create door animation object and connect with animation parameter
     mDoor = new AnimatedDoor( this->getNumberParameter("DoorOpenAnim"), 0.02f);
+
+    mSimulationClock.start();
 }
 
 //!
@@ -142,7 +145,7 @@ void S3DGame::timerEvent()
 }
 
 //!
-//! Slot which is called on timer update.
+//! Slot which is called on new frame.
 //!
 void S3DGame::updateGame()
 {
@@ -152,29 +155,38 @@ void S3DGame::updateGame()
         return;
     }
 
+    // The game logic advances in fixed steps of real time, independent of
+    // the rate of the frame updates
+    const int stepLength = 1000 / qMax( mSimulationRate, 1 );
+    const int steps = mSimulationSteps.Advance( mSimulationClock.elapsed(), stepLength );
+
+    for( int step = 0; step < steps; step++ )
+    {
+        StepGame();
+
+        // the game may have lost its path on reset
+        if( !CheckReady() )
+            return;
+    }
+
+    if( steps > 0 )
+        UpdateOutputs();
+}
+
+//!
+//! Advances the game logic by one fixed step.
+//!
+void S3DGame::StepGame()
+{
     if( mEndScreenTime > 0 )
     {
         // End screen fade in
         if( mEndScreenTime < mEndScreenTimeMax)
             mEndScreenTime++;
         mEndScreen->setValue(QVariant(mEndScreenTime / (float) mEndScreenTimeMax * mAnimScale ), true);
-
-        // output time
-        QTime time = QTime(0,0,0,0).addMSecs( mElapsed );
-        this->setValue("Stopwatch", "YOUR TIME IS "+time.toString("mm:ss.zzz")+"!", true);
         return;
     }
 
-    // update stopwatch
-    int elapsed = mTime.elapsed();
-    if( elapsed - mElapsed > 200 )
-    {
-        mElapsed = elapsed;
-        QTime time = QTime(0,0,0,0).addMSecs( elapsed );
-        this->setValue("Stopwatch", time.toString("mm:ss.zzz"), true);
-    }
-
-
     // Update Platforms according to timing
     UpdatePlatforms();
 
@@ -275,8 +287,42 @@ void S3DGame::updateGame()
     // reset input actions
     mP1Action = false;
     mP2Action = false;
+}
+
+//!
+//! Writes the state of the game logic to the render outputs.
+//!
+void S3DGame::UpdateOutputs()
+{
+    if( mEndScreenTime > 0 )
+    {
+        // output time
+        QTime time = QTime(0,0,0,0).addMSecs( mElapsed );
+        this->setValue("Stopwatch", "YOUR TIME IS "+time.toString("mm:ss.zzz")+"!", true);
+    }
+    else
+    {
+        // update stopwatch
+        int elapsed = mTime.elapsed();
+        if( elapsed - mElapsed > 200 )
+        {
+            mElapsed = elapsed;
+            QTime time = QTime(0,0,0,0).addMSecs( elapsed );
+            this->setValue("Stopwatch", time.toString("mm:ss.zzz"), true);
+        }
+    }
 
-};
+    mPCModelContainer->updateCopies();
+    S3DGameNode::UpdateCamera();
+
+    if( mPlatformMaterial.isNull() )
+        mPlatformMaterial = Ogre::MaterialManager::getSingleton().getByName("platformShader");
+    SetTransparency( mPlatformMaterial, mPlatform3Alpha );
+
+    if( mLavaMaterial.isNull() )
+        mLavaMaterial = Ogre::MaterialManager::getSingleton().getByName("LavaShader");
+    SetLavaTimer( mLavaMaterial, mLavaTimer );
+}
 
 
 void S3DGame::UpdateCharacter()
@@ -355,6 +401,15 @@ void S3DGame::UpdateCharacter()
 
 void S3DGame::ProcessEvents()
 {
+    const Vec3 &position = mPCModelTransform->getPosition();
+
+    // early out if the PC is outside of all events of the current path
+    if( !mCurrentPath->EventBounds().contains(position) )
+    {
+        mDoor->SetOpen(false);
+        return;
+    }
+
     QListIterator<GameEvent*> eventIter( mCurrentPath->Events() );
 
     bool doorOpen = false;
@@ -363,12 +418,12 @@ void S3DGame::ProcessEvents()
         GameEvent* g = eventIter.next();
 
         // check if event is active for the current PC markerPosition
-        if( g && g->isActive( mPCModelTransform->getPosition()) )
+        if( g && g->isActive( position ) )
         {
             // HACK to show end screen if checkpoint of current event says "finish"
-            if( !g->Checkpoint().isEmpty())
+            if( g->IsCheckpoint() )
             {
-                if( g->Checkpoint() == "finish" && !mEndScreenTime)
+                if( g->IsFinish() && !mEndScreenTime)
                 {
                     mEndScreenTime = 1;
                     // measure time
@@ -379,13 +434,14 @@ void S3DGame::ProcessEvents()
             }
 
             // check platforms
-            if( !g->Platform().isEmpty())
+            const GameEvent::PlatformType platform = g->GetPlatformType();
+            if( platform != GameEvent::NO_PLATFORM )
             {
-                if( g->Platform() == "Door" )
+                if( platform == GameEvent::DOOR )
                     doorOpen = true;
-                else if(( g->Platform() == "Platform1" && !mPlatform1 ) ||
-                        ( g->Platform() == "Platform2" && !mPlatform2 ) ||
-                        ( g->Platform() == "Platform3" && !mPlatform3 ) )
+                else if(( platform == GameEvent::PLATFORM1 && !mPlatform1 ) ||
+                        ( platform == GameEvent::PLATFORM2 && !mPlatform2 ) ||
+                        ( platform == GameEvent::PLATFORM3 && !mPlatform3 ) )
                 {
                     // player is on platform and platform is gone -> create fall path
                     mCreateFall = true;
@@ -474,7 +530,7 @@ void S3DGame::AdvanceToNextPath( Path* overNextPath /*= NULL*/ )
         CLAMP_LOWER( mPCLoopTime, 1);
 
         // HACK to blend out tutorial
-        if( mCurrentPath->Name() == "Path2" )
+        if( mCurrentPath == mTutorialPath )
             mRings->setValue(QVariant(0.0f), true);
     }
 
@@ -493,10 +549,6 @@ void S3DGame::UpdateCharacterPosition( Path* path, float alpha, float height )
 
     // Scale of PC
     mPCModelTransform->setScale(mScale, mScale, mScale);
-
-    mPCModelContainer->updateCopies();
-
-    S3DGameNode::UpdateCamera();
 }
 
 void S3DGame::PlayDeathAnim()
@@ -519,7 +571,11 @@ void S3DGame::loadReady()
     CopyAnimatedObjects();
 
     // update the game once everything is loaded
-    updateGame();
+    if( CheckReady() )
+    {
+        StepGame();
+        UpdateOutputs();
+    }
 }
 
 bool S3DGame::CheckReady()
@@ -540,10 +596,17 @@ void S3DGame::ResetGame()
     mEndScreen->setValue(QVariant(0.0f), true);
     mEndScreenTime = 0;
     mCheckpoint = NULL;
+
+    // resolve the handles used by the game loop, materials may have been reloaded
+    mTutorialPath = mEngine.GetPathByName( "Path2" );
+    mPlatformMaterial.setNull();
+    mLavaMaterial.setNull();
+
     AdvanceToNextPath();
 
     mTime.start();
     mElapsed = 0;
+    mSimulationSteps.DropLag();
 }
 
 
@@ -613,7 +676,6 @@ void S3DGame::UpdatePlatforms()
     else
         mPlatform3Alpha = 0.0f;
 
-    SetTransparency( "platformShader", mPlatform3Alpha );
 }
 
 float S3DGame::getPlatformMoveAlpha( float alpha )
@@ -672,8 +734,10 @@ void S3DGame::UpdateWorldObjects()
 void S3DGame::AnimateLava()
 {
     AdvanceTimeReset( mLavaTimer, mLavaStep, Ogre::Math::TWO_PI);
+}
 
-    Ogre::MaterialPtr materialPtr = Ogre::MaterialManager::getSingleton().getByName("LavaShader");
+void S3DGame::SetLavaTimer( const Ogre::MaterialPtr &materialPtr, float timer )
+{
     if( !materialPtr.isNull() )
     {
         Ogre::Pass* pass = materialPtr->getTechnique(0)->getPass(0); //1st pass, first texture unit
@@ -683,26 +747,25 @@ void S3DGame::AnimateLava()
             Ogre::GpuProgramParametersSharedPtr fpParams = pass->getFragmentProgramParameters();
             if ( !fpParams.isNull() && fpParams->_findNamedConstantDefinition("timer"))
             {
-                fpParams->setNamedConstant("timer", (Ogre::Real) sinf(mLavaTimer) );
+                fpParams->setNamedConstant("timer", (Ogre::Real) sinf(timer) );
             }
         }
     }
     else
     {
-        Log::error("LavaShader materialName not found!", "S3DGame::AnimateLava");
+        Log::error("LavaShader materialName not found!", "S3DGame::SetLavaTimer");
     }
 }
 
-void S3DGame::SetTransparency( QString materialName, float alpha )
+void S3DGame::SetTransparency( const Ogre::MaterialPtr &materialPtr, float alpha )
 {
-    Ogre::MaterialPtr materialPtr = Ogre::MaterialManager::getSingleton().getByName( materialName.toStdString() );
     if( !materialPtr.isNull() )
     {
         Ogre::TextureUnitState* ptus = materialPtr->getTechnique(0)->getPass(0)->getTextureUnitState(0); //1st pass, first texture unit
         ptus->setAlphaOperation(Ogre::LBX_MODULATE, Ogre::LBS_MANUAL, Ogre::LBS_TEXTURE, alpha );
     }
     else
-        Log::debug( materialName + " materialName not found!", "S3DGame::UpdatePlatforms");
+        Log::debug( "platformShader materialName not found!", "S3DGame::SetTransparency");
 }
 
 } // namespace S3DGameNode 
@@ -37,6 +37,7 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include "OgreTools.h"
 
 #include "S3DGameNode.h"
+#include "S3DGameClock.h"
 
 #include <QTime>
 
@@ -75,7 +76,10 @@ public: // functions
 private slots:
 
     //!
-    //! Slot which is called on new frame
+    //! Slot which is called on new frame.
+    //!
+    //! Runs as many fixed game logic steps as the elapsed time requires and
+    //! updates the render outputs once afterwards.
     //!
     void updateGame();
 
@@ -136,12 +140,23 @@ private: //data
     QTime mTime;
     int mElapsed;
 
+    // Real time clock and step accumulator of the fixed step game logic
+    QTime mSimulationClock;
+    FixedStepClock mSimulationSteps;
+
+    // Resolved materials and paths that are updated or tested every step
+    Ogre::MaterialPtr mPlatformMaterial, mLavaMaterial;
+    Path* mTutorialPath;
+
 protected: //functions
 
     virtual void ResetGame();
 
 private:
 
+    void StepGame();
+    void UpdateOutputs();
+
     void UpdateCharacterPosition( Path* path, float alpha, float height );
     void ProcessEvents();
 
@@ -156,7 +171,8 @@ private:
     void PlayDeathAnim();
     void UpdatePlatforms();
 
-    void SetTransparency( QString materialName, float alpha );
+    void SetTransparency( const Ogre::MaterialPtr &materialPtr, float alpha );
+    void SetLavaTimer( const Ogre::MaterialPtr &materialPtr, float timer );
 
     float getPlatformTransparency( float alpha );
     float getPlatformMoveAlpha( float alpha );
@@ -0,0 +1,86 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "S3DGameClock.h"
+//! \brief Header file for FixedStepClock class.
+//!
+//! \version    1.0
+//! \date       19.10.2026 (created)
+//!
+
+#ifndef S3DGAMECLOCK_H
+#define S3DGAMECLOCK_H
+
+namespace S3DGameNode {
+
+    // Accumulates real time and turns it into a number of fixed game logic
+    // steps. The time is passed in, so the game loop can be replayed with
+    // recorded frame times.
+    class FixedStepClock
+    {
+    public:
+
+        // Upper bound of logic steps per frame, slower frames drop the backlog
+        static const int MaxStepsPerFrame = 5;
+
+        FixedStepClock()
+            : mTime(0), mLag(0) {};
+
+        // Sets the time of the last frame and drops the remaining lag
+        void Reset( int time ) { mTime = time; mLag = 0; }
+
+        // Drops the remaining lag, e.g. when the game restarts
+        void DropLag() { mLag = 0; }
+
+        // Adds the time since the last frame and returns the number of steps
+        // of the given length in milliseconds to run for this frame
+        int Advance( int time, int stepLength )
+        {
+            if( stepLength < 1 )
+                stepLength = 1;
+
+            mLag += time - mTime;
+            mTime = time;
+
+            int steps = 0;
+            while( mLag >= stepLength && steps < MaxStepsPerFrame )
+            {
+                mLag -= stepLength;
+                steps++;
+            }
+
+            // drop the backlog if the frames are too slow to catch up
+            if( steps == MaxStepsPerFrame )
+                mLag = 0;
+
+            return steps;
+        }
+
+    private:
+
+        int mTime, mLag;
+    };
+
+} // namespace S3DGameNode
+#endif
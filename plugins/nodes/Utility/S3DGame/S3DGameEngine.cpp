@@ -384,7 +384,7 @@ void S3DGameEngine::ParseEvents( Ogre::SceneNode* sceneNode )
                     }
 
                     // append the event to the current path and iterate
-                    pPath->Events().append(gameEvent);
+                    pPath->AddEvent( gameEvent, gameEvent->Bounds() );
 
                     // store game event
                     mGameEvents.append( gameEvent );
@@ -51,22 +51,46 @@ class Enemy;
 class Obstacle;
 
 // This class stores a game events. 
-// An event consists of strings which define the actions of players
+// An event consists of strings which define the actions of players.
+// The strings are resolved to paths and platform ids when the event is
+// parsed, so the game loop never has to compare names.
 class GameEvent
 {
 public:
+
+    enum PlatformType { NO_PLATFORM, DOOR, PLATFORM1, PLATFORM2, PLATFORM3 };
+
     GameEvent( Ogre::SceneNode* eventSceneNode)
         : mSceneNode(eventSceneNode),
         mJump(NULL),
         mMove(NULL),
         mMoveJump(NULL),
         mPlatform(""),
-        mCheckpoint("")
+        mPlatformType(NO_PLATFORM),
+        mCheckpoint(""),
+        mFinish(false)
     {
         // check valid pointer
         assert( mSceneNode );
-        // Update the bounds of the event scene node
+        // Update the bounds of the event scene node. Event nodes are static,
+        // so the world bounds are stored once
         mSceneNode->_updateBounds();
+        mBounds = mSceneNode->_getWorldAABB();
+    };
+
+    // Creates an event without a scene node from its world bounds, e.g. to
+    // replay the game logic without a scene
+    GameEvent( const Ogre::AxisAlignedBox& bounds )
+        : mSceneNode(NULL),
+        mJump(NULL),
+        mMove(NULL),
+        mMoveJump(NULL),
+        mPlatform(""),
+        mPlatformType(NO_PLATFORM),
+        mBounds(bounds),
+        mCheckpoint(""),
+        mFinish(false)
+    {
     };
 
     Path* Jump() const { return mJump; }
@@ -76,22 +100,37 @@ public:
     Path * MoveJump() const { return mMoveJump; }
     void MoveJump(Path * val) { mMoveJump = val; }
     QString Platform() const { return mPlatform; }
-    void Platform( QString val) { mPlatform = val; }
+    void Platform( QString val)
+    {
+        mPlatform = val;
+        if( val == "Door" )           mPlatformType = DOOR;
+        else if( val == "Platform1" ) mPlatformType = PLATFORM1;
+        else if( val == "Platform2" ) mPlatformType = PLATFORM2;
+        else if( val == "Platform3" ) mPlatformType = PLATFORM3;
+        else                          mPlatformType = NO_PLATFORM;
+    }
+    PlatformType GetPlatformType() const { return mPlatformType; }
     QString Checkpoint() const { return mCheckpoint; }
-    void Checkpoint(QString val) { mCheckpoint = val; }
+    void Checkpoint(QString val) { mCheckpoint = val; mFinish = (val == "finish"); }
+    bool IsCheckpoint() const { return !mCheckpoint.isEmpty(); }
+    bool IsFinish() const { return mFinish; }
     Ogre::SceneNode* SceneNode() const { return mSceneNode; }
+    const Ogre::AxisAlignedBox& Bounds() const { return mBounds; }
 
     // Check if this event is active for the given position
-    bool isActive( Vec3 position )
+    bool isActive( const Vec3 &position ) const
     {
-        return ( mSceneNode && mSceneNode->_getWorldAABB().contains(position) );
+        return mBounds.contains(position);
     }
 
 private:
     Path *mJump, *mMove, *mMoveJump;
     QString mPlatform;
+    PlatformType mPlatformType;
     Ogre::SceneNode* mSceneNode;
+    Ogre::AxisAlignedBox mBounds;
     QString mCheckpoint;
+    bool mFinish;
 };
 
 
@@ -84,6 +84,7 @@ S3DGameNode::S3DGameNode ( const QString &name, ParameterGroup *parameterRoot )
     mP1ActionParameter(NULL),
     mP2ActionParameter(NULL),
     mStepSize(40),
+    mSimulationRate(25),
     mIntervalLength(10000),
     mScale(0.5f),
     mAnimScale(100.0f),
@@ -99,6 +100,7 @@ S3DGameNode::S3DGameNode ( const QString &name, ParameterGroup *parameterRoot )
     // setup game parameter change event
     this->getNumberParameter("PCScale")->setChangeFunction(SLOT(updateGameParameter()));
     this->getNumberParameter("StepSize")->setChangeFunction(SLOT(updateGameParameter()));
+    this->getNumberParameter("SimulationRate")->setChangeFunction(SLOT(updateGameParameter()));
     this->getNumberParameter("AnimScale")->setChangeFunction(SLOT(updateGameParameter()));
     this->getNumberParameter("IntervalLength")->setChangeFunction(SLOT(updateGameParameter()));
     this->getNumberParameter("JumpAnimLength")->setChangeFunction(SLOT(updateGameParameter()));
@@ -720,6 +722,9 @@ void S3DGameNode::updateGameParameter()
         //<parameter name="StepSize" ...
         if( param->getName() == "StepSize")
             mStepSize = param->getValue(false).toInt();
+        //<parameter name="SimulationRate" ...
+        else if( param->getName() == "SimulationRate")
+            mSimulationRate = param->getValue(false).toInt();
         //<parameter name="IntervalLength" ...
         else if( param->getName() == "IntervalLength")
             mIntervalLength = param->getValue(false).toInt();
@@ -235,6 +235,9 @@ protected: //data
 
     int mPlatform1Loop, mPlatform2Loop, mPlatform3Loop;
 
+    // Number of fixed game logic steps per second
+    int mSimulationRate;
+
     // local correspondences to GUI parameters
     float mScale, 
           mStepSize, 
@@ -90,6 +90,15 @@ using namespace Frapper;
         // Every path can have several events
         QList<GameEvent*>& Events() { return mEvents; }
 
+        // The union of the bounds of all events of the path, used to skip
+        // the event tests while the character is outside of every event
+        const Ogre::AxisAlignedBox& EventBounds() const { return mEventBounds; }
+        void AddEvent( GameEvent* event, const Ogre::AxisAlignedBox& bounds )
+        {
+            mEvents.append(event);
+            mEventBounds.merge(bounds);
+        }
+
         // The name is only used for convenience
         QString Name() const { return mName; }
         void Name( QString val) { mName = val; }
@@ -101,6 +110,7 @@ using namespace Frapper;
         float mLength;
         QString mName;
         QList<GameEvent*> mEvents;
+        Ogre::AxisAlignedBox mEventBounds;
     };
 
     //
@@ -50,8 +50,15 @@ PainterGraphicsScene::PainterGraphicsScene () :
 	m_maskLUT(NULL),
 	m_mask(NULL),
 	m_useLUT(false),
-	m_bgDarkenFactor(0.5f)
-{}
+	m_bgDarkenFactor(0.5f),
+	m_backgroundUseLUT(false),
+	m_backgroundDarkenFactor(0.5f),
+	m_lutTable(256),
+	m_allDirty(true)
+{
+	for( int i=0; i<256; i++)
+		m_lutTable[i] = lut(i);
+}
 
 //!
 //! Destructor of the PainterGraphicsScene class.
@@ -75,10 +82,22 @@ PainterGraphicsScene::~PainterGraphicsScene ()
 //!
 void PainterGraphicsScene::setBackground( QImage image )
 {
+	// keep the current item if it was built from the same image and settings
+	if( m_background && image == m_backgroundImage &&
+		m_backgroundUseLUT == m_useLUT && m_backgroundDarkenFactor == m_bgDarkenFactor )
+		return;
+
 	if( m_background ) {
 		delete m_background;
 		m_background = NULL;
 	}
+	m_backgroundImage = image;
+	m_backgroundUseLUT = m_useLUT;
+	m_backgroundDarkenFactor = m_bgDarkenFactor;
+
+	// the background defines the rendered scene rect
+	markAllDirty();
+
 	if( image.isNull() )
 		return;
 
@@ -107,6 +126,10 @@ void PainterGraphicsScene::setBackground( QImage image )
 //!
 void PainterGraphicsScene::setMask( QImage mask )
 {
+	// keep the current items if they were built from the same image
+	if( mask == m_maskImage && (m_mask || mask.isNull()) && (m_maskLUT || !m_useLUT || mask.isNull()) )
+		return;
+
 	if( m_mask ) {
 		delete m_mask;
 		m_mask = NULL;
@@ -115,20 +138,14 @@ void PainterGraphicsScene::setMask( QImage mask )
 		delete m_maskLUT;
 		m_maskLUT = NULL;
 	}
+	m_maskImage = mask;
+	markAllDirty();
 
 	if( mask.isNull() )
 		return;
 	
-	// use compositor to create actual transparent pixmap
-	QPixmap mask_tr( mask.size());
-	mask_tr.fill(Qt::transparent);
-
-	QPainter p(&mask_tr);
-	p.setCompositionMode( QPainter::CompositionMode_SourceOver);
-	p.drawImage(0,0, mask);
-	p.end();
-
-	m_mask = new QGraphicsPixmapItem( mask_tr );
+	// the pixmap keeps the transparency of the mask
+	m_mask = new QGraphicsPixmapItem( QPixmap::fromImage(mask) );
 	m_mask->setZValue(-9991.0f); // value needs to be larger than background and LUT
 	m_mask->setFlag( QGraphicsItem::ItemIsSelectable, false );
 	dynamic_cast<QGraphicsPixmapItem*>(m_mask)->setShapeMode( QGraphicsPixmapItem::BoundingRectShape );
@@ -144,35 +161,27 @@ void PainterGraphicsScene::setMask( QImage mask )
 
 			maskLUT.setColor(0, qRgba(0,0,0,0)); // black & transparent
 			for( int i=1; i<256; i++)
-				maskLUT.setColor(i, lut(i));
+				maskLUT.setColor(i, m_lutTable[i]);
 		
 		} else {
 
-			for( size_t y = 0; y < mask.height(); ++y) 
+			const QRgb* lutTable = m_lutTable.constData();
+			const int width = mask.width();
+
+			for( int y = 0; y < mask.height(); ++y) 
 			{
-				QRgb* srcCol = (QRgb*) mask.scanLine(y);
+				const QRgb* srcCol = (const QRgb*) mask.constScanLine(y);
 				QRgb* dstCol = (QRgb*) maskLUT.scanLine(y);
 
-				for( size_t x = 0; x < mask.width(); ++x) 
+				for( int x = 0; x < width; ++x) 
 				{
-					if( (srcCol[x] & RGB_MASK) == 0)
-						dstCol[x] = 0; // black & transparent
-					else
-						dstCol[x] = lut( qRed( srcCol[x] ));
+					const QRgb src = srcCol[x];
+					dstCol[x] = (src & RGB_MASK) == 0 ? 0 : lutTable[qRed(src)]; // black & transparent
 				}
 			}
 		}
 
-		// use compositor to create actual transparent pixmap
-		QPixmap mask_tr( maskLUT.size());
-		mask_tr.fill(Qt::transparent);
-
-		QPainter p(&mask_tr);
-		p.setCompositionMode( QPainter::CompositionMode_SourceOver);
-		p.drawImage(0,0, maskLUT);
-		p.end();
-
-		m_maskLUT = new QGraphicsPixmapItem( mask_tr );
+		m_maskLUT = new QGraphicsPixmapItem( QPixmap::fromImage(maskLUT) );
 		m_maskLUT->setZValue(-9990.0f); // put LUT-mask over normal mask
 		m_maskLUT->setFlag( QGraphicsItem::ItemIsSelectable, false );
 		dynamic_cast<QGraphicsPixmapItem*>(m_maskLUT)->setShapeMode( QGraphicsPixmapItem::BoundingRectShape );
@@ -221,15 +230,22 @@ QGraphicsItem* PainterGraphicsScene::getBackground()
 //!
 void PainterGraphicsScene::renderToImage( QImage &image, bool withBackground )
 {
+	renderToImage( image, QVector<QRect>() << image.rect(), withBackground );
+}
+
+//!
+//! Render the given regions of the scene to a QImage, the rest of the
+//! image is left untouched. The regions are given in image coordinates.
+//!
+void PainterGraphicsScene::renderToImage( QImage &image, const QVector<QRect> &regions, bool withBackground )
+{
+	if( regions.isEmpty() )
+		return;
+
 	// clear selection in scene
 	QList<QGraphicsItem*> selection = selectedItems();
 	clearSelection();
 
-	// init canvas with black
-	QPainter painter( &image );
-	painter.fillRect(image.rect(), Qt::black);
-	painter.setCompositionMode( QPainter::CompositionMode_SourceOver);
-
 	// hide all additional layers
 	foreach( QGraphicsItem* layer, m_layers ) {
 		layer->setVisible(false);
@@ -239,17 +255,33 @@ void PainterGraphicsScene::renderToImage( QImage &image, bool withBackground )
 	bool useLUT = m_useLUT;
 	setUseLUT(false);
 
-	// render current scene
-	if( m_background ) {
-
+	if( m_background )
 		m_background->setVisible(withBackground);
-		this->render( &painter, image.rect(), m_background->boundingRect());
-		m_background->setVisible( true );
-	
-	} else {
 
-		this->render( &painter, image.rect());
+	// scale of the whole scene rect to the image, keeping the aspect ratio
+	const QRectF source = getRenderSourceRect();
+	const bool validSource = source.width() > 0 && source.height() > 0;
+	QPointF offset;
+	const qreal ratio = getRenderMapping( image.size(), offset );
+
+	// init canvas with black and render the scene rect of each region
+	QPainter painter( &image );
+	foreach( const QRect &region, regions ) 
+	{
+		painter.setClipRect( region );
+		painter.setCompositionMode( QPainter::CompositionMode_SourceOver);
+		painter.fillRect( region, Qt::black );
+
+		if( validSource ) {
+			const QRectF regionSource( source.left() + (region.left() - offset.x()) / ratio, source.top() + (region.top() - offset.y()) / ratio,
+									   region.width() / ratio, region.height() / ratio );
+			this->render( &painter, region, regionSource, Qt::IgnoreAspectRatio );
+		}
 	}
+	painter.end();
+
+	if( m_background )
+		m_background->setVisible( true );
 
 	// restore usage of LUT
 	setUseLUT(useLUT);
@@ -264,6 +296,139 @@ void PainterGraphicsScene::renderToImage( QImage &image, bool withBackground )
 		item->setSelected(true);
 }
 
+//!
+//! Returns the scene rect that is rendered to the image
+//!
+QRectF PainterGraphicsScene::getRenderSourceRect() const
+{
+	return m_background ? m_background->boundingRect() : sceneRect();
+}
+
+//!
+//! Returns the mapping of the render source rect to an image of the given size
+//!
+qreal PainterGraphicsScene::getRenderMapping( const QSize &size, QPointF &offset ) const
+{
+	const QRectF source = getRenderSourceRect();
+	if( source.width() <= 0 || source.height() <= 0 ) {
+		offset = QPointF();
+		return 1.0;
+	}
+
+	const qreal ratio = qMin( size.width() / source.width(), size.height() / source.height() );
+	offset = QPointF( (size.width() - source.width() * ratio) / 2.0, (size.height() - source.height() * ratio) / 2.0 );
+	return ratio;
+}
+
+//!
+//! Returns the scene rects changed since the last call and resets them.
+//! Changes to items are tracked by their bounding rects including the pen
+//! and by their pen and brush.
+//!
+bool PainterGraphicsScene::takeDirtyRects( QVector<QRectF> &rects )
+{
+	// catch items that were moved, restyled, added or deleted without
+	// passing the scene, e.g. by undo commands
+	QHash<QGraphicsItem*, QRectF> itemRects;
+	QHash<QGraphicsItem*, ItemStyle> itemStyles;
+	foreach( QGraphicsItem* item, items() )
+	{
+		if( !dynamic_cast<BaseShapeItem*>(item) )
+			continue;
+
+		const QRectF rect = getItemRenderRect(item);
+		const ItemStyle style = getItemStyle(item);
+		itemRects.insert( item, rect );
+		itemStyles.insert( item, style );
+
+		QHash<QGraphicsItem*, QRectF>::const_iterator iter = m_itemRects.constFind(item);
+		if( iter == m_itemRects.constEnd() ) {
+			markDirty( rect );
+		} else if( iter.value() != rect || m_itemStyles.value(item) != style ) {
+			markDirty( iter.value() );
+			markDirty( rect );
+		}
+	}
+	for( QHash<QGraphicsItem*, QRectF>::const_iterator iter = m_itemRects.constBegin(); iter != m_itemRects.constEnd(); ++iter )
+	{
+		if( !itemRects.contains(iter.key()) )
+			markDirty( iter.value() );
+	}
+	m_itemRects = itemRects;
+	m_itemStyles = itemStyles;
+
+	const bool allDirty = m_allDirty;
+	rects = m_dirtyRects;
+	m_dirtyRects.clear();
+	m_allDirty = false;
+	return allDirty;
+}
+
+//!
+//! Marks the whole scene as changed
+//!
+void PainterGraphicsScene::markAllDirty()
+{
+	m_allDirty = true;
+	m_dirtyRects.clear();
+}
+
+//!
+//! Marks the given scene rect as changed
+//!
+void PainterGraphicsScene::markDirty( const QRectF& rect )
+{
+	if( !m_allDirty && !rect.isEmpty() )
+		m_dirtyRects.append( rect );
+}
+
+//!
+//! Returns the scene rect covered by the given item including its pen
+//!
+QRectF PainterGraphicsScene::getItemRenderRect( QGraphicsItem* item ) const
+{
+	if( !item->isVisible() )
+		return QRectF();
+
+	const QAbstractGraphicsShapeItem* shapeItem = dynamic_cast<const QAbstractGraphicsShapeItem*>(item);
+	const qreal margin = (shapeItem ? shapeItem->pen().widthF() / 2.0 : 0.0) + 1.0;
+	return item->sceneBoundingRect().adjusted( -margin, -margin, margin, margin );
+}
+
+//!
+//! Returns the pen and brush the given item is drawn with
+//!
+PainterGraphicsScene::ItemStyle PainterGraphicsScene::getItemStyle( QGraphicsItem* item ) const
+{
+	const QAbstractGraphicsShapeItem* shapeItem = dynamic_cast<const QAbstractGraphicsShapeItem*>(item);
+	if( !shapeItem )
+		return ItemStyle();
+
+	return ItemStyle( shapeItem->pen(), shapeItem->brush() );
+}
+
+//!
+//! Marks the last known and the current rect of the given item as changed
+//!
+void PainterGraphicsScene::markItemDirty( QGraphicsItem* item )
+{
+	const QRectF rect = getItemRenderRect(item);
+	markDirty( m_itemRects.value(item) );
+	markDirty( rect );
+	m_itemRects.insert( item, rect );
+	m_itemStyles.insert( item, getItemStyle(item) );
+}
+
+//!
+//! Marks the last known rect of the given item as changed and forgets the item
+//!
+void PainterGraphicsScene::markItemRemoved( QGraphicsItem* item )
+{
+	markDirty( m_itemRects.value(item, getItemRenderRect(item)) );
+	m_itemRects.remove( item );
+	m_itemStyles.remove( item );
+}
+
 //!
 //! Clear the whole scene and delete all items
 //!
@@ -274,6 +439,7 @@ void PainterGraphicsScene::clearItems()
 		if( dynamic_cast<BaseShapeItem*>(item))
 		{
 			QString itemName = dynamic_cast<BaseShapeItem*>(item)->getName();
+			markItemRemoved(item);
 			delete item;
 			
 			emit itemDeleted(itemName);
@@ -295,8 +461,12 @@ void PainterGraphicsScene::clear()
 	QGraphicsScene::clear();
 	m_background = NULL;
 	m_mask = NULL;
+	m_maskLUT = NULL;
 
 	m_layers.clear();
+	m_itemRects.clear();
+	m_itemStyles.clear();
+	markAllDirty();
 }
 
 BaseShapeItem* PainterGraphicsScene::createGraphicsItem( const PainterPanelItemData& itemData )
@@ -345,6 +515,7 @@ BaseShapeItem* PainterGraphicsScene::createGraphicsItem( const PainterPanelItemD
 
 		// items that are created from itemData should not be selected
 		item->setSelected(false);
+		markItemDirty(item);
 	}
 
 	return item;
@@ -421,6 +592,7 @@ BaseShapeItem* PainterGraphicsScene::createGraphicsItem( QPointF pos, BaseShapeI
 			result->setUseLUT(m_useLUT);
 
 			addItem( result );
+			markItemDirty( result );
 
 			emit itemCreated(result);
 			emit sceneChanged();
@@ -428,6 +600,7 @@ BaseShapeItem* PainterGraphicsScene::createGraphicsItem( QPointF pos, BaseShapeI
 		else 
 		{
 			addItem( result);
+			markItemDirty( result );
 		}
 	}
 
@@ -441,8 +614,10 @@ void PainterGraphicsScene::sceneHasChanged() {
 void PainterGraphicsScene::sceneItemHasChanged()
 {
 	BaseShapeItem* shapeItem = dynamic_cast<BaseShapeItem*>(sender());
-	if( shapeItem )
+	if( shapeItem ) {
+		markItemDirty(shapeItem);
 		emit itemChanged(shapeItem);
+	}
 	emit sceneChanged();
 }
 
@@ -459,14 +634,18 @@ BaseShapeItem* PainterGraphicsScene::getGraphicsItemByName( const QString& name
 
 void PainterGraphicsScene::updateGraphicsItem( const PainterPanelItemData& itemData )
 {
-	BaseShapeItem* item = getGraphicsItemByName( itemData.ItemName() );
+	updateGraphicsItem( itemData, getGraphicsItemByName( itemData.ItemName() ));
+}
 
+void PainterGraphicsScene::updateGraphicsItem( const PainterPanelItemData& itemData, BaseShapeItem* item )
+{
 	if( !item ) {
 		createGraphicsItem( itemData );
 	
 	} else {
 		if( !itemData.Valid() ){
 			QString itemName = item->getName();
+			markItemRemoved( item );
 			delete item;
 			emit itemDeleted( itemName );
 
@@ -489,12 +668,25 @@ void PainterGraphicsScene::updateGraphicsItem( const PainterPanelItemData& itemD
 			item->setBrush(brush);
 
 			item->updateShape();
+			markItemDirty( item );
 		}
 	}
 	
 	emit sceneChanged();
 }
 
+QHash<QString, BaseShapeItem*> PainterGraphicsScene::getGraphicsItemsByName()
+{
+	QHash<QString, BaseShapeItem*> result;
+	foreach( QGraphicsItem* gi, items() )
+	{
+		BaseShapeItem* bsi = dynamic_cast<BaseShapeItem*>(gi);
+		if( bsi && !result.contains( bsi->getName() ))
+			result.insert( bsi->getName(), bsi );
+	}
+	return result;
+}
+
 void PainterGraphicsScene::updateGraphicsItemNames()
 {
 	QList<QString> itemList = QList<QString>();
@@ -536,6 +728,7 @@ void PainterGraphicsScene::deleteGraphicsItem( QString name )
 {
 	BaseShapeItem* itemToDelete = getGraphicsItemByName(name);
 	if( itemToDelete ) {
+		markItemRemoved( itemToDelete );
 		delete itemToDelete;
 	}
 }
@@ -543,6 +736,8 @@ void PainterGraphicsScene::deleteGraphicsItem( QString name )
 
 void PainterGraphicsScene::signalItemChanged( BaseShapeItem* item )
 {
+	if( item )
+		markItemDirty(item);
 	emit itemChanged(item);
 }
 
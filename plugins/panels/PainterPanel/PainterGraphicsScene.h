@@ -40,6 +40,8 @@ http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
 #include <QGraphicsItem>
 #include <QPainter>
 #include <QBitmap>
+#include <QHash>
+#include <QVector>
 
 namespace PainterPanel {
 
@@ -172,6 +174,20 @@ public: //functions
 	//!
 	void updateGraphicsItem( const PainterPanelItemData& itemData );
 
+	//!
+	//! Updates the given GraphicsItem according to the given parameters,
+	//! creates a new item if no item is given
+	//!
+	//! \param itemData The values of the graphics item
+	//! \param item The graphics item to update, or NULL
+	//!
+	void updateGraphicsItem( const PainterPanelItemData& itemData, BaseShapeItem* item );
+
+	//!
+	//! Get all graphics items of the scene by name
+	//!
+	QHash<QString, BaseShapeItem*> getGraphicsItemsByName();
+
 	//!
 	//! This function is called for restoring all item names in the history widget
 	//!
@@ -200,6 +216,43 @@ public: //functions
     //!
     void renderToImage( QImage &image, bool withBackground=false );
 
+	//!
+	//! Render the given regions of the scene to a QImage, the rest of the
+	//! image is left untouched. The regions are given in image coordinates.
+	//!
+	void renderToImage( QImage &image, const QVector<QRect> &regions, bool withBackground=false );
+
+	//!
+	//! Returns the scene rect that is rendered to the image
+	//!
+	QRectF getRenderSourceRect() const;
+
+	//!
+	//! Returns the mapping of the render source rect to an image of the given
+	//! size. Like QGraphicsScene::render, the aspect ratio is kept and the
+	//! source is centered in the image.
+	//!
+	//! \param size The size of the image
+	//! \param offset Returns the image position of the top left source corner
+	//! \return The scale of the source to the image
+	//!
+	qreal getRenderMapping( const QSize &size, QPointF &offset ) const;
+
+	//!
+	//! Returns the scene rects changed since the last call and resets them.
+	//! Changes to items are tracked by their bounding rects including the pen
+	//! and by their pen and brush.
+	//!
+	//! \param rects The changed scene rects
+	//! \return True if the whole scene has changed, e.g. the mask or the background
+	//!
+	bool takeDirtyRects( QVector<QRectF> &rects );
+
+	//!
+	//! Marks the whole scene as changed
+	//!
+	void markAllDirty();
+
 	//!
 	//! Override QGraphicsScenes clear method to handle background an mask pointer
 	//!
@@ -229,6 +282,38 @@ protected slots:
 	//!
 	void sceneItemHasChanged();
 
+private: // types
+
+	//! the pen and brush a shape item is drawn with
+	typedef QPair<QPen, QBrush> ItemStyle;
+
+private: // functions
+
+	//!
+	//! Returns the scene rect covered by the given item including its pen
+	//!
+	QRectF getItemRenderRect( QGraphicsItem* item ) const;
+
+	//!
+	//! Returns the pen and brush the given item is drawn with
+	//!
+	ItemStyle getItemStyle( QGraphicsItem* item ) const;
+
+	//!
+	//! Marks the given scene rect as changed
+	//!
+	void markDirty( const QRectF& rect );
+
+	//!
+	//! Marks the last known and the current rect of the given item as changed
+	//!
+	void markItemDirty( QGraphicsItem* item );
+
+	//!
+	//! Marks the last known rect of the given item as changed and forgets the item
+	//!
+	void markItemRemoved( QGraphicsItem* item );
+
 private: // data
             
     //! the background item
@@ -245,6 +330,25 @@ private: // data
 	bool m_useLUT;
 	float m_bgDarkenFactor;
 
+	//! the images and settings the background and mask items were built from
+	QImage m_backgroundImage;
+	bool m_backgroundUseLUT;
+	float m_backgroundDarkenFactor;
+	QImage m_maskImage;
+
+	//! the LUT colors of all mask values
+	QVector<QRgb> m_lutTable;
+
+	//! the last known render rects of the shape items
+	QHash<QGraphicsItem*, QRectF> m_itemRects;
+
+	//! the last known pens and brushes of the shape items
+	QHash<QGraphicsItem*, ItemStyle> m_itemStyles;
+
+	//! the scene rects changed since the last render
+	QVector<QRectF> m_dirtyRects;
+	bool m_allDirty;
+
 }; //PainterGraphicsScene
 
 } // end namespace PainterPanel
@@ -180,9 +180,10 @@ void PainterGraphicsView::changePen( QPen pen )
 	    foreach (QGraphicsItem *graphics_item, m_scene->selectedItems())
 		{
 			BaseShapeItem *item = dynamic_cast<BaseShapeItem*>(graphics_item);
-			if( item )
+			if( item ) {
 				item->setPen(m_pen);
 				m_scene->signalItemChanged(item);
+			}
 		}
 	}
 }
@@ -41,6 +41,9 @@ http://www.gnu.org/copyleft/lesser.txt.
 namespace PainterPanel {
 using namespace Frapper;
 
+//! edge length of the image tiles that are rendered and uploaded on scene changes
+static const int RenderTileSize = 128;
+
  
 ///
 /// Constructors and Destructors
@@ -53,7 +56,8 @@ using namespace Frapper;
 //! \param flags Extra widget options.
 //!
 PainterPanelNode::PainterPanelNode( const QString &name, ParameterGroup *parameterRoot ) :
-	ImageNode(name, parameterRoot, true, "image")
+	ImageNode(name, parameterRoot, true, "image"),
+	m_renderTextureHandle(0)
 {
 	// update item parameter upon item changes in scene
 	connect( &m_scene, SIGNAL( itemCreated(BaseShapeItem*)),	this, SLOT( createParameter(BaseShapeItem*)));
@@ -120,13 +124,73 @@ void PainterPanelNode::renderSceneToImage( Ogre::TexturePtr& image, size_t width
 		if( width == 0)  width = image->getWidth();
 		if( height == 0) height = image->getHeight();
 
-		QImage view( width, height, QImage::Format_ARGB32_Premultiplied );
+		QVector<QRectF> dirtyRects;
+		const bool allDirty = m_scene.takeDirtyRects( dirtyRects );
+		const QRectF source = m_scene.getRenderSourceRect();
+
+		// render and write the whole image if the scene rect or the target changed
+		if( allDirty || source.isEmpty() || source != m_renderSource ||
+			m_renderCache.width() != (int) width || m_renderCache.height() != (int) height ||
+			image->getWidth() != width || image->getHeight() != height ||
+			image->getHandle() != m_renderTextureHandle )
+		{
+			m_renderCache = QImage( (int) width, (int) height, QImage::Format_ARGB32_Premultiplied );
+
+			// render current view to QImage
+			m_scene.renderToImage( m_renderCache );
+
+			// write QImage to Ogre Texture
+			OgreTools::QImageToOgreTexture( m_renderCache, image, image->getFormat() );
 
-		// render current view to QImage
-		m_scene.renderToImage( view );
+			m_renderSource = source;
+			m_renderTextureHandle = image->getHandle();
+			return;
+		}
+
+		if( dirtyRects.isEmpty() )
+			return;
+
+		// collect the image tiles touched by the changed scene rects
+		QPointF offset;
+		const qreal ratio = m_scene.getRenderMapping( QSize( (int) width, (int) height ), offset );
+		const int tilesX = ((int) width  + RenderTileSize - 1) / RenderTileSize;
+		const int tilesY = ((int) height + RenderTileSize - 1) / RenderTileSize;
+		QVector<bool> tiles( tilesX * tilesY, false );
 
-		// write QImage to Ogre Texture
-		OgreTools::QImageToOgreTexture( view, image, image->getFormat() );
+		foreach( const QRectF &rect, dirtyRects )
+		{
+			// add a small margin for antialiasing
+			const QRect imageRect = QRectF( offset.x() + (rect.left() - source.left()) * ratio, offset.y() + (rect.top() - source.top()) * ratio,
+											rect.width() * ratio, rect.height() * ratio ).toAlignedRect().adjusted( -2, -2, 2, 2 ).intersected( m_renderCache.rect() );
+			if( imageRect.isEmpty() )
+				continue;
+
+			for( int ty = imageRect.top() / RenderTileSize; ty <= imageRect.bottom() / RenderTileSize; ++ty )
+				for( int tx = imageRect.left() / RenderTileSize; tx <= imageRect.right() / RenderTileSize; ++tx )
+					tiles[ty * tilesX + tx] = true;
+		}
+
+		// merge neighboring tiles of a row into one region
+		QVector<QRect> regions;
+		for( int ty = 0; ty < tilesY; ++ty )
+		{
+			for( int tx = 0; tx < tilesX; ++tx )
+			{
+				if( !tiles[ty * tilesX + tx] )
+					continue;
+
+				const int start = tx;
+				while( tx + 1 < tilesX && tiles[ty * tilesX + tx + 1] )
+					++tx;
+
+				regions.append( QRect( start * RenderTileSize, ty * RenderTileSize, (tx - start + 1) * RenderTileSize, RenderTileSize ).intersected( m_renderCache.rect() ));
+			}
+		}
+
+		// render and write only the changed regions
+		m_scene.renderToImage( m_renderCache, regions );
+		foreach( const QRect &region, regions )
+			OgreTools::QImageToOgreTexture( m_renderCache, image, region );
 	}
 }
 
@@ -159,12 +223,16 @@ void PainterPanelNode::updateItems( int time )
 
 	if( itemGroup ) 
 	{
+		// look up the graphics items once instead of searching the scene per item
+		const QHash<QString, BaseShapeItem*> graphicsItems = m_scene.getGraphicsItemsByName();
+
 		foreach( AbstractParameter* absParam, itemGroup->getParameterMap().values()) 
 		{
 			ParameterGroup* itemParameter = dynamic_cast<ParameterGroup*>( absParam );
 			if( itemParameter )
 			{
-				updateItem(itemParameter, time);
+				PainterPanelItemData itemData( itemParameter, time );
+				m_scene.updateGraphicsItem( itemData, graphicsItems.value( itemData.ItemName() ));
 			}
 		}
 	}
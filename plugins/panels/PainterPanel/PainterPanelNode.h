@@ -200,6 +200,15 @@ protected:
 	//!
 	PainterGraphicsScene	m_scene;
 
+private: // data
+
+	//!
+	//! The last rendered image, the scene rect and the texture it was written to
+	//!
+	QImage m_renderCache;
+	QRectF m_renderSource;
+	Ogre::ResourceHandle m_renderTextureHandle;
+
 };
 
 } // end namespace PainterPanel
@@ -0,0 +1,221 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ProfilerPanel.cpp"
+//! \brief Implementation file for ProfilerPanel class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "ProfilerPanel.h"
+#include "Profiler.h"
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QToolBar>
+#include <QFileDialog>
+
+
+namespace Frapper {
+
+///
+/// Constructors and Destructors
+///
+
+
+//!
+//! Constructor of the ProfilerPanel class.
+//!
+//! \param parent The parent widget the created instance will be a child of.
+//! \param flags Extra widget options.
+//!
+ProfilerPanel::ProfilerPanel ( QWidget *parent /* = 0 */, Qt::WindowFlags flags /* = 0 */ ) :
+    ViewPanel(ViewPanel::T_PluginPanel, parent, flags),
+    m_recordAction(0)
+{
+    m_statisticsTable = new QTableWidget(0, 5, this);
+    m_statisticsTable->setHorizontalHeaderLabels(QStringList() << tr("Node") << tr("Calls") << tr("Self Time [ms]") << tr("Average [ms]") << tr("Max [ms]"));
+    m_statisticsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_statisticsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_statisticsTable->verticalHeader()->hide();
+    m_statisticsTable->horizontalHeader()->setStretchLastSection(true);
+
+    m_summaryLabel = new QLabel(this);
+
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->setSpacing(3);
+    layout->setContentsMargins(1, 1, 1, 1);
+    layout->addWidget(m_statisticsTable);
+    layout->addWidget(m_summaryLabel);
+    setLayout(layout);
+
+    m_refreshTimer.setInterval(1000);
+    connect(&m_refreshTimer, SIGNAL(timeout()), SLOT(updateStatistics()));
+
+    updateStatistics();
+}
+
+
+//!
+//! Destructor of the ProfilerPanel class.
+//!
+//! Defined virtual to guarantee that the destructor of a derived class
+//! will be called if the instance of the derived class is saved in a
+//! variable of its parent class type.
+//!
+ProfilerPanel::~ProfilerPanel ()
+{
+}
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Fills the given tool bars with actions for the profiler panel.
+//!
+//! \param mainToolBar The main tool bar to fill with actions.
+//! \param panelToolBar The panel tool bar to fill with actions.
+//!
+void ProfilerPanel::fillToolBars ( QToolBar *mainToolBar, QToolBar *panelToolBar )
+{
+    m_recordAction = new QAction(QIcon(":/playIcon"), tr("Record"), this);
+    m_recordAction->setCheckable(true);
+    m_recordAction->setChecked(Profiler::isEnabled());
+    m_recordAction->setToolTip(tr("Record the node evaluation"));
+    connect(m_recordAction, SIGNAL(toggled(bool)), SLOT(setRecording(bool)));
+
+    QAction *refreshAction = new QAction(QIcon(":/refreshIcon"), tr("Refresh"), this);
+    refreshAction->setToolTip(tr("Refresh the node statistics"));
+    connect(refreshAction, SIGNAL(triggered()), SLOT(updateStatistics()));
+
+    QAction *clearAction = new QAction(QIcon(":/deleteIcon"), tr("Clear"), this);
+    clearAction->setToolTip(tr("Drop all recorded events"));
+    connect(clearAction, SIGNAL(triggered()), SLOT(clear()));
+
+    QAction *exportAction = new QAction(QIcon(":/saveIcon"), tr("Export Trace..."), this);
+    exportAction->setToolTip(tr("Export the recorded events as Chrome trace"));
+    connect(exportAction, SIGNAL(triggered()), SLOT(exportTrace()));
+
+    mainToolBar->addAction(m_recordAction);
+    mainToolBar->addAction(refreshAction);
+    mainToolBar->addAction(clearAction);
+    mainToolBar->addAction(exportAction);
+
+    if (Profiler::isEnabled())
+        m_refreshTimer.start();
+}
+
+
+///
+/// Private Slots
+///
+
+
+//!
+//! Starts or stops recording.
+//!
+//! \param record The new recording state.
+//!
+void ProfilerPanel::setRecording ( bool record )
+{
+    Profiler::setEnabled(record);
+
+    if (record)
+        m_refreshTimer.start();
+    else
+        m_refreshTimer.stop();
+
+    if (m_recordAction)
+        m_recordAction->setIcon(QIcon(record ? ":/stopIcon" : ":/playIcon"));
+
+    updateStatistics();
+}
+
+
+//!
+//! Drops all recorded events.
+//!
+void ProfilerPanel::clear ()
+{
+    Profiler::clear();
+    updateStatistics();
+}
+
+
+//!
+//! Fills the table with the current node statistics.
+//!
+void ProfilerPanel::updateStatistics ()
+{
+    const QList<Profiler::NodeStatistics> statistics = Profiler::getNodeStatistics();
+
+    qint64 totalTime = 0;
+    m_statisticsTable->setSortingEnabled(false);
+    m_statisticsTable->setRowCount(statistics.size());
+    for (int row = 0; row < statistics.size(); ++row) {
+        const Profiler::NodeStatistics &nodeStatistics = statistics.at(row);
+        const double selfTime = nodeStatistics.selfTime / 1000.0;
+        const double averageTime = nodeStatistics.calls > 0 ? selfTime / nodeStatistics.calls : 0.0;
+        totalTime += nodeStatistics.selfTime;
+
+        QTableWidgetItem *nameItem = new QTableWidgetItem(nodeStatistics.nodeName);
+        QTableWidgetItem *callsItem = new QTableWidgetItem();
+        callsItem->setData(Qt::DisplayRole, nodeStatistics.calls);
+        QTableWidgetItem *selfTimeItem = new QTableWidgetItem();
+        selfTimeItem->setData(Qt::DisplayRole, QString::number(selfTime, 'f', 3).toDouble());
+        QTableWidgetItem *averageTimeItem = new QTableWidgetItem();
+        averageTimeItem->setData(Qt::DisplayRole, QString::number(averageTime, 'f', 3).toDouble());
+        QTableWidgetItem *maxTimeItem = new QTableWidgetItem();
+        maxTimeItem->setData(Qt::DisplayRole, QString::number(nodeStatistics.maxTime / 1000.0, 'f', 3).toDouble());
+
+        m_statisticsTable->setItem(row, 0, nameItem);
+        m_statisticsTable->setItem(row, 1, callsItem);
+        m_statisticsTable->setItem(row, 2, selfTimeItem);
+        m_statisticsTable->setItem(row, 3, averageTimeItem);
+        m_statisticsTable->setItem(row, 4, maxTimeItem);
+    }
+    m_statisticsTable->setSortingEnabled(true);
+
+    QString summary = tr("%1 events, %2 ms in %3 nodes").arg(Profiler::getEventCount()).arg(totalTime / 1000.0, 0, 'f', 1).arg(statistics.size());
+    const int droppedEventCount = Profiler::getDroppedEventCount();
+    if (droppedEventCount > 0)
+        summary += tr(", %1 events dropped").arg(droppedEventCount);
+    m_summaryLabel->setText(summary);
+}
+
+
+//!
+//! Asks for a file name and writes the recorded events as Chrome trace.
+//!
+void ProfilerPanel::exportTrace ()
+{
+    const QString filename = QFileDialog::getSaveFileName(this, tr("Export Trace"), "profile.json", tr("Chrome Trace Files (*.json)"));
+    if (!filename.isEmpty())
+        Profiler::writeChromeTrace(filename);
+}
+
+} // end namespace Frapper
@@ -0,0 +1,131 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ProfilerPanel.h"
+//! \brief Header file for ProfilerPanel class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef PROFILERPANEL_H
+#define PROFILERPANEL_H
+
+#include "FrapperPrerequisites.h"
+#include "ViewPanel.h"
+#include <QTableWidget>
+#include <QLabel>
+#include <QAction>
+#include <QtCore/QTimer>
+
+namespace Frapper {
+
+//!
+//! Panel for recording the node evaluation with the Profiler and listing the
+//! hottest nodes. The recording can be exported as Chrome trace JSON.
+//!
+class ProfilerPanel : public ViewPanel
+{
+
+    Q_OBJECT
+
+public: // constructors and destructors
+
+    //!
+    //! Constructor of the ProfilerPanel class.
+    //!
+    //! \param parent The parent widget the created instance will be a child of.
+    //! \param flags Extra widget options.
+    //!
+    ProfilerPanel ( QWidget *parent = 0, Qt::WindowFlags flags = 0 );
+
+    //!
+    //! Destructor of the ProfilerPanel class.
+    //!
+    //! Defined virtual to guarantee that the destructor of a derived class
+    //! will be called if the instance of the derived class is saved in a
+    //! variable of its parent class type.
+    //!
+    virtual ~ProfilerPanel ();
+
+public: // functions
+
+    //!
+    //! Fills the given tool bars with actions for the profiler panel.
+    //!
+    //! \param mainToolBar The main tool bar to fill with actions.
+    //! \param panelToolBar The panel tool bar to fill with actions.
+    //!
+    virtual void fillToolBars ( QToolBar *mainToolBar, QToolBar *panelToolBar );
+
+private slots: //
+
+    //!
+    //! Starts or stops recording.
+    //!
+    //! \param record The new recording state.
+    //!
+    void setRecording ( bool record );
+
+    //!
+    //! Drops all recorded events.
+    //!
+    void clear ();
+
+    //!
+    //! Fills the table with the current node statistics.
+    //!
+    void updateStatistics ();
+
+    //!
+    //! Asks for a file name and writes the recorded events as Chrome trace.
+    //!
+    void exportTrace ();
+
+private: // data
+
+    //!
+    //! The table listing the hottest nodes.
+    //!
+    QTableWidget *m_statisticsTable;
+
+    //!
+    //! Label showing the number of recorded events.
+    //!
+    QLabel *m_summaryLabel;
+
+    //!
+    //! The action toggling the recording.
+    //!
+    QAction *m_recordAction;
+
+    //!
+    //! Timer refreshing the statistics while recording.
+    //!
+    QTimer m_refreshTimer;
+};
+
+} // end namespace Frapper
+
+#endif
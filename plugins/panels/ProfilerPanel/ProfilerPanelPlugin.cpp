@@ -0,0 +1,56 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ProfilerPanelPlugin.cpp"
+//! \brief Implementation file for ProfilerPanelPlugin class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#include "ProfilerPanelPlugin.h"
+#include "ProfilerPanel.h"
+#include <QtCore/QtPlugin>
+
+
+///
+/// Public Functions
+///
+
+
+//!
+//! Creates a panel of this panel type.
+//!
+//! \param parent The parent widget of the panel.
+//! \return A pointer to the new panel.
+//!
+Panel * ProfilerPanelPlugin::createPanel( QWidget *parent)
+{
+    return new ProfilerPanel(parent);
+}
+
+
+#if QT_VERSION < 0x050000
+Q_EXPORT_PLUGIN2(ProfilerPanelplugin, ProfilerPanelPlugin)
+#endif
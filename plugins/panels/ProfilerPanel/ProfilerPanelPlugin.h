@@ -0,0 +1,62 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of FRAPPER
+research.animationsinstitut.de
+sourceforge.net/projects/frapper
+
+Copyright (c) 2008-2016 Filmakademie Baden-Wuerttemberg, Institute of Animation
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; version 2.1 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+-----------------------------------------------------------------------------
+*/
+
+//!
+//! \file "ProfilerPanelPlugin.h"
+//! \brief Header file for ProfilerPanelPlugin class.
+//!
+//! \version    1.0
+//! \date       18.10.2026 (created)
+//!
+
+#ifndef PROFILERPANELPLUGIN_H
+#define PROFILERPANELPLUGIN_H
+
+#include "PanelTypeInterface.h"
+
+
+//!
+//! Plugin class for creating ProfilerPanel objects.
+//!
+class ProfilerPanelPlugin : public QObject, public PanelTypeInterface
+{
+    Q_OBJECT
+#if QT_VERSION >= 0x050000
+    Q_PLUGIN_METADATA(IID "de.filmakademie.Nodes.NodeTypeInterface/1.1" FILE "metadata.json")
+#endif
+    Q_INTERFACES(PanelTypeInterface)
+
+public: // functions
+
+    //!
+    //! Creates a panel of this panel type.
+    //!
+    //! \param parent The parent widget of the panel.
+    //! \return A pointer to the new panel.
+    //!
+    virtual Panel * createPanel ( QWidget *parent );
+
+};
+
+
+#endif